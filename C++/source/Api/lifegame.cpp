@@ -0,0 +1,343 @@
+/**
+ * @file    lifegame.cpp
+ * @brief   ライフゲームのエンジンをC言語から使うためのAPIの実装.
+ * @note    Cの呼び出し元へ例外を投げないよう, エンジンを呼ぶ公開関数は全て本体をtry/catchで囲む.
+ *          例外はメモリ不足として, LIFEGAME_ERROR_MEMORY(ポインタを返す関数はNULL, 大きさを返す関数は0)を返す.
+ */
+#include "lifegame.h"
+#include "../Model/MatrixCell.h"
+#include "../Model/BitBoard.h"
+#include "../Model/PatternFile.h"
+#include "../Lib/MemoryUsage.h"
+#include "../Lib/Clock.h"
+
+#include <cstring>
+#include <string>
+
+/**
+ * @brief   盤面のハンドルの中身.
+ * @note    エンジン(MatrixCell)はセル毎のオブジェクトで持つので, 詰めた行は書き出した写し(m_cBoard)を返す.
+ *          盤面が変わったら印(m_bIsBoardDirty)を付け, 次にlifegame_get_rows()が呼ばれた時だけ書き出す.
+ */
+struct lifegame
+{
+	MatrixCell* m_pcMatrixCell;     // エンジン.
+	BitBoard m_cBoard;              // 詰めた行.(lifegame_get_rows()が返す).
+	bool m_bIsBoardDirty;           // m_cBoardが古いか否か.
+	int m_iThreadNum;               // 書き出しのスレッド数.
+	double m_dStepSecond;           // 直前のlifegame_step()の経過時間.
+};
+
+/**
+ * @brief   ハンドルを生成する.
+ * @note    例外は呼び出し元(公開関数)で受け止める.
+ */
+static lifegame_t* create_game(long i_lColMax, long i_lRowMax, int i_iBoundary)
+{
+	if( (0 >= i_lColMax) || (0 >= i_lRowMax) ) return 0;
+	if( (LIFEGAME_BOUNDARY_TORUS != i_iBoundary) && (LIFEGAME_BOUNDARY_DEAD != i_iBoundary) ) return 0;
+
+	lifegame_t* a_pcGame = new lifegame_t;
+	try
+	{
+		a_pcGame->m_pcMatrixCell = new MatrixCell(i_lColMax, i_lRowMax,
+			(LIFEGAME_BOUNDARY_DEAD == i_iBoundary)? MatrixCell::BOUNDARY_DEAD : MatrixCell::BOUNDARY_TORUS);
+	}
+	catch(...)
+	{
+		delete a_pcGame;
+		throw;
+	}
+	a_pcGame->m_bIsBoardDirty = true;
+	a_pcGame->m_iThreadNum = 1;
+	a_pcGame->m_dStepSecond = 0.0;
+	return a_pcGame;
+}
+
+int lifegame_get_version(void)
+{
+	return LIFEGAME_API_VERSION;
+}
+
+lifegame_t* lifegame_create(long i_lColMax, long i_lRowMax, int i_iBoundary)
+{
+	try
+	{
+		return create_game(i_lColMax, i_lRowMax, i_iBoundary);
+	}
+	catch(...)
+	{
+		return 0;
+	}
+}
+
+lifegame_t* lifegame_load(const char* i_pPath, long i_lColMax, long i_lRowMax, int i_iBoundary)
+{
+	if(0 == i_pPath) return 0;
+
+	lifegame_t* a_pcGame = 0;
+	try
+	{
+		BitBoard a_cPattern;
+		LifeRule a_cRule;
+		if(!PatternFile::load(i_pPath, a_cPattern, &a_cRule)) return 0;
+
+		long a_lColMax = (0 < i_lColMax)? i_lColMax : a_cPattern.getColMax();
+		long a_lRowMax = (0 < i_lRowMax)? i_lRowMax : a_cPattern.getRowMax();
+		a_pcGame = create_game(a_lColMax, a_lRowMax, i_iBoundary);
+		if(0 == a_pcGame) return 0;
+
+		// 中央に置く.(はみ出す部分は捨てる).
+		BitBoard& a_cBoard = a_pcGame->m_cBoard;
+		a_cBoard.init(a_lColMax, a_lRowMax);
+		a_cBoard.paste(a_cPattern, (a_lColMax - a_cPattern.getColMax()) / 2, (a_lRowMax - a_cPattern.getRowMax()) / 2);
+		a_pcGame->m_pcMatrixCell->importBitBoard(a_cBoard);
+		a_pcGame->m_pcMatrixCell->setRule(a_cRule);
+		a_pcGame->m_bIsBoardDirty = false;
+		return a_pcGame;
+	}
+	catch(...)
+	{
+		lifegame_destroy(a_pcGame);
+		return 0;
+	}
+}
+
+int lifegame_save(lifegame_t* i_pcGame, const char* i_pPath)
+{
+	if( (0 == i_pcGame) || (0 == i_pPath) ) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		if(0 == lifegame_get_rows(i_pcGame)) return LIFEGAME_ERROR_MEMORY;
+		if(!PatternFile::save(i_pPath, i_pcGame->m_cBoard, i_pcGame->m_pcMatrixCell->getRule())) return LIFEGAME_ERROR_FILE;
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+void lifegame_destroy(lifegame_t* i_pcGame)
+{
+	if(0 == i_pcGame) return;
+
+	try
+	{
+		delete i_pcGame->m_pcMatrixCell;
+		delete i_pcGame;
+	}
+	catch(...)
+	{
+	}
+}
+
+int lifegame_set_rule(lifegame_t* i_pcGame, const char* i_pRule)
+{
+	if( (0 == i_pcGame) || (0 == i_pRule) ) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		LifeRule a_cRule;
+		if(!a_cRule.parse(i_pRule)) return LIFEGAME_ERROR_ARGUMENT;
+		i_pcGame->m_pcMatrixCell->setRule(a_cRule);
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+int lifegame_get_rule(const lifegame_t* i_pcGame, char* o_pBuffer, size_t i_lSize)
+{
+	if( (0 == i_pcGame) || (0 == o_pBuffer) ) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		std::string a_strRule = i_pcGame->m_pcMatrixCell->getRule().toString();
+		if(i_lSize <= a_strRule.size()) return LIFEGAME_ERROR_ARGUMENT;
+		memcpy(o_pBuffer, a_strRule.c_str(), a_strRule.size() + 1);
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+int lifegame_set_thread_num(lifegame_t* i_pcGame, int i_iThreadNum)
+{
+	if( (0 == i_pcGame) || (1 > i_iThreadNum) ) return LIFEGAME_ERROR_ARGUMENT;
+
+	i_pcGame->m_iThreadNum = i_iThreadNum;
+	return LIFEGAME_OK;
+}
+
+int lifegame_step(lifegame_t* i_pcGame, long i_lGenerationNum)
+{
+	if( (0 == i_pcGame) || (0 > i_lGenerationNum) ) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		double a_dStart = getSecond();
+		for(long a_lIndex=0; a_lIndex<i_lGenerationNum; a_lIndex++)
+		{
+			i_pcGame->m_bIsBoardDirty = true;
+			i_pcGame->m_pcMatrixCell->refreshCell();
+		}
+		i_pcGame->m_dStepSecond = getSecond() - a_dStart;
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+long lifegame_get_col_max(const lifegame_t* i_pcGame)
+{
+	try
+	{
+		return (0 == i_pcGame)? 0 : i_pcGame->m_pcMatrixCell->getColMax();
+	}
+	catch(...)
+	{
+		return 0;
+	}
+}
+
+long lifegame_get_row_max(const lifegame_t* i_pcGame)
+{
+	try
+	{
+		return (0 == i_pcGame)? 0 : i_pcGame->m_pcMatrixCell->getRowMax();
+	}
+	catch(...)
+	{
+		return 0;
+	}
+}
+
+long lifegame_get_word_num(const lifegame_t* i_pcGame)
+{
+	try
+	{
+		return (0 == i_pcGame)? 0 : (i_pcGame->m_pcMatrixCell->getColMax() + BitBoard::WORD_BIT - 1) / BitBoard::WORD_BIT;
+	}
+	catch(...)
+	{
+		return 0;
+	}
+}
+
+const uint64_t* lifegame_get_rows(lifegame_t* i_pcGame)
+{
+	if(0 == i_pcGame) return 0;
+
+	try
+	{
+		if(i_pcGame->m_bIsBoardDirty)
+		{
+			i_pcGame->m_pcMatrixCell->exportBitBoard(i_pcGame->m_cBoard, i_pcGame->m_iThreadNum);
+			i_pcGame->m_bIsBoardDirty = false;
+		}
+		return i_pcGame->m_cBoard.getRow(0);
+	}
+	catch(...)
+	{
+		return 0;
+	}
+}
+
+int lifegame_get_cell(lifegame_t* i_pcGame, long i_lCol, long i_lRow)
+{
+	if(0 == i_pcGame) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		MatrixCell* a_pcMatrixCell = i_pcGame->m_pcMatrixCell;
+		if( (0 > i_lCol) || (a_pcMatrixCell->getColMax() <= i_lCol) || (0 > i_lRow) || (a_pcMatrixCell->getRowMax() <= i_lRow) ) return LIFEGAME_ERROR_ARGUMENT;
+
+		return (CellAttribute::ALIVE == a_pcMatrixCell->getCellState(i_lCol, i_lRow))? 1 : 0;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+int lifegame_set_cell(lifegame_t* i_pcGame, long i_lCol, long i_lRow, int i_iAlive)
+{
+	if(0 == i_pcGame) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		MatrixCell* a_pcMatrixCell = i_pcGame->m_pcMatrixCell;
+		if( (0 > i_lCol) || (a_pcMatrixCell->getColMax() <= i_lCol) || (0 > i_lRow) || (a_pcMatrixCell->getRowMax() <= i_lRow) ) return LIFEGAME_ERROR_ARGUMENT;
+
+		a_pcMatrixCell->setCellState(i_lCol, i_lRow, (0 != i_iAlive)? CellAttribute::ALIVE : CellAttribute::DEAD);
+
+		// 書き出し済みの行は1ビットだけ直す.
+		if(!i_pcGame->m_bIsBoardDirty) i_pcGame->m_cBoard.setBit(i_lCol, i_lRow, 0 != i_iAlive);
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		i_pcGame->m_bIsBoardDirty = true;
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+int lifegame_set_region(lifegame_t* i_pcGame, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight,
+	const uint64_t* i_pWord, long i_lWordNum)
+{
+	if( (0 == i_pcGame) || (0 == i_pWord) ) return LIFEGAME_ERROR_ARGUMENT;
+	if( (0 > i_lCol) || (0 > i_lRow) || (0 >= i_lWidth) || (0 >= i_lHeight) ) return LIFEGAME_ERROR_ARGUMENT;
+	long a_lWordNum = (i_lWidth + BitBoard::WORD_BIT - 1) / BitBoard::WORD_BIT;
+	long a_lStride = (0 < i_lWordNum)? i_lWordNum : a_lWordNum;
+	if(a_lStride < a_lWordNum) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		// 呼び出し元の行を矩形の大きさのBitBoardへ写す.(横幅を超えるビットは落とす).
+		BitBoard a_cRegion(i_lWidth, i_lHeight);
+		BitBoard::WORD a_wLastMask = a_cRegion.getLastWordMask();
+		for(long a_lRow=0; a_lRow<i_lHeight; a_lRow++)
+		{
+			BitBoard::WORD* a_pRow = a_cRegion.getRow(a_lRow);
+			memcpy(a_pRow, i_pWord + a_lRow * a_lStride, a_lWordNum * sizeof(BitBoard::WORD));
+			a_pRow[a_lWordNum - 1] &= a_wLastMask;
+		}
+		i_pcGame->m_bIsBoardDirty = true;
+		i_pcGame->m_pcMatrixCell->pasteRegion(a_cRegion, i_lCol, i_lRow, BitBoard::PASTE_REPLACE);
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
+
+int lifegame_get_stats(const lifegame_t* i_pcGame, lifegame_stats_t* o_pstStats)
+{
+	if( (0 == i_pcGame) || (0 == o_pstStats) ) return LIFEGAME_ERROR_ARGUMENT;
+
+	try
+	{
+		const MatrixCell* a_pcMatrixCell = i_pcGame->m_pcMatrixCell;
+		MemoryUsage a_cUsage;
+		a_pcMatrixCell->getMemoryUsage(a_cUsage);
+		o_pstStats->m_lGeneration = a_pcMatrixCell->getGeneration();
+		o_pstStats->m_lPopulation = a_pcMatrixCell->getPopulation();
+		o_pstStats->m_lChangedNum = a_pcMatrixCell->getChangedNum();
+		o_pstStats->m_lMemoryByte = sizeof(lifegame_t) + a_cUsage.getTotal() + MemoryUsage::getHeapByte(i_pcGame->m_cBoard.getByteSize());
+		o_pstStats->m_dStepSecond = i_pcGame->m_dStepSecond;
+		return LIFEGAME_OK;
+	}
+	catch(...)
+	{
+		return LIFEGAME_ERROR_MEMORY;
+	}
+}
@@ -0,0 +1,208 @@
+/**
+ * @file    lifegame.h
+ * @brief   ライフゲームのエンジン(MatrixCell)をC言語から使うためのAPI.
+ * @note    端末(curses)に依存しない. liblifegame.a / liblifegame.so としてビルドする.(source/Makefile の make lib).
+ * @note    盤面は1つのハンドル(lifegame_t)で表す. 異なるハンドルは別々のスレッドから使えるが, 1つのハンドルを同時に使ってはいけない.
+ * @note    関数は例外を投げない.(メモリが足りない場合はLIFEGAME_ERROR_MEMORY, ポインタを返す関数はNULLを返す).
+ * @note    API(関数, 構造体, 盤面の並び)を変える場合はLIFEGAME_API_VERSIONを上げる.(追加だけなら上げない).
+ */
+#ifndef __LIFEGAME_API_H__
+#define __LIFEGAME_API_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define LIFEGAME_API __attribute__((visibility("default")))
+#else
+#define LIFEGAME_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   APIの版.
+ */
+#define LIFEGAME_API_VERSION 1
+
+/**
+ * @brief   戻り値.(0以上は成功).
+ */
+#define LIFEGAME_OK              0
+#define LIFEGAME_ERROR_ARGUMENT  (-1)   /* 引数が不正. */
+#define LIFEGAME_ERROR_MEMORY    (-2)   /* メモリが足りない. */
+#define LIFEGAME_ERROR_FILE      (-3)   /* ファイルを読み書きできない. */
+
+/**
+ * @brief   盤面の端の扱い.
+ */
+#define LIFEGAME_BOUNDARY_TORUS  0      /* 上下左右の端が反対側の端と繋がる. */
+#define LIFEGAME_BOUNDARY_DEAD   1      /* 盤面の外は常に"死". */
+
+/**
+ * @brief   盤面のハンドル.(中身は公開しない).
+ */
+typedef struct lifegame lifegame_t;
+
+/**
+ * @brief   統計.
+ */
+typedef struct lifegame_stats
+{
+	long m_lGeneration;         /* 世代数. */
+	long m_lPopulation;         /* 生きているセルの数. */
+	long m_lChangedNum;         /* 直前の世代で変化したセルの数. */
+	size_t m_lMemoryByte;       /* 盤面が使っているメモリの量.(バイト. mallocの管理領域を含む). */
+	double m_dStepSecond;       /* 直前のlifegame_step()の経過時間.(秒). */
+} lifegame_stats_t;
+
+/**
+ * @brief   APIの版を取得.
+ * @return  ライブラリをビルドした時のLIFEGAME_API_VERSION.(ヘッダと異なれば使わない).
+ */
+LIFEGAME_API int lifegame_get_version(void);
+
+/**
+ * @brief   全セル"死"の盤面を生成する.
+ * @param   long i_lColMax 横幅.
+ * @param   long i_lRowMax 縦幅.
+ * @param   int i_iBoundary 端の扱い.(LIFEGAME_BOUNDARY_*).
+ * @return  ハンドル.(失敗は NULL).
+ * @note    規則は B3/S23.
+ */
+LIFEGAME_API lifegame_t* lifegame_create(long i_lColMax, long i_lRowMax, int i_iBoundary);
+
+/**
+ * @brief   パターンファイル(RLE / プレーンテキスト)を読み込んで盤面を生成する.
+ * @param   const char* i_pPath パターンファイル.
+ * @param   long i_lColMax 横幅.(0以下はパターンの横幅).
+ * @param   long i_lRowMax 縦幅.(0以下はパターンの縦幅).
+ * @param   int i_iBoundary 端の扱い.(LIFEGAME_BOUNDARY_*).
+ * @return  ハンドル.(失敗は NULL).
+ * @note    パターンは盤面の中央に置く. 規則はファイルに書かれていればそれに従う.
+ */
+LIFEGAME_API lifegame_t* lifegame_load(const char* i_pPath, long i_lColMax, long i_lRowMax, int i_iBoundary);
+
+/**
+ * @brief   盤面をRLE形式で保存する.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   const char* i_pPath 保存先.
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_*.
+ */
+LIFEGAME_API int lifegame_save(lifegame_t* i_pcGame, const char* i_pPath);
+
+/**
+ * @brief   盤面を破棄する.
+ * @param   lifegame_t* i_pcGame ハンドル.(NULLは何もしない).
+ * @return  なし.
+ */
+LIFEGAME_API void lifegame_destroy(lifegame_t* i_pcGame);
+
+/**
+ * @brief   規則を設定する.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   const char* i_pRule 規則.("B3/S23" または "23/3").
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.
+ */
+LIFEGAME_API int lifegame_set_rule(lifegame_t* i_pcGame, const char* i_pRule);
+
+/**
+ * @brief   規則を取得する.
+ * @param   const lifegame_t* i_pcGame ハンドル.
+ * @param   char* o_pBuffer 書き込み先.("B3/S23" の形式. 終端文字を含めて最大20バイト).
+ * @param   size_t i_lSize 書き込み先の大きさ.
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.(大きさが足りない場合も).
+ */
+LIFEGAME_API int lifegame_get_rule(const lifegame_t* i_pcGame, char* o_pBuffer, size_t i_lSize);
+
+/**
+ * @brief   盤面と書き出しに使うスレッド数を設定する.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   int i_iThreadNum スレッド数.(1以上. 既定は1).
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT.
+ */
+LIFEGAME_API int lifegame_set_thread_num(lifegame_t* i_pcGame, int i_iThreadNum);
+
+/**
+ * @brief   世代を進める.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   long i_lGenerationNum 進める世代数.(0以上).
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.
+ */
+LIFEGAME_API int lifegame_step(lifegame_t* i_pcGame, long i_lGenerationNum);
+
+/**
+ * @brief   横幅を取得.
+ */
+LIFEGAME_API long lifegame_get_col_max(const lifegame_t* i_pcGame);
+
+/**
+ * @brief   縦幅を取得.
+ */
+LIFEGAME_API long lifegame_get_row_max(const lifegame_t* i_pcGame);
+
+/**
+ * @brief   1行の語数を取得.((横幅 + 63) / 64).
+ */
+LIFEGAME_API long lifegame_get_word_num(const lifegame_t* i_pcGame);
+
+/**
+ * @brief   全セルの状態を詰めた行の並びを取得する.(写さずに参照する).
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @return  先頭の語.(失敗は NULL).
+ * @note    行 r の先頭は 戻り値 + r * lifegame_get_word_num(). 列 c は (c / 64)番目の語の (c % 64)ビット目(下位から)で, 1が"生".
+ *          横幅を超える余りのビットは0.
+ * @note    盤面を変える関数(lifegame_step(), lifegame_set_*())を呼ぶか, 破棄するまで有効.
+ *          盤面が変わった後の最初の呼び出しだけ, エンジンから詰め直す.(以降は同じ領域を返す).
+ */
+LIFEGAME_API const uint64_t* lifegame_get_rows(lifegame_t* i_pcGame);
+
+/**
+ * @brief   セルの状態を取得.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   long i_lCol 横座標.
+ * @param   long i_lRow 縦座標.
+ * @return  1:生 0:死 / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.
+ */
+LIFEGAME_API int lifegame_get_cell(lifegame_t* i_pcGame, long i_lCol, long i_lRow);
+
+/**
+ * @brief   セルの状態を設定.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   long i_lCol 横座標.
+ * @param   long i_lRow 縦座標.
+ * @param   int i_iAlive 0以外:生 0:死.
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.
+ */
+LIFEGAME_API int lifegame_set_cell(lifegame_t* i_pcGame, long i_lCol, long i_lRow, int i_iAlive);
+
+/**
+ * @brief   矩形内のセルを詰めた行で置き換える.
+ * @param   lifegame_t* i_pcGame ハンドル.
+ * @param   long i_lCol 横位置(左端).
+ * @param   long i_lRow 縦位置(上端).
+ * @param   long i_lWidth 横幅.
+ * @param   long i_lHeight 縦幅.
+ * @param   const uint64_t* i_pWord 矩形内のセルの状態.(並びはlifegame_get_rows()と同じ. 横幅を超えるビットは見ない).
+ * @param   long i_lWordNum i_pWordの1行の語数.(0以下は (i_lWidth + 63) / 64).
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.
+ * @note    盤面からはみ出す部分は捨てる.
+ */
+LIFEGAME_API int lifegame_set_region(lifegame_t* i_pcGame, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight,
+	const uint64_t* i_pWord, long i_lWordNum);
+
+/**
+ * @brief   統計を取得.
+ * @param   const lifegame_t* i_pcGame ハンドル.
+ * @param   lifegame_stats_t* o_pstStats 書き込み先.
+ * @return  LIFEGAME_OK / LIFEGAME_ERROR_ARGUMENT / LIFEGAME_ERROR_MEMORY.
+ */
+LIFEGAME_API int lifegame_get_stats(const lifegame_t* i_pcGame, lifegame_stats_t* o_pstStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __LIFEGAME_API_H__ */
@@ -0,0 +1,255 @@
+/*********************************************************
+ * C APIのユニットテスト
+ * ・Cのプログラムからライブラリ(liblifegame.a / liblifegame.so)だけで使えることを確かめる.
+ *********************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../lifegame.h"
+
+static const char* PATTERN_PATH = "test_lifegame.rle";
+static const char* SAVE_PATH = "test_lifegame_save.rle";
+
+void print_test_result(const char* i_pMessage, int i_bIsSuccess)
+{
+	printf("%s: %s\n", i_pMessage, i_bIsSuccess? "OK" : "NG");
+}
+
+/* 詰めた行からセルの状態を取得. */
+int get_bit(const uint64_t* i_pRows, long i_lWordNum, long i_lCol, long i_lRow)
+{
+	return (int)((i_pRows[i_lRow * i_lWordNum + i_lCol / 64] >> (i_lCol % 64)) & 1);
+}
+
+/* 詰めた行の生きているセルの数. */
+long count_rows(const uint64_t* i_pRows, long i_lWordNum, long i_lRowMax)
+{
+	long a_lNum = 0;
+	long a_lIndex;
+	for(a_lIndex=0; a_lIndex<i_lWordNum * i_lRowMax; a_lIndex++) a_lNum += __builtin_popcountll(i_pRows[a_lIndex]);
+	return a_lNum;
+}
+
+/* 生成と破棄をテスト. */
+int test_create(void)
+{
+	int a_bIsSuccess = (LIFEGAME_API_VERSION == lifegame_get_version());
+
+	lifegame_t* a_pcGame = lifegame_create(100, 30, LIFEGAME_BOUNDARY_TORUS);
+	if(NULL == a_pcGame) return 0;
+	a_bIsSuccess = a_bIsSuccess && (100 == lifegame_get_col_max(a_pcGame)) && (30 == lifegame_get_row_max(a_pcGame));
+	a_bIsSuccess = a_bIsSuccess && (2 == lifegame_get_word_num(a_pcGame));
+
+	const uint64_t* a_pRows = lifegame_get_rows(a_pcGame);
+	a_bIsSuccess = a_bIsSuccess && (NULL != a_pRows) && (0 == count_rows(a_pRows, 2, 30));
+
+	lifegame_stats_t a_stStats;
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_get_stats(a_pcGame, &a_stStats));
+	a_bIsSuccess = a_bIsSuccess && (0 == a_stStats.m_lGeneration) && (0 == a_stStats.m_lPopulation);
+	a_bIsSuccess = a_bIsSuccess && (100 * 30 * 64 < a_stStats.m_lMemoryByte);
+	lifegame_destroy(a_pcGame);
+
+	/* 不正な引数. */
+	a_bIsSuccess = a_bIsSuccess && (NULL == lifegame_create(0, 10, LIFEGAME_BOUNDARY_TORUS));
+	a_bIsSuccess = a_bIsSuccess && (NULL == lifegame_create(10, 10, 5));
+	a_bIsSuccess = a_bIsSuccess && (NULL == lifegame_load("not_exist.rle", 0, 0, LIFEGAME_BOUNDARY_TORUS));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_step(NULL, 1));
+	a_bIsSuccess = a_bIsSuccess && (NULL == lifegame_get_rows(NULL));
+	lifegame_destroy(NULL);
+	return a_bIsSuccess;
+}
+
+/* 世代を進めて詰めた行を読むテスト.(ブリンカー). */
+int test_step(void)
+{
+	lifegame_t* a_pcGame = lifegame_create(70, 10, LIFEGAME_BOUNDARY_TORUS);
+	if(NULL == a_pcGame) return 0;
+
+	/* 語の境目(63, 64, 65列)に横向きのブリンカー. */
+	int a_bIsSuccess = (LIFEGAME_OK == lifegame_set_cell(a_pcGame, 63, 5, 1));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_cell(a_pcGame, 64, 5, 1));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_cell(a_pcGame, 65, 5, 1));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_set_cell(a_pcGame, 70, 5, 1));
+	a_bIsSuccess = a_bIsSuccess && (1 == lifegame_get_cell(a_pcGame, 64, 5)) && (0 == lifegame_get_cell(a_pcGame, 64, 4));
+
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_step(a_pcGame, 1));
+	const uint64_t* a_pRows = lifegame_get_rows(a_pcGame);
+	a_bIsSuccess = a_bIsSuccess && (3 == count_rows(a_pRows, 2, 10));
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 2, 64, 4) && get_bit(a_pRows, 2, 64, 5) && get_bit(a_pRows, 2, 64, 6);
+
+	/* 盤面が変わらなければ同じ領域を返す. 余りのビットは0. */
+	a_bIsSuccess = a_bIsSuccess && (a_pRows == lifegame_get_rows(a_pcGame));
+	long a_lRow;
+	for(a_lRow=0; a_lRow<10; a_lRow++) a_bIsSuccess = a_bIsSuccess && (0 == (a_pRows[a_lRow * 2 + 1] >> 6));
+
+	/* 書き出し後のセルの変更も行に反映される. */
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_cell(a_pcGame, 0, 0, 1));
+	a_pRows = lifegame_get_rows(a_pcGame);
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 2, 0, 0) && (4 == count_rows(a_pRows, 2, 10));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_cell(a_pcGame, 0, 0, 0));
+
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_step(a_pcGame, 3));
+	a_pRows = lifegame_get_rows(a_pcGame);
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 2, 63, 5) && get_bit(a_pRows, 2, 64, 5) && get_bit(a_pRows, 2, 65, 5);
+
+	lifegame_stats_t a_stStats;
+	lifegame_get_stats(a_pcGame, &a_stStats);
+	a_bIsSuccess = a_bIsSuccess && (4 == a_stStats.m_lGeneration) && (3 == a_stStats.m_lPopulation) && (4 == a_stStats.m_lChangedNum);
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_step(a_pcGame, -1));
+	lifegame_destroy(a_pcGame);
+	return a_bIsSuccess;
+}
+
+/* 矩形を詰めた行で置き換えるテスト.(グライダー). */
+int test_set_region(void)
+{
+	lifegame_t* a_pcGame = lifegame_create(20, 20, LIFEGAME_BOUNDARY_DEAD);
+	if(NULL == a_pcGame) return 0;
+
+	/* .O. / ..O / OOO を1行2語の並びで渡す.(2語目と横幅を超えるビットは見ない). */
+	uint64_t a_rgwGlider[] = { 0x2 | 0x8, ~(uint64_t)0, 0x4 | 0xF0, ~(uint64_t)0, 0x7, ~(uint64_t)0 };
+	int a_bIsSuccess = (LIFEGAME_OK == lifegame_set_region(a_pcGame, 2, 3, 3, 3, a_rgwGlider, 2));
+	const uint64_t* a_pRows = lifegame_get_rows(a_pcGame);
+	a_bIsSuccess = a_bIsSuccess && (5 == count_rows(a_pRows, 1, 20));
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 1, 3, 3) && get_bit(a_pRows, 1, 4, 4);
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 1, 2, 5) && get_bit(a_pRows, 1, 3, 5) && get_bit(a_pRows, 1, 4, 5);
+
+	/* 4世代で右下へ1つずれる. */
+	lifegame_step(a_pcGame, 4);
+	a_pRows = lifegame_get_rows(a_pcGame);
+	a_bIsSuccess = a_bIsSuccess && (5 == count_rows(a_pRows, 1, 20));
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 1, 4, 4) && get_bit(a_pRows, 1, 5, 5);
+	a_bIsSuccess = a_bIsSuccess && get_bit(a_pRows, 1, 3, 6) && get_bit(a_pRows, 1, 4, 6) && get_bit(a_pRows, 1, 5, 6);
+
+	/* 置き換えなので, 0の矩形で消える. はみ出す部分は捨てる. */
+	uint64_t a_rgwZero[10] = { 0 };
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_region(a_pcGame, 0, 0, 10, 10, a_rgwZero, 0));
+	a_bIsSuccess = a_bIsSuccess && (0 == count_rows(lifegame_get_rows(a_pcGame), 1, 20));
+	uint64_t a_rgwFull[4] = { ~(uint64_t)0, ~(uint64_t)0, ~(uint64_t)0, ~(uint64_t)0 };
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_region(a_pcGame, 18, 18, 4, 4, a_rgwFull, 1));
+	a_bIsSuccess = a_bIsSuccess && (4 == count_rows(lifegame_get_rows(a_pcGame), 1, 20));
+
+	/* 不正な引数. */
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_set_region(a_pcGame, -1, 0, 3, 3, a_rgwGlider, 2));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_set_region(a_pcGame, 0, 0, 100, 1, a_rgwGlider, 1));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_set_region(a_pcGame, 0, 0, 3, 3, NULL, 1));
+	lifegame_destroy(a_pcGame);
+	return a_bIsSuccess;
+}
+
+/* 規則の設定と取得をテスト. */
+int test_rule(void)
+{
+	lifegame_t* a_pcGame = lifegame_create(10, 10, LIFEGAME_BOUNDARY_TORUS);
+	if(NULL == a_pcGame) return 0;
+
+	char a_szRule[20];
+	int a_bIsSuccess = (LIFEGAME_OK == lifegame_get_rule(a_pcGame, a_szRule, sizeof(a_szRule))) && (0 == strcmp("B3/S23", a_szRule));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_rule(a_pcGame, "23/36"));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_get_rule(a_pcGame, a_szRule, sizeof(a_szRule))) && (0 == strcmp("B36/S23", a_szRule));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_set_rule(a_pcGame, "B9/S23"));
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_get_rule(a_pcGame, a_szRule, 7));
+	lifegame_destroy(a_pcGame);
+	return a_bIsSuccess;
+}
+
+/* パターンファイルの読み込みと保存をテスト. */
+int test_load_save(void)
+{
+	FILE* a_pFile = fopen(PATTERN_PATH, "w");
+	if(NULL == a_pFile) return 0;
+	fprintf(a_pFile, "#N glider\nx = 3, y = 3, rule = B36/S23\nbo$2bo$3o!\n");
+	fclose(a_pFile);
+
+	/* 大きさを指定しなければパターンの大きさ. */
+	lifegame_t* a_pcGame = lifegame_load(PATTERN_PATH, 0, 0, LIFEGAME_BOUNDARY_DEAD);
+	if(NULL == a_pcGame) return 0;
+	char a_szRule[20];
+	lifegame_get_rule(a_pcGame, a_szRule, sizeof(a_szRule));
+	int a_bIsSuccess = (3 == lifegame_get_col_max(a_pcGame)) && (3 == lifegame_get_row_max(a_pcGame)) && (0 == strcmp("B36/S23", a_szRule));
+	a_bIsSuccess = a_bIsSuccess && (5 == count_rows(lifegame_get_rows(a_pcGame), 1, 3));
+	lifegame_destroy(a_pcGame);
+
+	/* 大きさを指定すれば中央に置く. */
+	a_pcGame = lifegame_load(PATTERN_PATH, 11, 9, LIFEGAME_BOUNDARY_TORUS);
+	if(NULL == a_pcGame) return 0;
+	a_bIsSuccess = a_bIsSuccess && (1 == lifegame_get_cell(a_pcGame, 5, 3)) && (1 == lifegame_get_cell(a_pcGame, 6, 4));
+	a_bIsSuccess = a_bIsSuccess && (1 == lifegame_get_cell(a_pcGame, 4, 5)) && (1 == lifegame_get_cell(a_pcGame, 6, 5));
+
+	/* 保存して読み直すと同じ盤面. */
+	lifegame_step(a_pcGame, 7);
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_save(a_pcGame, SAVE_PATH));
+	lifegame_t* a_pcLoaded = lifegame_load(SAVE_PATH, 11, 9, LIFEGAME_BOUNDARY_TORUS);
+	if(NULL == a_pcLoaded) return 0;
+	const uint64_t* a_pRows = lifegame_get_rows(a_pcGame);
+	const uint64_t* a_pLoaded = lifegame_get_rows(a_pcLoaded);
+	long a_lPopulation = count_rows(a_pRows, 1, 9);
+	a_bIsSuccess = a_bIsSuccess && (0 < a_lPopulation) && (a_lPopulation == count_rows(a_pLoaded, 1, 9));
+
+	/* 保存するRLEは生きているセルを囲む矩形なので, 位置は比べずに形と数を比べる. */
+	lifegame_get_rule(a_pcLoaded, a_szRule, sizeof(a_szRule));
+	a_bIsSuccess = a_bIsSuccess && (0 == strcmp("B36/S23", a_szRule));
+	lifegame_destroy(a_pcLoaded);
+	lifegame_destroy(a_pcGame);
+	remove(PATTERN_PATH);
+	remove(SAVE_PATH);
+	return a_bIsSuccess;
+}
+
+/* 複数スレッドでの書き出しと, 生成と破棄の繰り返しをテスト. */
+int test_thread_and_repeat(void)
+{
+	int a_bIsSuccess = 1;
+	int a_iIndex;
+	for(a_iIndex=0; a_iIndex<20; a_iIndex++)
+	{
+		lifegame_t* a_pcGame = lifegame_create(300, 200, LIFEGAME_BOUNDARY_TORUS);
+		if(NULL == a_pcGame) return 0;
+		a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_thread_num(a_pcGame, 4));
+		a_bIsSuccess = a_bIsSuccess && (LIFEGAME_ERROR_ARGUMENT == lifegame_set_thread_num(a_pcGame, 0));
+
+		/* R-ペントミノ. */
+		uint64_t a_rgwPentomino[] = { 0x6, 0x3, 0x2 };
+		lifegame_set_region(a_pcGame, 150, 100, 3, 3, a_rgwPentomino, 1);
+		lifegame_step(a_pcGame, 50);
+
+		lifegame_stats_t a_stStats;
+		lifegame_get_stats(a_pcGame, &a_stStats);
+		long a_lPopulation = count_rows(lifegame_get_rows(a_pcGame), lifegame_get_word_num(a_pcGame), 200);
+		a_bIsSuccess = a_bIsSuccess && (50 == a_stStats.m_lGeneration) && (a_stStats.m_lPopulation == a_lPopulation) && (5 < a_lPopulation);
+		lifegame_destroy(a_pcGame);
+	}
+	return a_bIsSuccess;
+}
+
+/* 確保できない大きさでも例外で落ちずにエラーを返すことをテスト. */
+int test_out_of_memory(void)
+{
+	lifegame_t* a_pcGame = lifegame_create(100, 30, LIFEGAME_BOUNDARY_TORUS);
+	if(NULL == a_pcGame) return 0;
+
+	/* 矩形を写すBitBoardが確保できない. */
+	uint64_t a_wWord = 1;
+	int a_bIsSuccess = (LIFEGAME_ERROR_MEMORY == lifegame_set_region(a_pcGame, 0, 0, 1L << 40, 1L << 20, &a_wWord, 0));
+	a_bIsSuccess = a_bIsSuccess && (0 == lifegame_get_cell(a_pcGame, 0, 0));
+
+	/* 失敗した後も使える. */
+	a_bIsSuccess = a_bIsSuccess && (LIFEGAME_OK == lifegame_set_region(a_pcGame, 0, 0, 1, 1, &a_wWord, 1));
+	a_bIsSuccess = a_bIsSuccess && (1 == lifegame_get_cell(a_pcGame, 0, 0));
+	lifegame_destroy(a_pcGame);
+	return a_bIsSuccess;
+}
+
+int main(void)
+{
+	print_test_result("test_create", test_create());
+	print_test_result("test_step", test_step());
+	print_test_result("test_set_region", test_set_region());
+	print_test_result("test_rule", test_rule());
+	print_test_result("test_load_save", test_load_save());
+	print_test_result("test_thread_and_repeat", test_thread_and_repeat());
+	print_test_result("test_out_of_memory", test_out_of_memory());
+	return 0;
+}
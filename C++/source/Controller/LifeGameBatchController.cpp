@@ -0,0 +1,198 @@
+/**
+ * @file    LifeGameBatchController.cpp
+ * @brief   ライフゲームを端末なしで実行するクラスの実装.
+ */
+
+#include "LifeGameBatchController.h"
+#include "../Model/PatternFile.h"
+#include "../Model/SoupGenerator.h"
+#include "../Model/GenerationHistory.h"
+#include "../Lib/Clock.h"
+
+#include <cstdio>
+
+/*******************
+ * コンストラクタ.
+ *******************/
+LifeGameBatchController::LifeGameBatchController(const LifeGameOption& i_cOption)
+	: m_cOption(i_cOption)
+{
+	long a_lCol = (0 < i_cOption.getColMax())? i_cOption.getColMax() : DEFAULT_COL_MAX;
+	long a_lRow = (0 < i_cOption.getRowMax())? i_cOption.getRowMax() : DEFAULT_ROW_MAX;
+
+	// Modelを生成.
+	m_pcLifeGameModel = new MatrixCell(a_lCol, a_lRow);
+	m_pcLifeGameModel->setRule(i_cOption.getRule());
+
+	// 処理段階毎の時間と件数を定期的に出力する.(--profile N).
+	m_pcLifeGameModel->getProfiler().setDump(stderr, i_cOption.getProfileEvery());
+}
+
+/*****************
+ * デストラクタ.
+ *****************/
+LifeGameBatchController::~LifeGameBatchController()
+{
+	m_cRecorder.stop();
+	m_cGifExporter.close();
+	m_cImageExporter.close();
+	if(m_pcLifeGameModel!= 0) delete m_pcLifeGameModel;
+}
+
+/***************************************
+ * 指定された初期配置をModelへ設定する.
+ ***************************************/
+void LifeGameBatchController::placeInitialCells(MatrixCell* i_pcModel, const LifeGameOption& i_cOption)
+{
+	long a_lColMax = i_pcModel->getColMax();
+	long a_lRowMax = i_pcModel->getRowMax();
+	const BitBoard& a_cPattern = i_cOption.getPattern();
+
+	BitBoard a_cBoard(a_lColMax, a_lRowMax);
+	if(i_cOption.isSoup())
+	{
+		SoupGenerator a_cSoup(i_cOption.getSeed(), i_cOption.getSoupDensity());
+		a_cSoup.generate(a_cBoard, i_cOption.getThreadNum());
+	}
+	a_cBoard.paste(a_cPattern, (a_lColMax - a_cPattern.getColMax()) / 2, (a_lRowMax - a_cPattern.getRowMax()) / 2);
+	i_pcModel->importBitBoard(a_cBoard, i_cOption.getThreadNum());
+}
+
+/***************************************
+ * 実行した場合のメモリの量を見積もる.
+ ***************************************/
+void LifeGameBatchController::estimateMemoryUsage(const LifeGameOption& i_cOption, MemoryUsage& io_cUsage)
+{
+	long a_lCol = (0 < i_cOption.getColMax())? i_cOption.getColMax() : DEFAULT_COL_MAX;
+	long a_lRow = (0 < i_cOption.getRowMax())? i_cOption.getRowMax() : DEFAULT_ROW_MAX;
+	MatrixCell::estimateMemoryUsage(a_lCol, a_lRow, io_cUsage);
+
+	if( !i_cOption.isBatch() && i_cOption.getServePath().empty() )
+	{
+		GenerationHistory::estimateMemoryUsage(a_lCol, a_lRow, static_cast<size_t>(i_cOption.getHistoryMegaByte()) * 1024 * 1024, io_cUsage);
+	}
+}
+
+/***************************************
+ * 指定された世代数だけ実行する.
+ ***************************************/
+bool LifeGameBatchController::run()
+{
+	long a_lCol = m_pcLifeGameModel->getColMax();
+	long a_lRow = m_pcLifeGameModel->getRowMax();
+
+	// セルの初期配置.
+	double a_dSeedStart = getSecond();
+	placeInitialCells(m_pcLifeGameModel, m_cOption);
+	double a_dSeedElapsed = getSecond() - a_dSeedStart;
+
+	// 記録/GIF/画像は通知を受け取る場合のみ登録する.(登録しなければ通知の負荷はない).
+	if(!m_cOption.getRecordPath().empty())
+	{
+		m_cRecorder.start(m_pcLifeGameModel);
+	}
+	if(!m_cOption.getGifPath().empty())
+	{
+		if(!m_cGifExporter.open(m_cOption.getGifPath(), a_lCol, a_lRow, m_cOption.getGifScale()))
+		{
+			fprintf(stderr, "cannot open: %s\n", m_cOption.getGifPath().c_str());
+			return false;
+		}
+		BitBoard a_cBoard;
+		m_pcLifeGameModel->exportBitBoard(a_cBoard);
+		m_cGifExporter.drawBoard(a_cBoard);
+		m_cGifExporter.writeFrame();
+		m_pcLifeGameModel->attach(&m_cGifExporter);
+	}
+	if(!m_cOption.getImagePath().empty())
+	{
+		if(!m_cImageExporter.open(m_cOption.getImagePath(), a_lCol, a_lRow, m_cOption.getImageScale(),
+			static_cast<LifeGameImageExporter::COLOR_MODE>(m_cOption.getImageColor()), m_cOption.getThreadNum()))
+		{
+			fprintf(stderr, "invalid image path: %s\n", m_cOption.getImagePath().c_str());
+			return false;
+		}
+		BitBoard a_cBoard;
+		m_pcLifeGameModel->exportBitBoard(a_cBoard);
+		m_cImageExporter.drawBoard(a_cBoard);
+		m_cImageExporter.writeFrame();
+		m_pcLifeGameModel->attach(&m_cImageExporter);
+	}
+	long a_lImageEvery = m_cOption.getImageEvery();
+
+	long a_lGenerationNum = m_cOption.getGenerationNum();
+	double a_dStart = getSecond();
+	for(long a_lIndex=0; a_lIndex<a_lGenerationNum; a_lIndex++)
+	{
+		m_cImageExporter.nextGeneration();
+		m_pcLifeGameModel->refreshCell();
+		m_cRecorder.commit();
+		if(m_cGifExporter.isOpen()) m_cGifExporter.writeFrame();
+		if(m_cImageExporter.isOpen() && 0 == (a_lIndex + 1) % a_lImageEvery) m_cImageExporter.writeFrame();
+	}
+	double a_dElapsed = getSecond() - a_dStart;
+
+	// 書き出し.
+	bool a_bRet = true;
+	if(m_cGifExporter.isOpen())
+	{
+		m_pcLifeGameModel->detach(&m_cGifExporter);
+		m_cGifExporter.close();
+	}
+	long a_lImageNum = m_cImageExporter.getFrameNum();
+	if(m_cImageExporter.isOpen())
+	{
+		m_pcLifeGameModel->detach(&m_cImageExporter);
+		if(!m_cImageExporter.close())
+		{
+			fprintf(stderr, "cannot save: %s\n", m_cOption.getImagePath().c_str());
+			a_bRet = false;
+		}
+	}
+	if(m_cRecorder.isRecording())
+	{
+		m_cRecorder.stop();
+		if(!m_cRecorder.getRecord().save(m_cOption.getRecordPath()))
+		{
+			fprintf(stderr, "cannot save: %s\n", m_cOption.getRecordPath().c_str());
+			a_bRet = false;
+		}
+	}
+
+	BitBoard a_cBoard;
+	m_pcLifeGameModel->exportBitBoard(a_cBoard);
+	if(!m_cOption.getOutputPath().empty())
+	{
+		if(!PatternFile::save(m_cOption.getOutputPath(), a_cBoard, m_pcLifeGameModel->getRule()))
+		{
+			fprintf(stderr, "cannot save: %s\n", m_cOption.getOutputPath().c_str());
+			a_bRet = false;
+		}
+	}
+
+	// 結果.
+	double a_dRate = (0.0 < a_dElapsed)? a_lGenerationNum / a_dElapsed : 0.0;
+	printf("size        : %ldx%ld\n", a_lCol, a_lRow);
+	printf("rule        : %s\n", m_pcLifeGameModel->getRule().toString().c_str());
+	if(m_cOption.isSoup())
+	{
+		printf("soup        : density %.4f, seed %llu (%.3f sec)\n",
+			SoupGenerator(m_cOption.getSeed(), m_cOption.getSoupDensity()).getDensity(),
+			static_cast<unsigned long long>(m_cOption.getSeed()), a_dSeedElapsed);
+	}
+	printf("generations : %ld\n", a_lGenerationNum);
+	printf("population  : %ld\n", a_cBoard.count());
+	printf("elapsed     : %.3f sec\n", a_dElapsed);
+	printf("rate        : %.1f gen/sec (%.3g cell/sec)\n", a_dRate, a_dRate * a_lCol * a_lRow);
+	if(0 < a_lImageNum)
+	{
+		printf("images      : %ld\n", a_lImageNum);
+	}
+	MemoryUsage a_cUsage;
+	m_pcLifeGameModel->getMemoryUsage(a_cUsage);
+	m_cRecorder.getMemoryUsage(a_cUsage);
+	printf("memory      : ");
+	a_cUsage.dump(stdout);
+
+	return a_bRet;
+}
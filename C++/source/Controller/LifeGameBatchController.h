@@ -0,0 +1,93 @@
+/**
+ * @file    LifeGameBatchController.h
+ * @brief	ライフゲームを端末なしで実行するコントローラー クラス宣言.
+ */
+#ifndef __LIFEGAME_BATCH_CONTROLLER_H__
+#define __LIFEGAME_BATCH_CONTROLLER_H__
+
+#include "../Model/MatrixCell.h"
+#include "../Model/GenerationRecorder.h"
+#include "../View/LifeGameGifExporter.h"
+#include "../View/LifeGameImageExporter.h"
+#include "LifeGameOption.h"
+
+/**
+ * @brief   ライフゲームを端末なしで実行するコントローラー クラス.
+ * @note	cursesを初期化せず, 描画もスリープもせずに指定された世代数だけ進める.
+ * @note	ベンチマークやCIでの確認, 記録/GIF/画像の作成に使う.
+ */
+class LifeGameBatchController
+{
+public:
+	/**
+	 * @brief	端末を使わない場合の既定の大きさ.
+	 */
+	enum { DEFAULT_COL_MAX = 256, DEFAULT_ROW_MAX = 256 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   const LifeGameOption& i_cOption コマンドライン引数.(loadPattern()済みであること).
+     */
+    LifeGameBatchController(const LifeGameOption& i_cOption);
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~LifeGameBatchController();
+
+	/**
+	 * @brief	指定された世代数だけ実行する.
+	 * @param	なし.
+	 * @return	成功/失敗.(失敗した場合は標準エラー出力に理由を出力する).
+	 * @note	終了後, 世代数と経過時間, 1秒あたりの世代数を標準出力へ出力する.
+	 */
+	bool run();
+
+	/**
+	 * @brief	コマンドライン引数で指定された初期配置をModelへ設定する.
+	 * @param	MatrixCell* i_pcModel 配置先.
+	 * @param	const LifeGameOption& i_cOption コマンドライン引数.
+	 * @return	なし.
+	 * @note	スープ(--soup)を敷き詰めた上に, パターン(--pattern)を中央へ配置する.
+	 * @note	Observerへの通知は行わない.
+	 */
+	static void placeInitialCells(MatrixCell* i_pcModel, const LifeGameOption& i_cOption);
+
+	/**
+	 * @brief	コマンドライン引数の大きさとモードで実行した場合のメモリの量を, 確保せずに見積もる.
+	 * @param	const LifeGameOption& i_cOption コマンドライン引数.
+	 * @param	MemoryUsage& io_cUsage 加算先.
+	 * @return	なし.
+	 * @note	大きさの指定が無ければ端末を使わない場合の既定の大きさとする.
+	 *          巻き戻しの履歴(--history-mb)は端末で実行する場合だけ加える.(記録(--record)は世代数とパターンで決まるので含まない).
+	 */
+	static void estimateMemoryUsage(const LifeGameOption& i_cOption, MemoryUsage& io_cUsage);
+
+private:
+	/**
+	 * @brief	コマンドライン引数.
+	 */
+	const LifeGameOption&	m_cOption;
+
+	/**
+	 * @brief	LifeGame Model
+	 */
+	MatrixCell*				m_pcLifeGameModel;
+
+	/**
+	 * @brief	世代の記録.(--record).
+	 */
+	GenerationRecorder		m_cRecorder;
+
+	/**
+	 * @brief	アニメーションGIFの書き出し.(--gif).
+	 */
+	LifeGameGifExporter		m_cGifExporter;
+
+	/**
+	 * @brief	世代の画像の書き出し.(--image).
+	 */
+	LifeGameImageExporter	m_cImageExporter;
+};
+
+#endif	// __LIFEGAME_BATCH_CONTROLLER_H__
@@ -4,29 +4,93 @@
  */
 
 #include "LifeGameController.h"
+#include "LifeGameBatchController.h"
+#include "../View/LifeGameViewOnCurses.h"
+#include "../View/LifeGameViewOnAnsi.h"
+#include "../Lib/Clock.h"
+#include "../Lib/Tracer.h"
+
+#include <cstdio>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+
+// 世代の記録を保存するファイル.
+#define RECORD_FILE	"LifeGame.rec"
+
+// 性能表示(HUD)を更新する間隔.(秒).
+#define HUD_INTERVAL	(0.5)
+
+// 速度の変更で指定できる範囲.(世代/秒).(GPS_MAXを超えたら無制限).
+#define GPS_MIN			(0.25)
+#define GPS_MAX			(10000.0)
+
+// 入力できる回数の上限.
+#define COUNT_MAX		(1000000000000L)
 
 /*******************
  * コンストラクタ.
  *******************/
-LifeGameController::LifeGameController()
+LifeGameController::LifeGameController(const LifeGameOption& i_cOption)
 {
 	m_ePrevEvent = EV_NONE;
+	m_lAnchorCol = -1;
+	m_lAnchorRow = -1;
+	m_lInterestCol = 0;
+	m_lInterestRow = 0;
+	m_lInterestWidth = 0;
+	m_lInterestHeight = 0;
+	m_dGenerationInterval = (0.0 < i_cOption.getGenerationRate())? 1.0 / i_cOption.getGenerationRate() : 0.0;
+	m_dFrameInterval = 1.0 / i_cOption.getFrameRate();
+	m_lCountPrefix = 0;
+	m_lCount = 0;
+	m_dNextFrame = 0.0;
+	m_lFrameNum = 0;
+	m_dFrameTime = 0.0;
+	m_dRunStart = 0.0;
+	m_dRunTime = 0.0;
+	m_bIsRecording = false;
+	m_stHudSample = HUD_SAMPLE();
+	m_dNextHud = 0.0;
+	m_strHudMeasure = "- gen/s | model - ms | render - ms | - changed/gen";
+	m_bIsInputRead = false;
+
+	// getSecond()と同じ時計で, フレームの時刻を絶対時刻で設定する.
+	m_iTimer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
 
 	// Viewを生成.
-	m_pcLifeGameView = new LifeGameViewOnCurses();
-	long a_lRow = m_pcLifeGameView->getRowMax();
-	long a_lCol = m_pcLifeGameView->getColMax();
+	// 盤面の大きさは指定が無ければ端末の大きさとする.(大きい盤面はビューポートで表示する).
+	if(i_cOption.isAnsi()) m_pcLifeGameView = new LifeGameViewOnAnsi();
+	else                   m_pcLifeGameView = new LifeGameViewOnCurses();
+	long a_lCol = (0 < i_cOption.getColMax())? i_cOption.getColMax() : m_pcLifeGameView->getColMax();
+	long a_lRow = (0 < i_cOption.getRowMax())? i_cOption.getRowMax() : m_pcLifeGameView->getRowMax();
+	m_pcLifeGameView->init(a_lCol, a_lRow);
+	m_pcLifeGameView->showStatus(i_cOption.isHud());
 
 	// Modelを生成.
 	m_pcLifeGameModel = new MatrixCell(a_lCol, a_lRow);
-
-	m_pcLifeGameModel->attach(m_pcLifeGameView);
+	m_pcLifeGameModel->setRule(i_cOption.getRule());
 
 	// セルの初期配置.
-	this->initialPlot();
+	if( i_cOption.getPatternPath().empty() && !i_cOption.isSoup() )
+	{
+		this->initialPlot();
+	}
+	else
+	{
+		LifeGameBatchController::placeInitialCells(m_pcLifeGameModel, i_cOption);
+	}
 	
+	// 以降はModelをシミュレーション スレッドだけが触る.
+	// 世代の更新が間に合わない場合は1フレーム以上の遅れを持ち越さない.
+	m_pcSimulator = new LifeGameSimulator(m_pcLifeGameModel, i_cOption.getGenerationRate(), m_dFrameInterval,
+		static_cast<size_t>(i_cOption.getHistoryMegaByte()) * 1024 * 1024);
+	m_pcSimulator->start();
+
 	// Modelのセル状態とViewの表示を同期させる.
-	this->syncStateModelToView();
+	m_pcLifeGameView->drawBoard(m_pcSimulator->getSnapshot().m_cBoard);
+	this->updateHud(false);
+	m_pcLifeGameView->flush();
 }
 
 /*****************
@@ -34,8 +98,34 @@ LifeGameController::LifeGameController()
  *****************/
 LifeGameController::~LifeGameController()
 {
+	// 記録の保存を含め, 送ったコマンドを全て実行してからスレッドを終了する.
+	if(m_bIsRecording) this->toggleRecord();
+	long a_lGenerationNum = 0;
+	double a_dGenerationTime = 0.0;
+	if(m_pcSimulator != 0)
+	{
+		m_pcSimulator->stop();
+		a_lGenerationNum = m_pcSimulator->getGenerationNum();
+		a_dGenerationTime = m_pcSimulator->getGenerationTime();
+		delete m_pcSimulator;
+	}
 	if(m_pcLifeGameModel!= 0) delete m_pcLifeGameModel;
 	if(m_pcLifeGameView != 0) delete m_pcLifeGameView;
+	if(0 <= m_iTimer) close(m_iTimer);
+
+	// 端末を戻した後に達成した速度を出力する.
+	if( (0 < a_lGenerationNum) && (0.0 < m_dRunTime) )
+	{
+		char a_szTarget[32] = "unlimited";
+		if(0.0 < m_dGenerationInterval) snprintf(a_szTarget, sizeof(a_szTarget), "%.1f", 1.0 / m_dGenerationInterval);
+		fprintf(stderr, "generations: %ld, %.1f gen/s (target: %s), average step time: %.3f ms\n",
+			a_lGenerationNum, a_lGenerationNum / m_dRunTime, a_szTarget, a_dGenerationTime / a_lGenerationNum * 1000.0);
+	}
+	if( (0 < m_lFrameNum) && (0.0 < m_dRunTime) )
+	{
+		fprintf(stderr, "frames: %ld, %.1f fps (target: %.1f), average frame time: %.3f ms\n",
+			m_lFrameNum, m_lFrameNum / m_dRunTime, 1.0 / m_dFrameInterval, m_dFrameTime / m_lFrameNum * 1000.0);
+	}
 }
 
 /*****************
@@ -112,13 +202,33 @@ LifeGameController::LIFEGAME_EVENT LifeGameController::eventLoop()
     RunEvent a_pcRunEvent[EV_MAX] = {
         &LifeGameController::nop,          // EV_NONE.
         &LifeGameController::nop,          // EV_QUIT.
-        &LifeGameController::nop,          // EV_PAUSE.
-        &LifeGameController::refreshCell,  // EV_START.
+        &LifeGameController::pause,        // EV_PAUSE.
+        &LifeGameController::nop,          // EV_START.
         &LifeGameController::moveToUpper,  // EV_MOVE_UP_CURSOR.
         &LifeGameController::moveToLower,  // EV_MOVE_LOW_CURSOR.
         &LifeGameController::moveToRight,  // EV_MOVE_RIGHT_CURSOR.
         &LifeGameController::moveToLeft,   // EV_MOVE_LEFT_CURSOR.
         &LifeGameController::plotCell,     // EV_PLOTCELL.
+        &LifeGameController::toggleRecord, // EV_RECORD.
+        &LifeGameController::toggleSelect, // EV_SELECT.
+        &LifeGameController::copyRegion,   // EV_COPY.
+        &LifeGameController::fillRegion,   // EV_FILL.
+        &LifeGameController::clearRegion,  // EV_CLEAR.
+        &LifeGameController::invertRegion, // EV_INVERT.
+        &LifeGameController::pasteRegion,          // EV_PASTE.
+        &LifeGameController::pasteRegionOr,        // EV_PASTE_OR.
+        &LifeGameController::pasteRegionXor,       // EV_PASTE_XOR.
+        &LifeGameController::rotateRegion,         // EV_ROTATE.
+        &LifeGameController::flipRegionHorizontal, // EV_FLIP_HORIZONTAL.
+        &LifeGameController::flipRegionVertical,   // EV_FLIP_VERTICAL.
+        &LifeGameController::zoomIn,               // EV_ZOOM_IN.
+        &LifeGameController::zoomOut,              // EV_ZOOM_OUT.
+        &LifeGameController::toggleHud,            // EV_HUD.
+        &LifeGameController::stepGeneration,       // EV_STEP.
+        &LifeGameController::runToGeneration,      // EV_RUN_TO.
+        &LifeGameController::speedUp,              // EV_SPEED_UP.
+        &LifeGameController::speedDown,            // EV_SPEED_DOWN.
+        &LifeGameController::rewindHistory,        // EV_UNDO.
     };
     LIFEGAME_EVENT a_eEvent = EV_NONE;
 
@@ -126,21 +236,137 @@ LifeGameController::LIFEGAME_EVENT LifeGameController::eventLoop()
     a_eEvent = getEvent();
 
     // 取得したイベントがEV_NONEだった場合, 前回実行したイベントに差し替える.
+    // 差し替えたEV_PAUSEは停止の状態を引き継ぐだけで, 処理(pause())は呼ばない.
+    bool a_bIsRepeat = false;
     if( (EV_NONE==a_eEvent) && (EV_PAUSE==m_ePrevEvent) )
     {
         a_eEvent = EV_PAUSE;
+        a_bIsRepeat = true;
     }
     else if( (EV_NONE==a_eEvent) && (EV_START==m_ePrevEvent))
     {
         a_eEvent = EV_START;
     }
 
-    (this->*a_pcRunEvent[a_eEvent])();
+    // 速度の変更は実行/停止を切り替えない.(実行中ならばそのまま実行を続ける).
+    if( (EV_SPEED_UP==a_eEvent) || (EV_SPEED_DOWN==a_eEvent) )
+    {
+        (this->*a_pcRunEvent[a_eEvent])();
+        a_eEvent = (EV_START==m_ePrevEvent)? EV_START : EV_NONE;
+    }
+
+    double a_dNow = getSecond();
+    if( (EV_START==a_eEvent) && (EV_START!=m_ePrevEvent) )
+    {
+        // 実行開始.(世代はシミュレーション スレッドが進める).
+        m_pcSimulator->send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_RUN));
+        m_dRunStart = a_dNow;
+        m_dNextFrame = a_dNow + m_dFrameInterval;
+
+        // 停止していた時間は性能表示(HUD)の計測に含めない.
+        HUD_SAMPLE a_stSample = { a_dNow, m_pcSimulator->getGenerationNum(), m_pcSimulator->getGenerationTime(),
+            m_lFrameNum, m_dFrameTime, m_pcSimulator->getChangedNum() };
+        m_stHudSample = a_stSample;
+        m_dNextHud = a_dNow + HUD_INTERVAL;
+    }
+    else if( (EV_START!=a_eEvent) && (EV_START==m_ePrevEvent) )
+    {
+        // 実行停止.(進めている途中の世代は最後まで進む).
+        m_pcSimulator->send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_PAUSE));
+        m_dRunTime += a_dNow - m_dRunStart;
+    }
+
+    if(!a_bIsRepeat) (this->*a_pcRunEvent[a_eEvent])();
+
+    // 見えている範囲が変わっていればシミュレーション スレッドへ知らせる.
+    this->updateInterest();
+
+    // 実行中はフレームの時刻が来た場合だけ最新の盤面を受け取って画面へ反映する.(間の世代の描画は飛ばす).
+    // 停止中は操作の結果をすぐに反映する.
+    if(EV_START != a_eEvent)
+    {
+        this->syncStateModelToView();
+        this->updateHud(false);
+        m_pcLifeGameView->flush();
+    }
+    else if(m_dNextFrame <= getSecond())
+    {
+        // 前のフレームから世代が進んでいなければ描画しない.
+        double a_dStart = getSecond();
+        if(this->syncStateModelToView())
+        {
+            this->updateHud(true);
+            m_pcLifeGameView->flush();
+            m_lFrameNum++;
+            m_dFrameTime += getSecond() - a_dStart;
+        }
+
+        // 描画が間に合わない場合は遅れを持ち越さない.
+        m_dNextFrame += m_dFrameInterval;
+        if(m_dNextFrame < a_dStart) m_dNextFrame = a_dStart + m_dFrameInterval;
+    }
 
     m_ePrevEvent = a_eEvent;
     return a_eEvent;
 }
 
+/**************************************************
+ * 入力, またはフレームの時刻まで待つ.
+ **************************************************/
+void LifeGameController::waitNextEvent()
+{
+    // 読み込み済みの入力が残っているかもしれないので, 入力が無くなるまでは待たない.
+    if(m_bIsInputRead) return;
+    TRACE_SCOPE("ui", "wait");
+
+    struct pollfd a_rgstPoll[2];
+    int a_iPollNum = 0;
+    a_rgstPoll[a_iPollNum].fd = m_pcLifeGameView->getInputFd();
+    a_rgstPoll[a_iPollNum].events = POLLIN;
+    a_iPollNum++;
+
+    // 停止中は編集やコマ送りの結果が公開されたらすぐに描画する.
+    if(EV_START != m_ePrevEvent)
+    {
+        a_rgstPoll[a_iPollNum].fd = m_pcSimulator->getPublishFd();
+        a_rgstPoll[a_iPollNum].events = POLLIN;
+        a_iPollNum++;
+        poll(a_rgstPoll, a_iPollNum, -1);
+        return;
+    }
+
+    // 実行中は次のフレームの時刻にタイマーを設定する.(世代を進める時刻はシミュレーション スレッドが待つ).
+    // 途中で公開された盤面はフレームの時刻にまとめて受け取る.
+    if(0 <= m_iTimer)
+    {
+        double a_dWake = m_dNextFrame;
+        if(a_dWake <= getSecond()) return;
+
+        struct itimerspec a_stTimer = {};
+        a_stTimer.it_value.tv_sec = static_cast<time_t>(a_dWake);
+        a_stTimer.it_value.tv_nsec = static_cast<long>((a_dWake - a_stTimer.it_value.tv_sec) * 1000000000.0);
+        timerfd_settime(m_iTimer, TFD_TIMER_ABSTIME, &a_stTimer, 0);
+
+        a_rgstPoll[a_iPollNum].fd = m_iTimer;
+        a_rgstPoll[a_iPollNum].events = POLLIN;
+        a_iPollNum++;
+    }
+    else
+    {
+        // タイマーが使えない場合は時刻まで眠る.
+        double a_dWait = m_dNextFrame - getSecond();
+        if(0.0 < a_dWait) usleep(static_cast<useconds_t>(a_dWait * 1000000.0));
+        return;
+    }
+
+    if( (0 < poll(a_rgstPoll, a_iPollNum, -1)) && (1 < a_iPollNum) && (a_rgstPoll[1].revents & POLLIN) )
+    {
+        // 満了回数を読み捨てる.
+        uint64_t a_ulExpired = 0;
+        if(sizeof(a_ulExpired) != read(m_iTimer, &a_ulExpired, sizeof(a_ulExpired))) return;
+    }
+}
+
 /**************************************
  * 入力されたコマンドからイベントに変換
  **************************************/
@@ -161,12 +387,45 @@ LifeGameController::LIFEGAME_EVENT LifeGameController::getEvent()
         { 'l',      EV_MOVE_RIGHT_CURSOR},
         { 'h',      EV_MOVE_LEFT_CURSOR},
         { 'i',      EV_PLOTCELL},
+        { 'r',      EV_RECORD},
+        { 'v',      EV_SELECT},
+        { 'y',      EV_COPY},
+        { 'f',      EV_FILL},
+        { 'x',      EV_CLEAR},
+        { 'n',      EV_INVERT},
+        { 'P',      EV_PASTE},
+        { 'O',      EV_PASTE_OR},
+        { 'X',      EV_PASTE_XOR},
+        { 'R',      EV_ROTATE},
+        { 'H',      EV_FLIP_HORIZONTAL},
+        { 'V',      EV_FLIP_VERTICAL},
+        { '+',      EV_ZOOM_IN},
+        { '-',      EV_ZOOM_OUT},
+        { 'd',      EV_HUD},
+        { '.',      EV_STEP},
+        { 'G',      EV_RUN_TO},
+        { '>',      EV_SPEED_UP},
+        { '<',      EV_SPEED_DOWN},
+        { 'u',      EV_UNDO},
     };
     char a_ch = '\0';
     LIFEGAME_EVENT a_eEvent = EV_NONE;
 
     // 入力されたコマンドを取得.(Viewから取得)
     a_ch = m_pcLifeGameView->getCommand();
+    m_bIsInputRead = ('\0' != a_ch);
+
+    // 数字は回数として溜める.(イベントにはしない).
+    if( ('0' <= a_ch) && (a_ch <= '9') )
+    {
+        if(m_lCountPrefix < COUNT_MAX) m_lCountPrefix = m_lCountPrefix * 10 + (a_ch - '0');
+        return EV_NONE;
+    }
+    if('\0' != a_ch)
+    {
+        m_lCount = m_lCountPrefix;
+        m_lCountPrefix = 0;
+    }
 
     // 入力された文字をイベントに変換.
     int a_iElementNum = sizeof(a_rgstPair) / sizeof(a_rgstPair[0]) ;
@@ -219,20 +478,343 @@ void LifeGameController::moveToLeft()
 void LifeGameController::plotCell()
 {
     // カーソル位置Viewから取得.
-    int a_iCol = m_pcLifeGameView->getCol();
-    int a_iRow = m_pcLifeGameView->getRow();
+    long a_lCol = m_pcLifeGameView->getCol();
+    long a_lRow = m_pcLifeGameView->getRow();
+
+	// セルの状態をModelへ送る.(Modelの状態を反転させるので, 表示している盤面が古くても正しく反転する).
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_TOGGLE_CELL);
+	a_stCommand.m_lCol = a_lCol;
+	a_stCommand.m_lRow = a_lRow;
+	if(!m_pcSimulator->send(a_stCommand)) return;
+
+	// 世代の更新を待たずにViewへ描画する.(次に受け取った盤面で上書きされる).
+	BitBoard& a_cBoard = m_pcSimulator->getSnapshot().m_cBoard;
+	a_cBoard.toggleBit(a_lCol, a_lRow);
+	m_pcLifeGameView->draw(a_lCol, a_lRow, a_cBoard.getBit(a_lCol, a_lRow)? CellAttribute::ALIVE : CellAttribute::DEAD);
+}
+
+/********************************************
+ * 世代の記録を開始/停止する.(トグル動作)
+ ********************************************/
+void LifeGameController::toggleRecord()
+{
+	LifeGameSimulator::COMMAND a_stCommand(m_bIsRecording? LifeGameSimulator::CMD_RECORD_STOP : LifeGameSimulator::CMD_RECORD_START);
+	a_stCommand.m_strPath = RECORD_FILE;
+	if(m_pcSimulator->send(a_stCommand)) m_bIsRecording = !m_bIsRecording;
+}
 
-	// セルの状態をModelから取得.
-    CellAttribute::CELL_STATE a_eState = m_pcLifeGameModel->getCellState(a_iCol, a_iRow);
+/********************************************
+ * 範囲選択の始点を設定/解除する.(トグル動作)
+ ********************************************/
+void LifeGameController::toggleSelect()
+{
+	if(0 <= m_lAnchorCol)
+	{
+		m_lAnchorCol = -1;
+		m_lAnchorRow = -1;
+	}
+	else
+	{
+		m_lAnchorCol = m_pcLifeGameView->getCol();
+		m_lAnchorRow = m_pcLifeGameView->getRow();
+	}
+}
 
-	// セルの状態を反転させる.
-	a_eState = (CellAttribute::ALIVE==a_eState)? CellAttribute::DEAD : CellAttribute::ALIVE;
+/***********************
+ * 選択範囲を取得.
+ ***********************/
+void LifeGameController::getSelection(long& o_lCol, long& o_lRow, long& o_lWidth, long& o_lHeight)
+{
+	long a_lCol = m_pcLifeGameView->getCol();
+	long a_lRow = m_pcLifeGameView->getRow();
+	long a_lAnchorCol = (0 <= m_lAnchorCol)? m_lAnchorCol : a_lCol;
+	long a_lAnchorRow = (0 <= m_lAnchorRow)? m_lAnchorRow : a_lRow;
 
-	// セルの状態をModelへ設定.
-    m_pcLifeGameModel->setCellState(a_iCol, a_iRow, a_eState);
+	o_lCol = (a_lCol < a_lAnchorCol)? a_lCol : a_lAnchorCol;
+	o_lRow = (a_lRow < a_lAnchorRow)? a_lRow : a_lAnchorRow;
+	o_lWidth = ((a_lCol < a_lAnchorCol)? a_lAnchorCol - a_lCol : a_lCol - a_lAnchorCol) + 1;
+	o_lHeight = ((a_lRow < a_lAnchorRow)? a_lAnchorRow - a_lRow : a_lRow - a_lAnchorRow) + 1;
 
-	// セルの状態をViewへ設定.
-    m_pcLifeGameView->draw(a_iCol, a_iRow, a_eState);
+	// 操作したら選択を解除する.
+	m_lAnchorCol = -1;
+	m_lAnchorRow = -1;
+}
+
+/***************************************
+ * 見えている範囲を関心領域として送る.
+ ***************************************/
+void LifeGameController::updateInterest()
+{
+	long a_lCol, a_lRow, a_lWidth, a_lHeight;
+	m_pcLifeGameView->getViewRegion(a_lCol, a_lRow, a_lWidth, a_lHeight);
+
+	// 範囲選択中は始点まで広げる.
+	if(0 <= m_lAnchorCol)
+	{
+		long a_lColEnd = (a_lCol + a_lWidth > m_lAnchorCol)? a_lCol + a_lWidth : m_lAnchorCol + 1;
+		long a_lRowEnd = (a_lRow + a_lHeight > m_lAnchorRow)? a_lRow + a_lHeight : m_lAnchorRow + 1;
+		if(m_lAnchorCol < a_lCol) a_lCol = m_lAnchorCol;
+		if(m_lAnchorRow < a_lRow) a_lRow = m_lAnchorRow;
+		a_lWidth = a_lColEnd - a_lCol;
+		a_lHeight = a_lRowEnd - a_lRow;
+	}
+
+	if( (a_lCol == m_lInterestCol) && (a_lRow == m_lInterestRow)
+	 && (a_lWidth == m_lInterestWidth) && (a_lHeight == m_lInterestHeight) ) return;
+
+	// 送れなかった場合は次の周回で送り直す.
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_SET_INTEREST);
+	a_stCommand.m_lCol = a_lCol;
+	a_stCommand.m_lRow = a_lRow;
+	a_stCommand.m_lWidth = a_lWidth;
+	a_stCommand.m_lHeight = a_lHeight;
+	if(!m_pcSimulator->send(a_stCommand)) return;
+	m_lInterestCol = a_lCol;
+	m_lInterestRow = a_lRow;
+	m_lInterestWidth = a_lWidth;
+	m_lInterestHeight = a_lHeight;
+}
+
+/***************************************
+ * 選択範囲をクリップボードへ写す.
+ ***************************************/
+void LifeGameController::copyRegion()
+{
+	long a_lCol, a_lRow, a_lWidth, a_lHeight;
+	this->getSelection(a_lCol, a_lRow, a_lWidth, a_lHeight);
+
+	// 表示している盤面から写す.(選択範囲はカーソルで決めるので盤面からはみ出さない).
+	// 関心領域は選択の始点まで広げているので, 選択範囲は受け取った盤面の最新の矩形に含まれる.
+	m_cClipboard.extract(m_pcSimulator->getSnapshot().m_cBoard, a_lCol, a_lRow, a_lWidth, a_lHeight);
+}
+
+/***************************************
+ * 選択範囲へのコマンドを送る.
+ ***************************************/
+void LifeGameController::sendRegionCommand(LifeGameSimulator::COMMAND_TYPE i_eType)
+{
+	LifeGameSimulator::COMMAND a_stCommand(i_eType);
+	this->getSelection(a_stCommand.m_lCol, a_stCommand.m_lRow, a_stCommand.m_lWidth, a_stCommand.m_lHeight);
+
+	// 変化したセルは次に受け取る盤面でViewへ描画される.
+	m_pcSimulator->send(a_stCommand);
+}
+
+/***************************************
+ * 選択範囲の全セルを"生"にする.
+ ***************************************/
+void LifeGameController::fillRegion()
+{
+	this->sendRegionCommand(LifeGameSimulator::CMD_FILL);
+}
+
+/***************************************
+ * 選択範囲の全セルを"死"にする.
+ ***************************************/
+void LifeGameController::clearRegion()
+{
+	this->sendRegionCommand(LifeGameSimulator::CMD_CLEAR);
+}
+
+/***************************************
+ * 選択範囲の全セルの 生/死 を反転する.
+ ***************************************/
+void LifeGameController::invertRegion()
+{
+	this->sendRegionCommand(LifeGameSimulator::CMD_INVERT);
+}
+
+/***************************************
+ * クリップボードをカーソル位置へ貼り付ける.
+ ***************************************/
+void LifeGameController::pasteClipboard(BitBoard::PASTE_MODE i_eMode)
+{
+	long a_lCol = m_pcLifeGameView->getCol();
+	long a_lRow = m_pcLifeGameView->getRow();
+
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_PASTE);
+	a_stCommand.m_lCol = a_lCol;
+	a_stCommand.m_lRow = a_lRow;
+	a_stCommand.m_cBoard = m_cClipboard;
+	a_stCommand.m_ePasteMode = i_eMode;
+	m_pcSimulator->send(a_stCommand);
+}
+
+/***************************************
+ * 貼り付け.(置き換え/OR/XOR)
+ ***************************************/
+void LifeGameController::pasteRegion()    { this->pasteClipboard(BitBoard::PASTE_REPLACE); }
+void LifeGameController::pasteRegionOr()  { this->pasteClipboard(BitBoard::PASTE_OR); }
+void LifeGameController::pasteRegionXor() { this->pasteClipboard(BitBoard::PASTE_XOR); }
+
+/***************************************
+ * 選択範囲を時計回りに90度回転する.
+ ***************************************/
+void LifeGameController::rotateRegion()
+{
+	this->sendRegionCommand(LifeGameSimulator::CMD_ROTATE);
+}
+
+/***************************************
+ * 選択範囲を左右反転する.
+ ***************************************/
+void LifeGameController::flipRegionHorizontal()
+{
+	this->sendRegionCommand(LifeGameSimulator::CMD_FLIP_HORIZONTAL);
+}
+
+/***************************************
+ * 選択範囲を上下反転する.
+ ***************************************/
+void LifeGameController::flipRegionVertical()
+{
+	this->sendRegionCommand(LifeGameSimulator::CMD_FLIP_VERTICAL);
+}
+
+/***************
+ * 拡大する.
+ ***************/
+void LifeGameController::zoomIn()
+{
+	m_pcLifeGameView->zoomIn();
+}
+
+/***************
+ * 縮小する.
+ ***************/
+void LifeGameController::zoomOut()
+{
+	m_pcLifeGameView->zoomOut();
+}
+
+/***************
+ * 一時停止する.
+ ***************/
+void LifeGameController::pause()
+{
+	// 停止を要求した時に1回だけ呼ばれる. 停止中のコマ送り(EV_STEP, EV_RUN_TO)で進めている途中の場合だけ止める.
+	// (実行中からの停止はeventLoop()がCMD_PAUSEを送る).
+	if( (EV_START != m_ePrevEvent) && (0 < m_pcSimulator->getStepRemain()) )
+	{
+		m_pcSimulator->send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_PAUSE));
+	}
+}
+
+/*************************************
+ * 入力した世代数だけ進める.
+ *************************************/
+void LifeGameController::stepGeneration()
+{
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_STEP);
+	a_stCommand.m_lCount = (0 < m_lCount)? m_lCount : 1;
+	m_pcSimulator->send(a_stCommand);
+}
+
+/*************************************
+ * 入力した世代まで最大速度で進める.
+ *************************************/
+void LifeGameController::runToGeneration()
+{
+	if(0 >= m_lCount) return;
+
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_RUN_TO);
+	a_stCommand.m_lCount = m_lCount;
+	m_pcSimulator->send(a_stCommand);
+}
+
+/*************************************
+ * 世代を進める速度を2倍にする.
+ *************************************/
+void LifeGameController::speedUp()
+{
+	if(0.0 >= m_dGenerationInterval) return;
+
+	double a_dRate = 2.0 / m_dGenerationInterval;
+	if(GPS_MAX < a_dRate) a_dRate = 0.0;
+
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_SET_RATE);
+	a_stCommand.m_dRate = a_dRate;
+	if(m_pcSimulator->send(a_stCommand)) m_dGenerationInterval = (0.0 < a_dRate)? 1.0 / a_dRate : 0.0;
+}
+
+/*************************************
+ * 世代を進める速度を1/2にする.
+ *************************************/
+void LifeGameController::speedDown()
+{
+	double a_dRate = (0.0 < m_dGenerationInterval)? 0.5 / m_dGenerationInterval : GPS_MAX / 2.0;
+	if(a_dRate < GPS_MIN) a_dRate = GPS_MIN;
+
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_SET_RATE);
+	a_stCommand.m_dRate = a_dRate;
+	if(m_pcSimulator->send(a_stCommand)) m_dGenerationInterval = 1.0 / a_dRate;
+}
+
+/*************************************
+ * 世代や編集を巻き戻す.
+ *************************************/
+void LifeGameController::rewindHistory()
+{
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_REWIND);
+	a_stCommand.m_lCount = (0 < m_lCount)? m_lCount : 1;
+	m_pcSimulator->send(a_stCommand);
+}
+
+/****************************************
+ * 性能表示(HUD)を表示/非表示にする.
+ ****************************************/
+void LifeGameController::toggleHud()
+{
+	m_pcLifeGameView->showStatus(!m_pcLifeGameView->isStatusVisible());
+	m_dNextHud = 0.0;	// すぐに更新する.
+}
+
+/****************************************
+ * 性能表示(HUD)の文字列を更新する.
+ ****************************************/
+void LifeGameController::updateHud(bool i_bIsRunning)
+{
+	if(!m_pcLifeGameView->isStatusVisible()) return;
+	double a_dNow = getSecond();
+	if(i_bIsRunning && (a_dNow < m_dNextHud)) return;
+	if(i_bIsRunning) this->measureHud(a_dNow);
+
+	char a_szStatus[256];
+	const LifeGameSimulator::SNAPSHOT& a_stSnapshot = m_pcSimulator->getSnapshot();
+	char a_szTarget[32] = "unlimited";
+	if(0.0 < m_dGenerationInterval) snprintf(a_szTarget, sizeof(a_szTarget), "%g gen/s", 1.0 / m_dGenerationInterval);
+	const char* a_pState = i_bIsRunning? "running" : "paused";
+	if(0 < m_pcSimulator->getStepRemain()) a_pState = "stepping";
+	snprintf(a_szStatus, sizeof(a_szStatus), " gen %ld | pop %ld | %s | target %s | %s ",
+		a_stSnapshot.m_lGeneration, a_stSnapshot.m_lPopulation, m_strHudMeasure.c_str(), a_szTarget, a_pState);
+	m_pcLifeGameView->setStatus(a_szStatus);
+}
+
+/****************************************
+ * 性能表示(HUD)の計測値を更新する.
+ ****************************************/
+void LifeGameController::measureHud(double i_dNow)
+{
+	double a_dNow = i_dNow;
+
+	// 前回の更新からの増分.(停止中は世代が進まないので0).
+	HUD_SAMPLE a_stSample = { a_dNow, m_pcSimulator->getGenerationNum(), m_pcSimulator->getGenerationTime(),
+		m_lFrameNum, m_dFrameTime, m_pcSimulator->getChangedNum() };
+	double a_dElapsed = a_dNow - m_stHudSample.m_dTime;
+	long a_lGenerationNum = a_stSample.m_lGenerationNum - m_stHudSample.m_lGenerationNum;
+	long a_lFrameNum = a_stSample.m_lFrameNum - m_stHudSample.m_lFrameNum;
+	double a_dRate = (0.0 < a_dElapsed)? a_lGenerationNum / a_dElapsed : 0.0;
+	double a_dStepTime = (0 < a_lGenerationNum)? (a_stSample.m_dGenerationTime - m_stHudSample.m_dGenerationTime) / a_lGenerationNum : 0.0;
+	double a_dDrawTime = (0 < a_lFrameNum)? (a_stSample.m_dFrameTime - m_stHudSample.m_dFrameTime) / a_lFrameNum : 0.0;
+	long a_lChangedNum = (0 < a_lGenerationNum)? (a_stSample.m_lChangedNum - m_stHudSample.m_lChangedNum) / a_lGenerationNum : 0;
+
+	char a_szMeasure[128];
+	snprintf(a_szMeasure, sizeof(a_szMeasure), "%.1f gen/s | model %.3f ms | render %.3f ms | %ld changed/gen",
+		a_dRate, a_dStepTime * 1000.0, a_dDrawTime * 1000.0, a_lChangedNum);
+	m_strHudMeasure = a_szMeasure;
+
+	m_stHudSample = a_stSample;
+	m_dNextHud = a_dNow + HUD_INTERVAL;
 }
 
 /***************
@@ -240,25 +822,21 @@ void LifeGameController::plotCell()
  ***************/
 void LifeGameController::refreshCell()
 {
-	m_pcLifeGameModel->refreshCell();
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_STEP);
+	a_stCommand.m_lCount = 1;
+	m_pcSimulator->send(a_stCommand);
 }
 
 /********************************************
  * Modelのセル状態とViewの表示を同期させる.
  ********************************************/
-void LifeGameController::syncStateModelToView()
+bool LifeGameController::syncStateModelToView()
 {
-	CellAttribute::CELL_STATE a_eState;
+	if(!m_pcSimulator->receive()) return false;
 
-	for(long a_lRow=0; a_lRow<m_pcLifeGameView->getRowMax(); a_lRow++)
-	{
-		for(long a_lCol=0; a_lCol<m_pcLifeGameView->getColMax(); a_lCol++)
-		{
-			// Modelから状態を取得.
-			a_eState = m_pcLifeGameModel->getCellState(a_lCol, a_lRow);
-			// Viewへ状態を描画.
-			m_pcLifeGameView->draw(a_lCol, a_lRow, a_eState);
-		}
-	}
+	// 受け取った盤面のうち最新の矩形(見えている範囲)だけを写す.
+	const LifeGameSimulator::SNAPSHOT& a_stSnapshot = m_pcSimulator->getSnapshot();
+	m_pcLifeGameView->drawRegion(a_stSnapshot.m_cBoard,
+		a_stSnapshot.m_lRegionCol, a_stSnapshot.m_lRegionRow, a_stSnapshot.m_lRegionWidth, a_stSnapshot.m_lRegionHeight);
+	return true;
 }
-
@@ -6,12 +6,19 @@
 #define __LIFEGAME_CONTROLLER_H__
 
 #include "../Model/MatrixCell.h"
-#include "../View/LifeGameViewOnCurses.h"
+#include "../View/LifeGameView.h"
 #include "../Lib/CellAttribute.h"
+#include "LifeGameOption.h"
+#include "LifeGameSimulator.h"
+
+#include <string>
 
 /**
  * @brief   ライフゲームのコントローラー クラス.
  * @note	MVCのコントローラー部.
+ * @note	世代を進めるのはLifeGameSimulatorのスレッドで, このクラスは入力と描画だけを行う.(UIスレッド).
+ *			Modelへの操作はコマンドとして送り, 進んだ盤面を受け取って描画する.
+ *			世代の更新が遅くてもカーソル移動などの入力と描画は止まらない.
  */
 class LifeGameController
 {
@@ -30,13 +37,35 @@ public:
         EV_MOVE_RIGHT_CURSOR,
         EV_MOVE_LEFT_CURSOR,
 		EV_PLOTCELL,
+		EV_RECORD,
+		EV_SELECT,
+		EV_COPY,
+		EV_FILL,
+		EV_CLEAR,
+		EV_INVERT,
+		EV_PASTE,
+		EV_PASTE_OR,
+		EV_PASTE_XOR,
+		EV_ROTATE,
+		EV_FLIP_HORIZONTAL,
+		EV_FLIP_VERTICAL,
+		EV_ZOOM_IN,
+		EV_ZOOM_OUT,
+		EV_HUD,
+		EV_STEP,
+		EV_RUN_TO,
+		EV_SPEED_UP,
+		EV_SPEED_DOWN,
+		EV_UNDO,
         EV_MAX,
     };
 
     /**
      * @brief   コンストラクタ.
+     * @param   const LifeGameOption& i_cOption コマンドライン引数.(loadPattern()済みであること).
+     * @note    パターンが指定されていなければinitialPlot()で初期配置する.
      */
-    LifeGameController();
+    LifeGameController(const LifeGameOption& i_cOption);
 
     /**
      * @brief   デストラクタ.
@@ -57,11 +86,23 @@ public:
 	 */
 	LIFEGAME_EVENT eventLoop();
 
+	/**
+	 * @brief	入力, またはフレームの時刻まで待つ.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	eventLoop()の後に呼ぶ.
+	 * @note	端末の入力とタイマー(timerfd)をpoll()で待つ. キーが押されたらすぐに戻る.
+	 *			停止中はタイマーを止めて入力と盤面の公開(編集の結果)だけを待つ.(CPUを使わない).
+	 * @note	直前のeventLoop()で入力を読んだ場合は待たない.(cursesが読み込み済みの入力が残っている事があるため).
+	 */
+	void waitNextEvent();
+
 	/**
 	 * @brief	イベントを取得.
 	 * @param	なし.
 	 * @return	イベント.
 	 * @note	入力されたコマンドからイベントに変換.
+	 * @note	数字は回数(世代数)の入力として次のキーまで溜める.(例: "100." で100世代進める).
 	 */
 	LIFEGAME_EVENT getEvent();
 
@@ -73,9 +114,10 @@ public:
 	void nop(){ }
 
 	/**
-	 * @brief	セルを再描画.
+	 * @brief	セルを再描画.(1世代進める).
 	 * @param	なし.
 	 * @return	なし.
+	 * @note	コマンドを送るだけで, 進んだ盤面はsyncStateModelToView()で受け取る.
 	 */
 	void refreshCell();
 
@@ -115,22 +157,343 @@ public:
 	void plotCell();
 
 	/**
-	 * @brief	Modelのセル状態とViewの表示を同期させる.
+	 * @brief	世代の記録を開始/停止する.(トグル動作).
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	停止時に記録をRECORD_FILEへ保存する.(保存はシミュレーション スレッドで行う).
+	 */
+	void toggleRecord();
+
+	/**
+	 * @brief	範囲選択の始点を設定/解除する.(トグル動作).
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	始点とカーソルを対角とする矩形が以下の矩形操作の対象となる.
+	 *			始点が無い場合はカーソル位置の1セルが対象となる.
+	 */
+	void toggleSelect();
+
+	/**
+	 * @brief	選択範囲をクリップボードへ写す.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void copyRegion();
+
+	/**
+	 * @brief	選択範囲の全セルを"生"にする.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void fillRegion();
+
+	/**
+	 * @brief	選択範囲の全セルを"死"にする.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void clearRegion();
+
+	/**
+	 * @brief	選択範囲の全セルの 生/死 を反転する.
 	 * @param	なし.
 	 * @return	なし.
 	 */
-	void syncStateModelToView();
+	void invertRegion();
+
+	/**
+	 * @brief	クリップボードをカーソル位置へ貼り付ける.(置き換え).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void pasteRegion();
+
+	/**
+	 * @brief	クリップボードをカーソル位置へ貼り付ける.(OR).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void pasteRegionOr();
+
+	/**
+	 * @brief	クリップボードをカーソル位置へ貼り付ける.(XOR).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void pasteRegionXor();
+
+	/**
+	 * @brief	選択範囲を時計回りに90度回転する.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void rotateRegion();
+
+	/**
+	 * @brief	選択範囲を左右反転する.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void flipRegionHorizontal();
+
+	/**
+	 * @brief	選択範囲を上下反転する.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void flipRegionVertical();
+
+	/**
+	 * @brief	拡大する.(1文字あたりのセルを減らす).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void zoomIn();
+
+	/**
+	 * @brief	縮小する.(1文字あたりのセルを増やす).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void zoomOut();
+
+	/**
+	 * @brief	性能表示(HUD)を表示/非表示にする.(トグル動作).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void toggleHud();
+
+	/**
+	 * @brief	一時停止する.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	コマ送り/指定世代までの実行の途中ならば止める.
+	 */
+	void pause();
+
+	/**
+	 * @brief	入力した世代数だけ進める.(入力が無ければ1世代).
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	途中の世代は描画せず, 進め終わってから1回だけ描画する.
+	 */
+	void stepGeneration();
+
+	/**
+	 * @brief	入力した世代まで最大速度で進める.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	途中の世代は描画せず, 進め終わってから1回だけ描画する.(世代の入力が無ければ何もしない).
+	 */
+	void runToGeneration();
+
+	/**
+	 * @brief	世代を進める速度を2倍にする.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	GPS_MAXを超えたら無制限にする.
+	 */
+	void speedUp();
+
+	/**
+	 * @brief	世代を進める速度を1/2にする.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	無制限からはGPS_MAX/2にする. GPS_MINより遅くはしない.
+	 */
+	void speedDown();
+
+	/**
+	 * @brief	入力した件数(無ければ1件)だけ世代や編集を巻き戻す.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	実行は止める. 世代の記録中は巻き戻さない.
+	 */
+	void rewindHistory();
+
+	/**
+	 * @brief	Modelのセル状態とViewの表示を同期させる.
+	 * @param	なし.
+	 * @return	新しい盤面を描画したか否か.
+	 * @note	シミュレーション スレッドが公開した最新の盤面を描画する.(公開されていなければ何もしない).
+	 */
+	bool syncStateModelToView();
 
 private:
+	/**
+	 * @brief	選択範囲を取得.
+	 * @param	long& o_lCol 横位置(左端).
+	 * @param	long& o_lRow 縦位置(上端).
+	 * @param	long& o_lWidth 横幅.
+	 * @param	long& o_lHeight 縦幅.
+	 * @return	なし.
+	 */
+	void getSelection(long& o_lCol, long& o_lRow, long& o_lWidth, long& o_lHeight);
+
+	/**
+	 * @brief	Viewの見えている範囲をシミュレーション スレッドへ関心領域として送る.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	前回送った範囲から変わった場合だけ送る.(移動, 拡大/縮小, ステータス行の表示/非表示, 端末の大きさ).
+	 *          範囲選択中は始点まで広げる.(copyRegion()は受け取った盤面から写すので).
+	 */
+	void updateInterest();
+
+	/**
+	 * @brief	クリップボードをカーソル位置へ貼り付ける.
+	 * @param	BitBoard::PASTE_MODE i_eMode 貼り付け方法.
+	 * @return	なし.
+	 */
+	void pasteClipboard(BitBoard::PASTE_MODE i_eMode);
+
+	/**
+	 * @brief	シミュレーション スレッドへコマンドを送る.
+	 * @param	LifeGameSimulator::COMMAND_TYPE i_eType コマンドの種類.
+	 * @return	なし.
+	 * @note	対象は選択範囲とする.
+	 */
+	void sendRegionCommand(LifeGameSimulator::COMMAND_TYPE i_eType);
+
+	/**
+	 * @brief	性能表示(HUD)の文字列を更新する.
+	 * @param	bool i_bIsRunning 実行中か否か.
+	 * @return	なし.
+	 * @note	実行中はHUD_INTERVAL秒に1回だけ計測値を更新する.(表示の負荷で計測値を乱さないため).
+	 * @note	前回の更新からの増分で速度と処理時間を求める.
+	 * @note	停止中は世代数と生きているセルの数だけを毎回更新する.(入力があった時だけ呼ばれる).
+	 */
+	void updateHud(bool i_bIsRunning);
+
+	/**
+	 * @brief	性能表示(HUD)の計測値を更新する.
+	 * @param	double i_dNow 現在時刻.
+	 * @return	なし.
+	 * @note	前回の更新からの増分で速度と処理時間を求め, m_strHudMeasureへ書く.
+	 */
+	void measureHud(double i_dNow);
+
 	/**
 	 * @brief	LifeGame Model
+	 * @note	シミュレーション スレッドの開始前と終了後だけ直接触る.
 	 */
 	MatrixCell*				m_pcLifeGameModel;
 
+	/**
+	 * @brief	世代を進めるスレッド.
+	 */
+	LifeGameSimulator*		m_pcSimulator;
+
 	/**
 	 * @brief	LifeGame View
 	 */
-	LifeGameViewOnCurses*	m_pcLifeGameView;
+	LifeGameView*			m_pcLifeGameView;
+
+	/**
+	 * @brief	世代を記録中か否か.
+	 */
+	bool m_bIsRecording;
+
+	/**
+	 * @brief	範囲選択の始点(横位置).(-1は始点なし).
+	 */
+	long m_lAnchorCol;
+
+	/**
+	 * @brief	範囲選択の始点(縦位置).(-1は始点なし).
+	 */
+	long m_lAnchorRow;
+
+	/**
+	 * @brief	最後に送った関心領域.(幅0は未送信).
+	 */
+	long m_lInterestCol;
+	long m_lInterestRow;
+	long m_lInterestWidth;
+	long m_lInterestHeight;
+
+	/**
+	 * @brief	クリップボード.
+	 */
+	BitBoard m_cClipboard;
+
+	/**
+	 * @brief	世代を進める間隔.(秒).(0は無制限).
+	 */
+	double m_dGenerationInterval;
+
+	/**
+	 * @brief	入力中の回数.(数字キーで入力する).
+	 */
+	long m_lCountPrefix;
+
+	/**
+	 * @brief	今回のイベントに付いた回数.(0は入力なし).
+	 */
+	long m_lCount;
+
+	/**
+	 * @brief	描画する間隔.(秒).
+	 */
+	double m_dFrameInterval;
+
+	/**
+	 * @brief	次に描画する時刻.
+	 */
+	double m_dNextFrame;
+
+	/**
+	 * @brief	実行中に描画したフレームの数.
+	 */
+	long m_lFrameNum;
+
+	/**
+	 * @brief	実行中に描画したフレームの処理時間の合計.(秒).
+	 */
+	double m_dFrameTime;
+
+	/**
+	 * @brief	実行を開始した時刻.
+	 */
+	double m_dRunStart;
+
+	/**
+	 * @brief	実行していた時間の合計.(秒).
+	 */
+	double m_dRunTime;
+
+	/**
+	 * @brief	性能表示(HUD)の計測値.(前回更新した時点の値).
+	 */
+	struct HUD_SAMPLE
+	{
+		double m_dTime;				// 時刻.
+		long m_lGenerationNum;		// 進めた世代の数.
+		double m_dGenerationTime;	// 世代を進めた処理時間の合計.
+		long m_lFrameNum;			// 描画したフレームの数.
+		double m_dFrameTime;		// 描画した処理時間の合計.
+		long m_lChangedNum;			// 状態が変化したセルの数の合計.
+	} m_stHudSample;
+
+	/**
+	 * @brief	次に性能表示(HUD)を更新する時刻.
+	 */
+	double m_dNextHud;
+
+	/**
+	 * @brief	性能表示(HUD)の計測値の文字列.(最後に計測した値).
+	 */
+	std::string m_strHudMeasure;
+
+	/**
+	 * @brief	フレームの時刻を知らせるタイマー.(timerfd).
+	 */
+	int m_iTimer;
+
+	/**
+	 * @brief	直前のeventLoop()で入力を読んだか否か.
+	 */
+	bool m_bIsInputRead;
 
 	/**
 	 * @brief 前回受け取ったイベント.
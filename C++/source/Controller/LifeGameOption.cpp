@@ -0,0 +1,334 @@
+/**
+ * @file    LifeGameOption.cpp
+ * @brief   ライフゲームのコマンドライン引数 クラスの実装.
+ */
+
+#include "LifeGameOption.h"
+#include "../Model/PatternFile.h"
+#include "../Lib/Profiler.h"
+#include "../Lib/Tracer.h"
+
+#include <getopt.h>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <ctime>
+
+/***************************************
+ * 正の整数を解析する.
+ ***************************************/
+static bool parsePositive(const char* i_pValue, long& o_lValue)
+{
+	char* a_pEnd = 0;
+	long a_lValue = strtol(i_pValue, &a_pEnd, 10);
+	if( (a_pEnd==i_pValue) || ('\0'!=*a_pEnd) || (0>=a_lValue) ) return false;
+	o_lValue = a_lValue;
+	return true;
+}
+
+/***************************************
+ * 1秒あたりの回数を解析する.
+ ***************************************/
+static bool parseRate(const char* i_pValue, bool i_bIsZeroAllowed, double& o_dValue)
+{
+	char* a_pEnd = 0;
+	double a_dValue = strtod(i_pValue, &a_pEnd);
+	if( (a_pEnd==i_pValue) || ('\0'!=*a_pEnd) || (0.0>a_dValue) ) return false;
+	if( !i_bIsZeroAllowed && (0.0>=a_dValue) ) return false;
+	o_dValue = a_dValue;
+	return true;
+}
+
+/***************************************
+ * コマンドライン引数を解析する.
+ ***************************************/
+bool LifeGameOption::parse(int i_iArgc, char* i_ppArgv[])
+{
+	// 長いオプションのみのもの.
+	enum { OPT_RECORD = 0x100, OPT_GIF, OPT_GIF_SCALE, OPT_SOUP, OPT_SEED, OPT_GPS, OPT_FPS, OPT_ANSI,
+		OPT_IMAGE, OPT_IMAGE_EVERY, OPT_IMAGE_SCALE, OPT_IMAGE_COLOR, OPT_HUD, OPT_HISTORY_MB, OPT_SERVE, OPT_PROFILE, OPT_TRACE, OPT_ESTIMATE_MEMORY };
+
+	static const struct option a_rgstOption[] = {
+		{ "batch",       no_argument,       0, 'b' },
+		{ "help",        no_argument,       0, 'h' },
+		{ "size",        required_argument, 0, 's' },
+		{ "rule",        required_argument, 0, 'r' },
+		{ "pattern",     required_argument, 0, 'p' },
+		{ "generations", required_argument, 0, 'g' },
+		{ "output",      required_argument, 0, 'o' },
+		{ "record",      required_argument, 0, OPT_RECORD },
+		{ "gif",         required_argument, 0, OPT_GIF },
+		{ "gif-scale",   required_argument, 0, OPT_GIF_SCALE },
+		{ "soup",        required_argument, 0, OPT_SOUP },
+		{ "seed",        required_argument, 0, OPT_SEED },
+		{ "threads",     required_argument, 0, 't' },
+		{ "gps",         required_argument, 0, OPT_GPS },
+		{ "fps",         required_argument, 0, OPT_FPS },
+		{ "ansi",        no_argument,       0, OPT_ANSI },
+		{ "hud",         no_argument,       0, OPT_HUD },
+		{ "image",       required_argument, 0, OPT_IMAGE },
+		{ "image-every", required_argument, 0, OPT_IMAGE_EVERY },
+		{ "image-scale", required_argument, 0, OPT_IMAGE_SCALE },
+		{ "image-color", required_argument, 0, OPT_IMAGE_COLOR },
+		{ "history-mb",  required_argument, 0, OPT_HISTORY_MB },
+		{ "serve",       required_argument, 0, OPT_SERVE },
+		{ "profile",     required_argument, 0, OPT_PROFILE },
+		{ "trace",       required_argument, 0, OPT_TRACE },
+		{ "estimate-memory", no_argument,   0, OPT_ESTIMATE_MEMORY },
+		{ 0, 0, 0, 0 },
+	};
+
+	opterr = 0;
+	optind = 1;
+	int a_iOption = 0;
+	while(-1 != (a_iOption = getopt_long(i_iArgc, i_ppArgv, "bhs:r:p:g:o:t:", a_rgstOption, 0)))
+	{
+		long a_lValue = 0;
+		switch(a_iOption)
+		{
+			case 'b':
+				this->m_bIsBatch = true;
+				break;
+			case 'h':
+				this->m_bIsHelp = true;
+				break;
+			case 's':
+			{
+				// "WxH".
+				std::string a_strSize(optarg);
+				size_t a_lPos = a_strSize.find_first_of("xX");
+				if( (std::string::npos==a_lPos)
+				 || !parsePositive(a_strSize.substr(0, a_lPos).c_str(), this->m_lColMax)
+				 || !parsePositive(a_strSize.substr(a_lPos+1).c_str(), this->m_lRowMax) )
+				{
+					this->m_strError = "invalid size: " + a_strSize;
+					return false;
+				}
+				break;
+			}
+			case 'r':
+				if(!this->m_cRule.parse(optarg))
+				{
+					this->m_strError = std::string("invalid rule: ") + optarg;
+					return false;
+				}
+				this->m_bIsRuleSpecified = true;
+				break;
+			case 'p':
+				this->m_strPatternPath = optarg;
+				break;
+			case 'g':
+				if(!parsePositive(optarg, this->m_lGenerationNum))
+				{
+					this->m_strError = std::string("invalid generations: ") + optarg;
+					return false;
+				}
+				break;
+			case 'o':
+				this->m_strOutputPath = optarg;
+				break;
+			case OPT_RECORD:
+				this->m_strRecordPath = optarg;
+				break;
+			case OPT_SERVE:
+				this->m_strServePath = optarg;
+				break;
+			case OPT_GIF:
+				this->m_strGifPath = optarg;
+				break;
+			case OPT_GIF_SCALE:
+				if(!parsePositive(optarg, a_lValue))
+				{
+					this->m_strError = std::string("invalid gif scale: ") + optarg;
+					return false;
+				}
+				this->m_iGifScale = static_cast<int>(a_lValue);
+				break;
+			case OPT_IMAGE:
+				this->m_strImagePath = optarg;
+				break;
+			case OPT_IMAGE_EVERY:
+				if(!parsePositive(optarg, this->m_lImageEvery))
+				{
+					this->m_strError = std::string("invalid image interval: ") + optarg;
+					return false;
+				}
+				break;
+			case OPT_IMAGE_SCALE:
+				if(!parsePositive(optarg, a_lValue))
+				{
+					this->m_strError = std::string("invalid image scale: ") + optarg;
+					return false;
+				}
+				this->m_iImageScale = static_cast<int>(a_lValue);
+				break;
+			case OPT_IMAGE_COLOR:
+			{
+				static const char* const s_rgpColorName[] = { "mono", "age", "heat" };
+				this->m_iImageColor = -1;
+				for(int a_iIndex=0; a_iIndex<3; a_iIndex++)
+				{
+					if(0 == strcmp(optarg, s_rgpColorName[a_iIndex])) this->m_iImageColor = a_iIndex;
+				}
+				if(0 > this->m_iImageColor)
+				{
+					this->m_strError = std::string("invalid image color: ") + optarg;
+					return false;
+				}
+				break;
+			}
+			case OPT_SOUP:
+			{
+				char* a_pEnd = 0;
+				this->m_dSoupDensity = strtod(optarg, &a_pEnd);
+				if( (a_pEnd==optarg) || ('\0'!=*a_pEnd) || (0.0>this->m_dSoupDensity) || (1.0<this->m_dSoupDensity) )
+				{
+					this->m_strError = std::string("invalid soup density: ") + optarg;
+					return false;
+				}
+				break;
+			}
+			case OPT_SEED:
+			{
+				char* a_pEnd = 0;
+				this->m_ulSeed = strtoull(optarg, &a_pEnd, 0);
+				if( (a_pEnd==optarg) || ('\0'!=*a_pEnd) )
+				{
+					this->m_strError = std::string("invalid seed: ") + optarg;
+					return false;
+				}
+				this->m_bIsSeedSpecified = true;
+				break;
+			}
+			case 't':
+				if(!parsePositive(optarg, a_lValue))
+				{
+					this->m_strError = std::string("invalid threads: ") + optarg;
+					return false;
+				}
+				this->m_iThreadNum = static_cast<int>(a_lValue);
+				break;
+			case OPT_ANSI:
+				this->m_bIsAnsi = true;
+				break;
+			case OPT_HUD:
+				this->m_bIsHud = true;
+				break;
+			case OPT_GPS:
+				if(!parseRate(optarg, true, this->m_dGenerationRate))
+				{
+					this->m_strError = std::string("invalid gps: ") + optarg;
+					return false;
+				}
+				break;
+			case OPT_FPS:
+				if(!parseRate(optarg, false, this->m_dFrameRate))
+				{
+					this->m_strError = std::string("invalid fps: ") + optarg;
+					return false;
+				}
+				break;
+			case OPT_HISTORY_MB:
+			{
+				char* a_pEnd = 0;
+				this->m_lHistoryMegaByte = strtol(optarg, &a_pEnd, 10);
+				if( (a_pEnd==optarg) || ('\0'!=*a_pEnd) || (0>this->m_lHistoryMegaByte) )
+				{
+					this->m_strError = std::string("invalid history size: ") + optarg;
+					return false;
+				}
+				break;
+			}
+			case OPT_PROFILE:
+				if(!parsePositive(optarg, this->m_lProfileEvery))
+				{
+					this->m_strError = std::string("invalid profile interval: ") + optarg;
+					return false;
+				}
+				if(!Profiler::isEnabled())
+				{
+					this->m_strError = "--profile needs a build with profiling (make PROFILE=1)";
+					return false;
+				}
+				break;
+			case OPT_ESTIMATE_MEMORY:
+				this->m_bIsEstimateMemory = true;
+				break;
+			case OPT_TRACE:
+				if(!Tracer::isEnabled())
+				{
+					this->m_strError = "--trace needs a build with tracing (make TRACE=1)";
+					return false;
+				}
+				this->m_strTracePath = optarg;
+				break;
+			default:
+				this->m_strError = std::string("unknown option: ") + i_ppArgv[optind-1];
+				return false;
+		}
+	}
+
+	if(optind < i_iArgc)
+	{
+		this->m_strError = std::string("unexpected argument: ") + i_ppArgv[optind];
+		return false;
+	}
+
+	// シードが未指定ならば時刻から決める.(出力して再現できるようにする).
+	if(!this->m_bIsSeedSpecified) this->m_ulSeed = static_cast<uint64_t>(time(0));
+	return true;
+}
+
+/***************************************
+ * 初期配置のパターンファイルを読み込む.
+ ***************************************/
+bool LifeGameOption::loadPattern()
+{
+	if(this->m_strPatternPath.empty()) return true;
+
+	LifeRule* a_pcRule = this->m_bIsRuleSpecified? 0 : &this->m_cRule;
+	if(!PatternFile::load(this->m_strPatternPath, this->m_cPattern, a_pcRule))
+	{
+		this->m_strError = "cannot load pattern: " + this->m_strPatternPath;
+		return false;
+	}
+	return true;
+}
+
+/***************************************
+ * 使い方の文字列を取得.
+ ***************************************/
+std::string LifeGameOption::getUsage(const char* i_pProgram)
+{
+	std::ostringstream a_strStream;
+	a_strStream
+		<< "usage: " << i_pProgram << " [options]" << std::endl
+		<< "  -b, --batch            run without terminal (headless)" << std::endl
+		<< "  -s, --size WxH         board size (default: terminal size, 256x256 in batch mode)" << std::endl
+		<< "  -r, --rule RULE        rule such as B3/S23 (default: B3/S23)" << std::endl
+		<< "  -p, --pattern FILE     initial pattern (RLE or plain text), placed at the center" << std::endl
+		<< "  -g, --generations N    generations to run in batch mode (default: 1000)" << std::endl
+		<< "  -o, --output FILE      save the last generation as RLE (batch mode)" << std::endl
+		<< "      --record FILE      record every generation (batch mode)" << std::endl
+		<< "      --gif FILE         export an animated GIF (batch mode)" << std::endl
+		<< "      --gif-scale N      pixels per cell of the GIF (default: 1)" << std::endl
+		<< "      --image PATTERN    export generations as PNG/PPM, e.g. gen%06d.png (batch mode)" << std::endl
+		<< "      --image-every N    export every N generations (default: 1)" << std::endl
+		<< "      --image-scale N    pixels per cell of the images (default: 1)" << std::endl
+		<< "      --image-color MODE mono, age (cell age) or heat (trail of dead cells) (default: mono)" << std::endl
+		<< "      --soup DENSITY     fill the board at random with the density 0.0-1.0" << std::endl
+		<< "      --seed N           seed of the soup (default: current time)" << std::endl
+		<< "  -t, --threads N        threads used to fill the board and draw images (default: 1)" << std::endl
+		<< "      --gps N            target generations per second, 0 for unlimited (default: 10)" << std::endl
+		<< "      --fps N            target frames per second (default: 30)" << std::endl
+		<< "      --ansi             draw with raw ANSI escape sequences instead of curses" << std::endl
+		<< "      --hud              show the performance status line at start (toggle with 'd')" << std::endl
+		<< "      --history-mb N     memory for undo/rewind with 'u', 0 to disable (default: 64)" << std::endl
+		<< "      --serve PATH       run without terminal and accept requests on the Unix socket PATH" << std::endl
+		<< "      --profile N        print time per phase to stderr every N generations (batch/serve mode, make PROFILE=1)" << std::endl
+		<< "      --estimate-memory  print the memory the board would use (size, mode, --history-mb) and exit" << std::endl
+		<< "      --trace FILE       save a Chrome trace (chrome://tracing, Perfetto) of the run to FILE (make TRACE=1)" << std::endl
+		<< "  -h, --help             show this help" << std::endl;
+	return a_strStream.str();
+}
@@ -0,0 +1,386 @@
+/**
+ * @file    LifeGameOption.h
+ * @brief	ライフゲームのコマンドライン引数 クラス宣言.
+ */
+#ifndef __LIFEGAME_OPTION_H__
+#define __LIFEGAME_OPTION_H__
+
+#include <string>
+#include <stdint.h>
+
+#include "../Lib/LifeRule.h"
+#include "../Model/BitBoard.h"
+
+/**
+ * @brief   ライフゲームのコマンドライン引数.
+ * @note	main()で解析し, コントローラーへ渡す.
+ */
+class LifeGameOption
+{
+public:
+    /**
+     * @brief   コンストラクタ.(既定値を設定).
+     */
+    LifeGameOption()
+	{
+		this->m_bIsBatch = false;
+		this->m_bIsHelp = false;
+		this->m_bIsAnsi = false;
+		this->m_bIsHud = false;
+		this->m_bIsEstimateMemory = false;
+		this->m_bIsRuleSpecified = false;
+		this->m_lColMax = 0;
+		this->m_lRowMax = 0;
+		this->m_lGenerationNum = 1000;
+		this->m_iGifScale = 1;
+		this->m_lImageEvery = 1;
+		this->m_iImageScale = 1;
+		this->m_iImageColor = 0;
+		this->m_dSoupDensity = -1.0;
+		this->m_ulSeed = 0;
+		this->m_bIsSeedSpecified = false;
+		this->m_iThreadNum = 1;
+		this->m_dGenerationRate = 10.0;
+		this->m_dFrameRate = 30.0;
+		this->m_lHistoryMegaByte = 64;
+		this->m_lProfileEvery = 0;
+	}
+
+    /**
+     * @brief   コマンドライン引数を解析する.
+     * @param   int i_iArgc 引数の数.
+     * @param   char* i_ppArgv[] 引数.
+     * @return  成功/失敗.(失敗した場合はgetError()に理由が入る).
+     */
+    bool parse(int i_iArgc, char* i_ppArgv[]);
+
+    /**
+     * @brief   初期配置のパターンファイルを読み込む.
+     * @param   なし.
+     * @return  成功/失敗.(失敗した場合はgetError()に理由が入る).
+     * @note    規則が指定されていなければ, ファイルに書かれた規則を使う.
+     * @note    パターンファイルが指定されていなければ何もしない.
+     */
+    bool loadPattern();
+
+    /**
+     * @brief   使い方の文字列を取得.
+     * @param   const char* i_pProgram プログラム名.
+     * @return  使い方.
+     */
+    static std::string getUsage(const char* i_pProgram);
+
+    /**
+     * @brief   解析に失敗した理由を取得.
+     */
+    const std::string& getError() const { return this->m_strError; }
+
+    /**
+     * @brief   端末を使わずに実行するか否か.(-b, --batch).
+     */
+    bool isBatch() const { return this->m_bIsBatch; }
+
+    /**
+     * @brief   使い方を表示するか否か.(-h, --help).
+     */
+    bool isHelp() const { return this->m_bIsHelp; }
+
+    /**
+     * @brief   cursesを使わずANSIエスケープシーケンスで表示するか否か.(--ansi).
+     */
+    bool isAnsi() const { return this->m_bIsAnsi; }
+
+    /**
+     * @brief   性能表示(HUD)を最初から表示するか否か.(--hud).
+     */
+    bool isHud() const { return this->m_bIsHud; }
+
+    /**
+     * @brief   盤面を確保せずにメモリの使用量を見積もって終了するか否か.(--estimate-memory).
+     */
+    bool isEstimateMemory() const { return this->m_bIsEstimateMemory; }
+
+    /**
+     * @brief   セルの横最大幅.(-s, --size WxH. 0は未指定).
+     */
+    long getColMax() const { return this->m_lColMax; }
+
+    /**
+     * @brief   セルの縦最大幅.(-s, --size WxH. 0は未指定).
+     */
+    long getRowMax() const { return this->m_lRowMax; }
+
+    /**
+     * @brief   誕生/生存の規則.(-r, --rule B3/S23).
+     */
+    const LifeRule& getRule() const { return this->m_cRule; }
+
+    /**
+     * @brief   規則が指定されたか否か.(未指定ならばパターンファイルの規則を使う).
+     */
+    bool isRuleSpecified() const { return this->m_bIsRuleSpecified; }
+
+    /**
+     * @brief   初期配置のパターンファイル.(-p, --pattern FILE. 空は未指定).
+     */
+    const std::string& getPatternPath() const { return this->m_strPatternPath; }
+
+    /**
+     * @brief   初期配置のパターン.(loadPattern()で読み込む. 未指定ならば大きさ0).
+     */
+    const BitBoard& getPattern() const { return this->m_cPattern; }
+
+    /**
+     * @brief   実行する世代数.(-g, --generations N. 端末を使わない場合のみ).
+     */
+    long getGenerationNum() const { return this->m_lGenerationNum; }
+
+    /**
+     * @brief   最終世代をRLE形式で保存するファイル.(-o, --output FILE. 空は未指定).
+     */
+    const std::string& getOutputPath() const { return this->m_strOutputPath; }
+
+    /**
+     * @brief   世代を記録するファイル.(--record FILE. 空は未指定).
+     */
+    const std::string& getRecordPath() const { return this->m_strRecordPath; }
+
+    /**
+     * @brief   アニメーションGIFを書き出すファイル.(--gif FILE. 空は未指定).
+     */
+    const std::string& getGifPath() const { return this->m_strGifPath; }
+
+    /**
+     * @brief   アニメーションGIFの1セルあたりのピクセル数.(--gif-scale N).
+     */
+    int getGifScale() const { return this->m_iGifScale; }
+
+    /**
+     * @brief   世代の画像を書き出すファイル.(--image PATTERN. 空は未指定).
+     */
+    const std::string& getImagePath() const { return this->m_strImagePath; }
+
+    /**
+     * @brief   画像を書き出す世代の間隔.(--image-every N).
+     */
+    long getImageEvery() const { return this->m_lImageEvery; }
+
+    /**
+     * @brief   画像の1セルあたりのピクセル数.(--image-scale N).
+     */
+    int getImageScale() const { return this->m_iImageScale; }
+
+    /**
+     * @brief   画像の色付け.(--image-color mono|age|heat).
+     * @return  0:mono 1:age 2:heat.(LifeGameImageExporter::COLOR_MODEと同じ順).
+     */
+    int getImageColor() const { return this->m_iImageColor; }
+
+    /**
+     * @brief   ランダムな初期配置(スープ)を使うか否か.(--soup DENSITY).
+     */
+    bool isSoup() const { return 0.0 <= this->m_dSoupDensity; }
+
+    /**
+     * @brief   スープの密度.(--soup DENSITY. 0.0〜1.0).
+     */
+    double getSoupDensity() const { return this->m_dSoupDensity; }
+
+    /**
+     * @brief   スープのシード.(--seed N. 未指定ならば時刻から決める).
+     */
+    uint64_t getSeed() const { return this->m_ulSeed; }
+
+    /**
+     * @brief   スレッド数.(-t, --threads N).
+     */
+    int getThreadNum() const { return this->m_iThreadNum; }
+
+    /**
+     * @brief   1秒あたりに進める世代数の目標.(--gps N. 0は無制限).
+     */
+    double getGenerationRate() const { return this->m_dGenerationRate; }
+
+    /**
+     * @brief   1秒あたりに描画するフレーム数の目標.(--fps N).
+     */
+    double getFrameRate() const { return this->m_dFrameRate; }
+
+    /**
+     * @brief   巻き戻し用の履歴の容量.(--history-mb N. メガバイト. 0は履歴を取らない).
+     */
+    long getHistoryMegaByte() const { return this->m_lHistoryMegaByte; }
+
+    /**
+     * @brief   処理段階毎の時間と件数を出力する世代の間隔.(--profile N. 0は出力しない).
+     */
+    long getProfileEvery() const { return this->m_lProfileEvery; }
+
+    /**
+     * @brief   処理の区間を記録するファイル.(--trace FILE. 空は記録しない).
+     */
+    const std::string& getTracePath() const { return this->m_strTracePath; }
+
+    /**
+     * @brief   制御用のUnixドメインソケット.(--serve PATH. 空は未指定).
+     */
+    const std::string& getServePath() const { return this->m_strServePath; }
+
+private:
+    /**
+     * @brief   端末を使わずに実行するか否か.
+     */
+    bool m_bIsBatch;
+
+    /**
+     * @brief   使い方を表示するか否か.
+     */
+    bool m_bIsHelp;
+
+    /**
+     * @brief   ANSIエスケープシーケンスで表示するか否か.
+     */
+    bool m_bIsAnsi;
+
+    /**
+     * @brief   性能表示(HUD)を最初から表示するか否か.
+     */
+    bool m_bIsHud;
+
+    /**
+     * @brief   メモリの使用量を見積もって終了するか否か.
+     */
+    bool m_bIsEstimateMemory;
+
+    /**
+     * @brief   セルの横最大幅.
+     */
+    long m_lColMax;
+
+    /**
+     * @brief   セルの縦最大幅.
+     */
+    long m_lRowMax;
+
+    /**
+     * @brief   誕生/生存の規則.
+     */
+    LifeRule m_cRule;
+
+    /**
+     * @brief   規則が指定されたか否か.
+     */
+    bool m_bIsRuleSpecified;
+
+    /**
+     * @brief   初期配置のパターンファイル.
+     */
+    std::string m_strPatternPath;
+
+    /**
+     * @brief   初期配置のパターン.
+     */
+    BitBoard m_cPattern;
+
+    /**
+     * @brief   実行する世代数.
+     */
+    long m_lGenerationNum;
+
+    /**
+     * @brief   最終世代を保存するファイル.
+     */
+    std::string m_strOutputPath;
+
+    /**
+     * @brief   世代を記録するファイル.
+     */
+    std::string m_strRecordPath;
+
+    /**
+     * @brief   アニメーションGIFを書き出すファイル.
+     */
+    std::string m_strGifPath;
+
+    /**
+     * @brief   アニメーションGIFの1セルあたりのピクセル数.
+     */
+    int m_iGifScale;
+
+    /**
+     * @brief   世代の画像を書き出すファイル.
+     */
+    std::string m_strImagePath;
+
+    /**
+     * @brief   画像を書き出す世代の間隔.
+     */
+    long m_lImageEvery;
+
+    /**
+     * @brief   画像の1セルあたりのピクセル数.
+     */
+    int m_iImageScale;
+
+    /**
+     * @brief   画像の色付け.
+     */
+    int m_iImageColor;
+
+    /**
+     * @brief   スープの密度.(負ならば未指定).
+     */
+    double m_dSoupDensity;
+
+    /**
+     * @brief   スープのシード.
+     */
+    uint64_t m_ulSeed;
+
+    /**
+     * @brief   シードが指定されたか否か.
+     */
+    bool m_bIsSeedSpecified;
+
+    /**
+     * @brief   スレッド数.
+     */
+    int m_iThreadNum;
+
+    /**
+     * @brief   1秒あたりに進める世代数の目標.(0は無制限).
+     */
+    double m_dGenerationRate;
+
+    /**
+     * @brief   1秒あたりに描画するフレーム数の目標.
+     */
+    double m_dFrameRate;
+
+    /**
+     * @brief   巻き戻し用の履歴の容量.(メガバイト).
+     */
+    long m_lHistoryMegaByte;
+
+    /**
+     * @brief   処理段階毎の時間と件数を出力する世代の間隔.
+     */
+    long m_lProfileEvery;
+
+    /**
+     * @brief   処理の区間を記録するファイル.
+     */
+    std::string m_strTracePath;
+
+    /**
+     * @brief   制御用のUnixドメインソケット.
+     */
+    std::string m_strServePath;
+
+    /**
+     * @brief   解析に失敗した理由.
+     */
+    std::string m_strError;
+};
+
+#endif	// __LIFEGAME_OPTION_H__
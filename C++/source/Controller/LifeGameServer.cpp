@@ -0,0 +1,479 @@
+/**
+ * @file    LifeGameServer.cpp
+ * @brief   ライフゲームをUnixドメインソケットから操作するクラスの実装.
+ */
+
+#include "LifeGameServer.h"
+#include "LifeGameBatchController.h"
+#include "../Model/PatternFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+/*******************
+ * コンストラクタ.
+ *******************/
+LifeGameServer::LifeGameServer(const LifeGameOption& i_cOption)
+	: m_cOption(i_cOption)
+{
+	long a_lCol = (0 < i_cOption.getColMax())? i_cOption.getColMax() : static_cast<long>(LifeGameBatchController::DEFAULT_COL_MAX);
+	long a_lRow = (0 < i_cOption.getRowMax())? i_cOption.getRowMax() : static_cast<long>(LifeGameBatchController::DEFAULT_ROW_MAX);
+
+	// Modelを生成し, 初期配置を置く.
+	m_pcLifeGameModel = new MatrixCell(a_lCol, a_lRow);
+	m_pcLifeGameModel->setRule(i_cOption.getRule());
+	m_pcLifeGameModel->getProfiler().setDump(stderr, i_cOption.getProfileEvery());
+	LifeGameBatchController::placeInitialCells(m_pcLifeGameModel, i_cOption);
+
+	// 以降はModelをシミュレーション スレッドだけが触る.(要求された世代だけを最大速度で進める).
+	m_pcSimulator = new LifeGameSimulator(m_pcLifeGameModel, 0.0, 0.0);
+	m_pcSimulator->start();
+
+	m_iListenFd = -1;
+	m_lNextClientId = 0;
+	m_bIsWaiting = false;
+	m_lCommandNum = 0;
+	m_bIsQuit = false;
+}
+
+/*****************
+ * デストラクタ.
+ *****************/
+LifeGameServer::~LifeGameServer()
+{
+	while(!m_mapClient.empty()) this->disconnect(m_mapClient.begin()->first);
+	if(0 <= m_iListenFd)
+	{
+		close(m_iListenFd);
+		unlink(m_cOption.getServePath().c_str());
+	}
+	if(m_pcSimulator != 0) delete m_pcSimulator;
+	if(m_pcLifeGameModel != 0) delete m_pcLifeGameModel;
+}
+
+/***************************************
+ * OP_QUITを受け取るまで要求に応える.
+ ***************************************/
+bool LifeGameServer::run()
+{
+	const std::string& a_strPath = m_cOption.getServePath();
+	struct sockaddr_un a_stAddress;
+	memset(&a_stAddress, 0, sizeof(a_stAddress));
+	a_stAddress.sun_family = AF_UNIX;
+	if(sizeof(a_stAddress.sun_path) <= a_strPath.size())
+	{
+		fprintf(stderr, "socket path too long: %s\n", a_strPath.c_str());
+		return false;
+	}
+	strcpy(a_stAddress.sun_path, a_strPath.c_str());
+
+	// 前回のソケットが残っていれば消す.
+	unlink(a_strPath.c_str());
+	m_iListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if( (0 > m_iListenFd)
+	 || (0 != bind(m_iListenFd, reinterpret_cast<struct sockaddr*>(&a_stAddress), sizeof(a_stAddress)))
+	 || (0 != listen(m_iListenFd, SOMAXCONN)) )
+	{
+		fprintf(stderr, "cannot listen: %s (%s)\n", a_strPath.c_str(), strerror(errno));
+		return false;
+	}
+
+	std::vector<struct pollfd> a_vecPoll;
+	std::vector<long> a_vecClientId;
+	while(!m_bIsQuit)
+	{
+		// 待ち受け, 盤面の公開, 各クライアント.(送信待ちがあれば書き込み可能も待つ).
+		a_vecPoll.clear();
+		a_vecClientId.clear();
+		struct pollfd a_stPoll;
+		a_stPoll.fd = m_iListenFd;
+		a_stPoll.events = POLLIN;
+		a_vecPoll.push_back(a_stPoll);
+		a_stPoll.fd = m_pcSimulator->getPublishFd();
+		a_vecPoll.push_back(a_stPoll);
+		for(std::map<long, CLIENT>::iterator a_it=m_mapClient.begin(); a_it!=m_mapClient.end(); ++a_it)
+		{
+			a_stPoll.fd = a_it->second.m_iFd;
+			a_stPoll.events = a_it->second.m_strOutput.empty()? POLLIN : (POLLIN | POLLOUT);
+			a_vecPoll.push_back(a_stPoll);
+			a_vecClientId.push_back(a_it->first);
+		}
+		if(0 > poll(&a_vecPoll[0], a_vecPoll.size(), -1))
+		{
+			if(EINTR == errno) continue;
+			fprintf(stderr, "poll failed: %s\n", strerror(errno));
+			return false;
+		}
+
+		if(a_vecPoll[1].revents & POLLIN) this->receiveSnapshot();
+		if(a_vecPoll[0].revents & POLLIN) this->accept();
+		for(size_t a_lIndex=0; a_lIndex<a_vecClientId.size(); a_lIndex++)
+		{
+			short a_sEvent = a_vecPoll[a_lIndex + 2].revents;
+			std::map<long, CLIENT>::iterator a_it = m_mapClient.find(a_vecClientId[a_lIndex]);
+			if( (0 == a_sEvent) || (a_it == m_mapClient.end()) ) continue;
+
+			bool a_bIsAlive = true;
+			if(a_sEvent & POLLOUT) a_bIsAlive = this->flush(a_it->second);
+			if(a_bIsAlive && (a_sEvent & (POLLIN | POLLHUP | POLLERR))) a_bIsAlive = this->receive(a_it->first);
+			if(!a_bIsAlive) this->disconnect(a_vecClientId[a_lIndex]);
+		}
+		this->process();
+	}
+
+	// 終了の応答は送りきっている事が多いが, 残っていれば送れるだけ送る.
+	for(std::map<long, CLIENT>::iterator a_it=m_mapClient.begin(); a_it!=m_mapClient.end(); ++a_it)
+	{
+		this->flush(a_it->second);
+	}
+	return true;
+}
+
+/*****************************
+ * 新しい接続を受け付ける.
+ *****************************/
+void LifeGameServer::accept()
+{
+	while(true)
+	{
+		int a_iFd = accept4(m_iListenFd, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(0 > a_iFd) return;
+
+		CLIENT& a_stClient = m_mapClient[m_lNextClientId++];
+		a_stClient.m_iFd = a_iFd;
+		a_stClient.m_lReceived = 0;
+	}
+}
+
+/*****************************
+ * クライアントから受信する.
+ *****************************/
+bool LifeGameServer::receive(long i_lClientId)
+{
+	CLIENT& a_stClient = m_mapClient[i_lClientId];
+	const size_t a_lHeaderSize = sizeof(REQUEST);
+	while(true)
+	{
+		// ヘッダー, またはヘッダーで決めたデータの受信先へ直接読み込む.
+		PENDING& a_stPending = a_stClient.m_stReceiving;
+		char* a_pTarget = 0;
+		size_t a_lRemain = 0;
+		if(a_stClient.m_lReceived < a_lHeaderSize)
+		{
+			a_pTarget = reinterpret_cast<char*>(&a_stPending.m_stRequest) + a_stClient.m_lReceived;
+			a_lRemain = a_lHeaderSize - a_stClient.m_lReceived;
+		}
+		else
+		{
+			size_t a_lOffset = a_stClient.m_lReceived - a_lHeaderSize;
+			char* a_pData = (OP_SET == a_stPending.m_stRequest.m_uiOp)?
+				reinterpret_cast<char*>(a_stPending.m_cBoard.getRow(0)) : &a_stPending.m_strText[0];
+			a_pTarget = a_pData + a_lOffset;
+			a_lRemain = a_stPending.m_stRequest.m_ulLength - a_lOffset;
+		}
+
+		ssize_t a_lRead = read(a_stClient.m_iFd, a_pTarget, a_lRemain);
+		if(0 == a_lRead) return false;
+		if(0 > a_lRead) return (EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno);
+		a_stClient.m_lReceived += a_lRead;
+
+		if(a_stClient.m_lReceived == a_lHeaderSize)
+		{
+			a_stPending.m_lClientId = i_lClientId;
+			if(!this->prepare(a_stPending))
+			{
+				// 続くデータの区切りが分からないので切断する.
+				this->reply(a_stPending, STATUS_BAD_REQUEST);
+				return false;
+			}
+		}
+
+		// 要求を受信し終えたら実行待ちへ移す.(データのバッファはそのまま移る).
+		if( (a_lHeaderSize <= a_stClient.m_lReceived)
+		 && (a_stClient.m_lReceived == a_lHeaderSize + a_stPending.m_stRequest.m_ulLength) )
+		{
+			m_deqPending.push_back(std::move(a_stPending));
+			a_stClient.m_stReceiving = PENDING();
+			a_stClient.m_lReceived = 0;
+		}
+	}
+}
+
+/*****************************************
+ * 要求のデータの受信先を用意する.
+ *****************************************/
+bool LifeGameServer::prepare(PENDING& io_stPending)
+{
+	const REQUEST& a_stRequest = io_stPending.m_stRequest;
+	long a_lColMax = m_pcSimulator->getSnapshot().m_cBoard.getColMax();
+	long a_lRowMax = m_pcSimulator->getSnapshot().m_cBoard.getRowMax();
+	switch(a_stRequest.m_uiOp)
+	{
+	case OP_LOAD:
+		if( (0 == a_stRequest.m_ulLength) || (PATH_MAX_LENGTH < a_stRequest.m_ulLength) ) return false;
+		io_stPending.m_strText.resize(a_stRequest.m_ulLength);
+		return true;
+	case OP_SET:
+		// 矩形は盤面の中から始まり, 盤面より大きくないこと.(はみ出した部分は書き込まない).
+		if( (0 > a_stRequest.m_rglArg[0]) || (a_lColMax <= a_stRequest.m_rglArg[0])
+		 || (0 > a_stRequest.m_rglArg[1]) || (a_lRowMax <= a_stRequest.m_rglArg[1])
+		 || (0 >= a_stRequest.m_rglArg[2]) || (a_lColMax < a_stRequest.m_rglArg[2])
+		 || (0 >= a_stRequest.m_rglArg[3]) || (a_lRowMax < a_stRequest.m_rglArg[3])
+		 || (BitBoard::PASTE_REPLACE < a_stRequest.m_uiMode) ) return false;
+		io_stPending.m_cBoard.init(a_stRequest.m_rglArg[2], a_stRequest.m_rglArg[3]);
+		return a_stRequest.m_ulLength
+			== sizeof(BitBoard::WORD) * io_stPending.m_cBoard.getWordNum() * io_stPending.m_cBoard.getRowMax();
+	case OP_STEP:
+		return (0 == a_stRequest.m_ulLength) && (0 <= a_stRequest.m_rglArg[0]);
+	case OP_QUERY:
+		// 矩形は盤面の中から始まり, 盤面より大きくないこと.(はみ出した部分は返さない. 右端と下端の計算が溢れないように).
+		return (0 == a_stRequest.m_ulLength)
+			&& (0 <= a_stRequest.m_rglArg[0]) && (a_lColMax > a_stRequest.m_rglArg[0])
+			&& (0 <= a_stRequest.m_rglArg[1]) && (a_lRowMax > a_stRequest.m_rglArg[1])
+			&& (0 < a_stRequest.m_rglArg[2]) && (a_lColMax >= a_stRequest.m_rglArg[2])
+			&& (0 < a_stRequest.m_rglArg[3]) && (a_lRowMax >= a_stRequest.m_rglArg[3]);
+	case OP_STATS:
+	case OP_SNAPSHOT:
+	case OP_QUIT:
+		return (0 == a_stRequest.m_ulLength);
+	default:
+		return false;
+	}
+}
+
+/*****************************************
+ * 受信済みの要求を順に実行する.
+ *****************************************/
+void LifeGameServer::process()
+{
+	while(!m_bIsWaiting && !m_bIsQuit && !m_deqPending.empty())
+	{
+		PENDING a_stPending = std::move(m_deqPending.front());
+		m_deqPending.pop_front();
+		if(this->execute(a_stPending))
+		{
+			m_stWaiting = std::move(a_stPending);
+			m_bIsWaiting = true;
+		}
+	}
+}
+
+/*****************************
+ * 要求を1つ実行する.
+ *****************************/
+bool LifeGameServer::execute(PENDING& io_stPending)
+{
+	// 盤面の公開を待つ要求の後に実行するので, この盤面は前の要求までを反映している.
+	const LifeGameSimulator::SNAPSHOT& a_stSnapshot = m_pcSimulator->getSnapshot();
+	const REQUEST& a_stRequest = io_stPending.m_stRequest;
+	long a_lColMax = a_stSnapshot.m_cBoard.getColMax();
+	long a_lRowMax = a_stSnapshot.m_cBoard.getRowMax();
+
+	LifeGameSimulator::COMMAND a_stCommand;
+	switch(a_stRequest.m_uiOp)
+	{
+	case OP_LOAD:
+		{
+			// 規則はコマンドライン引数のまま.(パターンファイルの規則は使わない).
+			BitBoard a_cPattern;
+			if(!PatternFile::load(io_stPending.m_strText, a_cPattern))
+			{
+				this->reply(io_stPending, STATUS_NOT_FOUND);
+				return false;
+			}
+			a_stCommand.m_eType = LifeGameSimulator::CMD_PASTE;
+			a_stCommand.m_cBoard.init(a_lColMax, a_lRowMax);
+			a_stCommand.m_cBoard.paste(a_cPattern, (a_lColMax - a_cPattern.getColMax()) / 2, (a_lRowMax - a_cPattern.getRowMax()) / 2);
+			a_stCommand.m_ePasteMode = BitBoard::PASTE_REPLACE;
+		}
+		break;
+	case OP_STEP:
+		if(0 == a_stRequest.m_rglArg[0])
+		{
+			this->reply(io_stPending, STATUS_OK, a_stSnapshot.m_lGeneration, a_stSnapshot.m_lPopulation);
+			return false;
+		}
+		a_stCommand.m_eType = LifeGameSimulator::CMD_STEP;
+		a_stCommand.m_lCount = a_stRequest.m_rglArg[0];
+		break;
+	case OP_SET:
+		// 受信したバッファをそのままシミュレーション スレッドへ渡す.
+		a_stCommand.m_eType = LifeGameSimulator::CMD_PASTE;
+		a_stCommand.m_lCol = a_stRequest.m_rglArg[0];
+		a_stCommand.m_lRow = a_stRequest.m_rglArg[1];
+		a_stCommand.m_cBoard = std::move(io_stPending.m_cBoard);
+		a_stCommand.m_ePasteMode = static_cast<BitBoard::PASTE_MODE>(a_stRequest.m_uiMode);
+		break;
+	case OP_QUERY:
+		{
+			// 盤面に収まる部分だけを返す.(位置と大きさはprepare()で盤面の大きさ以下に限っている).
+			long a_lLeft = static_cast<long>(a_stRequest.m_rglArg[0]);
+			long a_lTop = static_cast<long>(a_stRequest.m_rglArg[1]);
+			long a_lRight = std::min(a_lColMax, a_lLeft + static_cast<long>(a_stRequest.m_rglArg[2]));
+			long a_lBottom = std::min(a_lRowMax, a_lTop + static_cast<long>(a_stRequest.m_rglArg[3]));
+			BitBoard a_cRegion;
+			a_cRegion.extract(a_stSnapshot.m_cBoard, a_lLeft, a_lTop, a_lRight - a_lLeft, a_lBottom - a_lTop);
+
+			RESPONSE a_stResponse = { STATUS_OK, a_stRequest.m_uiOp, 0, { a_lLeft, a_lTop, a_lRight - a_lLeft, a_lBottom - a_lTop } };
+			this->reply(io_stPending.m_lClientId, a_stResponse, a_cRegion.getRow(0),
+				sizeof(BitBoard::WORD) * a_cRegion.getWordNum() * a_cRegion.getRowMax());
+		}
+		return false;
+	case OP_STATS:
+		this->reply(io_stPending, STATUS_OK, a_stSnapshot.m_lGeneration, a_stSnapshot.m_lPopulation, a_lColMax, a_lRowMax);
+		return false;
+	case OP_SNAPSHOT:
+		{
+			// 盤面のバッファから直接送る.
+			RESPONSE a_stResponse = { STATUS_OK, a_stRequest.m_uiOp, 0,
+				{ a_stSnapshot.m_lGeneration, a_stSnapshot.m_lPopulation, a_lColMax, a_lRowMax } };
+			this->reply(io_stPending.m_lClientId, a_stResponse, a_stSnapshot.m_cBoard.getRow(0),
+				sizeof(BitBoard::WORD) * a_stSnapshot.m_cBoard.getWordNum() * a_lRowMax);
+		}
+		return false;
+	case OP_QUIT:
+		this->reply(io_stPending, STATUS_OK);
+		m_bIsQuit = true;
+		return false;
+	default:
+		this->reply(io_stPending, STATUS_BAD_REQUEST);
+		return false;
+	}
+
+	if(this->sendCommand(std::move(a_stCommand))) return true;
+	this->reply(io_stPending, STATUS_BUSY);
+	return false;
+}
+
+/*****************************************
+ * 公開された盤面を受け取り, 待っている要求に応答する.
+ *****************************************/
+void LifeGameServer::receiveSnapshot()
+{
+	m_pcSimulator->receive();
+
+	// 送ったコマンドが全て反映された盤面ならば応答する.
+	const LifeGameSimulator::SNAPSHOT& a_stSnapshot = m_pcSimulator->getSnapshot();
+	if(m_bIsWaiting && (m_lCommandNum <= a_stSnapshot.m_lCommandNum))
+	{
+		m_bIsWaiting = false;
+		this->reply(m_stWaiting, STATUS_OK, a_stSnapshot.m_lGeneration, a_stSnapshot.m_lPopulation);
+	}
+}
+
+/*****************************************
+ * シミュレーション スレッドへコマンドを送る.
+ *****************************************/
+bool LifeGameServer::sendCommand(LifeGameSimulator::COMMAND&& io_stCommand)
+{
+	if(!m_pcSimulator->send(std::move(io_stCommand))) return false;
+	m_lCommandNum++;
+	return true;
+}
+
+/*****************************
+ * 応答する.
+ *****************************/
+void LifeGameServer::reply(long i_lClientId, const RESPONSE& i_stResponse, const void* i_pData, size_t i_lLength)
+{
+	std::map<long, CLIENT>::iterator a_it = m_mapClient.find(i_lClientId);
+	if(a_it == m_mapClient.end()) return;
+	CLIENT& a_stClient = a_it->second;
+
+	// 受信しないクライアントの送信待ちは増やし続けない.
+	if(OUTPUT_MAX_SIZE < a_stClient.m_strOutput.size())
+	{
+		this->disconnect(i_lClientId);
+		return;
+	}
+
+	RESPONSE a_stResponse = i_stResponse;
+	a_stResponse.m_ulLength = i_lLength;
+	const char* a_pHeader = reinterpret_cast<const char*>(&a_stResponse);
+	const char* a_pData = static_cast<const char*>(i_pData);
+
+	// 前の応答が残っていれば, 順序を守るため後ろに付ける.
+	size_t a_lSent = 0;
+	if(a_stClient.m_strOutput.empty())
+	{
+		struct iovec a_rgstVector[2];
+		a_rgstVector[0].iov_base = const_cast<char*>(a_pHeader);
+		a_rgstVector[0].iov_len = sizeof(a_stResponse);
+		a_rgstVector[1].iov_base = const_cast<char*>(a_pData);
+		a_rgstVector[1].iov_len = i_lLength;
+		struct msghdr a_stMessage;
+		memset(&a_stMessage, 0, sizeof(a_stMessage));
+		a_stMessage.msg_iov = a_rgstVector;
+		a_stMessage.msg_iovlen = (0 < i_lLength)? 2 : 1;
+
+		ssize_t a_lResult = sendmsg(a_stClient.m_iFd, &a_stMessage, MSG_NOSIGNAL);
+		if( (0 > a_lResult) && (EAGAIN != errno) && (EWOULDBLOCK != errno) )
+		{
+			this->disconnect(i_lClientId);
+			return;
+		}
+		if(0 < a_lResult) a_lSent = a_lResult;
+	}
+
+	// 送りきれなかった分だけをコピーする.
+	if(a_lSent < sizeof(a_stResponse))
+	{
+		a_stClient.m_strOutput.append(a_pHeader + a_lSent, sizeof(a_stResponse) - a_lSent);
+		a_lSent = sizeof(a_stResponse);
+	}
+	if(a_lSent < sizeof(a_stResponse) + i_lLength)
+	{
+		size_t a_lOffset = a_lSent - sizeof(a_stResponse);
+		a_stClient.m_strOutput.append(a_pData + a_lOffset, i_lLength - a_lOffset);
+	}
+}
+
+/*****************************
+ * 結果だけを応答する.
+ *****************************/
+void LifeGameServer::reply(const PENDING& i_stPending, STATUS i_eStatus, long i_lValue0, long i_lValue1, long i_lValue2, long i_lValue3)
+{
+	RESPONSE a_stResponse = { static_cast<uint32_t>(i_eStatus), i_stPending.m_stRequest.m_uiOp, 0,
+		{ i_lValue0, i_lValue1, i_lValue2, i_lValue3 } };
+	this->reply(i_stPending.m_lClientId, a_stResponse);
+}
+
+/*****************************
+ * 送信待ちのデータを送る.
+ *****************************/
+bool LifeGameServer::flush(CLIENT& io_stClient)
+{
+	size_t a_lSent = 0;
+	while(a_lSent < io_stClient.m_strOutput.size())
+	{
+		ssize_t a_lResult = send(io_stClient.m_iFd, io_stClient.m_strOutput.data() + a_lSent,
+			io_stClient.m_strOutput.size() - a_lSent, MSG_NOSIGNAL);
+		if(0 > a_lResult)
+		{
+			if( (EAGAIN != errno) && (EWOULDBLOCK != errno) && (EINTR != errno) ) return false;
+			break;
+		}
+		a_lSent += a_lResult;
+	}
+	io_stClient.m_strOutput.erase(0, a_lSent);
+	return true;
+}
+
+/*****************************
+ * 切断する.
+ *****************************/
+void LifeGameServer::disconnect(long i_lClientId)
+{
+	std::map<long, CLIENT>::iterator a_it = m_mapClient.find(i_lClientId);
+	if(a_it == m_mapClient.end()) return;
+	close(a_it->second.m_iFd);
+	m_mapClient.erase(a_it);
+}
@@ -0,0 +1,276 @@
+/**
+ * @file    LifeGameServer.h
+ * @brief	ライフゲームをUnixドメインソケットから操作するサーバー クラス宣言.
+ */
+#ifndef __LIFEGAME_SERVER_H__
+#define __LIFEGAME_SERVER_H__
+
+#include "../Model/MatrixCell.h"
+#include "../Model/BitBoard.h"
+#include "LifeGameSimulator.h"
+#include "LifeGameOption.h"
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <string>
+
+/**
+ * @brief   ライフゲームをUnixドメインソケットから操作するサーバー クラス.(--serve PATH).
+ * @note	端末を使わず, 外部のツールからの要求(読み込み, 世代を進める, 範囲の取得, セルの一括設定, 状態, 盤面)に応える.
+ * @note	要求は固定長のヘッダー(REQUEST)と, m_ulLengthバイトのデータからなる.(応答も同じくRESPONSEとデータ).
+ *          数値はホストのバイト順.(同じマシン上のツールから使う前提).
+ *          セルのデータはBitBoardと同じ並び.(1行 = (横幅+63)/64個の64ビット整数, bit0が左端. 行は上から順).
+ * @note	ソケットは全てノンブロッキングで, poll()で待つ.(複数のクライアントが同時に接続し, 要求を続けて送ってよい).
+ *          要求は届いた順に1つずつ実行し, 応答は各クライアントへ要求の順に返す.
+ * @note	Modelはシミュレーション スレッド(LifeGameSimulator)が進める. 世代を進める要求は, 結果の盤面が公開されるまで待つ.
+ *          (待つ間も他のクライアントの受信と送信は止まらない).
+ * @note	セルの一括設定のデータは受信したバッファのまま(コピーせずに)シミュレーション スレッドへ渡し,
+ *          盤面と範囲の応答は盤面のバッファから直接送信する.(送りきれなかった分だけを送信待ちのバッファへコピーする).
+ * @note	受信しないまま要求を送り続けるクライアントでメモリが増え続けないよう,
+ *          送信待ちがOUTPUT_MAX_SIZEを超えているクライアントへ更に応答する時は切断する.
+ */
+class LifeGameServer
+{
+public:
+	/**
+	 * @brief	要求の種類.
+	 */
+	enum OPERATION {
+		OP_LOAD = 1,		// パターンファイル(データ = パス)を中央に置く.(盤面は置き換える).          応答: 世代, 生きているセル数.
+		OP_STEP,			// m_rglArg[0]世代進める.                                                   応答: 世代, 生きているセル数.
+		OP_QUERY,			// 矩形(m_rglArg[0..3] = 横位置, 縦位置, 横幅, 縦幅)のセルを取得する.(位置は盤面の中, 大きさは盤面以下). 応答: 盤面に収まる矩形, データ = セル.
+		OP_SET,				// 矩形(m_rglArg[0..3])へデータのセルを書き込む.(m_uiModeはBitBoard::PASTE_MODE). 応答: 世代, 生きているセル数.
+		OP_STATS,			// 状態を取得する.                                                          応答: 世代, 生きているセル数, 横幅, 縦幅.
+		OP_SNAPSHOT,		// 全セルを取得する.                                                        応答: 世代, 生きているセル数, 横幅, 縦幅, データ = セル.
+		OP_QUIT,			// サーバーを終了する.
+	};
+
+	/**
+	 * @brief	応答の結果.
+	 */
+	enum STATUS {
+		STATUS_OK = 0,			// 成功.
+		STATUS_BAD_REQUEST,		// 要求が正しくない.
+		STATUS_NOT_FOUND,		// パターンファイルを読み込めない.
+		STATUS_BUSY,			// シミュレーション スレッドへコマンドを送れない.
+	};
+
+	/**
+	 * @brief	要求のヘッダー.
+	 */
+	struct REQUEST
+	{
+		uint32_t m_uiOp;			// 要求の種類.(OPERATION).
+		uint32_t m_uiMode;			// 書き込み方法.(OP_SETのみ).
+		uint64_t m_ulLength;		// 続くデータの大きさ.(バイト).
+		int64_t m_rglArg[4];		// 引数.
+	};
+
+	/**
+	 * @brief	応答のヘッダー.
+	 */
+	struct RESPONSE
+	{
+		uint32_t m_uiStatus;		// 結果.(STATUS).
+		uint32_t m_uiOp;			// 要求の種類.
+		uint64_t m_ulLength;		// 続くデータの大きさ.(バイト).
+		int64_t m_rglValue[4];		// 結果の値.
+	};
+
+	/**
+	 * @brief	パスの最大長.(OP_LOADのデータ).
+	 */
+	enum { PATH_MAX_LENGTH = 4096 };
+
+	/**
+	 * @brief	クライアント毎の送信待ちの上限.(バイト).
+	 * @note	超えた状態で次の応答をすると切断する.(1つの応答はこれより大きくてもよい).
+	 */
+	enum { OUTPUT_MAX_SIZE = 64 * 1024 * 1024 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   const LifeGameOption& i_cOption コマンドライン引数.(loadPattern()済みであること).
+     * @note	初期配置(--soup, --pattern)を置き, シミュレーション スレッドを開始する.
+     */
+    LifeGameServer(const LifeGameOption& i_cOption);
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~LifeGameServer();
+
+	/**
+	 * @brief	ソケットを開き, OP_QUITを受け取るまで要求に応える.
+	 * @param	なし.
+	 * @return	成功/失敗.(失敗した場合は標準エラー出力に理由を出力する).
+	 */
+	bool run();
+
+private:
+	/**
+	 * @brief	受信した要求.
+	 */
+	struct PENDING
+	{
+		long m_lClientId;			// 送ってきたクライアント.
+		REQUEST m_stRequest;		// ヘッダー.
+		BitBoard m_cBoard;			// セル.(OP_SET).(受信したバッファをそのまま渡す).
+		std::string m_strText;		// パス.(OP_LOAD).
+	};
+
+	/**
+	 * @brief	接続中のクライアント.
+	 */
+	struct CLIENT
+	{
+		int m_iFd;					// ソケット.
+		PENDING m_stReceiving;		// 受信中の要求.
+		size_t m_lReceived;			// 受信中の要求の受信済みバイト数.(ヘッダーを含む).
+		std::string m_strOutput;	// 送信待ちのデータ.
+	};
+
+	/**
+	 * @brief	コマンドライン引数.
+	 */
+	const LifeGameOption&	m_cOption;
+
+	/**
+	 * @brief	LifeGame Model.(シミュレーション スレッドだけが触る).
+	 */
+	MatrixCell*				m_pcLifeGameModel;
+
+	/**
+	 * @brief	シミュレーション スレッド.
+	 */
+	LifeGameSimulator*		m_pcSimulator;
+
+	/**
+	 * @brief	待ち受けるソケット.
+	 */
+	int						m_iListenFd;
+
+	/**
+	 * @brief	接続中のクライアント.(キーは接続順の通し番号).
+	 */
+	std::map<long, CLIENT>	m_mapClient;
+
+	/**
+	 * @brief	次に接続したクライアントの通し番号.
+	 */
+	long					m_lNextClientId;
+
+	/**
+	 * @brief	実行を待つ要求.(届いた順).
+	 */
+	std::deque<PENDING>		m_deqPending;
+
+	/**
+	 * @brief	盤面の公開を待っている要求.(m_bIsWaitingの場合のみ有効).
+	 */
+	PENDING					m_stWaiting;
+
+	/**
+	 * @brief	盤面の公開を待っているか否か.
+	 */
+	bool					m_bIsWaiting;
+
+	/**
+	 * @brief	シミュレーション スレッドへ送ったコマンドの数.
+	 */
+	long					m_lCommandNum;
+
+	/**
+	 * @brief	OP_QUITを受け取ったか否か.
+	 */
+	bool					m_bIsQuit;
+
+	/**
+	 * @brief	新しい接続を受け付ける.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void accept();
+
+	/**
+	 * @brief	クライアントから受信する.
+	 * @param	long i_lClientId クライアント.
+	 * @return	接続を続けるか否か.
+	 * @note	データはヘッダーで決めたバッファ(BitBoard, 文字列)へ直接受信する.
+	 */
+	bool receive(long i_lClientId);
+
+	/**
+	 * @brief	ヘッダーを受信し終えた要求のデータの受信先を用意する.
+	 * @param	PENDING& io_stPending 要求.
+	 * @return	成功/失敗.(正しくない要求).
+	 */
+	bool prepare(PENDING& io_stPending);
+
+	/**
+	 * @brief	受信済みの要求を順に実行する.
+	 * @param	なし.
+	 * @return	なし.
+	 * @note	盤面の公開を待つ要求に当たったら, そこで止める.
+	 */
+	void process();
+
+	/**
+	 * @brief	要求を1つ実行する.
+	 * @param	PENDING& io_stPending 要求.
+	 * @return	盤面の公開を待つか否か.(待たない要求はここで応答する).
+	 */
+	bool execute(PENDING& io_stPending);
+
+	/**
+	 * @brief	シミュレーション スレッドが公開した盤面を受け取り, 待っている要求に応答する.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void receiveSnapshot();
+
+	/**
+	 * @brief	シミュレーション スレッドへコマンドを送る.
+	 * @param	LifeGameSimulator::COMMAND&& io_stCommand コマンド.
+	 * @return	成功/失敗.
+	 */
+	bool sendCommand(LifeGameSimulator::COMMAND&& io_stCommand);
+
+	/**
+	 * @brief	応答する.
+	 * @param	long i_lClientId クライアント.(切断済みならば何もしない).
+	 * @param	const RESPONSE& i_stResponse ヘッダー.(m_ulLengthはi_lLengthで上書きする).
+	 * @param	const void* i_pData データ.
+	 * @param	size_t i_lLength データの大きさ.(バイト).
+	 * @return	なし.
+	 * @note	ヘッダーとデータを1回のsendmsg()で送り, 送りきれなかった分だけを送信待ちのバッファへコピーする.
+	 * @note	送信待ちが既にOUTPUT_MAX_SIZEを超えていれば, 応答せずに切断する.
+	 */
+	void reply(long i_lClientId, const RESPONSE& i_stResponse, const void* i_pData=0, size_t i_lLength=0);
+
+	/**
+	 * @brief	結果だけを応答する.
+	 * @param	const PENDING& i_stPending 要求.
+	 * @param	STATUS i_eStatus 結果.
+	 * @param	long i_lValue0 〜 i_lValue3 結果の値.
+	 * @return	なし.
+	 */
+	void reply(const PENDING& i_stPending, STATUS i_eStatus, long i_lValue0=0, long i_lValue1=0, long i_lValue2=0, long i_lValue3=0);
+
+	/**
+	 * @brief	送信待ちのデータを送る.
+	 * @param	CLIENT& io_stClient クライアント.
+	 * @return	接続を続けるか否か.
+	 */
+	bool flush(CLIENT& io_stClient);
+
+	/**
+	 * @brief	切断する.
+	 * @param	long i_lClientId クライアント.
+	 * @return	なし.
+	 */
+	void disconnect(long i_lClientId);
+};
+
+#endif	// __LIFEGAME_SERVER_H__
@@ -0,0 +1,399 @@
+/**
+ * @file    LifeGameSimulator.cpp
+ * @brief   ライフゲームの世代を別スレッドで進めるクラスの実装.
+ */
+
+#include "LifeGameSimulator.h"
+#include "../Lib/Clock.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "../Lib/Tracer.h"
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+/*******************
+ * コンストラクタ.
+ *******************/
+LifeGameSimulator::LifeGameSimulator(MatrixCell* i_pcModel, double i_dGenerationRate, double i_dMaxLag, size_t i_lHistoryByte)
+	: m_cHistory(i_lHistoryByte), m_lStepRemain(0), m_lGenerationNum(0), m_dGenerationTime(0.0), m_lChangedNum(0)
+{
+	m_pcModel = i_pcModel;
+	m_dGenerationInterval = (0.0 < i_dGenerationRate)? 1.0 / i_dGenerationRate : 0.0;
+	m_dMaxLag = i_dMaxLag;
+	m_dNextGeneration = 0.0;
+	m_bIsRunning = false;
+	m_bIsDirty = false;
+	m_lCommandNum = 0;
+	m_bIsInterest = false;
+	m_lInterestCol = 0;
+	m_lInterestRow = 0;
+	m_lInterestWidth = m_pcModel->getColMax();
+	m_lInterestHeight = m_pcModel->getRowMax();
+
+	m_iWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	m_iPublishFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	// 最初の盤面はスレッドを開始する前に書き出す.(残りは空きバッファ).
+	m_pstFront = &m_rgstSnapshot[0];
+	m_pcModel->exportBitBoard(m_pstFront->m_cBoard);
+	m_pstFront->m_lRegionCol = 0;
+	m_pstFront->m_lRegionRow = 0;
+	m_pstFront->m_lRegionWidth = m_pcModel->getColMax();
+	m_pstFront->m_lRegionHeight = m_pcModel->getRowMax();
+	m_pstFront->m_lGeneration = m_pcModel->getGeneration();
+	m_pstFront->m_lPopulation = m_pcModel->getPopulation();
+	m_pstFront->m_lCommandNum = 0;
+	for(int a_iIndex=1; a_iIndex<SNAPSHOT_NUM; a_iIndex++)
+	{
+		m_cFreeQueue.push(&m_rgstSnapshot[a_iIndex]);
+	}
+
+	// 初期配置より前には戻らない.
+	if(0 < i_lHistoryByte) m_cHistory.start(m_pcModel);
+}
+
+/*****************
+ * デストラクタ.
+ *****************/
+LifeGameSimulator::~LifeGameSimulator()
+{
+	this->stop();
+	if(m_bIsInterest) m_pcModel->detach(&m_cInterestBoard);
+	if(0 <= m_iWakeFd) close(m_iWakeFd);
+	if(0 <= m_iPublishFd) close(m_iPublishFd);
+}
+
+/**************************************
+ * シミュレーション スレッドを開始する.
+ **************************************/
+bool LifeGameSimulator::start()
+{
+	if(m_cThread.joinable()) return false;
+	m_cThread = std::thread(&LifeGameSimulator::run, this);
+	return true;
+}
+
+/**************************************
+ * シミュレーション スレッドを終了する.
+ **************************************/
+void LifeGameSimulator::stop()
+{
+	if(!m_cThread.joinable()) return;
+
+	// 終了のコマンドは捨てられないので, キューが空くまで待つ.
+	while(!this->send(COMMAND(CMD_QUIT)))
+	{
+		std::this_thread::yield();
+	}
+	m_cThread.join();
+}
+
+/*****************************
+ * コマンドを送る.
+ *****************************/
+bool LifeGameSimulator::send(const COMMAND& i_stCommand)
+{
+	if(!m_cCommandQueue.push(i_stCommand)) return false;
+	notify(m_iWakeFd);
+	return true;
+}
+
+/*****************************
+ * コマンドを移動して送る.
+ *****************************/
+bool LifeGameSimulator::send(COMMAND&& io_stCommand)
+{
+	if(!m_cCommandQueue.push(std::move(io_stCommand))) return false;
+	notify(m_iWakeFd);
+	return true;
+}
+
+/*****************************************
+ * 公開された最新の盤面を受け取る.
+ *****************************************/
+bool LifeGameSimulator::receive()
+{
+	drain(m_iPublishFd);
+
+	// 途中の盤面は飛ばして最新の盤面だけを使う.
+	SNAPSHOT* a_pstSnapshot = 0;
+	bool a_bIsReceived = false;
+	while(m_cPublishQueue.pop(a_pstSnapshot))
+	{
+		m_cFreeQueue.push(m_pstFront);
+		m_pstFront = a_pstSnapshot;
+		a_bIsReceived = true;
+	}
+
+	// 空きバッファを待っているかもしれないので起こす.
+	if(a_bIsReceived) notify(m_iWakeFd);
+	return a_bIsReceived;
+}
+
+/**************************************
+ * シミュレーション スレッドの処理.
+ **************************************/
+void LifeGameSimulator::run()
+{
+	TRACE_THREAD_NAME("simulator");
+	while(true)
+	{
+		// 溜まったコマンドを順に実行する.
+		COMMAND a_stCommand;
+		bool a_bIsQuit = false;
+		while(!a_bIsQuit && m_cCommandQueue.pop(a_stCommand))
+		{
+			a_bIsQuit = (CMD_QUIT == a_stCommand.m_eType);
+			if(!a_bIsQuit) this->execute(a_stCommand);
+		}
+		if(a_bIsQuit) break;
+
+		// 時刻が来ていれば1世代だけ進める.(次のコマンドを待たせないため).
+		double a_dNow = getSecond();
+		if(m_bIsRunning && (m_dNextGeneration <= a_dNow))
+		{
+			this->step(true);
+			m_dNextGeneration += m_dGenerationInterval;
+
+			// 世代の更新が間に合わない場合は遅れを持ち越さない.
+			a_dNow = getSecond();
+			if(m_dNextGeneration < a_dNow - m_dMaxLag) m_dNextGeneration = a_dNow;
+		}
+		else if(0 < m_lStepRemain.load(std::memory_order_relaxed))
+		{
+			this->step(false);
+			m_lStepRemain.store(m_lStepRemain.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+		}
+
+		// 空きバッファがあれば最新の盤面を公開する.(コマ送りの途中は公開しない).
+		bool a_bIsStepping = (0 < m_lStepRemain.load(std::memory_order_relaxed));
+		if(m_bIsDirty && !a_bIsStepping && this->publish()) m_bIsDirty = false;
+
+		// 次に進める世代が無ければコマンドを待つ.
+		double a_dTimeout = -1.0;
+		if(a_bIsStepping) a_dTimeout = 0.0;
+		else if(m_bIsRunning) a_dTimeout = (m_dNextGeneration < a_dNow)? 0.0 : m_dNextGeneration - a_dNow;
+		if(0.0 != a_dTimeout) this->wait(a_dTimeout);
+	}
+}
+
+/*****************************
+ * コマンドを実行する.
+ *****************************/
+void LifeGameSimulator::execute(const COMMAND& i_stCommand)
+{
+	TRACE_SCOPE_VALUE("sim", "command", i_stCommand.m_eType);
+	const COMMAND& a_st = i_stCommand;
+	switch(a_st.m_eType)
+	{
+	case CMD_RUN:
+		if(!m_bIsRunning) m_dNextGeneration = getSecond();
+		m_bIsRunning = true;
+		m_lStepRemain.store(0, std::memory_order_relaxed);
+		break;
+	case CMD_PAUSE:
+		m_bIsRunning = false;
+		m_lStepRemain.store(0, std::memory_order_relaxed);
+		break;
+	case CMD_STEP:
+		m_bIsRunning = false;
+		if(0 < a_st.m_lCount) m_lStepRemain.store(m_lStepRemain.load(std::memory_order_relaxed) + a_st.m_lCount, std::memory_order_relaxed);
+		break;
+	case CMD_RUN_TO:
+		// 目標が過去の世代ならば何もしない.
+		m_bIsRunning = false;
+		m_lStepRemain.store((m_pcModel->getGeneration() < a_st.m_lCount)? a_st.m_lCount - m_pcModel->getGeneration() : 0, std::memory_order_relaxed);
+		break;
+	case CMD_SET_RATE:
+		m_dGenerationInterval = (0.0 < a_st.m_dRate)? 1.0 / a_st.m_dRate : 0.0;
+		m_dNextGeneration = getSecond();
+		break;
+	case CMD_TOGGLE_CELL:
+		{
+			if( (a_st.m_lCol < 0) || (m_pcModel->getColMax() <= a_st.m_lCol)
+			 || (a_st.m_lRow < 0) || (m_pcModel->getRowMax() <= a_st.m_lRow) ) break;
+
+			CellAttribute::CELL_STATE a_eState = m_pcModel->getCellState(a_st.m_lCol, a_st.m_lRow);
+			a_eState = (CellAttribute::ALIVE==a_eState)? CellAttribute::DEAD : CellAttribute::ALIVE;
+			m_pcModel->setCellState(a_st.m_lCol, a_st.m_lRow, a_eState);
+
+			// 記録中ならば編集も記録する.(setCellState()は通知しない).
+			MatrixCellAttribute a_cAttribute(a_st.m_lCol, a_st.m_lRow, a_eState);
+			if(m_cRecorder.isRecording()) m_cRecorder.update(&a_cAttribute);
+			if(m_cHistory.isRecording()) m_cHistory.update(&a_cAttribute);
+			if(m_bIsInterest) m_cInterestBoard.update(&a_cAttribute);
+		}
+		break;
+	// 矩形の編集はModelからの通知で記録される.
+	case CMD_FILL:            m_pcModel->fillRegion(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight); break;
+	case CMD_CLEAR:           m_pcModel->clearRegion(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight); break;
+	case CMD_INVERT:          m_pcModel->invertRegion(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight); break;
+	case CMD_PASTE:           m_pcModel->pasteRegion(a_st.m_cBoard, a_st.m_lCol, a_st.m_lRow, a_st.m_ePasteMode); break;
+	case CMD_ROTATE:          m_pcModel->rotateRegion(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight); break;
+	case CMD_FLIP_HORIZONTAL: m_pcModel->flipRegion(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight, true); break;
+	case CMD_FLIP_VERTICAL:   m_pcModel->flipRegion(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight, false); break;
+	case CMD_RECORD_START:
+		if(!m_cRecorder.isRecording()) m_cRecorder.start(m_pcModel);
+		break;
+	case CMD_RECORD_STOP:
+		if(m_cRecorder.isRecording())
+		{
+			m_cRecorder.stop();
+			m_cRecorder.getRecord().save(a_st.m_strPath);
+		}
+		break;
+	case CMD_REWIND:
+		// 巻き戻しは通知されないので, 記録中は記録と食い違わないように巻き戻さない.
+		if(m_cRecorder.isRecording()) break;
+		m_bIsRunning = false;
+		m_lStepRemain.store(0, std::memory_order_relaxed);
+		m_cHistory.rewind(a_st.m_lCount);
+
+		// 写しも通知されないので, 関心領域を送り直す.
+		if(m_bIsInterest) m_pcModel->setInterest(&m_cInterestBoard, m_lInterestCol, m_lInterestRow, m_lInterestWidth, m_lInterestHeight);
+		break;
+	case CMD_SET_INTEREST:
+		this->setInterest(a_st.m_lCol, a_st.m_lRow, a_st.m_lWidth, a_st.m_lHeight);
+		break;
+	default:
+		break;
+	}
+
+	// 編集は1回ごとに1件の履歴にする.
+	m_cHistory.commit();
+
+	// 盤面が変わらないコマンドも公開して構わない.(UIが再描画するだけ).
+	m_bIsDirty = true;
+	m_lCommandNum++;
+}
+
+/*****************************
+ * 1世代進める.
+ *****************************/
+void LifeGameSimulator::step(bool i_bIsRunning)
+{
+	TRACE_SCOPE("sim", "step");
+	double a_dStart = getSecond();
+	m_pcModel->refreshCell();
+	m_cRecorder.commit();
+	m_cHistory.commit();
+	m_bIsDirty = true;
+	if(!i_bIsRunning) return;
+
+	// 書き込むのはこのスレッドだけなので, 読んで足して書けばよい.
+	m_lGenerationNum.store(m_lGenerationNum.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	m_dGenerationTime.store(m_dGenerationTime.load(std::memory_order_relaxed) + getSecond() - a_dStart, std::memory_order_relaxed);
+	m_lChangedNum.store(m_lChangedNum.load(std::memory_order_relaxed) + m_pcModel->getChangedNum(), std::memory_order_relaxed);
+}
+
+/*****************************************
+ * 盤面をUIスレッドへ公開する.
+ *****************************************/
+bool LifeGameSimulator::publish()
+{
+	SNAPSHOT* a_pstSnapshot = 0;
+	if(!m_cFreeQueue.pop(a_pstSnapshot)) return false;
+	TRACE_SCOPE_VALUE("sim", "publish", m_pcModel->getGeneration());
+
+	// 関心領域を指定した場合は写しから関心領域の中だけを写す.
+	if(m_bIsInterest)
+	{
+		BitBoard& a_cBoard = a_pstSnapshot->m_cBoard;
+		if( (a_cBoard.getColMax() != m_pcModel->getColMax()) || (a_cBoard.getRowMax() != m_pcModel->getRowMax()) )
+		{
+			a_cBoard.init(m_pcModel->getColMax(), m_pcModel->getRowMax());
+		}
+		a_cBoard.copyRect(m_cInterestBoard.m_cBoard, m_lInterestCol, m_lInterestRow, m_lInterestWidth, m_lInterestHeight);
+	}
+	else
+	{
+		m_pcModel->exportBitBoard(a_pstSnapshot->m_cBoard);
+	}
+	a_pstSnapshot->m_lRegionCol = m_lInterestCol;
+	a_pstSnapshot->m_lRegionRow = m_lInterestRow;
+	a_pstSnapshot->m_lRegionWidth = m_lInterestWidth;
+	a_pstSnapshot->m_lRegionHeight = m_lInterestHeight;
+	a_pstSnapshot->m_lGeneration = m_pcModel->getGeneration();
+	a_pstSnapshot->m_lPopulation = m_pcModel->getPopulation();
+	a_pstSnapshot->m_lCommandNum = m_lCommandNum;
+
+	// バッファはSNAPSHOT_NUM個しか無いので満杯にはならない.
+	m_cPublishQueue.push(a_pstSnapshot);
+	notify(m_iPublishFd);
+	return true;
+}
+
+/*****************************************
+ * 関心領域を設定する.
+ *****************************************/
+void LifeGameSimulator::setInterest(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	// 盤面に収まるように切り詰める.(公開する盤面へ写す範囲にもなる).
+	long a_lColEnd = i_lCol + i_lWidth;
+	long a_lRowEnd = i_lRow + i_lHeight;
+	if(0 > i_lCol) i_lCol = 0;
+	if(0 > i_lRow) i_lRow = 0;
+	if(m_pcModel->getColMax() < a_lColEnd) a_lColEnd = m_pcModel->getColMax();
+	if(m_pcModel->getRowMax() < a_lRowEnd) a_lRowEnd = m_pcModel->getRowMax();
+	if( (a_lColEnd <= i_lCol) || (a_lRowEnd <= i_lRow) ) return;
+	m_lInterestCol = i_lCol;
+	m_lInterestRow = i_lRow;
+	m_lInterestWidth = a_lColEnd - i_lCol;
+	m_lInterestHeight = a_lRowEnd - i_lRow;
+
+	if(!m_bIsInterest)
+	{
+		m_cInterestBoard.m_cBoard.init(m_pcModel->getColMax(), m_pcModel->getRowMax());
+		m_pcModel->attach(&m_cInterestBoard, m_lInterestCol, m_lInterestRow, m_lInterestWidth, m_lInterestHeight);
+		m_bIsInterest = true;
+	}
+	else
+	{
+		m_pcModel->setInterest(&m_cInterestBoard, m_lInterestCol, m_lInterestRow, m_lInterestWidth, m_lInterestHeight);
+	}
+}
+
+/*****************************************
+ * コマンド, 返されたバッファ, または指定時間まで待つ.
+ *****************************************/
+void LifeGameSimulator::wait(double i_dTimeout)
+{
+	// 通知を読み捨てる前にキューを見直すので, 通知を取りこぼしても次の周回で拾える.
+	if(!m_cCommandQueue.empty()) return;
+	TRACE_SCOPE("sim", "wait");
+
+	struct pollfd a_stPoll;
+	a_stPoll.fd = m_iWakeFd;
+	a_stPoll.events = POLLIN;
+	if(i_dTimeout < 0.0)
+	{
+		ppoll(&a_stPoll, 1, 0, 0);
+	}
+	else
+	{
+		struct timespec a_stTimeout;
+		a_stTimeout.tv_sec = static_cast<time_t>(i_dTimeout);
+		a_stTimeout.tv_nsec = static_cast<long>((i_dTimeout - a_stTimeout.tv_sec) * 1000000000.0);
+		ppoll(&a_stPoll, 1, &a_stTimeout, 0);
+	}
+	drain(m_iWakeFd);
+}
+
+/*****************************
+ * eventfdへ通知する.
+ *****************************/
+void LifeGameSimulator::notify(int i_iFd)
+{
+	uint64_t a_ulValue = 1;
+	if(sizeof(a_ulValue) != write(i_iFd, &a_ulValue, sizeof(a_ulValue))) return;
+}
+
+/*****************************
+ * eventfdへの通知を読み捨てる.
+ *****************************/
+void LifeGameSimulator::drain(int i_iFd)
+{
+	uint64_t a_ulValue = 0;
+	if(sizeof(a_ulValue) != read(i_iFd, &a_ulValue, sizeof(a_ulValue))) return;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file    LifeGameSimulator.h
+ * @brief   ライフゲームの世代を別スレッドで進めるクラスの宣言.
+ */
+#ifndef __LIFEGAME_SIMULATOR_H__
+#define __LIFEGAME_SIMULATOR_H__
+
+#include "../Model/MatrixCell.h"
+#include "../Model/BitBoard.h"
+#include "../Model/GenerationRecorder.h"
+#include "../Model/GenerationHistory.h"
+#include "../Lib/Observer.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "../Lib/SpscQueue.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * @brief   ライフゲームの世代を別スレッド(シミュレーション スレッド)で進めるクラス.
+ * @note    start()した後はModelをシミュレーション スレッドだけが触る.
+ *          UIスレッドはコマンドをsend()で送り, 進んだ盤面をreceive()で受け取る.
+ * @note    コマンドも盤面もロックを使わないSPSCキューで受け渡す.
+ *              ・コマンド      UIスレッド → シミュレーション スレッド.
+ *              ・盤面          シミュレーション スレッド → UIスレッド.(SNAPSHOT_NUM個のバッファを使い回す).
+ *          空きバッファが無い間は盤面を書き出さない.(書き出すのはUIが受け取る頻度まで).
+ * @note    待つ時はeventfdをpoll()する.(UIスレッドはgetPublishFd()を自分のpoll()に加える).
+ * @note    CMD_STEP/CMD_RUN_TOで進める間は盤面を公開せず, 全て進めてから1回だけ公開する.
+ *          (何百万世代進めても盤面の書き出しと描画は1回で済む. 途中で止めるにはCMD_PAUSEを送る).
+ * @note    CMD_SET_INTEREST で見えている範囲(関心領域)を指定すると, Modelへ関心領域を指定して登録し,
+ *          関心領域内の変化だけを受け取る. 公開する盤面も関心領域の中だけを書き出す.(外は古いまま).
+ *          指定しない場合は盤面全体を書き出す.(LifeGameServerなど).
+ */
+class LifeGameSimulator
+{
+public:
+    /**
+     * @brief   コマンドの種類.
+     */
+    enum COMMAND_TYPE {
+        CMD_RUN,                // 実行開始.
+        CMD_PAUSE,              // 実行停止.
+        CMD_STEP,               // m_lCount世代だけ進める.(実行は止める).
+        CMD_RUN_TO,             // m_lCount世代目まで進める.(実行は止める).
+        CMD_SET_RATE,           // 世代を進める速度をm_dRate(世代/秒)にする.(0は無制限).
+        CMD_TOGGLE_CELL,        // (m_lCol,m_lRow)のセルの 生/死 を反転する.
+        CMD_FILL,               // 矩形の全セルを"生"にする.
+        CMD_CLEAR,              // 矩形の全セルを"死"にする.
+        CMD_INVERT,             // 矩形の全セルの 生/死 を反転する.
+        CMD_PASTE,              // m_cBoardを(m_lCol,m_lRow)へm_ePasteModeで貼り付ける.
+        CMD_ROTATE,             // 矩形を時計回りに90度回転する.
+        CMD_FLIP_HORIZONTAL,    // 矩形を左右反転する.
+        CMD_FLIP_VERTICAL,      // 矩形を上下反転する.
+        CMD_RECORD_START,       // 世代の記録を開始する.
+        CMD_RECORD_STOP,        // 世代の記録を停止し, m_strPathへ保存する.
+        CMD_REWIND,             // 履歴をm_lCount件(世代または編集)巻き戻す.(実行は止める. 記録中は何もしない).
+        CMD_SET_INTEREST,       // 公開する盤面を矩形(関心領域)の中だけにする.(盤面からはみ出す部分は切り詰める).
+        CMD_QUIT,               // スレッドを終了する.
+    };
+
+    /**
+     * @brief   コマンド.(使わないメンバーは無視する).
+     */
+    struct COMMAND
+    {
+        COMMAND_TYPE m_eType;
+        long m_lCol;                        // 横位置.(左端).
+        long m_lRow;                        // 縦位置.(上端).
+        long m_lWidth;                      // 横幅.
+        long m_lHeight;                     // 縦幅.
+        long m_lCount;                      // 世代数.
+        double m_dRate;                     // 速度.(世代/秒).
+        BitBoard m_cBoard;                  // 貼り付けるセル.
+        BitBoard::PASTE_MODE m_ePasteMode;  // 貼り付け方法.
+        std::string m_strPath;              // 保存先.
+
+        COMMAND(COMMAND_TYPE i_eType = CMD_PAUSE)
+            : m_eType(i_eType), m_lCol(0), m_lRow(0), m_lWidth(0), m_lHeight(0), m_lCount(0), m_dRate(0.0),
+              m_ePasteMode(BitBoard::PASTE_REPLACE) { }
+    };
+
+    /**
+     * @brief   UIスレッドへ渡す盤面.
+     */
+    struct SNAPSHOT
+    {
+        BitBoard m_cBoard;      // 全セルの状態.(盤面全体の大きさ. 関心領域を指定した場合は, 関心領域の外は古い).
+        long m_lRegionCol;      // m_cBoardのうち最新の矩形.(関心領域を指定しない場合は盤面全体).
+        long m_lRegionRow;
+        long m_lRegionWidth;
+        long m_lRegionHeight;
+        long m_lGeneration;     // 世代.
+        long m_lPopulation;     // 生きているセルの数.
+        long m_lCommandNum;     // 書き出すまでに実行したコマンドの数.(送ったコマンドの結果が反映されたかを知るため).
+    };
+
+    /**
+     * @brief   盤面のバッファの数.(UIが表示中の1個 + 受け渡し中).
+     */
+    enum { SNAPSHOT_NUM = 3 };
+
+    /**
+     * @brief   コマンドキューの容量.
+     */
+    enum { COMMAND_QUEUE_SIZE = 256 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   MatrixCell* i_pcModel Model.(初期配置済みであること. 所有権は移らない).
+     * @param   double i_dGenerationRate 世代を進める速度.(世代/秒).(0は無制限).
+     * @param   double i_dMaxLag 世代の更新が間に合わない場合に持ち越す遅れの上限.(秒).
+     * @param   size_t i_lHistoryByte 巻き戻し用の履歴の容量.(バイト).(0は履歴を取らない).
+     * @note    現在の盤面をgetSnapshot()で見られる状態にする. スレッドはstart()で開始する.
+     */
+    LifeGameSimulator(MatrixCell* i_pcModel, double i_dGenerationRate, double i_dMaxLag, size_t i_lHistoryByte=0);
+
+    /**
+     * @brief   デストラクタ.
+     * @note    スレッドを終了させる.(送ったコマンドは全て実行してから終了する).
+     * @note    関心領域を指定していればModelから登録解除する.(Modelはこのクラスより後に破棄すること).
+     */
+    virtual ~LifeGameSimulator();
+
+    /**
+     * @brief   シミュレーション スレッドを開始する.
+     * @param   なし.
+     * @return  成功/失敗.
+     */
+    bool start();
+
+    /**
+     * @brief   シミュレーション スレッドを終了する.
+     * @param   なし.
+     * @return  なし.
+     * @note    送ったコマンドは全て実行してから終了する. 終了後はModelを触ってよい.
+     */
+    void stop();
+
+    /**
+     * @brief   コマンドを送る.(UIスレッド).
+     * @param   const COMMAND& i_stCommand コマンド.
+     * @return  成功/失敗.(キューが満杯の場合は失敗).
+     * @note    待たずに戻る. 結果は盤面としてreceive()で受け取る.
+     */
+    bool send(const COMMAND& i_stCommand);
+
+    /**
+     * @brief   コマンドを移動して送る.(UIスレッド).
+     * @param   COMMAND&& io_stCommand コマンド.(成功した場合のみ移動する).
+     * @return  成功/失敗.(キューが満杯の場合は失敗).
+     * @note    貼り付けるセル(m_cBoard)をコピーせずにシミュレーション スレッドへ渡す.
+     */
+    bool send(COMMAND&& io_stCommand);
+
+    /**
+     * @brief   公開された最新の盤面を受け取る.(UIスレッド).
+     * @param   なし.
+     * @return  新しい盤面を受け取ったか否か.
+     * @note    受け取った盤面はgetSnapshot()で参照する. 古い盤面のバッファはシミュレーション スレッドへ返す.
+     */
+    bool receive();
+
+    /**
+     * @brief   最後に受け取った盤面.(UIスレッド).
+     * @note    次のreceive()まで有効. UIスレッドが書き換えてもよい.(次の盤面で上書きされる).
+     */
+    SNAPSHOT& getSnapshot() { return *this->m_pstFront; }
+
+    /**
+     * @brief   盤面が公開された事を知らせるファイルディスクリプタ.(eventfd).
+     * @note    poll()で読み込み可能になったらreceive()を呼ぶ.
+     */
+    int getPublishFd() const { return this->m_iPublishFd; }
+
+    /**
+     * @brief   CMD_STEP/CMD_RUN_TOで進める残りの世代数.
+     * @note    0になった後に最後の盤面が公開される.
+     */
+    long getStepRemain() const { return this->m_lStepRemain.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   実行中に進めた世代の数.
+     */
+    long getGenerationNum() const { return this->m_lGenerationNum.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   実行中に世代を進めた処理時間の合計.(秒).
+     */
+    double getGenerationTime() const { return this->m_dGenerationTime.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   実行中に状態が変化したセルの数の合計.
+     */
+    long getChangedNum() const { return this->m_lChangedNum.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief   シミュレーション スレッドの処理.
+     * @param   なし.
+     * @return  なし.
+     */
+    void run();
+
+    /**
+     * @brief   コマンドを実行する.(シミュレーション スレッド).
+     * @param   const COMMAND& i_stCommand コマンド.
+     * @return  なし.
+     */
+    void execute(const COMMAND& i_stCommand);
+
+    /**
+     * @brief   1世代進める.(シミュレーション スレッド).
+     * @param   bool i_bIsRunning 実行中か否か.(実行中の世代だけを計測値に数える).
+     * @return  なし.
+     */
+    void step(bool i_bIsRunning);
+
+    /**
+     * @brief   盤面を空きバッファへ書き出してUIスレッドへ公開する.(シミュレーション スレッド).
+     * @param   なし.
+     * @return  公開できたか否か.(空きバッファが無い場合は失敗).
+     */
+    bool publish();
+
+    /**
+     * @brief   コマンド, 返されたバッファ, または指定時間まで待つ.(シミュレーション スレッド).
+     * @param   double i_dTimeout 待つ時間.(秒).(負は無期限).
+     * @return  なし.
+     */
+    void wait(double i_dTimeout);
+
+    /**
+     * @brief   関心領域を設定する.(シミュレーション スレッド).
+     * @param   long i_lCol 〜 long i_lHeight 関心領域.(盤面の座標).
+     * @return  なし.
+     * @note    最初はModelへ登録し, 以降は関心領域だけを変える.(どちらも関心領域内の全セルが写しへ届く).
+     */
+    void setInterest(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   eventfdへ通知する.
+     * @param   int i_iFd eventfd.
+     * @return  なし.
+     */
+    static void notify(int i_iFd);
+
+    /**
+     * @brief   eventfdへの通知を読み捨てる.
+     * @param   int i_iFd eventfd.
+     * @return  なし.
+     */
+    static void drain(int i_iFd);
+
+    /**
+     * @brief   LifeGame Model.(start()の後はシミュレーション スレッドだけが触る).
+     */
+    MatrixCell* m_pcModel;
+
+    /**
+     * @brief   世代の記録.(シミュレーション スレッドだけが触る).
+     */
+    GenerationRecorder m_cRecorder;
+
+    /**
+     * @brief   巻き戻し用の履歴.(シミュレーション スレッドだけが触る).
+     */
+    GenerationHistory m_cHistory;
+
+    /**
+     * @brief   関心領域の盤面の写し.(Modelから関心領域内の変化だけを受け取る).
+     */
+    class InterestBoard : public Observer<MatrixCellAttribute>
+    {
+    public:
+        BitBoard m_cBoard;      // 盤面全体の大きさ.(関心領域の外は古い).
+
+        bool update(const MatrixCellAttribute* i_pcAttribute)
+        {
+            i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+            {
+                this->m_cBoard.setBit(i_lCol, i_lRow, CellAttribute::ALIVE == i_eState);
+            });
+            return true;
+        }
+    };
+
+    /**
+     * @brief   関心領域の盤面の写し.(シミュレーション スレッドだけが触る).
+     */
+    InterestBoard m_cInterestBoard;
+
+    /**
+     * @brief   関心領域を指定したか否か.(シミュレーション スレッド).
+     */
+    bool m_bIsInterest;
+
+    /**
+     * @brief   関心領域.(盤面に収まるように切り詰めたもの).(シミュレーション スレッド).
+     */
+    long m_lInterestCol;
+    long m_lInterestRow;
+    long m_lInterestWidth;
+    long m_lInterestHeight;
+
+    /**
+     * @brief   盤面のバッファ.
+     */
+    SNAPSHOT m_rgstSnapshot[SNAPSHOT_NUM];
+
+    /**
+     * @brief   UIスレッドが表示中の盤面.
+     */
+    SNAPSHOT* m_pstFront;
+
+    /**
+     * @brief   コマンドキュー.(UIスレッド → シミュレーション スレッド).
+     */
+    SpscQueue<COMMAND, COMMAND_QUEUE_SIZE> m_cCommandQueue;
+
+    /**
+     * @brief   公開した盤面.(シミュレーション スレッド → UIスレッド).
+     */
+    SpscQueue<SNAPSHOT*, SNAPSHOT_NUM> m_cPublishQueue;
+
+    /**
+     * @brief   空きバッファ.(UIスレッド → シミュレーション スレッド).
+     */
+    SpscQueue<SNAPSHOT*, SNAPSHOT_NUM> m_cFreeQueue;
+
+    /**
+     * @brief   シミュレーション スレッドを起こすeventfd.(コマンド, 空きバッファ).
+     */
+    int m_iWakeFd;
+
+    /**
+     * @brief   盤面を公開した事を知らせるeventfd.
+     */
+    int m_iPublishFd;
+
+    /**
+     * @brief   シミュレーション スレッド.
+     */
+    std::thread m_cThread;
+
+    /**
+     * @brief   世代を進める間隔.(秒).(0は無制限).(シミュレーション スレッド).
+     */
+    double m_dGenerationInterval;
+
+    /**
+     * @brief   持ち越す遅れの上限.(秒).
+     */
+    double m_dMaxLag;
+
+    /**
+     * @brief   次の世代を進める時刻.(シミュレーション スレッド).
+     */
+    double m_dNextGeneration;
+
+    /**
+     * @brief   実行中か否か.(シミュレーション スレッド).
+     */
+    bool m_bIsRunning;
+
+    /**
+     * @brief   CMD_STEP/CMD_RUN_TOで進める残りの世代数.(書き込むのはシミュレーション スレッドだけ).
+     */
+    std::atomic<long> m_lStepRemain;
+
+    /**
+     * @brief   公開していない変化があるか否か.(シミュレーション スレッド).
+     */
+    bool m_bIsDirty;
+
+    /**
+     * @brief   実行したコマンドの数.(シミュレーション スレッド).
+     */
+    long m_lCommandNum;
+
+    /**
+     * @brief   実行中に進めた世代の数.
+     */
+    std::atomic<long> m_lGenerationNum;
+
+    /**
+     * @brief   実行中に世代を進めた処理時間の合計.(秒).
+     */
+    std::atomic<double> m_dGenerationTime;
+
+    /**
+     * @brief   実行中に状態が変化したセルの数の合計.
+     */
+    std::atomic<long> m_lChangedNum;
+};
+
+#endif	// __LIFEGAME_SIMULATOR_H__
@@ -0,0 +1,371 @@
+/*********************************************************
+ * LifeGameServerクラスのユニットテスト
+ *********************************************************/
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../LifeGameServer.h"
+#include "../LifeGameOption.h"
+#include "../../Model/MatrixCell.h"
+#include "../../Model/BitBoard.h"
+#include "../../Model/SoupGenerator.h"
+
+using namespace std;
+
+static const char* SOCKET_PATH = "test_LifeGameServer.sock";
+static const char* PATTERN_PATH = "test_LifeGameServer.rle";
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+double get_second()
+{
+	struct timeval a_stTime;
+	gettimeofday(&a_stTime, 0);
+	return a_stTime.tv_sec + a_stTime.tv_usec / 1000000.0;
+}
+
+// サーバーへ接続する.(ソケットができるまで最大2秒待つ).
+int connect_server()
+{
+	struct sockaddr_un a_stAddress;
+	memset(&a_stAddress, 0, sizeof(a_stAddress));
+	a_stAddress.sun_family = AF_UNIX;
+	strcpy(a_stAddress.sun_path, SOCKET_PATH);
+
+	double a_dEnd = get_second() + 2.0;
+	while(get_second() < a_dEnd)
+	{
+		int a_iFd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if(0 == connect(a_iFd, reinterpret_cast<struct sockaddr*>(&a_stAddress), sizeof(a_stAddress))) return a_iFd;
+		close(a_iFd);
+		usleep(10000);
+	}
+	return -1;
+}
+
+bool write_all(int i_iFd, const void* i_pData, size_t i_lLength)
+{
+	const char* a_pData = static_cast<const char*>(i_pData);
+	while(0 < i_lLength)
+	{
+		ssize_t a_lResult = write(i_iFd, a_pData, i_lLength);
+		if(0 >= a_lResult) return false;
+		a_pData += a_lResult;
+		i_lLength -= a_lResult;
+	}
+	return true;
+}
+
+bool read_all(int i_iFd, void* o_pData, size_t i_lLength)
+{
+	char* a_pData = static_cast<char*>(o_pData);
+	while(0 < i_lLength)
+	{
+		ssize_t a_lResult = read(i_iFd, a_pData, i_lLength);
+		if(0 >= a_lResult) return false;
+		a_pData += a_lResult;
+		i_lLength -= a_lResult;
+	}
+	return true;
+}
+
+// 要求を送る.
+bool send_request(int i_iFd, uint32_t i_uiOp, long i_lArg0=0, long i_lArg1=0, long i_lArg2=0, long i_lArg3=0,
+	const void* i_pData=0, size_t i_lLength=0, uint32_t i_uiMode=0)
+{
+	LifeGameServer::REQUEST a_stRequest = { i_uiOp, i_uiMode, i_lLength, { i_lArg0, i_lArg1, i_lArg2, i_lArg3 } };
+	return write_all(i_iFd, &a_stRequest, sizeof(a_stRequest)) && write_all(i_iFd, i_pData, i_lLength);
+}
+
+// 応答を受け取る.(データはセルとしてo_pcBoardへ読み込む).
+bool recv_response(int i_iFd, LifeGameServer::RESPONSE& o_stResponse, BitBoard* o_pcBoard=0)
+{
+	if(!read_all(i_iFd, &o_stResponse, sizeof(o_stResponse))) return false;
+	if(0 == o_stResponse.m_ulLength) return true;
+	if(0 == o_pcBoard) return false;
+
+	// 範囲の応答は(横位置, 縦位置, 横幅, 縦幅), 盤面の応答は(世代, セル数, 横幅, 縦幅).
+	o_pcBoard->init(o_stResponse.m_rglValue[2], o_stResponse.m_rglValue[3]);
+	if(o_stResponse.m_ulLength != sizeof(BitBoard::WORD) * o_pcBoard->getWordNum() * o_pcBoard->getRowMax()) return false;
+	return read_all(i_iFd, o_pcBoard->getRow(0), o_stResponse.m_ulLength);
+}
+
+// 一括設定, 世代を進める, 盤面の取得をテスト.(手元のMatrixCellと比べる).
+bool test_server_set_step_snapshot(int i_iFd, MatrixCell& io_cExpected)
+{
+	BitBoard a_cSoup(128, 96);
+	SoupGenerator(7, 0.35).generate(a_cSoup, 1);
+	io_cExpected.importBitBoard(a_cSoup);
+	for(int a_iGeneration=0; a_iGeneration<30; a_iGeneration++) io_cExpected.refreshCell();
+	BitBoard a_cExpectedBoard;
+	io_cExpected.exportBitBoard(a_cExpectedBoard);
+
+	LifeGameServer::RESPONSE a_stResponse;
+	bool a_bIsSuccess = send_request(i_iFd, LifeGameServer::OP_SET, 0, 0, 128, 96,
+		a_cSoup.getRow(0), sizeof(BitBoard::WORD) * a_cSoup.getWordNum() * 96, BitBoard::PASTE_REPLACE)
+		&& recv_response(i_iFd, a_stResponse);
+	a_bIsSuccess = a_bIsSuccess && (LifeGameServer::STATUS_OK == a_stResponse.m_uiStatus) && (a_cSoup.count() == a_stResponse.m_rglValue[1]);
+
+	a_bIsSuccess = a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_STEP, 30) && recv_response(i_iFd, a_stResponse);
+	a_bIsSuccess = a_bIsSuccess && (30 == a_stResponse.m_rglValue[0]) && (a_cExpectedBoard.count() == a_stResponse.m_rglValue[1]);
+
+	BitBoard a_cBoard;
+	a_bIsSuccess = a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_SNAPSHOT) && recv_response(i_iFd, a_stResponse, &a_cBoard);
+	return a_bIsSuccess && (30 == a_stResponse.m_rglValue[0]) && (a_cBoard == a_cExpectedBoard);
+}
+
+// 範囲の取得と, 範囲への書き込み(XOR)をテスト.
+bool test_server_query(int i_iFd, MatrixCell& io_cExpected)
+{
+	BitBoard a_cExpectedBoard;
+	io_cExpected.exportBitBoard(a_cExpectedBoard);
+
+	// はみ出した範囲は盤面に収まる部分だけを返す.
+	LifeGameServer::RESPONSE a_stResponse;
+	BitBoard a_cRegion;
+	BitBoard a_cExpectedRegion;
+	a_cExpectedRegion.extract(a_cExpectedBoard, 100, 90, 28, 6);
+	bool a_bIsSuccess = send_request(i_iFd, LifeGameServer::OP_QUERY, 100, 90, 50, 20) && recv_response(i_iFd, a_stResponse, &a_cRegion);
+	a_bIsSuccess = a_bIsSuccess && (100 == a_stResponse.m_rglValue[0]) && (90 == a_stResponse.m_rglValue[1]);
+	a_bIsSuccess = a_bIsSuccess && (a_cRegion == a_cExpectedRegion);
+
+	// 70x10の矩形を反転する.(ワードの境界を跨ぐ).
+	BitBoard a_cMask(70, 10);
+	a_cMask.fillRect(0, 0, 70, 10, true);
+	a_bIsSuccess = a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_SET, 30, 40, 70, 10,
+		a_cMask.getRow(0), sizeof(BitBoard::WORD) * a_cMask.getWordNum() * 10, BitBoard::PASTE_XOR)
+		&& recv_response(i_iFd, a_stResponse);
+	io_cExpected.invertRegion(30, 40, 70, 10);
+	io_cExpected.exportBitBoard(a_cExpectedBoard);
+	a_cExpectedRegion.extract(a_cExpectedBoard, 20, 35, 90, 20);
+	a_bIsSuccess = a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_QUERY, 20, 35, 90, 20) && recv_response(i_iFd, a_stResponse, &a_cRegion);
+	return a_bIsSuccess && (a_cRegion == a_cExpectedRegion);
+}
+
+// パターンファイルの読み込みと状態の取得をテスト.
+bool test_server_load(int i_iFd)
+{
+	// グライダー.
+	FILE* a_pFile = fopen(PATTERN_PATH, "w");
+	if(0 == a_pFile) return false;
+	fputs("x = 3, y = 3, rule = B3/S23\nbo$2bo$3o!\n", a_pFile);
+	fclose(a_pFile);
+
+	LifeGameServer::RESPONSE a_stResponse;
+	bool a_bIsSuccess = send_request(i_iFd, LifeGameServer::OP_LOAD, 0, 0, 0, 0, PATTERN_PATH, strlen(PATTERN_PATH))
+		&& recv_response(i_iFd, a_stResponse);
+	remove(PATTERN_PATH);
+	a_bIsSuccess = a_bIsSuccess && (LifeGameServer::STATUS_OK == a_stResponse.m_uiStatus) && (5 == a_stResponse.m_rglValue[1]);
+
+	a_bIsSuccess = a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_STATS) && recv_response(i_iFd, a_stResponse);
+	a_bIsSuccess = a_bIsSuccess && (30 == a_stResponse.m_rglValue[0]) && (5 == a_stResponse.m_rglValue[1])
+		&& (128 == a_stResponse.m_rglValue[2]) && (96 == a_stResponse.m_rglValue[3]);
+
+	// 読み込めないファイル.
+	const char* a_pMissing = "no_such_pattern.rle";
+	a_bIsSuccess = a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_LOAD, 0, 0, 0, 0, a_pMissing, strlen(a_pMissing))
+		&& recv_response(i_iFd, a_stResponse);
+	return a_bIsSuccess && (LifeGameServer::STATUS_NOT_FOUND == a_stResponse.m_uiStatus);
+}
+
+// 複数のクライアントが続けて送った要求に, 要求の順で応答するかをテスト.
+bool test_server_pipeline(int i_iFd)
+{
+	int a_iOtherFd = connect_server();
+	if(0 > a_iOtherFd) return false;
+
+	// 応答を待たずに送る.(受け取る側は別スレッド).
+	const int a_iStepNum = 1000;
+	LifeGameServer::RESPONSE a_stResponse;
+	bool a_bIsSuccess = send_request(i_iFd, LifeGameServer::OP_STATS) && recv_response(i_iFd, a_stResponse);
+	long a_lGeneration = a_stResponse.m_rglValue[0];
+	thread a_cSender([i_iFd, a_iOtherFd]()
+	{
+		for(int a_iIndex=0; a_iIndex<a_iStepNum; a_iIndex++)
+		{
+			send_request(i_iFd, LifeGameServer::OP_STEP, 1);
+			if(0 == a_iIndex % 100) send_request(a_iOtherFd, LifeGameServer::OP_STATS);
+		}
+	});
+	for(int a_iIndex=0; a_iIndex<a_iStepNum; a_iIndex++)
+	{
+		a_bIsSuccess = a_bIsSuccess && recv_response(i_iFd, a_stResponse);
+		a_bIsSuccess = a_bIsSuccess && (a_lGeneration + a_iIndex + 1 == a_stResponse.m_rglValue[0]);
+	}
+	for(int a_iIndex=0; a_iIndex<a_iStepNum / 100; a_iIndex++)
+	{
+		a_bIsSuccess = a_bIsSuccess && recv_response(a_iOtherFd, a_stResponse) && (LifeGameServer::OP_STATS == a_stResponse.m_uiOp);
+	}
+	a_cSender.join();
+	close(a_iOtherFd);
+	return a_bIsSuccess;
+}
+
+// 正しくない要求には応答して切断するかをテスト.
+bool test_server_bad_request()
+{
+	int a_iFd = connect_server();
+	if(0 > a_iFd) return false;
+
+	LifeGameServer::RESPONSE a_stResponse;
+	bool a_bIsSuccess = send_request(a_iFd, 99) && recv_response(a_iFd, a_stResponse);
+	a_bIsSuccess = a_bIsSuccess && (LifeGameServer::STATUS_BAD_REQUEST == a_stResponse.m_uiStatus);
+
+	char a_ch = 0;
+	a_bIsSuccess = a_bIsSuccess && (0 == read(a_iFd, &a_ch, 1));
+	close(a_iFd);
+	return a_bIsSuccess;
+}
+
+// 盤面の外から始まる範囲や盤面より大きい範囲の取得は, 正しくない要求として応答して切断するかをテスト.
+bool test_server_query_out_of_range()
+{
+	const long a_rglQuery[][4] = {
+		{ 0, 0, INT64_MAX, 1 },
+		{ 0, 0, 1, INT64_MAX },
+		{ INT64_MAX, INT64_MAX, INT64_MAX, INT64_MAX },
+		{ -1, 0, 10, 10 },
+		{ 0, INT64_MIN, 10, 10 },
+		{ 128, 0, 1, 1 },
+		{ 0, 0, 129, 1 },
+	};
+	bool a_bIsSuccess = true;
+	for(size_t a_lIndex=0; a_bIsSuccess && (a_lIndex<sizeof(a_rglQuery)/sizeof(a_rglQuery[0])); a_lIndex++)
+	{
+		int a_iFd = connect_server();
+		if(0 > a_iFd) return false;
+
+		LifeGameServer::RESPONSE a_stResponse;
+		a_bIsSuccess = send_request(a_iFd, LifeGameServer::OP_QUERY, a_rglQuery[a_lIndex][0], a_rglQuery[a_lIndex][1],
+			a_rglQuery[a_lIndex][2], a_rglQuery[a_lIndex][3]) && recv_response(a_iFd, a_stResponse);
+		a_bIsSuccess = a_bIsSuccess && (LifeGameServer::STATUS_BAD_REQUEST == a_stResponse.m_uiStatus);
+
+		char a_ch = 0;
+		a_bIsSuccess = a_bIsSuccess && (0 == read(a_iFd, &a_ch, 1));
+		close(a_iFd);
+	}
+	return a_bIsSuccess;
+}
+
+// 応答を受信しないまま要求を送り続けるクライアントを, 送信待ちが上限を超えたところで切断するかをテスト.
+bool test_server_output_limit(int i_iFd)
+{
+	int a_iFd = connect_server();
+	if(0 > a_iFd) return false;
+
+	// 盤面の応答(128x96)で上限の2倍になるまで送る.(切断された後の送信はEPIPEで止まる).
+	const size_t a_lResponseSize = sizeof(LifeGameServer::RESPONSE) + sizeof(BitBoard::WORD) * 2 * 96;
+	const long a_lRequestNum = 2 * LifeGameServer::OUTPUT_MAX_SIZE / a_lResponseSize;
+	LifeGameServer::REQUEST a_stRequest = { LifeGameServer::OP_SNAPSHOT, 0, 0, { 0, 0, 0, 0 } };
+	long a_lSent = 0;
+	while( (a_lSent < a_lRequestNum) && (sizeof(a_stRequest) == send(a_iFd, &a_stRequest, sizeof(a_stRequest), MSG_NOSIGNAL)) ) a_lSent++;
+
+	// 受け取れるのは上限と送信のバッファに収まった分だけで, その後は切断されている.(切断されなければ2秒で諦める).
+	struct timeval a_stTimeout = { 2, 0 };
+	setsockopt(a_iFd, SOL_SOCKET, SO_RCVTIMEO, &a_stTimeout, sizeof(a_stTimeout));
+	char a_rgchBuffer[65536];
+	size_t a_lReceived = 0;
+	ssize_t a_lRead = 0;
+	while(0 < (a_lRead = read(a_iFd, a_rgchBuffer, sizeof(a_rgchBuffer)))) a_lReceived += a_lRead;
+	close(a_iFd);
+	bool a_bIsSuccess = (a_lReceived < a_lRequestNum * a_lResponseSize);
+
+	// 他のクライアントには影響しない.
+	LifeGameServer::RESPONSE a_stResponse;
+	return a_bIsSuccess && send_request(i_iFd, LifeGameServer::OP_STATS) && recv_response(i_iFd, a_stResponse)
+		&& (LifeGameServer::STATUS_OK == a_stResponse.m_uiStatus);
+}
+
+// 1世代ずつ応答を待って進める速さをテスト.(1秒あたり1000世代以上).
+bool test_server_step_rate(int i_iFd)
+{
+	const int a_iStepNum = 5000;
+	LifeGameServer::RESPONSE a_stResponse;
+	bool a_bIsSuccess = true;
+	double a_dStart = get_second();
+	for(int a_iIndex=0; a_bIsSuccess && (a_iIndex<a_iStepNum); a_iIndex++)
+	{
+		a_bIsSuccess = send_request(i_iFd, LifeGameServer::OP_STEP, 1) && recv_response(i_iFd, a_stResponse);
+	}
+	double a_dRate = a_iStepNum / (get_second() - a_dStart);
+	printf("test_server_step_rate(128x96): %.0f round trips/s\n", a_dRate);
+	return a_bIsSuccess && (1000.0 <= a_dRate);
+}
+
+bool test_LifeGame_Server()
+{
+	bool a_bIsSuccess = false;
+
+	const char* a_rgpArgv[] = { "LifeGame", "--serve", SOCKET_PATH, "-s", "128x96" };
+	LifeGameOption a_cOption;
+	a_cOption.parse(sizeof(a_rgpArgv) / sizeof(a_rgpArgv[0]), const_cast<char**>(a_rgpArgv));
+	LifeGameServer* a_pcServer = new LifeGameServer(a_cOption);
+	bool a_bIsRun = false;
+	thread a_cServerThread([a_pcServer, &a_bIsRun]() { a_bIsRun = a_pcServer->run(); });
+
+	int a_iFd = connect_server();
+	MatrixCell a_cExpected(128L, 96L);
+
+	// 一括設定, 世代を進める, 盤面の取得をテスト.
+	a_bIsSuccess = (0 <= a_iFd) && test_server_set_step_snapshot(a_iFd, a_cExpected);
+	print_test_result("test_server_set_step_snapshot", a_bIsSuccess);
+
+	// 範囲の取得と書き込みをテスト.
+	a_bIsSuccess = (0 <= a_iFd) && test_server_query(a_iFd, a_cExpected);
+	print_test_result("test_server_query", a_bIsSuccess);
+
+	// パターンファイルの読み込みをテスト.
+	a_bIsSuccess = (0 <= a_iFd) && test_server_load(a_iFd);
+	print_test_result("test_server_load", a_bIsSuccess);
+
+	// 続けて送った要求をテスト.
+	a_bIsSuccess = (0 <= a_iFd) && test_server_pipeline(a_iFd);
+	print_test_result("test_server_pipeline", a_bIsSuccess);
+
+	// 正しくない要求をテスト.
+	a_bIsSuccess = test_server_bad_request();
+	print_test_result("test_server_bad_request", a_bIsSuccess);
+
+	// 範囲外の取得をテスト.
+	a_bIsSuccess = test_server_query_out_of_range();
+	print_test_result("test_server_query_out_of_range", a_bIsSuccess);
+
+	// 送信待ちの上限をテスト.
+	a_bIsSuccess = (0 <= a_iFd) && test_server_output_limit(a_iFd);
+	print_test_result("test_server_output_limit", a_bIsSuccess);
+
+	// 世代を進める速さをテスト.
+	a_bIsSuccess = (0 <= a_iFd) && test_server_step_rate(a_iFd);
+	print_test_result("test_server_step_rate", a_bIsSuccess);
+
+	// 終了.
+	LifeGameServer::RESPONSE a_stResponse;
+	a_bIsSuccess = (0 <= a_iFd) && send_request(a_iFd, LifeGameServer::OP_QUIT) && recv_response(a_iFd, a_stResponse);
+	a_cServerThread.join();
+	delete a_pcServer;
+	if(0 <= a_iFd) close(a_iFd);
+	a_bIsSuccess = a_bIsSuccess && a_bIsRun && (0 != access(SOCKET_PATH, F_OK));
+	print_test_result("test_server_quit", a_bIsSuccess);
+
+	return true;
+}
+
+int main()
+{
+	test_LifeGame_Server();
+	return 0;
+}
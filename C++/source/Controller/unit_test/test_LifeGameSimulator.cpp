@@ -0,0 +1,505 @@
+/*********************************************************
+ * LifeGameSimulatorクラス(とSpscQueue)のユニットテスト
+ *********************************************************/
+
+#include <iostream>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/time.h>
+
+#include "../LifeGameSimulator.h"
+#include "../../Lib/SpscQueue.h"
+#include "../../Model/MatrixCell.h"
+#include "../../Model/BitBoard.h"
+#include "../../Model/SoupGenerator.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+double get_second()
+{
+	struct timeval a_stTime;
+	gettimeofday(&a_stTime, 0);
+	return a_stTime.tv_sec + a_stTime.tv_usec / 1000000.0;
+}
+
+// 公開された盤面を受け取り, 条件を満たすまで待つ.(最大i_dTimeout秒).
+template<typename FUNC>
+bool wait_snapshot(LifeGameSimulator& i_cSimulator, FUNC i_cIsDone, double i_dTimeout)
+{
+	double a_dEnd = get_second() + i_dTimeout;
+	while(get_second() < a_dEnd)
+	{
+		i_cSimulator.receive();
+		if(i_cIsDone(i_cSimulator.getSnapshot())) return true;
+
+		struct pollfd a_stPoll;
+		a_stPoll.fd = i_cSimulator.getPublishFd();
+		a_stPoll.events = POLLIN;
+		poll(&a_stPoll, 1, 100);
+	}
+	return false;
+}
+
+// 別スレッドから書き込んだ値を順番どおりに全て読めるかをテスト.
+bool test_spsc_queue()
+{
+	SpscQueue<long, 64> a_cQueue;
+	bool a_bIsSuccess = a_cQueue.empty();
+
+	// 容量を超えたら失敗する.
+	for(long a_lIndex=0; a_lIndex<64; a_lIndex++) a_bIsSuccess = a_bIsSuccess && a_cQueue.push(a_lIndex);
+	a_bIsSuccess = a_bIsSuccess && !a_cQueue.push(64);
+	long a_lValue = -1;
+	for(long a_lIndex=0; a_lIndex<64; a_lIndex++) a_bIsSuccess = a_bIsSuccess && a_cQueue.pop(a_lValue) && (a_lIndex == a_lValue);
+	a_bIsSuccess = a_bIsSuccess && !a_cQueue.pop(a_lValue) && a_cQueue.empty();
+
+	// 書き込み1スレッド/読み出し1スレッド.
+	const long a_lNum = 1000000;
+	std::thread a_cProducer([&a_cQueue, a_lNum]()
+	{
+		for(long a_lIndex=0; a_lIndex<a_lNum; a_lIndex++)
+		{
+			while(!a_cQueue.push(a_lIndex)) std::this_thread::yield();
+		}
+	});
+	long a_lExpected = 0;
+	while(a_lExpected < a_lNum)
+	{
+		if(!a_cQueue.pop(a_lValue)) { std::this_thread::yield(); continue; }
+		if(a_lValue != a_lExpected) a_bIsSuccess = false;
+		a_lExpected++;
+	}
+	a_cProducer.join();
+	return a_bIsSuccess && a_cQueue.empty();
+}
+
+// コマ送りした盤面が同じ世代だけ直接進めた盤面と一致するかをテスト.
+bool test_simulator_step()
+{
+	BitBoard a_cSoup(150, 90);
+	SoupGenerator(3, 0.4).generate(a_cSoup, 1);
+
+	MatrixCell a_cExpected(150, 90);
+	a_cExpected.importBitBoard(a_cSoup);
+	for(int a_iGeneration=0; a_iGeneration<25; a_iGeneration++) a_cExpected.refreshCell();
+	BitBoard a_cExpectedBoard;
+	a_cExpected.exportBitBoard(a_cExpectedBoard);
+
+	MatrixCell a_cModel(150, 90);
+	a_cModel.importBitBoard(a_cSoup);
+	LifeGameSimulator a_cSimulator(&a_cModel, 0.0, 0.1);
+	bool a_bIsSuccess = (a_cSimulator.getSnapshot().m_cBoard == a_cSoup);
+	a_cSimulator.start();
+
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_STEP);
+	a_stCommand.m_lCount = 20;
+	a_cSimulator.send(a_stCommand);
+	a_stCommand.m_lCount = 5;
+	a_cSimulator.send(a_stCommand);
+
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 25 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	const LifeGameSimulator::SNAPSHOT& a_stSnapshot = a_cSimulator.getSnapshot();
+	a_bIsSuccess = a_bIsSuccess && (a_stSnapshot.m_cBoard == a_cExpectedBoard) && (a_stSnapshot.m_lPopulation == a_cExpectedBoard.count());
+
+	// 停止後はModelを直接見てよい.(コマ送りは実行中の世代に数えない).
+	a_cSimulator.stop();
+	return a_bIsSuccess && (25 == a_cModel.getGeneration()) && (0 == a_cSimulator.getGenerationNum());
+}
+
+// 指定世代までの実行は途中の盤面を公開せず, 最後に1回だけ公開するかをテスト.
+bool test_simulator_run_to()
+{
+	BitBoard a_cSoup(120, 60);
+	SoupGenerator(9, 0.35).generate(a_cSoup, 1);
+
+	MatrixCell a_cExpected(120, 60);
+	a_cExpected.importBitBoard(a_cSoup);
+	for(int a_iGeneration=0; a_iGeneration<3000; a_iGeneration++) a_cExpected.refreshCell();
+	BitBoard a_cExpectedBoard;
+	a_cExpected.exportBitBoard(a_cExpectedBoard);
+
+	MatrixCell a_cModel(120, 60);
+	a_cModel.importBitBoard(a_cSoup);
+	LifeGameSimulator a_cSimulator(&a_cModel, 10.0, 0.1);
+	a_cSimulator.start();
+
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_RUN_TO);
+	a_stCommand.m_lCount = 3000;
+	a_cSimulator.send(a_stCommand);
+
+	// 受け取った盤面の世代が変わった回数を数える.
+	long a_lPrevGeneration = 0;
+	long a_lChangeNum = 0;
+	bool a_bIsSuccess = wait_snapshot(a_cSimulator, [&a_lPrevGeneration, &a_lChangeNum](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		if(a_lPrevGeneration != i_stSnapshot.m_lGeneration) a_lChangeNum++;
+		a_lPrevGeneration = i_stSnapshot.m_lGeneration;
+		return 3000 == i_stSnapshot.m_lGeneration;
+	}, 10.0);
+	a_bIsSuccess = a_bIsSuccess && (a_cSimulator.getSnapshot().m_cBoard == a_cExpectedBoard) && (0 == a_cSimulator.getStepRemain());
+
+	// 途中の世代は受け取らない.
+	a_bIsSuccess = a_bIsSuccess && (1 == a_lChangeNum);
+
+	// 過去の世代を指定しても戻らない.
+	a_stCommand.m_lCount = 10;
+	a_cSimulator.send(a_stCommand);
+	wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT&) { return false; }, 0.1);
+	a_bIsSuccess = a_bIsSuccess && (3000 == a_cSimulator.getSnapshot().m_lGeneration);
+
+	// 途中で止めると, 止めた世代の盤面が公開される.
+	a_stCommand.m_lCount = 1000000000L;
+	a_cSimulator.send(a_stCommand);
+	usleep(100000);
+	a_bIsSuccess = a_bIsSuccess && (0 < a_cSimulator.getStepRemain());
+	a_cSimulator.send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_PAUSE));
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 3000 < i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_cSimulator.stop();
+	return a_bIsSuccess && (0 == a_cSimulator.getStepRemain()) && (a_cModel.getGeneration() == a_cSimulator.getSnapshot().m_lGeneration);
+}
+
+// 編集のコマンドが送った順に反映されるかをテスト.
+bool test_simulator_edit()
+{
+	MatrixCell a_cModel(100, 50);
+	LifeGameSimulator a_cSimulator(&a_cModel, 10.0, 0.1);
+	a_cSimulator.start();
+
+	BitBoard a_cExpected(100, 50);
+	LifeGameSimulator::COMMAND a_stFill(LifeGameSimulator::CMD_FILL);
+	a_stFill.m_lCol = 10;
+	a_stFill.m_lRow = 5;
+	a_stFill.m_lWidth = 70;
+	a_stFill.m_lHeight = 20;
+	a_cSimulator.send(a_stFill);
+	a_cExpected.fillRect(10, 5, 70, 20, true);
+
+	// 生きているセルと死んでいるセルを1つずつ反転する.
+	LifeGameSimulator::COMMAND a_stToggle(LifeGameSimulator::CMD_TOGGLE_CELL);
+	a_stToggle.m_lCol = 10;
+	a_stToggle.m_lRow = 5;
+	a_cSimulator.send(a_stToggle);
+	a_stToggle.m_lCol = 99;
+	a_stToggle.m_lRow = 49;
+	a_cSimulator.send(a_stToggle);
+	a_cExpected.setBit(10, 5, false);
+	a_cExpected.setBit(99, 49, true);
+
+	LifeGameSimulator::COMMAND a_stPaste(LifeGameSimulator::CMD_PASTE);
+	a_stPaste.m_cBoard.init(3, 3);
+	a_stPaste.m_cBoard.fillRect(0, 0, 3, 3, true);
+	a_stPaste.m_lCol = 0;
+	a_stPaste.m_lRow = 40;
+	a_stPaste.m_ePasteMode = BitBoard::PASTE_XOR;
+	a_cSimulator.send(a_stPaste);
+	a_cExpected.fillRect(0, 40, 3, 3, true);
+
+	bool a_bIsSuccess = wait_snapshot(a_cSimulator, [&a_cExpected](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return i_stSnapshot.m_cBoard == a_cExpected;
+	}, 5.0);
+	return a_bIsSuccess && (0 == a_cSimulator.getSnapshot().m_lGeneration) && (a_cExpected.count() == a_cSimulator.getSnapshot().m_lPopulation);
+}
+
+// 実行と停止, 速度の指定をテスト.
+bool test_simulator_run()
+{
+	MatrixCell a_cModel(64, 64);
+	a_cModel.fillRegion(10, 10, 1, 3);	// ブリンカー.
+	LifeGameSimulator a_cSimulator(&a_cModel, 0.0, 0.1);
+	a_cSimulator.start();
+
+	// 無制限で実行.
+	a_cSimulator.send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_RUN));
+	bool a_bIsSuccess = wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 100 <= i_stSnapshot.m_lGeneration;
+	}, 5.0);
+
+	// 停止したら世代が進まない.
+	a_cSimulator.send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_PAUSE));
+	a_cSimulator.send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_STEP));	// 世代数0は何もしない.
+	usleep(50000);
+	wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT&) { return false; }, 0.1);
+	long a_lPaused = a_cSimulator.getSnapshot().m_lGeneration;
+	long a_lGenerationNum = a_cSimulator.getGenerationNum();
+	wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT&) { return false; }, 0.2);
+	a_bIsSuccess = a_bIsSuccess && (a_lPaused == a_cSimulator.getSnapshot().m_lGeneration) && (a_lPaused == a_lGenerationNum);
+	a_bIsSuccess = a_bIsSuccess && (3 == a_cSimulator.getSnapshot().m_lPopulation);
+
+	// 100世代/秒で0.5秒実行.
+	LifeGameSimulator::COMMAND a_stRate(LifeGameSimulator::CMD_SET_RATE);
+	a_stRate.m_dRate = 100.0;
+	a_cSimulator.send(a_stRate);
+	a_cSimulator.send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_RUN));
+	wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT&) { return false; }, 0.5);
+	a_cSimulator.stop();
+	long a_lRun = a_cSimulator.getGenerationNum() - a_lGenerationNum;
+	return a_bIsSuccess && (35 <= a_lRun) && (a_lRun <= 65);
+}
+
+// 1世代に時間がかかる盤面でも, コマンドの送信と盤面の受け取りが待たされない事を確認.
+bool test_simulator_responsive()
+{
+	BitBoard a_cSoup(2000, 2000);
+	SoupGenerator(5, 0.3).generate(a_cSoup, 2);
+	MatrixCell a_cModel(2000, 2000);
+	a_cModel.importBitBoard(a_cSoup, 2);
+
+	LifeGameSimulator a_cSimulator(&a_cModel, 0.0, 0.1);
+	a_cSimulator.start();
+	a_cSimulator.send(LifeGameSimulator::COMMAND(LifeGameSimulator::CMD_RUN));
+
+	// 世代を進めている間にUIスレッドの処理にかかる時間を測る.
+	double a_dWorst = 0.0;
+	double a_dEnd = get_second() + 1.0;
+	long a_lLoop = 0;
+	while(get_second() < a_dEnd)
+	{
+		double a_dStart = get_second();
+		LifeGameSimulator::COMMAND a_stToggle(LifeGameSimulator::CMD_TOGGLE_CELL);
+		a_stToggle.m_lCol = a_lLoop % 2000;
+		a_cSimulator.send(a_stToggle);
+		a_cSimulator.receive();
+		double a_dTime = get_second() - a_dStart;
+		if(a_dWorst < a_dTime) a_dWorst = a_dTime;
+		a_lLoop++;
+		usleep(10000);
+	}
+	a_cSimulator.stop();
+
+	long a_lGenerationNum = a_cSimulator.getGenerationNum();
+	printf("test_simulator_responsive(2000x2000): %ld generations, %.3f ms/step, worst UI call %.3f ms\n",
+		a_lGenerationNum, (0 < a_lGenerationNum)? a_cSimulator.getGenerationTime() / a_lGenerationNum * 1000.0 : 0.0, a_dWorst * 1000.0);
+	return (0 < a_lGenerationNum) && (a_dWorst < 0.05);
+}
+
+// 巻き戻しをテスト.(世代と編集を1件ずつ戻す).
+bool test_simulator_rewind()
+{
+	BitBoard a_cSoup(120, 80);
+	SoupGenerator(5, 0.35).generate(a_cSoup, 1);
+
+	MatrixCell a_cExpected(120, 80);
+	a_cExpected.importBitBoard(a_cSoup);
+	for(int a_iGeneration=0; a_iGeneration<10; a_iGeneration++) a_cExpected.refreshCell();
+	BitBoard a_cExpectedBoard;
+	a_cExpected.exportBitBoard(a_cExpectedBoard);
+
+	MatrixCell a_cModel(120, 80);
+	a_cModel.importBitBoard(a_cSoup);
+	LifeGameSimulator a_cSimulator(&a_cModel, 0.0, 0.1, 1024 * 1024);
+	a_cSimulator.start();
+
+	// 10世代進めて編集し, さらに5世代進める.
+	LifeGameSimulator::COMMAND a_stCommand(LifeGameSimulator::CMD_STEP);
+	a_stCommand.m_lCount = 10;
+	a_cSimulator.send(a_stCommand);
+	bool a_bIsSuccess = wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 10 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && (a_cSimulator.getSnapshot().m_cBoard == a_cExpectedBoard);
+
+	// コマンドはコマ送りを待たずに実行されるので, 10世代進んでから編集する.
+	LifeGameSimulator::COMMAND a_stFill(LifeGameSimulator::CMD_FILL);
+	a_stFill.m_lCol = 20;
+	a_stFill.m_lRow = 10;
+	a_stFill.m_lWidth = 40;
+	a_stFill.m_lHeight = 30;
+	a_cSimulator.send(a_stFill);
+	a_stCommand.m_lCount = 5;
+	a_cSimulator.send(a_stCommand);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 15 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+
+	// 5世代 + 編集1回を巻き戻すと, 10世代目の盤面に戻る.
+	LifeGameSimulator::COMMAND a_stRewind(LifeGameSimulator::CMD_REWIND);
+	a_stRewind.m_lCount = 6;
+	a_cSimulator.send(a_stRewind);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 10 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && (a_cSimulator.getSnapshot().m_cBoard == a_cExpectedBoard);
+
+	// 残りを超えて巻き戻すと初期配置に戻る.
+	a_stRewind.m_lCount = 1000;
+	a_cSimulator.send(a_stRewind);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 0 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && (a_cSimulator.getSnapshot().m_cBoard == a_cSoup);
+	a_cSimulator.stop();
+	return a_bIsSuccess;
+}
+
+// 矩形内のセルが一致するか否か.
+static bool is_same_region(const BitBoard& i_cBoard, const BitBoard& i_cExpected, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	for(long a_lRow=i_lRow; a_lRow<i_lRow+i_lHeight; a_lRow++)
+	{
+		for(long a_lCol=i_lCol; a_lCol<i_lCol+i_lWidth; a_lCol++)
+		{
+			if(i_cBoard.getBit(a_lCol, a_lRow) != i_cExpected.getBit(a_lCol, a_lRow)) return false;
+		}
+	}
+	return true;
+}
+
+// 公開された盤面の最新の矩形.
+static bool is_region(const LifeGameSimulator::SNAPSHOT& i_stSnapshot, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	return (i_lCol == i_stSnapshot.m_lRegionCol) && (i_lRow == i_stSnapshot.m_lRegionRow)
+		&& (i_lWidth == i_stSnapshot.m_lRegionWidth) && (i_lHeight == i_stSnapshot.m_lRegionHeight);
+}
+
+// 関心領域を指定した場合に, 関心領域の中が世代, 編集, 移動, 巻き戻しに追従するかをテスト.
+bool test_simulator_interest()
+{
+	BitBoard a_cSoup(200, 120);
+	SoupGenerator(7, 0.35).generate(a_cSoup, 1);
+
+	MatrixCell a_cExpected(200, 120);
+	a_cExpected.importBitBoard(a_cSoup);
+	BitBoard a_cExpectedBoard;
+
+	MatrixCell a_cModel(200, 120);
+	a_cModel.importBitBoard(a_cSoup);
+	LifeGameSimulator a_cSimulator(&a_cModel, 0.0, 0.1, 1024 * 1024);
+	a_cSimulator.start();
+
+	// 関心領域を指定しなければ盤面全体.
+	bool a_bIsSuccess = is_region(a_cSimulator.getSnapshot(), 0, 0, 200, 120) && (a_cSimulator.getSnapshot().m_cBoard == a_cSoup);
+
+	// 関心領域を指定して5世代進める.
+	LifeGameSimulator::COMMAND a_stInterest(LifeGameSimulator::CMD_SET_INTEREST);
+	a_stInterest.m_lCol = 30;
+	a_stInterest.m_lRow = 20;
+	a_stInterest.m_lWidth = 80;
+	a_stInterest.m_lHeight = 40;
+	a_cSimulator.send(a_stInterest);
+	LifeGameSimulator::COMMAND a_stStep(LifeGameSimulator::CMD_STEP);
+	a_stStep.m_lCount = 5;
+	a_cSimulator.send(a_stStep);
+	for(int a_iGeneration=0; a_iGeneration<5; a_iGeneration++) a_cExpected.refreshCell();
+	a_cExpected.exportBitBoard(a_cExpectedBoard);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 5 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && is_region(a_cSimulator.getSnapshot(), 30, 20, 80, 40);
+	a_bIsSuccess = a_bIsSuccess && is_same_region(a_cSimulator.getSnapshot().m_cBoard, a_cExpectedBoard, 30, 20, 80, 40);
+	a_bIsSuccess = a_bIsSuccess && (a_cExpected.getPopulation() == a_cSimulator.getSnapshot().m_lPopulation);
+
+	// 1セルの編集は通知されないが, 関心領域の中には反映される.
+	LifeGameSimulator::COMMAND a_stToggle(LifeGameSimulator::CMD_TOGGLE_CELL);
+	a_stToggle.m_lCol = 45;
+	a_stToggle.m_lRow = 33;
+	a_cSimulator.send(a_stToggle);
+	a_cExpectedBoard.toggleBit(45, 33);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 3 == i_stSnapshot.m_lCommandNum;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && is_same_region(a_cSimulator.getSnapshot().m_cBoard, a_cExpectedBoard, 30, 20, 80, 40);
+	BitBoard a_cEditedBoard = a_cExpectedBoard;
+
+	// 関心領域を動かすと, 新しい関心領域の中も最新になる.(盤面からはみ出す部分は切り詰める).
+	a_cExpected.importBitBoard(a_cExpectedBoard);
+	a_stInterest.m_lCol = 150;
+	a_stInterest.m_lRow = 90;
+	a_stInterest.m_lWidth = 100;
+	a_stInterest.m_lHeight = 50;
+	a_cSimulator.send(a_stInterest);
+	a_stStep.m_lCount = 3;
+	a_cSimulator.send(a_stStep);
+	for(int a_iGeneration=0; a_iGeneration<3; a_iGeneration++) a_cExpected.refreshCell();
+	a_cExpected.exportBitBoard(a_cExpectedBoard);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 8 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && is_region(a_cSimulator.getSnapshot(), 150, 90, 50, 30);
+	a_bIsSuccess = a_bIsSuccess && is_same_region(a_cSimulator.getSnapshot().m_cBoard, a_cExpectedBoard, 150, 90, 50, 30);
+
+	// 巻き戻しは通知されないが, 関心領域の中には反映される.
+	LifeGameSimulator::COMMAND a_stRewind(LifeGameSimulator::CMD_REWIND);
+	a_stRewind.m_lCount = 3;
+	a_cSimulator.send(a_stRewind);
+	a_bIsSuccess = a_bIsSuccess && wait_snapshot(a_cSimulator, [](const LifeGameSimulator::SNAPSHOT& i_stSnapshot)
+	{
+		return 5 == i_stSnapshot.m_lGeneration;
+	}, 5.0);
+	a_bIsSuccess = a_bIsSuccess && is_same_region(a_cSimulator.getSnapshot().m_cBoard, a_cEditedBoard, 150, 90, 50, 30);
+	a_cSimulator.stop();
+
+	// Modelは盤面全体を進めている.
+	BitBoard a_cModelBoard;
+	a_cModel.exportBitBoard(a_cModelBoard);
+	return a_bIsSuccess && (a_cModelBoard == a_cEditedBoard);
+}
+
+bool test_LifeGame_Simulator()
+{
+	bool a_bIsSuccess = false;
+
+	// SPSCキューをテスト.
+	a_bIsSuccess = test_spsc_queue();
+	print_test_result("test_spsc_queue", a_bIsSuccess);
+
+	// コマ送りをテスト.
+	a_bIsSuccess = test_simulator_step();
+	print_test_result("test_simulator_step", a_bIsSuccess);
+
+	// 指定世代までの実行をテスト.
+	a_bIsSuccess = test_simulator_run_to();
+	print_test_result("test_simulator_run_to", a_bIsSuccess);
+
+	// 編集をテスト.
+	a_bIsSuccess = test_simulator_edit();
+	print_test_result("test_simulator_edit", a_bIsSuccess);
+
+	// 実行/停止をテスト.
+	a_bIsSuccess = test_simulator_run();
+	print_test_result("test_simulator_run", a_bIsSuccess);
+
+	// 巻き戻しをテスト.
+	a_bIsSuccess = test_simulator_rewind();
+	print_test_result("test_simulator_rewind", a_bIsSuccess);
+
+	// 関心領域をテスト.
+	a_bIsSuccess = test_simulator_interest();
+	print_test_result("test_simulator_interest", a_bIsSuccess);
+
+	// UIスレッドが待たされない事をテスト.
+	a_bIsSuccess = test_simulator_responsive();
+	print_test_result("test_simulator_responsive", a_bIsSuccess);
+
+	return true;
+}
+
+int main()
+{
+	test_LifeGame_Simulator();
+	return 0;
+}
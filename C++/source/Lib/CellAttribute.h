@@ -5,7 +5,6 @@
 #ifndef __CELL_ATTRIBUTE_H__
 #define __CELL_ATTRIBUTE_H__
 
-#include "Observer.h"
 
 /**
  * @brief   細胞（セル）の属性情報.
@@ -13,7 +12,7 @@
  * @note    受け渡す情報は以下.
  * @note        ・セルの状態.
  */
-class CellAttribute : public Information
+class CellAttribute
 {
 public:
     /**
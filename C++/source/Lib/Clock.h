@@ -0,0 +1,35 @@
+/**
+ * @file    Clock.h
+ * @brief   時間計測用の関数.
+ */
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include <time.h>
+
+/**
+ * @brief   現在時刻を秒で取得.
+ * @param   なし.
+ * @return  単調増加する時刻.(秒).
+ * @note    経過時間の計測に使う.(時刻そのものに意味はない).
+ */
+inline double getSecond()
+{
+	struct timespec a_stTime;
+	clock_gettime(CLOCK_MONOTONIC, &a_stTime);
+	return a_stTime.tv_sec + a_stTime.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief   呼び出したスレッドのCPU時間を秒で取得.
+ * @param   なし.
+ * @return  スレッドが消費したCPU時間.(秒).
+ */
+inline double getThreadCpuSecond()
+{
+	struct timespec a_stTime;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &a_stTime);
+	return a_stTime.tv_sec + a_stTime.tv_nsec / 1000000000.0;
+}
+
+#endif	// __CLOCK_H__
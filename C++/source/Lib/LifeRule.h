@@ -0,0 +1,119 @@
+/**
+ * @file    LifeRule.h
+ * @brief   誕生/生存の規則クラス.
+ */
+#ifndef __LIFE_RULE_H__
+#define __LIFE_RULE_H__
+
+#include <string>
+#include <cctype>
+
+/**
+ * @brief   誕生/生存の規則.
+ * @note    隣接する生きたセルの数(0〜8)ごとに, 誕生するか/生存するかをビットで持つ.
+ * @note    "B3/S23"形式(または"23/3"形式)の文字列で指定する.
+ *          既定値はライフゲーム(B3/S23).
+ */
+class LifeRule
+{
+public:
+    /**
+     * @brief   コンストラクタ.(B3/S23).
+     */
+    LifeRule()
+	{
+		this->m_uiBorn = (1 << 3);
+		this->m_uiSurvive = (1 << 2) | (1 << 3);
+	}
+
+    /**
+     * @brief   誕生するか否か.
+     * @param   long i_lNeighborAliveNum 隣接セルの生存数.
+     * @return  true:誕生する false:誕生しない.
+     */
+    bool isBorn(long i_lNeighborAliveNum) const { return 0 != ((this->m_uiBorn >> i_lNeighborAliveNum) & 1); }
+
+    /**
+     * @brief   生存するか否か.
+     * @param   long i_lNeighborAliveNum 隣接セルの生存数.
+     * @return  true:生存する false:死滅する.
+     */
+    bool isSurvive(long i_lNeighborAliveNum) const { return 0 != ((this->m_uiSurvive >> i_lNeighborAliveNum) & 1); }
+
+    /**
+     * @brief   誕生する隣接セルの生存数をビットで取得.(ビットnが1ならばn個で誕生).
+     */
+    unsigned int getBornMask() const { return this->m_uiBorn; }
+
+    /**
+     * @brief   生存する隣接セルの生存数をビットで取得.(ビットnが1ならばn個で生存).
+     */
+    unsigned int getSurviveMask() const { return this->m_uiSurvive; }
+
+    /**
+     * @brief   文字列から規則を設定.
+     * @param   const std::string& i_strRule "B3/S23"形式または"23/3"形式(生存/誕生)の文字列.
+     * @return  成功/失敗.(失敗した場合は変更しない).
+     */
+    bool parse(const std::string& i_strRule)
+	{
+		unsigned int a_uiBorn = 0;
+		unsigned int a_uiSurvive = 0;
+		unsigned int* a_puiTarget = 0;
+		bool a_bIsBS = false;
+
+		for(size_t a_lIndex=0; a_lIndex<i_strRule.size(); a_lIndex++)
+		{
+			char a_ch = static_cast<char>(toupper(static_cast<unsigned char>(i_strRule[a_lIndex])));
+			if('B' == a_ch)      { a_puiTarget = &a_uiBorn;    a_bIsBS = true; }
+			else if('S' == a_ch) { a_puiTarget = &a_uiSurvive; a_bIsBS = true; }
+			else if('/' == a_ch)
+			{
+				// "23/3"形式は 生存/誕生 の順.
+				if(!a_bIsBS) a_puiTarget = &a_uiBorn;
+				else a_puiTarget = 0;
+			}
+			else if( ('0'<=a_ch) && ('8'>=a_ch) )
+			{
+				if(0 == a_puiTarget)
+				{
+					if(a_bIsBS) return false;
+					a_puiTarget = &a_uiSurvive;
+				}
+				*a_puiTarget |= 1 << (a_ch - '0');
+			}
+			else return false;
+		}
+
+		this->m_uiBorn = a_uiBorn;
+		this->m_uiSurvive = a_uiSurvive;
+		return true;
+	}
+
+    /**
+     * @brief   規則を文字列で取得.
+     * @param   なし.
+     * @return  "B3/S23"形式の文字列.
+     */
+    std::string toString() const
+	{
+		std::string a_strRule("B");
+		for(int a_iNum=0; a_iNum<=8; a_iNum++) if(this->isBorn(a_iNum)) a_strRule += static_cast<char>('0' + a_iNum);
+		a_strRule += "/S";
+		for(int a_iNum=0; a_iNum<=8; a_iNum++) if(this->isSurvive(a_iNum)) a_strRule += static_cast<char>('0' + a_iNum);
+		return a_strRule;
+	}
+
+private:
+    /**
+     * @brief   誕生する隣接セルの生存数.(ビット).
+     */
+    unsigned int m_uiBorn;
+
+    /**
+     * @brief   生存する隣接セルの生存数.(ビット).
+     */
+    unsigned int m_uiSurvive;
+};
+
+#endif  // __LIFE_RULE_H__
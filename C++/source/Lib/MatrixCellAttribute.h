@@ -5,8 +5,8 @@
 #ifndef __MATRIXCELL_ATTRIBUTE_H__
 #define __MATRIXCELL_ATTRIBUTE_H__
 
-#include "Observer.h"
 #include "CellAttribute.h"
+#include "../Model/BitBoard.h"
 
 /**
  * @brief   MatrixCellの属性情報.
@@ -14,8 +14,11 @@
  * @note    受け渡す情報は以下.
  *	        ・セルの状態.
  *			・座標.
+ * @note    矩形の一括操作では, 1回の通知で矩形内の状態と変化したセルを受け渡す.
+ *          受信側はforEachChanged()で変化したセルを辿る.
+ * @note    BitBoardのうち窓(ウィンドウ)の中だけを通知する場合がある.(世代の変化は盤面全体のBitBoardを窓で区切って渡す).
  */
-class MatrixCellAttribute : public Information
+class MatrixCellAttribute
 {
 public:
     /**
@@ -28,6 +31,9 @@ public:
 		this->m_cCellAttribute.setState(CellAttribute::DEAD);
 		this->m_lCol = -1;
 		this->m_lRow = -1;
+		this->m_pcRegion = 0;
+		this->m_pcChanged = 0;
+		this->setWindow(0, 0, 0, 0);
 	}
 
     /**
@@ -40,8 +46,127 @@ public:
         this->m_cCellAttribute.setState(i_eState);
 		this->m_lCol = i_lCol;
 		this->m_lRow = i_lRow;
+		this->m_pcRegion = 0;
+		this->m_pcChanged = 0;
+		this->setWindow(0, 0, 0, 0);
     }
 
+    /**
+     * @brief   コンストラクタ.(矩形の一括通知).
+     * @param   long i_lCol 矩形の横座標(左端).
+     * @param   long i_lRow 矩形の縦座標(上端).
+     * @param   const BitBoard* i_pcRegion 矩形内の全セルの状態.
+     * @param   const BitBoard* i_pcChanged 矩形内で変化したセル.(i_pcRegionと同じ大きさ).
+     * @note    BitBoardは通知の間だけ有効.
+     */
+    MatrixCellAttribute(long i_lCol, long i_lRow, const BitBoard* i_pcRegion, const BitBoard* i_pcChanged)
+    {
+        this->m_cCellAttribute.setState(CellAttribute::DEAD);
+		this->m_lCol = i_lCol;
+		this->m_lRow = i_lRow;
+		this->m_pcRegion = i_pcRegion;
+		this->m_pcChanged = i_pcChanged;
+		this->setWindow(0, 0, i_pcChanged->getColMax(), i_pcChanged->getRowMax());
+    }
+
+    /**
+     * @brief   コンストラクタ.(矩形の一部分の一括通知).
+     * @param   long i_lCol BitBoardの横座標(左端).
+     * @param   long i_lRow BitBoardの縦座標(上端).
+     * @param   const BitBoard* i_pcRegion 全セルの状態.
+     * @param   const BitBoard* i_pcChanged 変化したセル.(i_pcRegionと同じ大きさ).
+     * @param   long i_lWindowCol 〜 i_lWindowHeight 通知する窓.(BitBoard内の座標). 窓の外のセルは辿らない.
+     * @note    BitBoardは通知の間だけ有効.
+     */
+    MatrixCellAttribute(long i_lCol, long i_lRow, const BitBoard* i_pcRegion, const BitBoard* i_pcChanged,
+		long i_lWindowCol, long i_lWindowRow, long i_lWindowWidth, long i_lWindowHeight)
+    {
+        this->m_cCellAttribute.setState(CellAttribute::DEAD);
+		this->m_lCol = i_lCol;
+		this->m_lRow = i_lRow;
+		this->m_pcRegion = i_pcRegion;
+		this->m_pcChanged = i_pcChanged;
+		this->setWindow(i_lWindowCol, i_lWindowRow, i_lWindowWidth, i_lWindowHeight);
+    }
+
+    /**
+     * @brief   矩形の一括通知か否か.
+     */
+	bool isRegion() const { return 0 != this->m_pcRegion; }
+
+    /**
+     * @brief   矩形内の全セルの状態を取得.(1セルの通知では0).
+     */
+	const BitBoard* getRegion() const { return this->m_pcRegion; }
+
+    /**
+     * @brief   矩形内で変化したセルを取得.(1セルの通知では0).
+     */
+	const BitBoard* getChanged() const { return this->m_pcChanged; }
+
+    /**
+     * @brief   変化したセルを行順(左上から右下)に辿る.
+     * @param   FUNC i_cFunc 処理. (long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState) の形式.
+     * @return  なし.
+     * @note    1セルの通知ではそのセルだけを渡す.
+     */
+	template<typename FUNC>
+	void forEachChanged(FUNC i_cFunc) const
+	{
+		if(!this->isRegion())
+		{
+			i_cFunc(this->m_lCol, this->m_lRow, this->getState());
+			return;
+		}
+		this->forEachChangedWord([this, &i_cFunc](long i_lCol, long i_lRow, BitBoard::WORD i_wBits)
+		{
+			while(0 != i_wBits)
+			{
+				long a_lCol = i_lCol + __builtin_ctzll(i_wBits);
+				bool a_bAlive = this->m_pcRegion->getBit(a_lCol - this->m_lCol, i_lRow - this->m_lRow);
+				i_cFunc(a_lCol, i_lRow, a_bAlive? CellAttribute::ALIVE : CellAttribute::DEAD);
+				i_wBits &= i_wBits - 1;
+			}
+		});
+	}
+
+    /**
+     * @brief   変化したセルを語(64セル)単位で行順に辿る.(変化のない語は飛ばす).
+     * @param   FUNC i_cFunc 処理. (long i_lCol, long i_lRow, BitBoard::WORD i_wBits) の形式.
+     *          i_lColは語の先頭ビットの横座標. i_wBitsは変化したセル.(窓の外のビットは落としてある).
+     * @return  なし.
+     * @note    セルの状態が要らない受信側向け. 1セルの通知でも, そのセルのビットだけを立てた語を渡す.
+     */
+	template<typename FUNC>
+	void forEachChangedWord(FUNC i_cFunc) const
+	{
+		if(!this->isRegion())
+		{
+			i_cFunc(this->m_lCol, this->m_lRow, static_cast<BitBoard::WORD>(1));
+			return;
+		}
+		if( (0 >= this->m_lWindowWidth) || (0 >= this->m_lWindowHeight) ) return;
+
+		// 窓の左端と右端の語は窓の外のビットを落とす.
+		long a_lColEnd = this->m_lWindowCol + this->m_lWindowWidth;
+		long a_lWordBegin = this->m_lWindowCol / BitBoard::WORD_BIT;
+		long a_lWordEnd = (a_lColEnd - 1) / BitBoard::WORD_BIT;
+		BitBoard::WORD a_wBeginMask = ~static_cast<BitBoard::WORD>(0) << (this->m_lWindowCol % BitBoard::WORD_BIT);
+		BitBoard::WORD a_wEndMask = (0 == a_lColEnd % BitBoard::WORD_BIT)? ~static_cast<BitBoard::WORD>(0) : (static_cast<BitBoard::WORD>(1) << (a_lColEnd % BitBoard::WORD_BIT)) - 1;
+		for(long a_lRow=this->m_lWindowRow; a_lRow<this->m_lWindowRow + this->m_lWindowHeight; a_lRow++)
+		{
+			const BitBoard::WORD* a_pWord = this->m_pcChanged->getRow(a_lRow);
+			for(long a_lWord=a_lWordBegin; a_lWord<=a_lWordEnd; a_lWord++)
+			{
+				BitBoard::WORD a_wBits = a_pWord[a_lWord];
+				if(a_lWord == a_lWordBegin) a_wBits &= a_wBeginMask;
+				if(a_lWord == a_lWordEnd) a_wBits &= a_wEndMask;
+				if(0 == a_wBits) continue;
+				i_cFunc(this->m_lCol + a_lWord * BitBoard::WORD_BIT, this->m_lRow + a_lRow, a_wBits);
+			}
+		}
+	}
+
     /**
      * @brief   状態を取得.
      * @param   なし.
@@ -87,6 +212,17 @@ public:
 	void setRow(long i_lRow) { this->m_lRow = i_lRow; }
 
 private:
+	/**
+	 * @brief	窓を設定する.(BitBoard内の座標).
+	 */
+	void setWindow(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+	{
+		this->m_lWindowCol = i_lCol;
+		this->m_lWindowRow = i_lRow;
+		this->m_lWindowWidth = i_lWidth;
+		this->m_lWindowHeight = i_lHeight;
+	}
+
     /**
      * @brief   状態.
      * @see     状態はCELL_STATEを参照.
@@ -102,6 +238,24 @@ private:
 	 * @brief	縦座標.
 	 */
 	long m_lRow;
+
+	/**
+	 * @brief	矩形内の全セルの状態.(1セルの通知では0).
+	 */
+	const BitBoard* m_pcRegion;
+
+	/**
+	 * @brief	矩形内で変化したセル.(1セルの通知では0).
+	 */
+	const BitBoard* m_pcChanged;
+
+	/**
+	 * @brief	通知する窓.(BitBoard内の座標).
+	 */
+	long m_lWindowCol;
+	long m_lWindowRow;
+	long m_lWindowWidth;
+	long m_lWindowHeight;
 };
 
 #endif  // __MATRIXCELL_ATTRIBUTE_H__
@@ -0,0 +1,131 @@
+/**
+ * @file    MemoryUsage.h
+ * @brief   メモリ使用量の分類別の集計.
+ */
+#ifndef __MEMORY_USAGE_H__
+#define __MEMORY_USAGE_H__
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief   メモリ使用量の分類別の集計.
+ * @note    各クラスのgetMemoryUsage()(確保済みの量)とestimateMemoryUsage()(確保する前の見積り)が加算する.
+ * @note    ヒープの量はmallocの管理領域と切り上げを含めた量とする.(getHeapByte()).
+ */
+class MemoryUsage
+{
+public:
+	/**
+	 * @brief	分類.
+	 */
+	enum CATEGORY {
+		CATEGORY_CELL = 0,		// セル本体と盤面の索引.
+		CATEGORY_LINK,			// 隣接セルへのリンク.
+		CATEGORY_CACHE,			// 変化の記録, Observerの関心領域などの作業領域.
+		CATEGORY_HISTORY,		// 巻き戻しの履歴, 世代の記録.
+		CATEGORY_HASH,			// ツリー系のエンジンのハッシュ表.(MatrixCellは持たない).
+		CATEGORY_MAX,
+	};
+
+	/**
+	 * @brief	分類の名前.
+	 */
+	static const char* getCategoryName(int i_iCategory)
+	{
+		static const char* s_rgpName[CATEGORY_MAX] = { "cell", "link", "cache", "history", "hash" };
+		return s_rgpName[i_iCategory];
+	}
+
+	/**
+	 * @brief	要求した大きさに対してmallocが確保するヒープの量.(バイト).
+	 * @param	size_t i_lRequest 要求する大きさ.(バイト).
+	 * @return	管理領域と切り上げを含めた量.(0は確保しない).
+	 * @note	glibc(64bit)の場合.(8バイトの管理領域を足して16バイト単位に切り上げ, 最小32バイト.
+	 *          mmap()の閾値(既定128KiB)以上はページ単位).
+	 */
+	static size_t getHeapByte(size_t i_lRequest)
+	{
+		if(0 == i_lRequest) return 0;
+		if(MMAP_THRESHOLD <= i_lRequest) return (i_lRequest + 16 + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+		size_t a_lChunk = (i_lRequest + 8 + 15) & ~static_cast<size_t>(15);
+		return (a_lChunk < 32)? 32 : a_lChunk;
+	}
+
+	/**
+	 * @brief	vectorが確保しているヒープの量.(バイト).
+	 */
+	template<typename T>
+	static size_t getVectorByte(const std::vector<T>& i_vecData)
+	{
+		return getHeapByte(i_vecData.capacity() * sizeof(T));
+	}
+
+    /**
+     * @brief   コンストラクタ.
+     */
+	MemoryUsage() { this->clear(); }
+
+	/**
+	 * @brief	全ての分類を0にする.
+	 */
+	void clear() { memset(this->m_rglByte, 0, sizeof(this->m_rglByte)); }
+
+	/**
+	 * @brief	分類へ加算する.
+	 * @param	CATEGORY i_eCategory 分類.
+	 * @param	size_t i_lByte 量.(バイト).
+	 * @return	なし.
+	 */
+	void add(CATEGORY i_eCategory, size_t i_lByte) { this->m_rglByte[i_eCategory] += i_lByte; }
+
+	/**
+	 * @brief	全ての分類を加算する.
+	 */
+	void add(const MemoryUsage& i_cUsage)
+	{
+		for(int a_iCategory=0; a_iCategory<CATEGORY_MAX; a_iCategory++) this->m_rglByte[a_iCategory] += i_cUsage.m_rglByte[a_iCategory];
+	}
+
+	/**
+	 * @brief	分類の量.(バイト).
+	 */
+	size_t get(CATEGORY i_eCategory) const { return this->m_rglByte[i_eCategory]; }
+
+	/**
+	 * @brief	合計.(バイト).
+	 */
+	size_t getTotal() const
+	{
+		size_t a_lTotal = 0;
+		for(int a_iCategory=0; a_iCategory<CATEGORY_MAX; a_iCategory++) a_lTotal += this->m_rglByte[a_iCategory];
+		return a_lTotal;
+	}
+
+	/**
+	 * @brief	1行出力する.
+	 * @param	FILE* i_pFile 出力先.
+	 * @return	なし.
+	 * @note	"合計 MB (cell ... link ... cache ... history ... hash ...)" の形式.(MB = 1024 * 1024バイト).
+	 */
+	void dump(FILE* i_pFile) const
+	{
+		fprintf(i_pFile, "%.1f MB (", this->getTotal() / (1024.0 * 1024.0));
+		for(int a_iCategory=0; a_iCategory<CATEGORY_MAX; a_iCategory++)
+		{
+			fprintf(i_pFile, "%s%s %.1f", (0 == a_iCategory)? "" : ", ", getCategoryName(a_iCategory), this->m_rglByte[a_iCategory] / (1024.0 * 1024.0));
+		}
+		fprintf(i_pFile, ")\n");
+	}
+
+private:
+	enum {
+		MMAP_THRESHOLD = 128 * 1024,
+		PAGE_SIZE = 4096,
+	};
+
+	size_t m_rglByte[CATEGORY_MAX];
+};
+
+#endif	// __MEMORY_USAGE_H__
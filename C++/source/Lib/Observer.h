@@ -6,38 +6,35 @@
 #ifndef __OBSERVER_H__
 #define __OBSERVER_H__
 
-#include <list>
-#include <iterator>
-
-/**
- * @brief   オブザーバーパターンにおいて通知を行う場合, 通知したい情報
- * @note    何も定義していないクラス.定義は具象クラスで行う.
- */
-class Information
-{
-};
+#include <vector>
+#include <algorithm>
 
 /**
  * @brief   デザインパターン(オブザーバーパターン) Observer
- *
+ * @tparam  MSG 通知に伴うメッセージの型.(受信側でキャストせずに使える).
  */
+template<typename MSG>
 class Observer
 {
 public:
+    virtual ~Observer(){ }
+
     /**
      * @brief   Subjetから通知を受信.
-     * @param   Information* i_pcInformation 通知に伴うメッセージ.
+     * @param   const MSG* i_pcMessage 通知に伴うメッセージ.
      * @return  結果を返す.
      */
-    virtual bool update(Information* i_pcInformation=0) = 0;
+    virtual bool update(const MSG* i_pcMessage=0) = 0;
 };
 
 
 
 /**
  * @brief   デザインパターン(オブザーバーパターン) Subject
- *
+ * @tparam  MSG 通知に伴うメッセージの型.(Observer<MSG>だけを登録できる).
+ * @note    実行時に任意のObserverを登録できる.(通知は仮想関数呼び出し).
  */
+template<typename MSG>
 class Subject
 {
 public:
@@ -46,26 +43,22 @@ public:
 
     /**
      * @brief   Observerを登録する.
-     * @param   Observer* i_pcObserver 登録するオブザーバ.
+     * @param   Observer<MSG>* i_pcObserver 登録するオブザーバ.
      * @return  なし.
      */
-    virtual void attach(Observer* i_pcObserver)
+    virtual void attach(Observer<MSG>* i_pcObserver)
     {
         m_pcObserverList.push_back(i_pcObserver);
     }
 
     /**
      * @brief   Observerを登録解除する.
-     * @param   Observer* i_pcObserver 登録解除するオブザーバ.
+     * @param   Observer<MSG>* i_pcObserver 登録解除するオブザーバ.
      * @return  なし.
      */
-    virtual void detach(Observer* i_pcObserver)
+    virtual void detach(Observer<MSG>* i_pcObserver)
     {
-        std::list<Observer*>::iterator a_Iterator;
-        for(a_Iterator=m_pcObserverList.begin(); a_Iterator!=m_pcObserverList.end(); ++a_Iterator)
-        {
-            if( (*a_Iterator)==i_pcObserver ) m_pcObserverList.erase(a_Iterator);
-        }
+        m_pcObserverList.erase(std::remove(m_pcObserverList.begin(), m_pcObserverList.end(), i_pcObserver), m_pcObserverList.end());
     }
 
     /**
@@ -75,40 +68,107 @@ public:
      * @retval  true    持っている.
      * @retval  false   持っていない.
      */
-    virtual bool hasObserver(Observer* i_pcObserver)
+    virtual bool hasObserver(Observer<MSG>* i_pcObserver) const
     {
-        std::list<Observer*>::iterator a_Iterator;
-        for(a_Iterator=m_pcObserverList.begin(); a_Iterator!=m_pcObserverList.end(); ++a_Iterator)
+        return m_pcObserverList.end() != std::find(m_pcObserverList.begin(), m_pcObserverList.end(), i_pcObserver);
+    }
+
+protected:
+    /**
+     * @brief   Observerへ通知を送信.
+     * @param   const MSG* i_pcMessage 通知に伴うメッセージ.
+     * @return  なし.
+     */
+    void notify(const MSG* i_pcMessage=0)
+    {
+        for(size_t a_lIndex=0; a_lIndex<m_pcObserverList.size(); a_lIndex++)
         {
-            if( (*a_Iterator)==i_pcObserver ) return true;
+            m_pcObserverList[a_lIndex]->update(i_pcMessage);
         }
+    }
+
+    /**
+     * @brief   登録されたオブザーバ
+     */
+    std::vector<Observer<MSG>*> m_pcObserverList;
+};
+
+
+
+/**
+ * @brief   デザインパターン(オブザーバーパターン) Subject.(Observerの型と最大数をコンパイル時に決める).
+ * @tparam  MSG 通知に伴うメッセージの型.
+ * @tparam  OBSERVER Observerの型.(bool update(const MSG*)を持つこと. 仮想関数でなくてよい).
+ * @tparam  N 登録できるObserverの最大数.
+ * @note    Observerは固定長の配列に持ち, 通知はOBSERVER::update()を直接呼ぶ.(インライン展開できる).
+ *          Cellの隣接セルのように, 相手の型と数が決まっていて通知の回数が多い場合に使う.
+ */
+template<typename MSG, typename OBSERVER, int N>
+class StaticSubject
+{
+public:
+    StaticSubject() : m_iObserverNum(0) { }
+
+    /**
+     * @brief   Observerを登録する.
+     * @param   OBSERVER* i_pcObserver 登録するオブザーバ.
+     * @return  成功/失敗.(N個登録済みの場合は失敗).
+     */
+    bool attach(OBSERVER* i_pcObserver)
+    {
+        if(N <= m_iObserverNum) return false;
+        m_rgpcObserver[m_iObserverNum++] = i_pcObserver;
+        return true;
+    }
 
-        return false;
+    /**
+     * @brief   Observerを登録解除する.
+     * @param   OBSERVER* i_pcObserver 登録解除するオブザーバ.
+     * @return  なし.
+     */
+    void detach(OBSERVER* i_pcObserver)
+    {
+        m_iObserverNum = static_cast<int>(std::remove(m_rgpcObserver, m_rgpcObserver + m_iObserverNum, i_pcObserver) - m_rgpcObserver);
     }
 
+    /**
+     * @brief   Observerを持っているか否かを確認する.
+     * @param   i_pcObserver 確認するオブザーバ.
+     * @return  引数で渡されたオブザーバを持っているかをどうか返す.
+     */
+    bool hasObserver(OBSERVER* i_pcObserver) const
+    {
+        return (m_rgpcObserver + m_iObserverNum) != std::find(m_rgpcObserver, m_rgpcObserver + m_iObserverNum, i_pcObserver);
+    }
+
+    /**
+     * @brief   登録されたObserverの数.
+     */
+    int getObserverNum() const { return m_iObserverNum; }
+
 protected:
     /**
      * @brief   Observerへ通知を送信.
-     * @param   Information* i_pcInformation 通知に伴うメッセージ.
+     * @param   const MSG* i_pcMessage 通知に伴うメッセージ.
      * @return  なし.
      */
-    virtual void notify(Information* i_pcInformation=0)
+    void notify(const MSG* i_pcMessage=0)
     {
-        bool a_bRet=false;
-
-        std::list<Observer*>::iterator a_Iterator;
-        for(a_Iterator=m_pcObserverList.begin(); a_Iterator!=m_pcObserverList.end(); ++a_Iterator)
+        for(int a_iIndex=0; a_iIndex<m_iObserverNum; a_iIndex++)
         {
-            a_bRet = (*a_Iterator)->update(i_pcInformation);
+            m_rgpcObserver[a_iIndex]->update(i_pcMessage);
         }
     }
 
     /**
      * @brief   登録されたオブザーバ
      */
-    std::list<Observer*> m_pcObserverList;
-private:
+    OBSERVER* m_rgpcObserver[N];
 
+    /**
+     * @brief   登録されたオブザーバの数.
+     */
+    int m_iObserverNum;
 };
 
 #endif  //__OBSERVER_H__
@@ -0,0 +1,49 @@
+/**
+ * @file    ParallelFor.h
+ * @brief   範囲を分割して複数スレッドで処理する関数.
+ */
+#ifndef __PARALLEL_FOR_H__
+#define __PARALLEL_FOR_H__
+
+#include <vector>
+#include <thread>
+
+/**
+ * @brief   [i_lBegin, i_lEnd)をi_iThreadNum個の連続した範囲に分割し, 各範囲を別スレッドで処理する.
+ * @param   long i_lBegin 開始.
+ * @param   long i_lEnd 終了.(含まない).
+ * @param   int i_iThreadNum スレッド数.(1以下ならば呼び出し元のスレッドで処理する).
+ * @param   FUNC i_cFunc 処理. void(long i_lBegin, long i_lEnd) の形式.
+ * @return  なし.
+ * @note    全ての範囲の処理が終わるまで戻らない.
+ * @note    範囲の処理が互いに干渉しないこと.(行ごとの処理などに使う).
+ */
+template<typename FUNC>
+void parallelFor(long i_lBegin, long i_lEnd, int i_iThreadNum, FUNC i_cFunc)
+{
+	long a_lNum = i_lEnd - i_lBegin;
+	if(a_lNum <= 0) return;
+	if(i_iThreadNum > a_lNum) i_iThreadNum = static_cast<int>(a_lNum);
+	if(i_iThreadNum <= 1)
+	{
+		i_cFunc(i_lBegin, i_lEnd);
+		return;
+	}
+
+	// 最後の範囲は呼び出し元のスレッドで処理する.
+	std::vector<std::thread> a_vecThread;
+	for(int a_iIndex=0; a_iIndex<i_iThreadNum-1; a_iIndex++)
+	{
+		long a_lFrom = i_lBegin + a_lNum * a_iIndex / i_iThreadNum;
+		long a_lTo = i_lBegin + a_lNum * (a_iIndex + 1) / i_iThreadNum;
+		a_vecThread.push_back(std::thread(i_cFunc, a_lFrom, a_lTo));
+	}
+	i_cFunc(i_lBegin + a_lNum * (i_iThreadNum - 1) / i_iThreadNum, i_lEnd);
+
+	for(size_t a_lIndex=0; a_lIndex<a_vecThread.size(); a_lIndex++)
+	{
+		a_vecThread[a_lIndex].join();
+	}
+}
+
+#endif	// __PARALLEL_FOR_H__
@@ -0,0 +1,340 @@
+/**
+ * @file    Profiler.h
+ * @brief   Modelの処理段階毎の時間と件数の計測.
+ */
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "Clock.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief   Modelの処理段階毎の時間と件数の計測.
+ * @note    LIFEGAME_PROFILEを定義してビルドした場合のみ計測する.(make PROFILE=1).
+ *          定義しない場合, 計測用のマクロ(PROFILE_PHASE, PROFILE_COUNT, PROFILE_END_GENERATION)は何も生成せず,
+ *          取得できる値は全て0になる.
+ * @note    時間と件数はスレッド毎の領域に加算し, 世代の終わりにendGeneration()で合計する.
+ *          endGeneration()は計測対象のスレッドが加算を終えた後(parallelFor()の後など)に呼ぶこと.
+ * @note    領域は加算の間だけ使用中の印を立てて取る. 取れなければ次の領域を試すので,
+ *          スレッドの作り直しで番号が一巡しても, 同時に動くスレッドが同じ領域へ書き込むことはない.
+ * @note    並列に実行した段階の時間は全スレッドの合計.
+ */
+class Profiler
+{
+public:
+	/**
+	 * @brief	処理段階.
+	 */
+	enum PHASE {
+		PHASE_SEND = 0,		// 隣接セルへの状態の通知.(sendStateToNeighborCell).
+		PHASE_DECIDE,		// 次世代の決定.(decideNextGeneration).
+		PHASE_NOTIFY,		// Observerへの変化の通知.
+		PHASE_EXPORT,		// BitBoardへの書き出し.(exportBitBoard).
+		PHASE_MAX,
+	};
+
+	/**
+	 * @brief	件数.
+	 */
+	enum COUNTER {
+		COUNTER_VISITED = 0,	// 調べたセル数.
+		COUNTER_CHANGED,		// 状態が変化したセル数.
+		COUNTER_NOTIFY,			// Observerへの通知の回数.
+		COUNTER_MAX,
+	};
+
+	/**
+	 * @brief	集計結果.
+	 */
+	struct RECORD
+	{
+		long m_lGeneration;						// 最後に集計した世代.
+		long m_lGenerationNum;					// 集計した世代数.
+		double m_rgdWallSecond[PHASE_MAX];		// 経過時間.(秒).
+		double m_rgdCpuSecond[PHASE_MAX];		// CPU時間.(秒).
+		long m_rglCounter[COUNTER_MAX];			// 件数.
+	};
+
+	/**
+	 * @brief	計測するか否か.(LIFEGAME_PROFILEを定義してビルドしたか).
+	 */
+	static bool isEnabled()
+	{
+#ifdef LIFEGAME_PROFILE
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief	処理段階の名前.
+	 */
+	static const char* getPhaseName(int i_iPhase)
+	{
+		static const char* s_rgpName[PHASE_MAX] = { "send", "decide", "notify", "export" };
+		return s_rgpName[i_iPhase];
+	}
+
+	/**
+	 * @brief	件数の名前.
+	 */
+	static const char* getCounterName(int i_iCounter)
+	{
+		static const char* s_rgpName[COUNTER_MAX] = { "visited", "changed", "notified" };
+		return s_rgpName[i_iCounter];
+	}
+
+    /**
+     * @brief   コンストラクタ.
+     */
+	Profiler()
+	{
+		for(int a_iSlot=0; a_iSlot<THREAD_MAX; a_iSlot++)
+		{
+			this->m_rgstSlot[a_iSlot].m_bIsBusy.store(false, std::memory_order_relaxed);
+		}
+		clearSlot();
+		clear(this->m_stLast);
+		clear(this->m_stTotal);
+		clear(this->m_stInterval);
+		this->m_pDumpFile = 0;
+		this->m_lDumpEvery = 0;
+	}
+
+	/**
+	 * @brief	呼び出したスレッドの領域へ時間を加算する.
+	 * @param	PHASE i_ePhase 処理段階.
+	 * @param	double i_dWallSecond 経過時間.(秒).
+	 * @param	double i_dCpuSecond CPU時間.(秒).
+	 * @return	なし.
+	 */
+	void addTime(PHASE i_ePhase, double i_dWallSecond, double i_dCpuSecond)
+	{
+		SLOT& a_stSlot = lockSlot();
+		a_stSlot.m_rgdWallSecond[i_ePhase] += i_dWallSecond;
+		a_stSlot.m_rgdCpuSecond[i_ePhase] += i_dCpuSecond;
+		a_stSlot.m_bIsBusy.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * @brief	呼び出したスレッドの領域へ件数を加算する.
+	 * @param	COUNTER i_eCounter 件数の種類.
+	 * @param	long i_lCount 加算する件数.
+	 * @return	なし.
+	 */
+	void addCount(COUNTER i_eCounter, long i_lCount)
+	{
+		SLOT& a_stSlot = lockSlot();
+		a_stSlot.m_rglCounter[i_eCounter] += i_lCount;
+		a_stSlot.m_bIsBusy.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * @brief	全スレッドの領域を1世代分として合計する.
+	 * @param	long i_lGeneration 終わった世代.
+	 * @return	なし.
+	 * @note	出力先を設定していれば, 設定した世代数毎に1世代あたりの平均を1行出力する.
+	 */
+	void endGeneration(long i_lGeneration)
+	{
+		clear(this->m_stLast);
+		for(int a_iSlot=0; a_iSlot<THREAD_MAX; a_iSlot++)
+		{
+			SLOT& a_stSlot = this->m_rgstSlot[a_iSlot];
+			for(int a_iPhase=0; a_iPhase<PHASE_MAX; a_iPhase++)
+			{
+				this->m_stLast.m_rgdWallSecond[a_iPhase] += a_stSlot.m_rgdWallSecond[a_iPhase];
+				this->m_stLast.m_rgdCpuSecond[a_iPhase] += a_stSlot.m_rgdCpuSecond[a_iPhase];
+			}
+			for(int a_iCounter=0; a_iCounter<COUNTER_MAX; a_iCounter++)
+			{
+				this->m_stLast.m_rglCounter[a_iCounter] += a_stSlot.m_rglCounter[a_iCounter];
+			}
+		}
+		clearSlot();
+		this->m_stLast.m_lGeneration = i_lGeneration;
+		this->m_stLast.m_lGenerationNum = 1;
+		add(this->m_stTotal, this->m_stLast);
+		add(this->m_stInterval, this->m_stLast);
+
+		if( (0 != this->m_pDumpFile) && (this->m_lDumpEvery <= this->m_stInterval.m_lGenerationNum) )
+		{
+			dump(this->m_pDumpFile, this->m_stInterval);
+			clear(this->m_stInterval);
+		}
+	}
+
+	/**
+	 * @brief	直前の世代の集計結果.
+	 */
+	const RECORD& getLast() const { return this->m_stLast; }
+
+	/**
+	 * @brief	計測を始めてからの集計結果.
+	 */
+	const RECORD& getTotal() const { return this->m_stTotal; }
+
+	/**
+	 * @brief	定期的な出力を設定する.
+	 * @param	FILE* i_pFile 出力先.(0は出力しない).
+	 * @param	long i_lEvery 出力する間隔.(世代数).
+	 * @return	なし.
+	 */
+	void setDump(FILE* i_pFile, long i_lEvery)
+	{
+		this->m_pDumpFile = (0 < i_lEvery)? i_pFile : 0;
+		this->m_lDumpEvery = i_lEvery;
+		clear(this->m_stInterval);
+	}
+
+	/**
+	 * @brief	集計結果を1世代あたりの平均として1行出力する.
+	 * @param	FILE* i_pFile 出力先.
+	 * @param	const RECORD& i_stRecord 集計結果.
+	 * @return	なし.
+	 * @note	"profile gen=G n=N send=壁/CPU ... visited=V ..." の形式.(時間はミリ秒).
+	 */
+	static void dump(FILE* i_pFile, const RECORD& i_stRecord)
+	{
+		double a_dNum = (0 < i_stRecord.m_lGenerationNum)? static_cast<double>(i_stRecord.m_lGenerationNum) : 1.0;
+		fprintf(i_pFile, "profile gen=%ld n=%ld", i_stRecord.m_lGeneration, i_stRecord.m_lGenerationNum);
+		for(int a_iPhase=0; a_iPhase<PHASE_MAX; a_iPhase++)
+		{
+			fprintf(i_pFile, " %s=%.3f/%.3fms", getPhaseName(a_iPhase),
+				i_stRecord.m_rgdWallSecond[a_iPhase] * 1000.0 / a_dNum, i_stRecord.m_rgdCpuSecond[a_iPhase] * 1000.0 / a_dNum);
+		}
+		for(int a_iCounter=0; a_iCounter<COUNTER_MAX; a_iCounter++)
+		{
+			fprintf(i_pFile, " %s=%.0f", getCounterName(a_iCounter), i_stRecord.m_rglCounter[a_iCounter] / a_dNum);
+		}
+		fprintf(i_pFile, "\n");
+		fflush(i_pFile);
+	}
+
+	/**
+	 * @brief	処理段階の時間を測る.(スコープを抜けるときに加算する).
+	 */
+	class Scope
+	{
+	public:
+		Scope(Profiler& io_cProfiler, PHASE i_ePhase) : m_cProfiler(io_cProfiler), m_ePhase(i_ePhase)
+		{
+			this->m_dWallSecond = getSecond();
+			this->m_dCpuSecond = getThreadCpuSecond();
+		}
+		~Scope()
+		{
+			this->m_cProfiler.addTime(this->m_ePhase, getSecond() - this->m_dWallSecond, getThreadCpuSecond() - this->m_dCpuSecond);
+		}
+
+	private:
+		Profiler& m_cProfiler;
+		PHASE m_ePhase;
+		double m_dWallSecond;
+		double m_dCpuSecond;
+	};
+
+private:
+	/**
+	 * @brief	スレッド毎の領域の数.(これを超えるスレッドが同時に加算する場合は空くまで待つ).
+	 */
+#ifdef LIFEGAME_PROFILE
+	enum { THREAD_MAX = 64 };
+#else
+	enum { THREAD_MAX = 1 };
+#endif
+
+	/**
+	 * @brief	スレッド毎の領域.(キャッシュラインを共有しないように揃える).
+	 */
+	struct alignas(64) SLOT
+	{
+		std::atomic<bool> m_bIsBusy;			// 加算中のスレッドがあるか.
+		double m_rgdWallSecond[PHASE_MAX];
+		double m_rgdCpuSecond[PHASE_MAX];
+		long m_rglCounter[COUNTER_MAX];
+	};
+
+	/**
+	 * @brief	呼び出したスレッドが最初に試す領域の番号.(初めて呼んだ順に割り当てる).
+	 */
+	static int getThreadSlot()
+	{
+		static std::atomic<int> s_iNextSlot(0);
+		thread_local int t_iSlot = s_iNextSlot.fetch_add(1) % THREAD_MAX;
+		return t_iSlot;
+	}
+
+	/**
+	 * @brief	空いている領域を使用中にして取る.(使い終わったらm_bIsBusyをfalseに戻す).
+	 * @note	番号が重なった別のスレッドが加算中ならば次の番号を試す.
+	 */
+	SLOT& lockSlot()
+	{
+		int a_iSlot = getThreadSlot();
+		while(this->m_rgstSlot[a_iSlot].m_bIsBusy.exchange(true, std::memory_order_acquire))
+		{
+			a_iSlot = (a_iSlot + 1) % THREAD_MAX;
+		}
+		return this->m_rgstSlot[a_iSlot];
+	}
+
+	/**
+	 * @brief	全スレッドの領域の値を0にする.(使用中の印は変えない).
+	 */
+	void clearSlot()
+	{
+		for(int a_iSlot=0; a_iSlot<THREAD_MAX; a_iSlot++)
+		{
+			SLOT& a_stSlot = this->m_rgstSlot[a_iSlot];
+			memset(a_stSlot.m_rgdWallSecond, 0, sizeof(a_stSlot.m_rgdWallSecond));
+			memset(a_stSlot.m_rgdCpuSecond, 0, sizeof(a_stSlot.m_rgdCpuSecond));
+			memset(a_stSlot.m_rglCounter, 0, sizeof(a_stSlot.m_rglCounter));
+		}
+	}
+
+	static void clear(RECORD& o_stRecord) { memset(&o_stRecord, 0, sizeof(o_stRecord)); }
+
+	static void add(RECORD& io_stRecord, const RECORD& i_stRecord)
+	{
+		for(int a_iPhase=0; a_iPhase<PHASE_MAX; a_iPhase++)
+		{
+			io_stRecord.m_rgdWallSecond[a_iPhase] += i_stRecord.m_rgdWallSecond[a_iPhase];
+			io_stRecord.m_rgdCpuSecond[a_iPhase] += i_stRecord.m_rgdCpuSecond[a_iPhase];
+		}
+		for(int a_iCounter=0; a_iCounter<COUNTER_MAX; a_iCounter++) io_stRecord.m_rglCounter[a_iCounter] += i_stRecord.m_rglCounter[a_iCounter];
+		io_stRecord.m_lGeneration = i_stRecord.m_lGeneration;
+		io_stRecord.m_lGenerationNum += i_stRecord.m_lGenerationNum;
+	}
+
+	SLOT m_rgstSlot[THREAD_MAX];
+	RECORD m_stLast;
+	RECORD m_stTotal;
+	RECORD m_stInterval;
+	FILE* m_pDumpFile;
+	long m_lDumpEvery;
+};
+
+/**
+ * @brief	計測用のマクロ.(LIFEGAME_PROFILEを定義しない場合は何も生成しない).
+ * @note	PROFILE_PHASE(計測, 段階)        スコープの終わりまでの時間を段階に加算する.
+ *          PROFILE_COUNT(計測, 種類, 件数)   件数を加算する.
+ *          PROFILE_END_GENERATION(計測, 世代) 1世代分を合計する.
+ */
+#ifdef LIFEGAME_PROFILE
+#define PROFILE_CONCAT_(a, b)						a##b
+#define PROFILE_CONCAT(a, b)						PROFILE_CONCAT_(a, b)
+#define PROFILE_PHASE(profiler, phase)				Profiler::Scope PROFILE_CONCAT(a_cProfileScope, __LINE__)((profiler), (phase))
+#define PROFILE_COUNT(profiler, counter, count)		(profiler).addCount((counter), (count))
+#define PROFILE_END_GENERATION(profiler, generation)	(profiler).endGeneration(generation)
+#else
+#define PROFILE_PHASE(profiler, phase)				((void)0)
+#define PROFILE_COUNT(profiler, counter, count)		((void)0)
+#define PROFILE_END_GENERATION(profiler, generation)	((void)0)
+#endif
+
+#endif	// __PROFILER_H__
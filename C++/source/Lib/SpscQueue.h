@@ -0,0 +1,108 @@
+/**
+ * @file    SpscQueue.h
+ * @brief   1対1のスレッド間でロックを使わずに値を受け渡すキュー.
+ */
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief   書き込み1スレッド/読み出し1スレッドのリングバッファ.(Single Producer Single Consumer).
+ * @note    push()は書き込み側の1スレッドだけ, pop()は読み出し側の1スレッドだけが呼ぶこと.
+ * @note    ロックもシステムコールも使わない. 空/満杯の時は待たずにfalseを返す.(待つ場合は呼び出し側で行う).
+ * @note    値はpush()で要素へコピー(または移動)し, pop()で移動して取り出す. push()より前の書き込みはpop()した側から見える.
+ * @tparam  T 値の型.
+ * @tparam  N 容量.(要素数).
+ */
+template<typename T, size_t N>
+class SpscQueue
+{
+public:
+    /**
+     * @brief   コンストラクタ.
+     */
+    SpscQueue() : m_ulHead(0), m_ulTail(0) { }
+
+    /**
+     * @brief   値を末尾へ追加.(書き込み側).
+     * @param   const T& i_cValue 値.
+     * @return  成功/失敗.(満杯の場合は失敗).
+     */
+    bool push(const T& i_cValue)
+    {
+        size_t a_ulTail = this->m_ulTail.load(std::memory_order_relaxed);
+        if(N <= a_ulTail - this->m_ulHead.load(std::memory_order_acquire)) return false;
+
+        this->m_rgValue[a_ulTail % N] = i_cValue;
+        this->m_ulTail.store(a_ulTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief   値を末尾へ移動して追加.(書き込み側).
+     * @param   T&& io_cValue 値.(成功した場合のみ移動する).
+     * @return  成功/失敗.(満杯の場合は失敗).
+     * @note    大きなバッファを持つ値をコピーせずに渡す場合に使う.
+     */
+    bool push(T&& io_cValue)
+    {
+        size_t a_ulTail = this->m_ulTail.load(std::memory_order_relaxed);
+        if(N <= a_ulTail - this->m_ulHead.load(std::memory_order_acquire)) return false;
+
+        this->m_rgValue[a_ulTail % N] = std::move(io_cValue);
+        this->m_ulTail.store(a_ulTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief   先頭の値を取り出す.(読み出し側).
+     * @param   T& o_cValue 値.
+     * @return  成功/失敗.(空の場合は失敗).
+     */
+    bool pop(T& o_cValue)
+    {
+        size_t a_ulHead = this->m_ulHead.load(std::memory_order_relaxed);
+        if(a_ulHead == this->m_ulTail.load(std::memory_order_acquire)) return false;
+
+        o_cValue = std::move(this->m_rgValue[a_ulHead % N]);
+        this->m_rgValue[a_ulHead % N] = T();	// 要素に残ったメモリをすぐに手放す.
+        this->m_ulHead.store(a_ulHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief   空か否か.
+     * @note    どちらのスレッドから呼んでもよいが, 結果は呼んだ時点のもの.
+     */
+    bool empty() const
+    {
+        return this->m_ulHead.load(std::memory_order_acquire) == this->m_ulTail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief   容量.
+     */
+    static size_t capacity() { return N; }
+
+private:
+    /**
+     * @brief   要素.
+     */
+    T m_rgValue[N];
+
+    /**
+     * @brief   次に読み出す位置.(通し番号. 読み出し側だけが更新する).
+     * @note    書き込み側と同じキャッシュラインに置かない.
+     */
+    alignas(64) std::atomic<size_t> m_ulHead;
+
+    /**
+     * @brief   次に書き込む位置.(通し番号. 書き込み側だけが更新する).
+     */
+    alignas(64) std::atomic<size_t> m_ulTail;
+};
+
+#endif	// __SPSC_QUEUE_H__
@@ -0,0 +1,346 @@
+/**
+ * @file    Tracer.h
+ * @brief   処理の区間をスレッド毎に記録し, Chromeのtrace event形式で出力する.
+ */
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+#include "Clock.h"
+
+#include <atomic>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+/**
+ * @brief   処理の区間(開始時刻と終了時刻)の記録.
+ * @note    LIFEGAME_TRACEを定義してビルドした場合のみ記録する.(make TRACE=1).
+ *          定義しない場合, 記録用のマクロ(TRACE_SCOPE, TRACE_SCOPE_VALUE, TRACE_THREAD_NAME)は何も生成しない.
+ * @note    区間はスレッド毎の領域に追記する.(排他なし. 領域の割り当てもロックを使わない).
+ *          終了したスレッドの領域は, 後から作られたスレッドが続けて使う.(同じtidとして出力される).
+ * @note    出力(write(), save())はchrome://tracing や Perfetto で読める.
+ *          スレッドが止まり, 区間が途切れている所がパイプラインの待ちである.
+ */
+class Tracer
+{
+public:
+	enum {
+		CHUNK_EVENT_NUM = 512,		// 1塊の区間の数.(塊は必要になってから確保する).
+		CHUNK_MAX = 512,			// 1スレッドの塊の最大数.(これを超えた区間は捨てる).
+		THREAD_MAX = 256,			// 同時に記録できるスレッドの最大数.
+	};
+
+	/**
+	 * @brief	値を持たない区間.
+	 */
+	static constexpr long NO_VALUE = std::numeric_limits<long>::min();
+
+	/**
+	 * @brief	区間.
+	 * @note	分類と名前は文字列リテラル.(ポインタだけを持ち, 引用符などのエスケープはしない).
+	 */
+	struct EVENT
+	{
+		const char* m_pCategory;	// 分類.("model", "band", "render", "io", "sim").
+		const char* m_pName;		// 名前.
+		double m_dStart;			// 開始時刻.(getSecond()).
+		double m_dEnd;				// 終了時刻.(getSecond()).
+		long m_lValue;				// 付随する値.(世代, 帯の先頭行など. NO_VALUEは無し).
+	};
+
+	/**
+	 * @brief	記録するか否か.(LIFEGAME_TRACEを定義してビルドしたか).
+	 */
+	static bool isEnabled()
+	{
+#ifdef LIFEGAME_TRACE
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief	プロセスで唯一の記録を取得する.
+	 */
+	static Tracer& getInstance()
+	{
+		static Tracer s_cTracer;
+		return s_cTracer;
+	}
+
+	/**
+	 * @brief	記録を開始する.(時刻はここを0として出力する).
+	 * @return	なし.
+	 */
+	void start()
+	{
+		this->m_dOrigin = getSecond();
+		this->m_bIsRecording.store(true, std::memory_order_release);
+	}
+
+	/**
+	 * @brief	記録を停止する.(記録済みの区間は残る).
+	 * @return	なし.
+	 */
+	void stop()
+	{
+		this->m_bIsRecording.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * @brief	記録中か否か.
+	 */
+	bool isRecording() const { return this->m_bIsRecording.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief	呼び出したスレッドの領域へ区間を追記する.
+	 * @param	const char* i_pCategory 分類.
+	 * @param	const char* i_pName 名前.
+	 * @param	double i_dStart 開始時刻.(getSecond()).
+	 * @param	double i_dEnd 終了時刻.(getSecond()).
+	 * @param	long i_lValue 付随する値.(NO_VALUEは無し).
+	 * @return	なし.
+	 */
+	void add(const char* i_pCategory, const char* i_pName, double i_dStart, double i_dEnd, long i_lValue=NO_VALUE)
+	{
+		if(!this->isRecording()) return;
+
+		BUFFER* a_pstBuffer = this->getThreadBuffer();
+		if(0 == a_pstBuffer)
+		{
+			this->m_lDropNum.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// 書き込むのはこのスレッドだけなので, 書いてから件数を公開すればよい.
+		long a_lIndex = a_pstBuffer->m_lEventNum.load(std::memory_order_relaxed);
+		long a_lChunk = a_lIndex / CHUNK_EVENT_NUM;
+		if(CHUNK_MAX <= a_lChunk)
+		{
+			this->m_lDropNum.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		if(0 == a_pstBuffer->m_rgpstChunk[a_lChunk]) a_pstBuffer->m_rgpstChunk[a_lChunk] = new EVENT[CHUNK_EVENT_NUM];
+
+		EVENT& a_stEvent = a_pstBuffer->m_rgpstChunk[a_lChunk][a_lIndex % CHUNK_EVENT_NUM];
+		a_stEvent.m_pCategory = i_pCategory;
+		a_stEvent.m_pName = i_pName;
+		a_stEvent.m_dStart = i_dStart;
+		a_stEvent.m_dEnd = i_dEnd;
+		a_stEvent.m_lValue = i_lValue;
+		a_pstBuffer->m_lEventNum.store(a_lIndex + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief	呼び出したスレッドの名前を設定する.(出力のスレッド名になる).
+	 * @param	const char* i_pName 名前.(文字列リテラル).
+	 * @return	なし.
+	 */
+	void setThreadName(const char* i_pName)
+	{
+		BUFFER* a_pstBuffer = this->getThreadBuffer();
+		if(0 != a_pstBuffer) a_pstBuffer->m_pThreadName.store(i_pName, std::memory_order_release);
+	}
+
+	/**
+	 * @brief	記録した区間の数.
+	 */
+	long getEventNum() const
+	{
+		long a_lNum = 0;
+		for(int a_iIndex=0; a_iIndex<THREAD_MAX; a_iIndex++)
+		{
+			const BUFFER* a_pstBuffer = this->m_rgpstBuffer[a_iIndex].load(std::memory_order_acquire);
+			if(0 != a_pstBuffer) a_lNum += a_pstBuffer->m_lEventNum.load(std::memory_order_acquire);
+		}
+		return a_lNum;
+	}
+
+	/**
+	 * @brief	領域が足りずに捨てた区間の数.
+	 */
+	long getDropNum() const { return this->m_lDropNum.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief	記録した区間をChromeのtrace event形式(JSON)で出力する.
+	 * @param	FILE* i_pFile 出力先.
+	 * @return	成功/失敗.
+	 * @note	各区間は完了イベント("ph":"X")とし, 時刻はマイクロ秒で出力する.
+	 *          書き込み中のスレッドがあっても構わない.(その時点で公開済みの区間だけを出力する).
+	 */
+	bool write(FILE* i_pFile) const
+	{
+		fprintf(i_pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+		fprintf(i_pFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"LifeGame\"}}");
+		for(int a_iIndex=0; a_iIndex<THREAD_MAX; a_iIndex++)
+		{
+			const BUFFER* a_pstBuffer = this->m_rgpstBuffer[a_iIndex].load(std::memory_order_acquire);
+			if(0 == a_pstBuffer) continue;
+
+			const char* a_pThreadName = a_pstBuffer->m_pThreadName.load(std::memory_order_acquire);
+			if(0 != a_pThreadName)
+			{
+				fprintf(i_pFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+					a_iIndex + 1, a_pThreadName);
+			}
+
+			long a_lEventNum = a_pstBuffer->m_lEventNum.load(std::memory_order_acquire);
+			for(long a_lEvent=0; a_lEvent<a_lEventNum; a_lEvent++)
+			{
+				const EVENT& a_stEvent = a_pstBuffer->m_rgpstChunk[a_lEvent / CHUNK_EVENT_NUM][a_lEvent % CHUNK_EVENT_NUM];
+				fprintf(i_pFile, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+					a_stEvent.m_pName, a_stEvent.m_pCategory, a_iIndex + 1,
+					(a_stEvent.m_dStart - this->m_dOrigin) * 1000000.0, (a_stEvent.m_dEnd - a_stEvent.m_dStart) * 1000000.0);
+				if(NO_VALUE != a_stEvent.m_lValue) fprintf(i_pFile, ",\"args\":{\"value\":%ld}", a_stEvent.m_lValue);
+				fprintf(i_pFile, "}");
+			}
+		}
+		fprintf(i_pFile, "\n]}\n");
+		return (0 == fflush(i_pFile)) && (0 == ferror(i_pFile));
+	}
+
+	/**
+	 * @brief	記録した区間をファイルへ保存する.
+	 * @param	const std::string& i_strPath 保存先.
+	 * @return	成功/失敗.
+	 */
+	bool save(const std::string& i_strPath) const
+	{
+		FILE* a_pFile = fopen(i_strPath.c_str(), "w");
+		if(0 == a_pFile) return false;
+		bool a_bRet = this->write(a_pFile);
+		return (0 == fclose(a_pFile)) && a_bRet;
+	}
+
+	/**
+	 * @brief	区間を測る.(スコープを抜けるときに追記する).
+	 * @note	記録中でなければ時刻も取得しない.
+	 */
+	class Scope
+	{
+	public:
+		Scope(const char* i_pCategory, const char* i_pName, long i_lValue=NO_VALUE)
+			: m_pCategory(i_pCategory), m_pName(i_pName), m_lValue(i_lValue)
+		{
+			this->m_dStart = Tracer::getInstance().isRecording()? getSecond() : -1.0;
+		}
+		~Scope()
+		{
+			if(0.0 <= this->m_dStart) Tracer::getInstance().add(this->m_pCategory, this->m_pName, this->m_dStart, getSecond(), this->m_lValue);
+		}
+
+	private:
+		const char* m_pCategory;
+		const char* m_pName;
+		long m_lValue;
+		double m_dStart;
+	};
+
+private:
+	/**
+	 * @brief	スレッド毎の領域.
+	 * @note	使用中は持ち主のスレッドだけが書き込む.
+	 */
+	struct BUFFER
+	{
+		std::atomic<bool> m_bIsInUse;				// 使用中のスレッドがあるか.
+		std::atomic<const char*> m_pThreadName;		// スレッド名.(0は未設定).
+		std::atomic<long> m_lEventNum;				// 公開済みの区間の数.
+		EVENT* m_rgpstChunk[CHUNK_MAX];				// 区間の塊.
+	};
+
+	/**
+	 * @brief	スレッドの終了時に領域を手放す.
+	 */
+	struct OWNER
+	{
+		BUFFER* m_pstBuffer;
+		OWNER() : m_pstBuffer(0) { }
+		~OWNER() { if(0 != this->m_pstBuffer) this->m_pstBuffer->m_bIsInUse.store(false, std::memory_order_release); }
+	};
+
+	Tracer() : m_bIsRecording(false), m_lDropNum(0), m_dOrigin(0.0)
+	{
+		for(int a_iIndex=0; a_iIndex<THREAD_MAX; a_iIndex++) this->m_rgpstBuffer[a_iIndex].store(0, std::memory_order_relaxed);
+	}
+
+	~Tracer()
+	{
+		for(int a_iIndex=0; a_iIndex<THREAD_MAX; a_iIndex++)
+		{
+			BUFFER* a_pstBuffer = this->m_rgpstBuffer[a_iIndex].load(std::memory_order_acquire);
+			if(0 == a_pstBuffer) continue;
+			for(int a_iChunk=0; a_iChunk<CHUNK_MAX; a_iChunk++) delete[] a_pstBuffer->m_rgpstChunk[a_iChunk];
+			delete a_pstBuffer;
+		}
+	}
+
+	Tracer(const Tracer&);
+	Tracer& operator=(const Tracer&);
+
+	/**
+	 * @brief	呼び出したスレッドの領域.(初めて呼んだときに割り当てる. 割り当てられなければ0).
+	 */
+	BUFFER* getThreadBuffer()
+	{
+		thread_local OWNER t_stOwner;
+		if(0 == t_stOwner.m_pstBuffer) t_stOwner.m_pstBuffer = this->acquireBuffer();
+		return t_stOwner.m_pstBuffer;
+	}
+
+	/**
+	 * @brief	空いている領域を取る.(無ければ空いている番号に新しく作る).
+	 */
+	BUFFER* acquireBuffer()
+	{
+		for(int a_iIndex=0; a_iIndex<THREAD_MAX; a_iIndex++)
+		{
+			BUFFER* a_pstBuffer = this->m_rgpstBuffer[a_iIndex].load(std::memory_order_acquire);
+			if(0 == a_pstBuffer)
+			{
+				// 新しく作った領域を空いている番号へ置く.(他のスレッドに先を越されたら次の番号を試す).
+				BUFFER* a_pstNew = new BUFFER;
+				a_pstNew->m_bIsInUse.store(true, std::memory_order_relaxed);
+				a_pstNew->m_pThreadName.store(0, std::memory_order_relaxed);
+				a_pstNew->m_lEventNum.store(0, std::memory_order_relaxed);
+				for(int a_iChunk=0; a_iChunk<CHUNK_MAX; a_iChunk++) a_pstNew->m_rgpstChunk[a_iChunk] = 0;
+				if(this->m_rgpstBuffer[a_iIndex].compare_exchange_strong(a_pstBuffer, a_pstNew, std::memory_order_acq_rel)) return a_pstNew;
+				delete a_pstNew;
+			}
+
+			bool a_bIsInUse = false;
+			if(a_pstBuffer->m_bIsInUse.compare_exchange_strong(a_bIsInUse, true, std::memory_order_acq_rel))
+			{
+				a_pstBuffer->m_pThreadName.store(0, std::memory_order_release);
+				return a_pstBuffer;
+			}
+		}
+		return 0;
+	}
+
+	std::atomic<BUFFER*> m_rgpstBuffer[THREAD_MAX];
+	std::atomic<bool> m_bIsRecording;
+	std::atomic<long> m_lDropNum;
+	double m_dOrigin;
+};
+
+/**
+ * @brief	記録用のマクロ.(LIFEGAME_TRACEを定義しない場合は何も生成しない).
+ * @note	TRACE_SCOPE(分類, 名前)             スコープの終わりまでを1区間として記録する.
+ *          TRACE_SCOPE_VALUE(分類, 名前, 値)   値(世代, 帯の先頭行など)を付けて記録する.
+ *          TRACE_THREAD_NAME(名前)             呼び出したスレッドに名前を付ける.
+ */
+#ifdef LIFEGAME_TRACE
+#define TRACE_CONCAT_(a, b)							a##b
+#define TRACE_CONCAT(a, b)							TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(category, name)					Tracer::Scope TRACE_CONCAT(a_cTraceScope, __LINE__)((category), (name))
+#define TRACE_SCOPE_VALUE(category, name, value)	Tracer::Scope TRACE_CONCAT(a_cTraceScope, __LINE__)((category), (name), (value))
+#define TRACE_THREAD_NAME(name)						Tracer::getInstance().setThreadName(name)
+#else
+#define TRACE_SCOPE(category, name)					((void)0)
+#define TRACE_SCOPE_VALUE(category, name, value)	((void)0)
+#define TRACE_THREAD_NAME(name)						((void)0)
+#endif
+
+#endif	// __TRACER_H__
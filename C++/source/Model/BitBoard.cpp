@@ -0,0 +1,270 @@
+/**
+ * @file    BitBoard.cpp
+ * @brief   全セルの状態を1セル1ビットで保持するクラスの実装.
+ */
+#include "BitBoard.h"
+
+#include <algorithm>
+
+/******************************************
+ * 左端からi_lNumビットのマスク.
+ ******************************************/
+static inline BitBoard::WORD getLowMask(long i_lNum)
+{
+	if(BitBoard::WORD_BIT <= i_lNum) return ~static_cast<BitBoard::WORD>(0);
+	return (static_cast<BitBoard::WORD>(1) << i_lNum) - 1;
+}
+
+/******************************************
+ * ワードのビット順を反転.
+ ******************************************/
+static inline BitBoard::WORD reverseWord(BitBoard::WORD i_wBits)
+{
+	i_wBits = ((i_wBits >> 1) & 0x5555555555555555ULL) | ((i_wBits & 0x5555555555555555ULL) << 1);
+	i_wBits = ((i_wBits >> 2) & 0x3333333333333333ULL) | ((i_wBits & 0x3333333333333333ULL) << 2);
+	i_wBits = ((i_wBits >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((i_wBits & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	return __builtin_bswap64(i_wBits);
+}
+
+/******************************************
+ * 初期化.
+ ******************************************/
+void BitBoard::init(long i_lColMax, long i_lRowMax)
+{
+	this->m_lColMax = i_lColMax;
+	this->m_lRowMax = i_lRowMax;
+	this->m_lWordNum = (i_lColMax + WORD_BIT - 1) / WORD_BIT;
+	this->m_vecWord.assign(this->m_lWordNum * i_lRowMax, 0);
+}
+
+/******************************************
+ * 全セルを0(DEAD)にする.
+ ******************************************/
+void BitBoard::clear()
+{
+	this->m_vecWord.assign(this->m_vecWord.size(), 0);
+}
+
+/******************************************
+ * 別のBitBoardの1(ALIVE)のセルを書き込む.
+ ******************************************/
+void BitBoard::paste(const BitBoard& i_cSource, long i_lCol, long i_lRow)
+{
+	if( (0==this->m_lColMax) || (0==this->m_lRowMax) ) return;
+
+	for(long a_lRow=0; a_lRow<i_cSource.getRowMax(); a_lRow++)
+	{
+		long a_lDstRow = ((i_lRow + a_lRow) % this->m_lRowMax + this->m_lRowMax) % this->m_lRowMax;
+		for(long a_lCol=0; a_lCol<i_cSource.getColMax(); a_lCol++)
+		{
+			if(!i_cSource.getBit(a_lCol, a_lRow)) continue;
+			long a_lDstCol = ((i_lCol + a_lCol) % this->m_lColMax + this->m_lColMax) % this->m_lColMax;
+			this->setBit(a_lDstCol, a_lDstRow, true);
+		}
+	}
+}
+
+/******************************************
+ * 指定位置から64セル分のビットを取得.
+ ******************************************/
+BitBoard::WORD BitBoard::getBits(long i_lCol, long i_lRow) const
+{
+	if(0 > i_lCol)
+	{
+		if(-i_lCol >= WORD_BIT) return 0;
+		return this->getBits(0, i_lRow) << (-i_lCol);
+	}
+
+	long a_lWord = i_lCol / WORD_BIT;
+	long a_lShift = i_lCol % WORD_BIT;
+	if(a_lWord >= this->m_lWordNum) return 0;
+
+	const WORD* a_pWord = this->getRow(i_lRow);
+	WORD a_wBits = a_pWord[a_lWord] >> a_lShift;
+	if( (0 != a_lShift) && (a_lWord + 1 < this->m_lWordNum) )
+	{
+		a_wBits |= a_pWord[a_lWord + 1] << (WORD_BIT - a_lShift);
+	}
+	return a_wBits;
+}
+
+/******************************************
+ * 指定位置から64セル分のビットを設定.
+ ******************************************/
+void BitBoard::setBits(long i_lCol, long i_lRow, WORD i_wBits, WORD i_wMask)
+{
+	long a_lWord = i_lCol / WORD_BIT;
+	long a_lShift = i_lCol % WORD_BIT;
+	WORD* a_pWord = this->getRow(i_lRow);
+
+	i_wBits &= i_wMask;
+	a_pWord[a_lWord] = (a_pWord[a_lWord] & ~(i_wMask << a_lShift)) | (i_wBits << a_lShift);
+	if( (0 != a_lShift) && (a_lWord + 1 < this->m_lWordNum) )
+	{
+		long a_lRest = WORD_BIT - a_lShift;
+		a_pWord[a_lWord + 1] = (a_pWord[a_lWord + 1] & ~(i_wMask >> a_lRest)) | (i_wBits >> a_lRest);
+	}
+}
+
+/******************************************
+ * 矩形内の全セルを設定.
+ ******************************************/
+void BitBoard::fillRect(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight, bool i_bValue)
+{
+	WORD a_wBits = i_bValue? ~static_cast<WORD>(0) : 0;
+	for(long a_lRow=i_lRow; a_lRow<i_lRow+i_lHeight; a_lRow++)
+	{
+		for(long a_lCol=i_lCol; a_lCol<i_lCol+i_lWidth; a_lCol+=WORD_BIT)
+		{
+			this->setBits(a_lCol, a_lRow, a_wBits, getLowMask(i_lCol + i_lWidth - a_lCol));
+		}
+	}
+}
+
+/******************************************
+ * 矩形内の全セルを反転.
+ ******************************************/
+void BitBoard::invertRect(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	for(long a_lRow=i_lRow; a_lRow<i_lRow+i_lHeight; a_lRow++)
+	{
+		for(long a_lCol=i_lCol; a_lCol<i_lCol+i_lWidth; a_lCol+=WORD_BIT)
+		{
+			this->setBits(a_lCol, a_lRow, ~this->getBits(a_lCol, a_lRow), getLowMask(i_lCol + i_lWidth - a_lCol));
+		}
+	}
+}
+
+/******************************************
+ * 同じ大きさの別のBitBoardから矩形内のセルを写す.
+ ******************************************/
+void BitBoard::copyRect(const BitBoard& i_cSource, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	for(long a_lRow=i_lRow; a_lRow<i_lRow+i_lHeight; a_lRow++)
+	{
+		for(long a_lCol=i_lCol; a_lCol<i_lCol+i_lWidth; a_lCol+=WORD_BIT)
+		{
+			this->setBits(a_lCol, a_lRow, i_cSource.getBits(a_lCol, a_lRow), getLowMask(i_lCol + i_lWidth - a_lCol));
+		}
+	}
+}
+
+/******************************************
+ * 別のBitBoardの矩形を切り出す.
+ ******************************************/
+void BitBoard::extract(const BitBoard& i_cSource, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	this->init(i_lWidth, i_lHeight);
+	for(long a_lRow=0; a_lRow<i_lHeight; a_lRow++)
+	{
+		WORD* a_pWord = this->getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<this->m_lWordNum; a_lWord++)
+		{
+			a_pWord[a_lWord] = i_cSource.getBits(i_lCol + a_lWord * WORD_BIT, i_lRow + a_lRow);
+		}
+		if(0 < this->m_lWordNum) a_pWord[this->m_lWordNum - 1] &= this->getLastWordMask();
+	}
+}
+
+/******************************************
+ * 別のBitBoardを指定の方法で書き込む.
+ ******************************************/
+void BitBoard::pasteRect(const BitBoard& i_cSource, long i_lCol, long i_lRow, PASTE_MODE i_eMode)
+{
+	long a_lWidth = std::min(i_cSource.getColMax(), this->m_lColMax - i_lCol);
+	long a_lHeight = std::min(i_cSource.getRowMax(), this->m_lRowMax - i_lRow);
+
+	for(long a_lRow=0; a_lRow<a_lHeight; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<a_lWidth; a_lCol+=WORD_BIT)
+		{
+			WORD a_wSource = i_cSource.getBits(a_lCol, a_lRow);
+			WORD a_wBits = this->getBits(i_lCol + a_lCol, i_lRow + a_lRow);
+			switch(i_eMode)
+			{
+				case PASTE_OR:      a_wBits |= a_wSource; break;
+				case PASTE_XOR:     a_wBits ^= a_wSource; break;
+				case PASTE_REPLACE: a_wBits = a_wSource;  break;
+			}
+			this->setBits(i_lCol + a_lCol, i_lRow + a_lRow, a_wBits, getLowMask(a_lWidth - a_lCol));
+		}
+	}
+}
+
+/******************************************
+ * 時計回りに90度回転したBitBoardを作る.
+ ******************************************/
+void BitBoard::rotateClockwise(BitBoard& o_cRotated) const
+{
+	// 元の(col, row)は回転後の(rowMax-1-row, col)へ移る.
+	o_cRotated.init(this->m_lRowMax, this->m_lColMax);
+	for(long a_lRow=0; a_lRow<this->m_lRowMax; a_lRow++)
+	{
+		const WORD* a_pWord = this->getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<this->m_lWordNum; a_lWord++)
+		{
+			// 1(ALIVE)のビットだけを辿る.
+			WORD a_wBits = a_pWord[a_lWord];
+			while(0 != a_wBits)
+			{
+				long a_lCol = a_lWord * WORD_BIT + __builtin_ctzll(a_wBits);
+				o_cRotated.setBit(this->m_lRowMax - 1 - a_lRow, a_lCol, true);
+				a_wBits &= a_wBits - 1;
+			}
+		}
+	}
+}
+
+/******************************************
+ * 左右を反転.
+ ******************************************/
+void BitBoard::flipHorizontal()
+{
+	// 反転後のi番目のワードは, 元の右端から64セル分をビット反転したもの.
+	std::vector<WORD> a_vecRow(this->m_lWordNum);
+	for(long a_lRow=0; a_lRow<this->m_lRowMax; a_lRow++)
+	{
+		for(long a_lWord=0; a_lWord<this->m_lWordNum; a_lWord++)
+		{
+			long a_lCol = this->m_lColMax - (a_lWord + 1) * WORD_BIT;
+			a_vecRow[a_lWord] = reverseWord(this->getBits(a_lCol, a_lRow));
+		}
+		if(0 < this->m_lWordNum) a_vecRow[this->m_lWordNum - 1] &= this->getLastWordMask();
+		std::copy(a_vecRow.begin(), a_vecRow.end(), this->getRow(a_lRow));
+	}
+}
+
+/******************************************
+ * 上下を反転.
+ ******************************************/
+void BitBoard::flipVertical()
+{
+	for(long a_lRow=0; a_lRow<this->m_lRowMax/2; a_lRow++)
+	{
+		WORD* a_pTop = this->getRow(a_lRow);
+		std::swap_ranges(a_pTop, a_pTop + this->m_lWordNum, this->getRow(this->m_lRowMax - 1 - a_lRow));
+	}
+}
+
+/******************************************
+ * 1(ALIVE)のセル数を数える.
+ ******************************************/
+long BitBoard::count() const
+{
+	long a_lCount = 0;
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecWord.size(); a_lIndex++)
+	{
+		a_lCount += __builtin_popcountll(this->m_vecWord[a_lIndex]);
+	}
+	return a_lCount;
+}
+
+/******************************************
+ * 行の末尾ワードの有効ビットマスクを取得.
+ ******************************************/
+BitBoard::WORD BitBoard::getLastWordMask() const
+{
+	long a_lRest = this->m_lColMax % WORD_BIT;
+	if(0 == a_lRest) return ~static_cast<WORD>(0);
+	return (static_cast<WORD>(1) << a_lRest) - 1;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file    BitBoard.h
+ * @brief   全セルの状態を1セル1ビットで保持するクラスの宣言.
+ */
+
+#ifndef __BITBOARD_H__
+#define __BITBOARD_H__
+
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief   全セルの状態を1セル1ビットで保持するクラス.
+ * @note    1行を64ビットのワード列として保持する.(ビット0が左端のセル).
+ * @note    各行の末尾ワードの余りビットは常に0とする.
+ */
+class BitBoard
+{
+public:
+    /**
+     * @brief   1ワードの型.
+     */
+    typedef uint64_t WORD;
+
+    /**
+     * @brief   1ワードのビット数.
+     */
+    enum { WORD_BIT = 64 };
+
+    /**
+     * @brief   pasteRect()の書き込み方法.
+     */
+    enum PASTE_MODE {
+        PASTE_OR,       // 1(ALIVE)のセルだけ書き込む.
+        PASTE_XOR,      // 1(ALIVE)のセルを反転する.
+        PASTE_REPLACE,  // 矩形内を置き換える.
+    };
+
+    /**
+     * @brief   コンストラクタ.
+     */
+    BitBoard()
+	{
+		this->init(0, 0);
+	}
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   long i_lColMax 横幅.
+     * @param   long i_lRowMax 縦幅.
+     */
+    BitBoard(long i_lColMax, long i_lRowMax)
+	{
+		this->init(i_lColMax, i_lRowMax);
+	}
+
+    /**
+     * @brief   初期化.全セルを0(DEAD)にする.
+     * @param   long i_lColMax 横幅.
+     * @param   long i_lRowMax 縦幅.
+     * @return  なし.
+     */
+    void init(long i_lColMax, long i_lRowMax);
+
+    /**
+     * @brief   全セルを0(DEAD)にする.
+     * @param   なし.
+     * @return  なし.
+     */
+    void clear();
+
+    /**
+     * @brief   横幅を取得.
+     */
+    long getColMax() const { return this->m_lColMax; }
+
+    /**
+     * @brief   縦幅を取得.
+     */
+    long getRowMax() const { return this->m_lRowMax; }
+
+    /**
+     * @brief   1行のワード数を取得.
+     */
+    long getWordNum() const { return this->m_lWordNum; }
+
+    /**
+     * @brief   ワード列に確保している大きさ.(バイト).
+     */
+    size_t getByteSize() const { return this->m_vecWord.capacity() * sizeof(WORD); }
+
+    /**
+     * @brief   1行分のワード列を取得.
+     * @param   long i_lRow 縦位置.
+     * @return  ワード列の先頭.
+     */
+    WORD* getRow(long i_lRow) { return &(this->m_vecWord[i_lRow * this->m_lWordNum]); }
+
+    /**
+     * @brief   1行分のワード列を取得.
+     * @param   long i_lRow 縦位置.
+     * @return  ワード列の先頭.
+     */
+    const WORD* getRow(long i_lRow) const { return &(this->m_vecWord[i_lRow * this->m_lWordNum]); }
+
+    /**
+     * @brief   セルのビットを取得.
+     * @param   long i_lCol 横位置.
+     * @param   long i_lRow 縦位置.
+     * @return  true:1(ALIVE) false:0(DEAD).
+     */
+    bool getBit(long i_lCol, long i_lRow) const
+	{
+		const WORD* a_pWord = this->getRow(i_lRow);
+		return ( 0 != ((a_pWord[i_lCol / WORD_BIT] >> (i_lCol % WORD_BIT)) & 1) );
+	}
+
+    /**
+     * @brief   セルのビットを設定.
+     * @param   long i_lCol 横位置.
+     * @param   long i_lRow 縦位置.
+     * @param   bool i_bValue true:1(ALIVE) false:0(DEAD).
+     * @return  なし.
+     */
+    void setBit(long i_lCol, long i_lRow, bool i_bValue)
+	{
+		WORD* a_pWord = this->getRow(i_lRow);
+		WORD a_wMask = static_cast<WORD>(1) << (i_lCol % WORD_BIT);
+		if(i_bValue) a_pWord[i_lCol / WORD_BIT] |= a_wMask;
+		else         a_pWord[i_lCol / WORD_BIT] &= ~a_wMask;
+	}
+
+    /**
+     * @brief   セルのビットを反転.
+     * @param   long i_lCol 横位置.
+     * @param   long i_lRow 縦位置.
+     * @return  なし.
+     */
+    void toggleBit(long i_lCol, long i_lRow)
+	{
+		WORD* a_pWord = this->getRow(i_lRow);
+		a_pWord[i_lCol / WORD_BIT] ^= static_cast<WORD>(1) << (i_lCol % WORD_BIT);
+	}
+
+    /**
+     * @brief   別のBitBoardの1(ALIVE)のセルを書き込む.
+     * @param   const BitBoard& i_cSource 書き込むBitBoard.
+     * @param   long i_lCol 書き込む位置(左端).
+     * @param   long i_lRow 書き込む位置(上端).
+     * @return  なし.
+     * @note    はみ出した部分は反対側へ回り込む.(MatrixCellと同じく球面).
+     */
+    void paste(const BitBoard& i_cSource, long i_lCol, long i_lRow);
+
+    /**
+     * @brief   指定位置から64セル分のビットを取得.
+     * @param   long i_lCol 横位置(左端). 負の値や横幅を超える部分は0とする.
+     * @param   long i_lRow 縦位置.
+     * @return  64セル分のビット.(bit0が左端).
+     */
+    WORD getBits(long i_lCol, long i_lRow) const;
+
+    /**
+     * @brief   指定位置から64セル分のビットを設定.
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置.
+     * @param   WORD i_wBits 設定するビット.(bit0が左端).
+     * @param   WORD i_wMask 設定するビットのマスク.(横幅を超えないこと).
+     * @return  なし.
+     */
+    void setBits(long i_lCol, long i_lRow, WORD i_wBits, WORD i_wMask);
+
+    /**
+     * @brief   矩形内の全セルを設定.
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置(上端).
+     * @param   long i_lWidth 横幅.
+     * @param   long i_lHeight 縦幅.
+     * @param   bool i_bValue true:1(ALIVE) false:0(DEAD).
+     * @return  なし.
+     * @note    矩形は範囲内であること.(以下の矩形操作も同じ).
+     */
+    void fillRect(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight, bool i_bValue);
+
+    /**
+     * @brief   矩形内の全セルを反転.
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置(上端).
+     * @param   long i_lWidth 横幅.
+     * @param   long i_lHeight 縦幅.
+     * @return  なし.
+     */
+    void invertRect(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   同じ大きさの別のBitBoardから矩形内のセルを写す.
+     * @param   const BitBoard& i_cSource 写し元.(このBitBoardと同じ大きさ).
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置(上端).
+     * @param   long i_lWidth 横幅.
+     * @param   long i_lHeight 縦幅.
+     * @return  なし.
+     * @note    矩形の外のセルは変えない.
+     */
+    void copyRect(const BitBoard& i_cSource, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   別のBitBoardの矩形を切り出す.
+     * @param   const BitBoard& i_cSource 切り出し元.
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置(上端).
+     * @param   long i_lWidth 横幅.
+     * @param   long i_lHeight 縦幅.
+     * @return  なし.
+     * @note    大きさは切り出した矩形になる.
+     */
+    void extract(const BitBoard& i_cSource, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   別のBitBoardを指定の方法で書き込む.
+     * @param   const BitBoard& i_cSource 書き込むBitBoard.
+     * @param   long i_lCol 書き込む位置(左端).
+     * @param   long i_lRow 書き込む位置(上端).
+     * @param   PASTE_MODE i_eMode 書き込み方法.
+     * @return  なし.
+     * @note    はみ出した部分は書き込まない.(paste()と異なり回り込まない).
+     */
+    void pasteRect(const BitBoard& i_cSource, long i_lCol, long i_lRow, PASTE_MODE i_eMode);
+
+    /**
+     * @brief   時計回りに90度回転したBitBoardを作る.
+     * @param   BitBoard& o_cRotated 回転したBitBoard.(縦横の大きさが入れ替わる).
+     * @return  なし.
+     */
+    void rotateClockwise(BitBoard& o_cRotated) const;
+
+    /**
+     * @brief   左右を反転.
+     * @param   なし.
+     * @return  なし.
+     */
+    void flipHorizontal();
+
+    /**
+     * @brief   上下を反転.
+     * @param   なし.
+     * @return  なし.
+     */
+    void flipVertical();
+
+    /**
+     * @brief   1(ALIVE)のセル数を数える.
+     * @param   なし.
+     * @return  1(ALIVE)のセル数.
+     */
+    long count() const;
+
+    /**
+     * @brief   行の末尾ワードの有効ビットマスクを取得.
+     * @param   なし.
+     * @return  有効ビットマスク.
+     */
+    WORD getLastWordMask() const;
+
+    /**
+     * @brief   内容が等しいか否か.
+     */
+    bool operator==(const BitBoard& i_cOther) const
+	{
+		return (this->m_lColMax == i_cOther.m_lColMax)
+			&& (this->m_lRowMax == i_cOther.m_lRowMax)
+			&& (this->m_vecWord == i_cOther.m_vecWord);
+	}
+
+    /**
+     * @brief   内容が異なるか否か.
+     */
+    bool operator!=(const BitBoard& i_cOther) const { return !(*this == i_cOther); }
+
+private:
+    /**
+     * @brief   横幅.
+     */
+    long m_lColMax;
+
+    /**
+     * @brief   縦幅.
+     */
+    long m_lRowMax;
+
+    /**
+     * @brief   1行のワード数.
+     */
+    long m_lWordNum;
+
+    /**
+     * @brief   全行のワード列.
+     */
+    std::vector<WORD> m_vecWord;
+};
+
+#endif  //__BITBOARD_H__
@@ -9,17 +9,16 @@
  * 自分自身の状態を決定する.
  *
  ******************************************/
-bool Cell::decideState()
+bool Cell::decideState(const LifeRule& i_cRule)
 {
     CellAttribute::CELL_STATE a_ePreviousState = this->m_cAttribute.getState();  // 前状態を記憶.
     CellAttribute::CELL_STATE a_eNextState = this->m_cAttribute.getState();
 
 
 	// 次の状態を決定.
-	if(      true == this->isBorn() )				a_eNextState = CellAttribute::ALIVE;	// 誕生.
-	else if( true == this->isSurvive() )			a_eNextState = CellAttribute::ALIVE;	// 生存.
-	else if( true == this->isUnderPopulation() )	a_eNextState = CellAttribute::DEAD;		// 過疎.
-	else if( true == this->isOverPopulation() )		a_eNextState = CellAttribute::DEAD;		// 過密.
+	if(      true == this->isBorn(i_cRule) )		a_eNextState = CellAttribute::ALIVE;	// 誕生.
+	else if( true == this->isSurvive(i_cRule) )		a_eNextState = CellAttribute::ALIVE;	// 生存.
+	else if( true == this->isDie(i_cRule) )			a_eNextState = CellAttribute::DEAD;		// 過疎/過密.
 
 	// 隣接セルの生存数をクリア.
 	this->m_lNeighborAliveNum = 0;
@@ -35,15 +34,15 @@ bool Cell::decideState()
  *
  * 誕生.
  * 　自分自身と隣接セルの状態から, 誕生か否かを判定する.
- * 　死んでいるセルに隣接する生きたセルがちょうど3つあれば、次の世代が誕生する。
+ * 　死んでいるセルに隣接する生きたセルが規則の誕生の数(ライフゲームでは3つ)あれば、次の世代が誕生する。
  *
  ********************************************************************************/
-bool Cell::isBorn()
+bool Cell::isBorn(const LifeRule& i_cRule)
 {
     // 自分自身の状態.
     CellAttribute::CELL_STATE a_eState = this->m_cAttribute.getState();
 
-    if( (CellAttribute::DEAD==a_eState) && (3==this->m_lNeighborAliveNum) ) return true;
+    if( (CellAttribute::DEAD==a_eState) && i_cRule.isBorn(this->m_lNeighborAliveNum) ) return true;
     else return false;
 }
 
@@ -51,47 +50,31 @@ bool Cell::isBorn()
  *
  * 生存.
  * 　自分自身と隣接セルの状態から, 生存か否かを判定する.
- * 　生きているセルに隣接する生きたセルが2つか3つならば、次の世代でも生存する。
+ * 　生きているセルに隣接する生きたセルが規則の生存の数(ライフゲームでは2つか3つ)ならば、次の世代でも生存する。
  *
  *********************************************************************************/
-bool Cell::isSurvive()
+bool Cell::isSurvive(const LifeRule& i_cRule)
 {
     // 自分自身の状態.
     CellAttribute::CELL_STATE a_eState = this->m_cAttribute.getState();
 
-    if( (CellAttribute::ALIVE==a_eState) && (2==this->m_lNeighborAliveNum|| 3==this->m_lNeighborAliveNum) ) return true;
+    if( (CellAttribute::ALIVE==a_eState) && i_cRule.isSurvive(this->m_lNeighborAliveNum) ) return true;
     else return false;
 }
 
 /********************************************************************************
  *
- * 過疎.
- * 　自分自身と隣接セルの状態から, 過疎か否かを判定する.
- * 　生きているセルに隣接する生きたセルが1つ以下ならば、過疎により死滅する。
+ * 過疎/過密.
+ * 　自分自身と隣接セルの状態から, 過疎/過密か否かを判定する.
+ * 　生きているセルに隣接する生きたセルが規則の生存の数でなければ、過疎/過密により死滅する。
+ * 　(ライフゲームでは1つ以下で過疎, 4つ以上で過密).
  *
  ********************************************************************************/
-bool Cell::isUnderPopulation()
+bool Cell::isDie(const LifeRule& i_cRule)
 {
     // 自分自身の状態.
     CellAttribute::CELL_STATE a_eState = this->m_cAttribute.getState();
 
-    if( (CellAttribute::ALIVE==a_eState) && (1>=this->m_lNeighborAliveNum) ) return true;
+    if( (CellAttribute::ALIVE==a_eState) && !i_cRule.isSurvive(this->m_lNeighborAliveNum) ) return true;
     else return false;
 }
-
-/******************************************************************************
- *
- * 過密.
- * 　自分自身と隣接セルの状態から, 過密か否かを判定する.
- * 　生きているセルに隣接する生きたセルが4つ以上ならば、過密により死滅する。
- *
- ******************************************************************************/
-bool Cell::isOverPopulation()
-{
-    // 自分自身の状態.
-    CellAttribute::CELL_STATE a_eState = this->m_cAttribute.getState();
-
-    if( (CellAttribute::ALIVE==a_eState) && (4<=this->m_lNeighborAliveNum) ) return true;
-    else return false;
-}
-
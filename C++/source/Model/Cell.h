@@ -8,11 +8,13 @@
 
 #include "../Lib/Observer.h"
 #include "../Lib/CellAttribute.h"
+#include "../Lib/LifeRule.h"
 
 /**
  * @brief 細胞（セル）1個をあらわすクラス.
+ * @note  隣接セル(8個)へ状態を通知する.(Cell同士の通知は仮想関数を介さずCell::update()を直接呼ぶ).
  */
-class Cell : public Subject, Observer
+class Cell : public StaticSubject<CellAttribute, Cell, 8>
 {
 public:
 
@@ -93,18 +95,31 @@ public:
      * @retval  false   変更無し.
      * @note    隣接セルの状態から自分自身の状態を決定する.<br>
      *          記憶していた隣接セルの状態をクリアする.<br>
+     *          規則はライフゲーム(B3/S23).<br>
      */
-    bool decideState();
+    bool decideState()
+	{
+		static const LifeRule a_cRule;
+		return this->decideState(a_cRule);
+	}
+
+    /**
+     * @brief   自分自身の状態を決定する.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
+     * @return  前状態から変更があったかを返す.
+     * @retval  true    変更有り.
+     * @retval  false   変更無し.
+     */
+    bool decideState(const LifeRule& i_cRule);
 
 	/**
-	 * @brief	Subjectから通知を受信.
-	 * @param	Information* i_pcInformation セルの属性.
+	 * @brief	隣接セルから通知を受信.
+	 * @param	const CellAttribute* i_pcAttribute 隣接セルの属性.
 	 * @return	成功/失敗.
-	 * @note	CellAttributeのインスタンスが渡されることを想定している.
 	 */
-	bool update(Information* i_pcInformation)
+	bool update(const CellAttribute* i_pcAttribute)
 	{
-		this->receiveStateFromNeighborCell( static_cast<CellAttribute*>(i_pcInformation) );
+		this->receiveStateFromNeighborCell(i_pcAttribute);
 		return true;
 	}
 
@@ -134,12 +149,12 @@ private:
 
     /**
      * @brief   隣接セルの状態を受け取る.
-     * @param   CellAttribute::CELL_STATE i_eState 隣接セルの状態(DEAD/ALIVE)
+     * @param   const CellAttribute* i_pcCellAttribute 隣接セルの属性.(状態はDEAD/ALIVE)
      * @return  結果.
      * @retval  true    成功.
      * @retval  false   失敗.
      */
-    bool receiveStateFromNeighborCell(CellAttribute* i_pcCellAttribute)
+    bool receiveStateFromNeighborCell(const CellAttribute* i_pcCellAttribute)
 	{
 		if(CellAttribute::ALIVE == i_pcCellAttribute->getState())
 		{
@@ -150,43 +165,33 @@ private:
 
     /**
      * @brief   自分自身と隣接セルの状態から, 誕生か否かを判定する.
-     * @param   なし.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
      * @return  セルの状態がALIVEとなるかを返す.
      * @retval  true    セルの状態がALIVEとなる.
      * @retval  false   セルの状態は変更無し.
-     * @note    死んでいるセルに隣接する生きたセルがちょうど3つあれば,次の世代が誕生する.
+     * @note    死んでいるセルに隣接する生きたセルが規則の誕生の数(ライフゲームでは3つ)あれば,次の世代が誕生する.
      */
-    bool isBorn();
+    bool isBorn(const LifeRule& i_cRule);
 
     /**
      * @brief   自分自身と隣接セルの状態から, 生存か否かを判定する.
-     * @param   なし.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
      * @return  セルの状態がALIVEとなるかを返す.
      * @retval  true    セルの状態がALIVEとなる.
      * @retval  false   セルの状態は変更無し.
-     * @note    生きているセルに隣接する生きたセルが2つか3つならば, 次の世代でも生存する.
+     * @note    生きているセルに隣接する生きたセルが規則の生存の数(ライフゲームでは2つか3つ)ならば, 次の世代でも生存する.
      */
-    bool isSurvive();
+    bool isSurvive(const LifeRule& i_cRule);
 
     /**
-     * @brief   自分自身と隣接セルの状態から, 過疎か否かを判定する.
-     * @param   なし.
+     * @brief   自分自身と隣接セルの状態から, 過疎/過密か否かを判定する.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
      * @return  セルの状態がDEADとなるかを返す.
      * @retval  true    セルの状態がDEADとなる.
      * @retval  false   セルの状態は変更無し.
-     * @note    生きているセルに隣接する生きたセルが1つ以下ならば, 過疎により死滅する.
-     */
-    bool isUnderPopulation();
-
-    /**
-     * @brief   自分自身と隣接セルの状態から, 過密か否かを判定する.
-     * @param   なし.
-     * @return  セルの状態がDEADとなるを返す.
-     * @retval  true    セルの状態がDEADとなる.
-     * @retval  false   セルの状態は変更無し.
-     * @note    生きているセルに隣接する生きたセルが4つ以上ならば, 過密により死滅する.
+     * @note    生きているセルに隣接する生きたセルが規則の生存の数でなければ, 過疎/過密により死滅する.
      */
-    bool isOverPopulation();
+    bool isDie(const LifeRule& i_cRule);
 
 };
 
@@ -0,0 +1,287 @@
+/**
+ * @file    GenerationHistory.cpp
+ * @brief   MatrixCellの変化を巻き戻すための履歴を保持するクラスの実装.
+ */
+#include "GenerationHistory.h"
+
+#include <algorithm>
+using namespace std;
+
+/******************************************
+ * 履歴を取り始める.
+ ******************************************/
+void GenerationHistory::start(MatrixCell* i_pcMatrixCell)
+{
+	this->stop();
+	this->m_pcMatrixCell = i_pcMatrixCell;
+	i_pcMatrixCell->exportBitBoard(this->m_cCurrent);
+	this->m_cPending.init(this->m_cCurrent.getColMax(), this->m_cCurrent.getRowMax());
+	this->m_lBaseGeneration = i_pcMatrixCell->getGeneration();
+	i_pcMatrixCell->attach(this);
+}
+
+/******************************************
+ * 履歴を取るのをやめ, 履歴を捨てる.
+ ******************************************/
+void GenerationHistory::stop()
+{
+	if(0 != this->m_pcMatrixCell) this->m_pcMatrixCell->detach(this);
+	this->m_pcMatrixCell = 0;
+	this->clear();
+}
+
+/******************************************
+ * 履歴を空にする.
+ ******************************************/
+void GenerationHistory::clear()
+{
+	this->m_deqEntry.clear();
+	this->m_deqKeyFrame.clear();
+	this->m_lFirstSequence = 0;
+	this->m_lBaseGeneration = 0;
+	this->m_lDeltaByte = 0;
+	this->m_lDeltaByteSinceKeyFrame = 0;
+	this->m_cCurrent.init(0, 0);
+	this->m_cPending.init(0, 0);
+	this->m_vecDirtyWord.clear();
+}
+
+/******************************************
+ * 変化を1件の履歴として確定する.
+ ******************************************/
+void GenerationHistory::commit()
+{
+	if(0 == this->m_pcMatrixCell) return;
+
+	long a_lGeneration = this->m_pcMatrixCell->getGeneration();
+	long a_lPrevGeneration = this->m_deqEntry.empty()? this->m_lBaseGeneration : this->m_deqEntry.back().m_lGeneration;
+	if(this->m_vecDirtyWord.empty() && (a_lGeneration == a_lPrevGeneration)) return;
+
+	// 同じワードが2回入っている事があるので, 位置順に並べて重複を除く.
+	sort(this->m_vecDirtyWord.begin(), this->m_vecDirtyWord.end());
+	this->m_vecDirtyWord.erase(unique(this->m_vecDirtyWord.begin(), this->m_vecDirtyWord.end()), this->m_vecDirtyWord.end());
+
+	this->m_deqEntry.push_back(ENTRY());
+	ENTRY& a_stEntry = this->m_deqEntry.back();
+	a_stEntry.m_lGeneration = a_lGeneration;
+
+	BitBoard::WORD* a_pPending = this->m_cPending.getRow(0);
+	BitBoard::WORD* a_pCurrent = this->m_cCurrent.getRow(0);
+	long a_lPrevWord = 0;
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecDirtyWord.size(); a_lIndex++)
+	{
+		long a_lWord = this->m_vecDirtyWord[a_lIndex];
+		BitBoard::WORD a_wMask = a_pPending[a_lWord];
+		if(0 == a_wMask) continue;	// 2回反転して元に戻った.
+		a_pPending[a_lWord] = 0;
+		a_pCurrent[a_lWord] ^= a_wMask;
+
+		// 前のワードからの距離.(可変長整数).
+		unsigned long a_ulDiff = static_cast<unsigned long>(a_lWord - a_lPrevWord);
+		a_lPrevWord = a_lWord;
+		while(0x80 <= a_ulDiff)
+		{
+			a_stEntry.m_vecDelta.push_back(static_cast<unsigned char>(a_ulDiff | 0x80));
+			a_ulDiff >>= 7;
+		}
+		a_stEntry.m_vecDelta.push_back(static_cast<unsigned char>(a_ulDiff));
+
+		// 0でないバイトの印と, 0でないバイト.
+		size_t a_lFlagPos = a_stEntry.m_vecDelta.size();
+		a_stEntry.m_vecDelta.push_back(0);
+		for(int a_iByte=0; a_iByte<static_cast<int>(sizeof(BitBoard::WORD)); a_iByte++)
+		{
+			unsigned char a_byData = static_cast<unsigned char>(a_wMask >> (a_iByte * 8));
+			if(0 == a_byData) continue;
+			a_stEntry.m_vecDelta[a_lFlagPos] |= static_cast<unsigned char>(1 << a_iByte);
+			a_stEntry.m_vecDelta.push_back(a_byData);
+		}
+	}
+	this->m_vecDirtyWord.clear();
+
+	// 差分は追記で伸ばしたので, 余分な確保を返してから容量に数える.
+	a_stEntry.m_vecDelta.shrink_to_fit();
+	this->m_lDeltaByte += getEntryByte(a_stEntry);
+	this->m_lDeltaByteSinceKeyFrame += a_stEntry.m_vecDelta.size();
+
+	// 差分が盤面1枚分に達したらキーフレームを持つ.
+	if(this->getBoardByte() <= this->m_lDeltaByteSinceKeyFrame)
+	{
+		this->m_deqKeyFrame.push_back(KEYFRAME());
+		this->m_deqKeyFrame.back().m_lSequence = this->getLastSequence();
+		this->m_deqKeyFrame.back().m_cBoard = this->m_cCurrent;
+		this->m_lDeltaByteSinceKeyFrame = 0;
+	}
+
+	this->trim();
+}
+
+/******************************************
+ * 容量を設定する.
+ ******************************************/
+void GenerationHistory::setByteMax(size_t i_lByteMax)
+{
+	this->m_lByteMax = i_lByteMax;
+	this->trim();
+}
+
+/******************************************
+ * 確保しているメモリの量.
+ ******************************************/
+void GenerationHistory::getMemoryUsage(MemoryUsage& io_cUsage) const
+{
+	io_cUsage.add(MemoryUsage::CATEGORY_HISTORY, this->getByteSize()
+		+ MemoryUsage::getHeapByte(this->m_cCurrent.getByteSize()) + MemoryUsage::getHeapByte(this->m_cPending.getByteSize())
+		+ MemoryUsage::getVectorByte(this->m_vecDirtyWord));
+}
+
+/******************************************
+ * 確保するメモリの量を見積もる.
+ ******************************************/
+void GenerationHistory::estimateMemoryUsage(long i_lColMax, long i_lRowMax, size_t i_lByteMax, MemoryUsage& io_cUsage)
+{
+	if(0 == i_lByteMax) return;		// 履歴を取らない.
+	size_t a_lWordNum = ((i_lColMax + BitBoard::WORD_BIT - 1) / BitBoard::WORD_BIT) * i_lRowMax;
+	io_cUsage.add(MemoryUsage::CATEGORY_HISTORY, i_lByteMax + 2 * MemoryUsage::getHeapByte(sizeof(BitBoard::WORD) * a_lWordNum)
+		+ MemoryUsage::getHeapByte(sizeof(long) * a_lWordNum));
+}
+
+/******************************************
+ * 容量を超えている間, 古い履歴を捨てる.
+ ******************************************/
+void GenerationHistory::trim()
+{
+	while( !this->m_deqEntry.empty() && (this->m_lByteMax < this->getByteSize()) )
+	{
+		this->m_lDeltaByte -= getEntryByte(this->m_deqEntry.front());
+		this->m_lBaseGeneration = this->m_deqEntry.front().m_lGeneration;
+		this->m_deqEntry.pop_front();
+		this->m_lFirstSequence++;
+
+		// 戻れる最も古い状態(最も古い履歴の前)より前のキーフレームは使わない.
+		while( !this->m_deqKeyFrame.empty() && (this->m_deqKeyFrame.front().m_lSequence < this->m_lFirstSequence - 1) )
+		{
+			this->m_deqKeyFrame.pop_front();
+		}
+	}
+	if(this->m_deqEntry.empty()) this->m_lDeltaByteSinceKeyFrame = 0;
+}
+
+/******************************************
+ * 履歴を巻き戻す.
+ ******************************************/
+long GenerationHistory::rewind(long i_lCount)
+{
+	if( (0 == this->m_pcMatrixCell) || (0 >= i_lCount) ) return 0;
+
+	// 確定前の変化は先に確定しておく.
+	this->commit();
+	if(i_lCount > this->getEntryNum()) i_lCount = this->getEntryNum();
+	if(0 == i_lCount) return 0;
+
+	// 戻す先 = a_lTarget番の履歴の直後の状態.
+	long a_lLast = this->getLastSequence();
+	long a_lTarget = a_lLast - i_lCount;
+
+	// 戻す先以後で最も近いキーフレームから戻す方が差分が少なければ, キーフレームから戻す.
+	BitBoard a_cBoard;
+	long a_lFrom = a_lLast;
+	size_t a_lFromCurrent = 0;
+	for(long a_lSeq=a_lTarget+1; a_lSeq<=a_lLast; a_lSeq++)
+	{
+		a_lFromCurrent += this->m_deqEntry[a_lSeq - this->m_lFirstSequence].m_vecDelta.size();
+	}
+	deque<KEYFRAME>::const_iterator a_itKeyFrame = this->m_deqKeyFrame.begin();
+	while( (a_itKeyFrame != this->m_deqKeyFrame.end()) && (a_itKeyFrame->m_lSequence < a_lTarget) ) ++a_itKeyFrame;
+	if(a_itKeyFrame != this->m_deqKeyFrame.end())
+	{
+		size_t a_lFromKeyFrame = this->getBoardByte();
+		for(long a_lSeq=a_lTarget+1; a_lSeq<=a_itKeyFrame->m_lSequence; a_lSeq++)
+		{
+			a_lFromKeyFrame += this->m_deqEntry[a_lSeq - this->m_lFirstSequence].m_vecDelta.size();
+		}
+		if(a_lFromKeyFrame < a_lFromCurrent)
+		{
+			a_cBoard = a_itKeyFrame->m_cBoard;
+			a_lFrom = a_itKeyFrame->m_lSequence;
+		}
+	}
+	if(a_lFrom == a_lLast) a_cBoard = this->m_cCurrent;
+
+	// 差分を新しい順にXORすると前の状態に戻る.
+	for(long a_lSeq=a_lFrom; a_lSeq>a_lTarget; a_lSeq--)
+	{
+		applyDelta(this->m_deqEntry[a_lSeq - this->m_lFirstSequence].m_vecDelta, a_cBoard);
+	}
+
+	// 現在の状態と違うセルだけをMatrixCellへ設定する.
+	for(long a_lRow=0; a_lRow<a_cBoard.getRowMax(); a_lRow++)
+	{
+		const BitBoard::WORD* a_pTarget = a_cBoard.getRow(a_lRow);
+		const BitBoard::WORD* a_pCurrent = this->m_cCurrent.getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<a_cBoard.getWordNum(); a_lWord++)
+		{
+			BitBoard::WORD a_wDiff = a_pTarget[a_lWord] ^ a_pCurrent[a_lWord];
+			while(0 != a_wDiff)
+			{
+				int a_iBit = __builtin_ctzll(a_wDiff);
+				a_wDiff &= a_wDiff - 1;
+				bool a_bIsAlive = (0 != ((a_pTarget[a_lWord] >> a_iBit) & 1));
+				this->m_pcMatrixCell->setCellState(a_lWord * BitBoard::WORD_BIT + a_iBit, a_lRow, a_bIsAlive? CellAttribute::ALIVE : CellAttribute::DEAD);
+			}
+		}
+	}
+
+	// 巻き戻した履歴とキーフレームを捨てる.
+	for(long a_lSeq=a_lLast; a_lSeq>a_lTarget; a_lSeq--)
+	{
+		this->m_lDeltaByte -= getEntryByte(this->m_deqEntry.back());
+		this->m_deqEntry.pop_back();
+	}
+	while( !this->m_deqKeyFrame.empty() && (a_lTarget < this->m_deqKeyFrame.back().m_lSequence) )
+	{
+		this->m_deqKeyFrame.pop_back();
+	}
+	this->m_lDeltaByteSinceKeyFrame = 0;
+	long a_lKeyFrameSeq = this->m_deqKeyFrame.empty()? this->m_lFirstSequence - 1 : this->m_deqKeyFrame.back().m_lSequence;
+	for(long a_lSeq=a_lKeyFrameSeq+1; a_lSeq<=a_lTarget; a_lSeq++)
+	{
+		this->m_lDeltaByteSinceKeyFrame += this->m_deqEntry[a_lSeq - this->m_lFirstSequence].m_vecDelta.size();
+	}
+
+	this->m_cCurrent = a_cBoard;
+	this->m_pcMatrixCell->setGeneration(this->m_deqEntry.empty()? this->m_lBaseGeneration : this->m_deqEntry.back().m_lGeneration);
+	return i_lCount;
+}
+
+/******************************************
+ * 差分をBitBoardへ適用する.
+ ******************************************/
+void GenerationHistory::applyDelta(const vector<unsigned char>& i_vecDelta, BitBoard& io_cBoard)
+{
+	BitBoard::WORD* a_pWord = io_cBoard.getRow(0);
+	long a_lWord = 0;
+	size_t a_lPos = 0;
+	while(a_lPos < i_vecDelta.size())
+	{
+		// 前のワードからの距離.
+		unsigned long a_ulDiff = 0;
+		int a_iShift = 0;
+		unsigned char a_byData = 0;
+		do{
+			a_byData = i_vecDelta[a_lPos++];
+			a_ulDiff |= static_cast<unsigned long>(a_byData & 0x7F) << a_iShift;
+			a_iShift += 7;
+		}while( (a_byData & 0x80) && (a_lPos < i_vecDelta.size()) );
+		a_lWord += static_cast<long>(a_ulDiff);
+
+		// 0でないバイトだけを読む.
+		unsigned char a_byFlag = i_vecDelta[a_lPos++];
+		BitBoard::WORD a_wMask = 0;
+		for(int a_iByte=0; a_iByte<static_cast<int>(sizeof(BitBoard::WORD)); a_iByte++)
+		{
+			if(a_byFlag & (1 << a_iByte)) a_wMask |= static_cast<BitBoard::WORD>(i_vecDelta[a_lPos++]) << (a_iByte * 8);
+		}
+		a_pWord[a_lWord] ^= a_wMask;
+	}
+}
@@ -0,0 +1,286 @@
+/**
+ * @file    GenerationHistory.h
+ * @brief   MatrixCellの変化を巻き戻すための履歴を保持するクラスの宣言.
+ */
+#ifndef __GENERATION_HISTORY_H__
+#define __GENERATION_HISTORY_H__
+
+#include <deque>
+#include <vector>
+#include <stddef.h>
+
+#include "../Lib/Observer.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "../Lib/MemoryUsage.h"
+#include "MatrixCell.h"
+#include "BitBoard.h"
+
+/**
+ * @brief   MatrixCellの変化を巻き戻すための履歴.(容量を決めたリングバッファ).
+ * @note    MatrixCellにObserverとして登録し, commit()ごとに1件の履歴(1世代, または1回の編集)を作る.
+ * @note    履歴は前の状態とのXOR(差分)で, 変化したワード(横64セル)ごとに
+ *          「前のワードからの距離(可変長整数) + 0でないバイトの印(1バイト) + 0でないバイト」で持つ.
+ *          変化が疎なら1ワード数バイト, 密でも64セルで10バイト.
+ * @note    差分の合計が盤面1枚分に達するごとに全セルの状態(キーフレーム)を持つ.
+ *          巻き戻しは現在の状態か, 近いキーフレームのどちらか近い方から差分を逆にたどる.
+ *          (巻き戻しで適用する差分は盤面1枚分程度までになる).
+ * @note    差分とキーフレームの合計が容量を超えたら古い履歴から捨てる.
+ *          (1件毎のvectorとdequeの管理領域も容量に含める. 変化の無い世代が続いても容量を超えない).
+ */
+class GenerationHistory : public Observer<MatrixCellAttribute>
+{
+public:
+    /**
+     * @brief   容量の既定値.(バイト).
+     */
+    enum { DEFAULT_BYTE_MAX = 64 * 1024 * 1024 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   size_t i_lByteMax 容量.(バイト).
+     */
+    GenerationHistory(size_t i_lByteMax=DEFAULT_BYTE_MAX)
+	{
+		this->m_lByteMax = i_lByteMax;
+		this->m_pcMatrixCell = 0;
+		this->clear();
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~GenerationHistory()
+	{
+		this->stop();
+	}
+
+    /**
+     * @brief   履歴を取り始める.
+     * @param   MatrixCell* i_pcMatrixCell 対象のMatrixCell.
+     * @return  なし.
+     * @note    MatrixCellへObserverとして登録し, 現在の状態を起点とする.(それより前には戻れない).
+     */
+    void start(MatrixCell* i_pcMatrixCell);
+
+    /**
+     * @brief   履歴を取るのをやめ, 履歴を捨てる.
+     * @param   なし.
+     * @return  なし.
+     */
+    void stop();
+
+    /**
+     * @brief   履歴を取っているか否か.
+     */
+    bool isRecording() const { return 0 != this->m_pcMatrixCell; }
+
+    /**
+     * @brief   前回のcommit()からの変化を1件の履歴として確定する.
+     * @param   なし.
+     * @return  なし.
+     * @note    MatrixCell::refreshCell()の後, またはセルを編集した後に呼ぶ.
+     *          セルも世代数も変わっていなければ履歴を作らない.
+     */
+    void commit();
+
+    /**
+     * @brief   履歴を巻き戻す.
+     * @param   long i_lCount 巻き戻す件数.(履歴の件数を超える場合は最も古い状態まで).
+     * @return  巻き戻した件数.
+     * @note    MatrixCellのセルと世代数を戻し, 巻き戻した履歴は捨てる.(やり直しはできない).
+     * @note    Observerへは通知しない.(記録中のGenerationRecorderには残らない).
+     */
+    long rewind(long i_lCount);
+
+    /**
+     * @brief   履歴の件数.
+     */
+    long getEntryNum() const { return static_cast<long>(this->m_deqEntry.size()); }
+
+    /**
+     * @brief   キーフレームの数.
+     */
+    long getKeyFrameNum() const { return static_cast<long>(this->m_deqKeyFrame.size()); }
+
+    /**
+     * @brief   使っている容量.(差分とキーフレームの合計. 管理領域を含む).(バイト).
+     */
+    size_t getByteSize() const { return this->m_lDeltaByte + this->m_deqKeyFrame.size() * this->getKeyFrameByte(); }
+
+    /**
+     * @brief   容量.(バイト).
+     */
+    size_t getByteMax() const { return this->m_lByteMax; }
+
+    /**
+     * @brief   容量を設定する.(超えている場合は古い履歴を捨てる).
+     * @param   size_t i_lByteMax 容量.(バイト).
+     * @return  なし.
+     */
+    void setByteMax(size_t i_lByteMax);
+
+    /**
+     * @brief   確保しているメモリの量をhistoryへ加算する.
+     * @param   MemoryUsage& io_cUsage 加算先.
+     * @return  なし.
+     * @note    容量(getByteSize())に, 作業用の盤面(現在の状態, 確定前の変化)を加えた量.
+     */
+    void getMemoryUsage(MemoryUsage& io_cUsage) const;
+
+    /**
+     * @brief   容量いっぱいまで履歴を取った場合のメモリの量を見積もり, historyへ加算する.
+     * @param   long i_lColMax 横幅.
+     * @param   long i_lRowMax 縦幅.
+     * @param   size_t i_lByteMax 容量.(バイト).
+     * @param   MemoryUsage& io_cUsage 加算先.
+     * @return  なし.
+     * @note    確定前の変化の位置は, 1世代で全ワードが変化した場合の量とする.
+     */
+    static void estimateMemoryUsage(long i_lColMax, long i_lRowMax, size_t i_lByteMax, MemoryUsage& io_cUsage);
+
+	/**
+	 * @brief	Subjectから通知を受信.
+	 * @param	const MatrixCellAttribute* i_pcAttribute MatrixCellの属性.
+	 * @return	成功/失敗.
+	 * @note	通知しない編集(MatrixCell::setCellState())も, 編集したセルを渡して呼ぶ.
+	 */
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE)
+		{
+			this->toggle(i_lCol, i_lRow);
+		});
+		return true;
+	}
+
+private:
+    /**
+     * @brief   1件の履歴.
+     */
+    struct ENTRY
+    {
+        std::vector<unsigned char> m_vecDelta;  // 前の状態との差分.
+        long m_lGeneration;                     // この履歴の後の世代数.
+    };
+
+    /**
+     * @brief   キーフレーム.
+     */
+    struct KEYFRAME
+    {
+        long m_lSequence;                       // 直後の状態を持つ履歴の通し番号.
+        BitBoard m_cBoard;                      // 全セルの状態.
+    };
+
+    /**
+     * @brief   記録中のMatrixCell.(記録していない場合は0).
+     */
+    MatrixCell* m_pcMatrixCell;
+
+    /**
+     * @brief   容量.(バイト).
+     */
+    size_t m_lByteMax;
+
+    /**
+     * @brief   履歴.(古い順).
+     */
+    std::deque<ENTRY> m_deqEntry;
+
+    /**
+     * @brief   キーフレーム.(古い順).
+     */
+    std::deque<KEYFRAME> m_deqKeyFrame;
+
+    /**
+     * @brief   最も古い履歴の通し番号.
+     */
+    long m_lFirstSequence;
+
+    /**
+     * @brief   最も古い履歴の前の世代数.
+     */
+    long m_lBaseGeneration;
+
+    /**
+     * @brief   差分の合計.(1件毎の管理領域を含む).(バイト).
+     */
+    size_t m_lDeltaByte;
+
+    /**
+     * @brief   最後のキーフレームより後の差分の合計.(バイト).
+     */
+    size_t m_lDeltaByteSinceKeyFrame;
+
+    /**
+     * @brief   現在の全セルの状態.(確定した履歴まで).
+     */
+    BitBoard m_cCurrent;
+
+    /**
+     * @brief   確定前の変化.(変化したセルのビットが立つ).
+     */
+    BitBoard m_cPending;
+
+    /**
+     * @brief   確定前の変化があるワードの位置.(縦位置 * ワード数 + ワード番号).(重複あり).
+     */
+    std::vector<long> m_vecDirtyWord;
+
+    /**
+     * @brief   履歴を空にする.
+     * @param   なし.
+     * @return  なし.
+     */
+    void clear();
+
+    /**
+     * @brief   確定前の変化へセルを加える.
+     * @param   long i_lCol 横位置.
+     * @param   long i_lRow 縦位置.
+     * @return  なし.
+     */
+    void toggle(long i_lCol, long i_lRow)
+	{
+		BitBoard::WORD* a_pWord = this->m_cPending.getRow(i_lRow) + i_lCol / BitBoard::WORD_BIT;
+		if(0 == *a_pWord) this->m_vecDirtyWord.push_back(i_lRow * this->m_cPending.getWordNum() + i_lCol / BitBoard::WORD_BIT);
+		*a_pWord ^= static_cast<BitBoard::WORD>(1) << (i_lCol % BitBoard::WORD_BIT);
+	}
+
+    /**
+     * @brief   盤面1枚分の大きさ.(バイト).
+     */
+    size_t getBoardByte() const { return sizeof(BitBoard::WORD) * this->m_cCurrent.getWordNum() * this->m_cCurrent.getRowMax(); }
+
+    /**
+     * @brief   キーフレーム1枚が使う量.(管理領域を含む).(バイト).
+     */
+    size_t getKeyFrameByte() const { return sizeof(KEYFRAME) + MemoryUsage::getHeapByte(this->getBoardByte()); }
+
+    /**
+     * @brief   1件の履歴が使う量.(管理領域を含む).(バイト).
+     */
+    static size_t getEntryByte(const ENTRY& i_stEntry) { return sizeof(ENTRY) + MemoryUsage::getVectorByte(i_stEntry.m_vecDelta); }
+
+    /**
+     * @brief   最新の履歴の通し番号.(履歴が無い場合は m_lFirstSequence - 1).
+     */
+    long getLastSequence() const { return this->m_lFirstSequence + this->getEntryNum() - 1; }
+
+    /**
+     * @brief   容量を超えている間, 古い履歴を捨てる.
+     * @param   なし.
+     * @return  なし.
+     */
+    void trim();
+
+    /**
+     * @brief   差分をBitBoardへ適用する.(XOR).
+     * @param   const std::vector<unsigned char>& i_vecDelta 差分.
+     * @param   BitBoard& io_cBoard 適用するBitBoard.
+     * @return  なし.
+     */
+    static void applyDelta(const std::vector<unsigned char>& i_vecDelta, BitBoard& io_cBoard);
+};
+
+#endif  //__GENERATION_HISTORY_H__
@@ -0,0 +1,33 @@
+/**
+ * @file    GenerationPlayer.cpp
+ * @brief   記録した世代を再生するクラスの実装.
+ */
+#include "GenerationPlayer.h"
+
+/******************************************
+ * 指定した世代へ移動する.
+ ******************************************/
+bool GenerationPlayer::seek(long i_lGeneration)
+{
+	if( (0>i_lGeneration) || (this->m_pcRecord->getGenerationNum()<=i_lGeneration) ) return false;
+
+	long a_lInterval = this->m_pcRecord->getKeyFrameInterval();
+	long a_lKeyFrameGeneration = (i_lGeneration / a_lInterval) * a_lInterval;
+
+	// 同じキーフレーム区間を前へ進む場合は, 現在の状態から差分を適用する.
+	// それ以外はキーフレームから差分を適用する.
+	long a_lFrom = this->m_lGeneration;
+	if( (a_lFrom<a_lKeyFrameGeneration) || (i_lGeneration<a_lFrom) )
+	{
+		this->m_cBoard = this->m_pcRecord->getKeyFrame(i_lGeneration / a_lInterval);
+		a_lFrom = a_lKeyFrameGeneration;
+	}
+
+	for(long a_lGeneration=a_lFrom+1; a_lGeneration<=i_lGeneration; a_lGeneration++)
+	{
+		this->m_pcRecord->applyDelta(a_lGeneration, this->m_cBoard);
+	}
+
+	this->m_lGeneration = i_lGeneration;
+	return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file    GenerationPlayer.h
+ * @brief   記録した世代を再生するクラスの宣言.
+ */
+
+#ifndef __GENERATION_PLAYER_H__
+#define __GENERATION_PLAYER_H__
+
+#include "GenerationRecord.h"
+#include "BitBoard.h"
+
+/**
+ * @brief   記録した世代を再生するクラス.
+ * @note    直前のキーフレームから差分を適用して任意の世代へ移動する.
+ *          再計算は行わないため, 移動のコストは高々キーフレーム間隔分の差分の適用.
+ */
+class GenerationPlayer
+{
+public:
+    /**
+     * @brief   コンストラクタ.
+     * @param   const GenerationRecord* i_pcRecord 再生する記録.
+     */
+    GenerationPlayer(const GenerationRecord* i_pcRecord)
+	{
+		this->m_pcRecord = i_pcRecord;
+		this->m_lGeneration = -1;
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~GenerationPlayer() { }
+
+    /**
+     * @brief   指定した世代へ移動する.
+     * @param   long i_lGeneration 相対世代.
+     * @return  成功/失敗.(記録の範囲外の場合は失敗).
+     */
+    bool seek(long i_lGeneration);
+
+    /**
+     * @brief   現在の相対世代を取得.(未移動の場合は-1).
+     */
+    long getGeneration() const { return this->m_lGeneration; }
+
+    /**
+     * @brief   現在の世代の全セルの状態を取得.
+     */
+    const BitBoard& getBoard() const { return this->m_cBoard; }
+
+private:
+    /**
+     * @brief   再生する記録.
+     */
+    const GenerationRecord* m_pcRecord;
+
+    /**
+     * @brief   現在の相対世代.
+     */
+    long m_lGeneration;
+
+    /**
+     * @brief   現在の世代の全セルの状態.
+     */
+    BitBoard m_cBoard;
+};
+
+#endif  //__GENERATION_PLAYER_H__
@@ -0,0 +1,199 @@
+/**
+ * @file    GenerationRecord.cpp
+ * @brief   世代の記録(キーフレーム + 差分)を保持するクラスの実装.
+ */
+#include "GenerationRecord.h"
+#include "../Lib/Tracer.h"
+
+#include <fstream>
+#include <cstring>
+using namespace std;
+
+// ファイルの識別子.
+static const char g_szRecordMagic[8] = { 'L', 'G', 'R', 'E', 'C', '0', '0', '1' };
+
+/******************************************
+ * 初期化.記録を空にする.
+ ******************************************/
+void GenerationRecord::init(long i_lColMax, long i_lRowMax, long i_lKeyFrameInterval, long i_lFirstGeneration)
+{
+	this->m_lColMax = i_lColMax;
+	this->m_lRowMax = i_lRowMax;
+	this->m_lKeyFrameInterval = (0<i_lKeyFrameInterval)? i_lKeyFrameInterval : DEFAULT_KEYFRAME_INTERVAL;
+	this->m_lFirstGeneration = i_lFirstGeneration;
+	this->m_vecKeyFrame.clear();
+	this->m_vecDelta.clear();
+	this->m_vecDeltaEnd.clear();
+}
+
+/******************************************
+ * 世代を追加する.
+ ******************************************/
+void GenerationRecord::addGeneration(const unsigned char* i_pDelta, size_t i_lDeltaSize, const BitBoard* i_pcKeyFrame)
+{
+	if(this->isNextKeyFrame() && (0!=i_pcKeyFrame))
+	{
+		this->m_vecKeyFrame.push_back(*i_pcKeyFrame);
+	}
+
+	this->m_vecDelta.insert(this->m_vecDelta.end(), i_pDelta, i_pDelta + i_lDeltaSize);
+	this->m_vecDeltaEnd.push_back(this->m_vecDelta.size());
+}
+
+/******************************************
+ * 差分をBitBoardへ適用する.
+ ******************************************/
+void GenerationRecord::applyDelta(long i_lGeneration, BitBoard& io_cBoard) const
+{
+	size_t a_lBegin = this->m_vecDeltaEnd[i_lGeneration - 1];
+	size_t a_lEnd = this->m_vecDeltaEnd[i_lGeneration];
+	long a_lIndex = 0;
+	long a_lCellNum = this->m_lColMax * this->m_lRowMax;
+
+	size_t a_lPos = a_lBegin;
+	while(a_lPos < a_lEnd)
+	{
+		// 可変長整数を読み出す.
+		unsigned long a_ulValue = 0;
+		int a_iShift = 0;
+		unsigned char a_byData = 0;
+		do{
+			a_byData = this->m_vecDelta[a_lPos++];
+			a_ulValue |= static_cast<unsigned long>(a_byData & 0x7F) << a_iShift;
+			a_iShift += 7;
+		}while( (a_byData & 0x80) && (a_lPos < a_lEnd) );
+
+		// zigzag復号.
+		long a_lDiff = (a_ulValue & 1)? ~static_cast<long>(a_ulValue >> 1) : static_cast<long>(a_ulValue >> 1);
+		a_lIndex += a_lDiff;
+		if( (0 > a_lIndex) || (a_lCellNum <= a_lIndex) ) break;	// 壊れた差分は盤面の外を指さない.
+
+		io_cBoard.toggleBit(a_lIndex % this->m_lColMax, a_lIndex / this->m_lColMax);
+	}
+}
+
+/******************************************
+ * ファイルへ保存する.
+ * 数値はlong(実行環境のバイトオーダー)で書き出す.
+ ******************************************/
+bool GenerationRecord::save(const string& i_strPath) const
+{
+	TRACE_SCOPE_VALUE("io", "record save", this->getGenerationNum());
+	ofstream a_cFile(i_strPath.c_str(), ios::out | ios::binary | ios::trunc);
+	if(!a_cFile) return false;
+
+	long a_rglHeader[] = {
+		this->m_lColMax,
+		this->m_lRowMax,
+		this->m_lKeyFrameInterval,
+		this->m_lFirstGeneration,
+		this->getGenerationNum(),
+		static_cast<long>(this->m_vecKeyFrame.size()),
+		static_cast<long>(this->m_vecDelta.size()),
+	};
+	a_cFile.write(g_szRecordMagic, sizeof(g_szRecordMagic));
+	a_cFile.write(reinterpret_cast<const char*>(a_rglHeader), sizeof(a_rglHeader));
+
+	// キーフレーム.
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecKeyFrame.size(); a_lIndex++)
+	{
+		const BitBoard& a_cKeyFrame = this->m_vecKeyFrame[a_lIndex];
+		if(0 == a_cKeyFrame.getRowMax()) continue;
+		a_cFile.write(reinterpret_cast<const char*>(a_cKeyFrame.getRow(0)),
+			sizeof(BitBoard::WORD) * a_cKeyFrame.getWordNum() * a_cKeyFrame.getRowMax());
+	}
+
+	// 差分.
+	if(!this->m_vecDeltaEnd.empty())
+	{
+		a_cFile.write(reinterpret_cast<const char*>(&this->m_vecDeltaEnd[0]), sizeof(size_t) * this->m_vecDeltaEnd.size());
+	}
+	if(!this->m_vecDelta.empty())
+	{
+		a_cFile.write(reinterpret_cast<const char*>(&this->m_vecDelta[0]), this->m_vecDelta.size());
+	}
+
+	return a_cFile.good();
+}
+
+/******************************************
+ * ファイルから読み込む.
+ ******************************************/
+bool GenerationRecord::load(const string& i_strPath)
+{
+	ifstream a_cFile(i_strPath.c_str(), ios::in | ios::binary);
+	if(!a_cFile) return false;
+
+	char a_szMagic[sizeof(g_szRecordMagic)];
+	long a_rglHeader[7];
+	a_cFile.read(a_szMagic, sizeof(a_szMagic));
+	a_cFile.read(reinterpret_cast<char*>(a_rglHeader), sizeof(a_rglHeader));
+	if( !a_cFile || (0!=memcmp(a_szMagic, g_szRecordMagic, sizeof(g_szRecordMagic))) ) return false;
+
+	// 残りのバイト数.(件数と大きさはこれを超えられない).
+	streampos a_lDataBegin = a_cFile.tellg();
+	a_cFile.seekg(0, ios::end);
+	size_t a_lRemain = static_cast<size_t>(a_cFile.tellg() - a_lDataBegin);
+	a_cFile.seekg(a_lDataBegin);
+
+	this->init(a_rglHeader[0], a_rglHeader[1], a_rglHeader[2], a_rglHeader[3]);
+	long a_lGenerationNum = a_rglHeader[4];
+	long a_lKeyFrameNum = a_rglHeader[5];
+	long a_lDeltaSize = a_rglHeader[6];
+	bool a_bIsValid = (0<this->m_lColMax) && (0<this->m_lRowMax) && (0<=a_lDeltaSize) && (0<=a_lGenerationNum)
+		&& (a_lKeyFrameNum == (a_lGenerationNum + this->m_lKeyFrameInterval - 1) / this->m_lKeyFrameInterval);
+
+	// 壊れたファイルで巨大な領域を確保しないよう, 掛け算の前に割り算で比べる.
+	if(a_bIsValid && (0 < a_lKeyFrameNum))
+	{
+		size_t a_lWordNum = (static_cast<size_t>(this->m_lColMax) + BitBoard::WORD_BIT - 1) / BitBoard::WORD_BIT;
+		a_bIsValid = (a_lWordNum <= a_lRemain / sizeof(BitBoard::WORD) / static_cast<size_t>(this->m_lRowMax));
+		size_t a_lBoardByte = a_bIsValid? a_lWordNum * sizeof(BitBoard::WORD) * this->m_lRowMax : 0;
+		a_bIsValid = a_bIsValid && (static_cast<size_t>(a_lKeyFrameNum) <= a_lRemain / a_lBoardByte);
+		if(a_bIsValid) a_lRemain -= a_lKeyFrameNum * a_lBoardByte;
+	}
+	a_bIsValid = a_bIsValid && (static_cast<size_t>(a_lGenerationNum) <= a_lRemain / sizeof(size_t));
+	if(a_bIsValid) a_lRemain -= a_lGenerationNum * sizeof(size_t);
+	a_bIsValid = a_bIsValid && (static_cast<size_t>(a_lDeltaSize) <= a_lRemain);
+	if(!a_bIsValid)
+	{
+		this->init(0, 0, DEFAULT_KEYFRAME_INTERVAL, 0);
+		return false;
+	}
+
+	// キーフレーム.
+	this->m_vecKeyFrame.resize(a_lKeyFrameNum);
+	for(long a_lIndex=0; a_lIndex<a_lKeyFrameNum; a_lIndex++)
+	{
+		BitBoard& a_cKeyFrame = this->m_vecKeyFrame[a_lIndex];
+		a_cKeyFrame.init(this->m_lColMax, this->m_lRowMax);
+		if(0 == a_cKeyFrame.getRowMax()) continue;
+		a_cFile.read(reinterpret_cast<char*>(a_cKeyFrame.getRow(0)),
+			sizeof(BitBoard::WORD) * a_cKeyFrame.getWordNum() * a_cKeyFrame.getRowMax());
+	}
+
+	// 差分.
+	this->m_vecDeltaEnd.resize(a_lGenerationNum);
+	this->m_vecDelta.resize(a_lDeltaSize);
+	if(0 < a_lGenerationNum)
+	{
+		a_cFile.read(reinterpret_cast<char*>(&this->m_vecDeltaEnd[0]), sizeof(size_t) * a_lGenerationNum);
+	}
+	if(0 < a_lDeltaSize)
+	{
+		a_cFile.read(reinterpret_cast<char*>(&this->m_vecDelta[0]), a_lDeltaSize);
+	}
+
+	// 差分の終端は減らず, 差分の外を指さない.
+	for(long a_lIndex=0; a_bIsValid && (a_lIndex<a_lGenerationNum); a_lIndex++)
+	{
+		a_bIsValid = (0 == a_lIndex) || (this->m_vecDeltaEnd[a_lIndex - 1] <= this->m_vecDeltaEnd[a_lIndex]);
+	}
+	a_bIsValid = a_bIsValid && ( (0 == a_lGenerationNum) || (this->m_vecDeltaEnd[a_lGenerationNum - 1] <= this->m_vecDelta.size()) );
+	if( !a_cFile.good() || !a_bIsValid )
+	{
+		this->init(0, 0, DEFAULT_KEYFRAME_INTERVAL, 0);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file    GenerationRecord.h
+ * @brief   世代の記録(キーフレーム + 差分)を保持するクラスの宣言.
+ */
+
+#ifndef __GENERATION_RECORD_H__
+#define __GENERATION_RECORD_H__
+
+#include <vector>
+#include <string>
+#include <stddef.h>
+
+#include "../Lib/MemoryUsage.h"
+#include "BitBoard.h"
+
+/**
+ * @brief   世代の記録を保持するクラス.
+ * @note    一定間隔の世代ごとに全セルの状態(キーフレーム)を持ち,
+ *          それ以外の世代は前世代から変化したセルの位置(差分)だけを持つ.
+ * @note    差分は「前回の位置からの距離」をzigzag符号化した可変長整数の列.
+ *          変化は反転(XOR)として扱うため, 同じ位置が2回現れると元に戻る.
+ * @note    世代は記録開始時を0とした相対世代で扱う.
+ */
+class GenerationRecord
+{
+public:
+    /**
+     * @brief   キーフレーム間隔の既定値.
+     */
+    enum { DEFAULT_KEYFRAME_INTERVAL = 64 };
+
+    /**
+     * @brief   1つの位置を書き出すのに要る最大のバイト数.(64ビットを7ビットずつ).
+     */
+    enum { INDEX_BYTE_MAX = 10 };
+
+    /**
+     * @brief   コンストラクタ.
+     */
+    GenerationRecord()
+	{
+		this->init(0, 0, DEFAULT_KEYFRAME_INTERVAL, 0);
+	}
+
+    /**
+     * @brief   初期化.記録を空にする.
+     * @param   long i_lColMax 横幅.
+     * @param   long i_lRowMax 縦幅.
+     * @param   long i_lKeyFrameInterval キーフレーム間隔.
+     * @param   long i_lFirstGeneration 記録開始時のMatrixCellの世代数.
+     * @return  なし.
+     */
+    void init(long i_lColMax, long i_lRowMax, long i_lKeyFrameInterval, long i_lFirstGeneration);
+
+    /**
+     * @brief   横幅を取得.
+     */
+    long getColMax() const { return this->m_lColMax; }
+
+    /**
+     * @brief   縦幅を取得.
+     */
+    long getRowMax() const { return this->m_lRowMax; }
+
+    /**
+     * @brief   キーフレーム間隔を取得.
+     */
+    long getKeyFrameInterval() const { return this->m_lKeyFrameInterval; }
+
+    /**
+     * @brief   記録開始時のMatrixCellの世代数を取得.
+     */
+    long getFirstGeneration() const { return this->m_lFirstGeneration; }
+
+    /**
+     * @brief   記録済みの世代数を取得.(相対世代0を含む).
+     */
+    long getGenerationNum() const { return static_cast<long>(this->m_vecDeltaEnd.size()); }
+
+    /**
+     * @brief   キーフレームを取得.
+     * @param   long i_lIndex キーフレーム番号.(相対世代 = 番号 * キーフレーム間隔).
+     * @return  キーフレーム.
+     */
+    const BitBoard& getKeyFrame(long i_lIndex) const { return this->m_vecKeyFrame[i_lIndex]; }
+
+    /**
+     * @brief   差分データの大きさ(バイト数)を取得.
+     */
+    size_t getDeltaSize() const { return this->m_vecDelta.size(); }
+
+    /**
+     * @brief   確保しているメモリの量をhistoryへ加算する.
+     * @param   MemoryUsage& io_cUsage 加算先.
+     * @return  なし.
+     */
+    void getMemoryUsage(MemoryUsage& io_cUsage) const
+	{
+		size_t a_lByte = MemoryUsage::getVectorByte(this->m_vecKeyFrame) + MemoryUsage::getVectorByte(this->m_vecDelta)
+			+ MemoryUsage::getVectorByte(this->m_vecDeltaEnd);
+		for(size_t a_lIndex=0; a_lIndex<this->m_vecKeyFrame.size(); a_lIndex++)
+		{
+			a_lByte += MemoryUsage::getHeapByte(this->m_vecKeyFrame[a_lIndex].getByteSize());
+		}
+		io_cUsage.add(MemoryUsage::CATEGORY_HISTORY, a_lByte);
+	}
+
+    /**
+     * @brief   世代を追加する.
+     * @param   const unsigned char* i_pDelta 前世代からの差分.
+     * @param   size_t i_lDeltaSize 差分のバイト数.
+     * @param   const BitBoard* i_pcKeyFrame 追加する世代がキーフレームの場合は全セルの状態.それ以外は0.
+     * @return  なし.
+     * @note    相対世代0の差分は空であること.
+     */
+    void addGeneration(const unsigned char* i_pDelta, size_t i_lDeltaSize, const BitBoard* i_pcKeyFrame);
+
+    /**
+     * @brief   追加する世代がキーフレームか否か.
+     * @param   なし.
+     * @return  true:キーフレーム false:差分のみ.
+     */
+    bool isNextKeyFrame() const { return 0 == (this->getGenerationNum() % this->m_lKeyFrameInterval); }
+
+    /**
+     * @brief   差分をBitBoardへ適用する.(変化したセルを反転する).
+     * @param   long i_lGeneration 相対世代.(1以上).
+     * @param   BitBoard& io_cBoard 適用先.相対世代-1の状態であること.
+     * @return  なし.
+     */
+    void applyDelta(long i_lGeneration, BitBoard& io_cBoard) const;
+
+    /**
+     * @brief   変化したセルの位置を差分として書き出す.
+     * @param   unsigned char* o_pDelta 書き出し先.INDEX_BYTE_MAXバイト以上空いていること.
+     * @param   long& io_lPrevIndex 前回書き出した位置.(差分の先頭では0).
+     * @param   long i_lIndex 変化したセルの位置.(縦位置 * 横幅 + 横位置).
+     * @return  書き出した次の位置.
+     */
+    static unsigned char* encodeIndex(unsigned char* o_pDelta, long& io_lPrevIndex, long i_lIndex)
+	{
+		long a_lDiff = i_lIndex - io_lPrevIndex;
+		io_lPrevIndex = i_lIndex;
+
+		// zigzag符号化. 0,-1,1,-2,... → 0,1,2,3,...
+		unsigned long a_ulValue = (a_lDiff<0)? ((static_cast<unsigned long>(~a_lDiff) << 1) | 1) : (static_cast<unsigned long>(a_lDiff) << 1);
+
+		// 7ビットずつ可変長で書き出す.
+		while(a_ulValue >= 0x80)
+		{
+			*o_pDelta++ = static_cast<unsigned char>(a_ulValue | 0x80);
+			a_ulValue >>= 7;
+		}
+		*o_pDelta++ = static_cast<unsigned char>(a_ulValue);
+		return o_pDelta;
+	}
+
+    /**
+     * @brief   ファイルへ保存する.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @return  成功/失敗.
+     */
+    bool save(const std::string& i_strPath) const;
+
+    /**
+     * @brief   ファイルから読み込む.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @return  成功/失敗.
+     * @note    件数と大きさがファイルの大きさに収まらない, 差分の終端が減る/差分の外を指す場合は失敗し, 記録は空になる.
+     */
+    bool load(const std::string& i_strPath);
+
+private:
+    /**
+     * @brief   横幅.
+     */
+    long m_lColMax;
+
+    /**
+     * @brief   縦幅.
+     */
+    long m_lRowMax;
+
+    /**
+     * @brief   キーフレーム間隔.
+     */
+    long m_lKeyFrameInterval;
+
+    /**
+     * @brief   記録開始時のMatrixCellの世代数.
+     */
+    long m_lFirstGeneration;
+
+    /**
+     * @brief   キーフレーム.
+     */
+    std::vector<BitBoard> m_vecKeyFrame;
+
+    /**
+     * @brief   全世代の差分を連結したもの.
+     */
+    std::vector<unsigned char> m_vecDelta;
+
+    /**
+     * @brief   各世代の差分の終端位置.(相対世代iの差分は[end[i-1], end[i]) ).
+     */
+    std::vector<size_t> m_vecDeltaEnd;
+};
+
+#endif  //__GENERATION_RECORD_H__
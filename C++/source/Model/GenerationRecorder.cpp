@@ -0,0 +1,59 @@
+/**
+ * @file    GenerationRecorder.cpp
+ * @brief   MatrixCellの世代を記録するクラスの実装.
+ */
+#include "GenerationRecorder.h"
+
+/******************************************
+ * 記録を開始する.
+ ******************************************/
+void GenerationRecorder::start(MatrixCell* i_pcMatrixCell)
+{
+	this->stop();
+
+	this->m_pcMatrixCell = i_pcMatrixCell;
+	this->m_cRecord.init(i_pcMatrixCell->getColMax(), i_pcMatrixCell->getRowMax(),
+		this->m_lKeyFrameInterval, i_pcMatrixCell->getGeneration());
+
+	// 相対世代0はキーフレームのみ.
+	this->m_lDeltaSize = 0;
+	this->m_lPrevIndex = 0;
+	i_pcMatrixCell->exportBitBoard(this->m_cKeyFrame);
+	this->m_cRecord.addGeneration(0, 0, &this->m_cKeyFrame);
+
+	i_pcMatrixCell->attach(this);
+}
+
+/******************************************
+ * 記録を停止する.
+ ******************************************/
+void GenerationRecorder::stop()
+{
+	if(0 == this->m_pcMatrixCell) return;
+
+	this->m_pcMatrixCell->detach(this);
+	this->m_pcMatrixCell = 0;
+	this->m_lDeltaSize = 0;
+	this->m_lPrevIndex = 0;
+}
+
+/******************************************
+ * 1世代分の変化を確定する.
+ ******************************************/
+void GenerationRecorder::commit()
+{
+	if(0 == this->m_pcMatrixCell) return;
+
+	// キーフレーム間隔ごとに全セルの状態を記録する.
+	const BitBoard* a_pcKeyFrame = 0;
+	if(this->m_cRecord.isNextKeyFrame())
+	{
+		this->m_pcMatrixCell->exportBitBoard(this->m_cKeyFrame);
+		a_pcKeyFrame = &this->m_cKeyFrame;
+	}
+
+	// 1世代分をまとめて記録へ移す.
+	this->m_cRecord.addGeneration(this->m_lDeltaSize? &this->m_vecDelta[0] : 0, this->m_lDeltaSize, a_pcKeyFrame);
+	this->m_lDeltaSize = 0;
+	this->m_lPrevIndex = 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file    GenerationRecorder.h
+ * @brief   MatrixCellの世代を記録するクラスの宣言.
+ */
+
+#ifndef __GENERATION_RECORDER_H__
+#define __GENERATION_RECORDER_H__
+
+#include <vector>
+#include <algorithm>
+
+#include "../Lib/Observer.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "MatrixCell.h"
+#include "GenerationRecord.h"
+
+/**
+ * @brief   MatrixCellの世代を記録するクラス.
+ * @note    MatrixCellにObserverとして登録し, 通知された変化セルを差分として蓄える.
+ * @note    1世代分の通知を受け取った後にcommit()を呼ぶこと.
+ */
+class GenerationRecorder : public Observer<MatrixCellAttribute>
+{
+public:
+    /**
+     * @brief   コンストラクタ.
+     * @param   long i_lKeyFrameInterval キーフレーム間隔.
+     */
+    GenerationRecorder(long i_lKeyFrameInterval=GenerationRecord::DEFAULT_KEYFRAME_INTERVAL)
+	{
+		this->m_lKeyFrameInterval = i_lKeyFrameInterval;
+		this->m_pcMatrixCell = 0;
+		this->m_lDeltaSize = 0;
+		this->m_lPrevIndex = 0;
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~GenerationRecorder()
+	{
+		this->stop();
+	}
+
+    /**
+     * @brief   記録を開始する.
+     * @param   MatrixCell* i_pcMatrixCell 記録するMatrixCell.
+     * @return  なし.
+     * @note    MatrixCellへObserverとして登録し, 現在の状態を相対世代0として記録する.
+     */
+    void start(MatrixCell* i_pcMatrixCell);
+
+    /**
+     * @brief   記録を停止する.
+     * @param   なし.
+     * @return  なし.
+     * @note    commit()されていない変化は破棄する.
+     */
+    void stop();
+
+    /**
+     * @brief   記録中か否か.
+     */
+    bool isRecording() const { return 0 != this->m_pcMatrixCell; }
+
+    /**
+     * @brief   1世代分の変化を確定する.
+     * @param   なし.
+     * @return  なし.
+     * @note    MatrixCell::refreshCell()の後に呼ぶ.
+     */
+    void commit();
+
+    /**
+     * @brief   記録を取得.
+     */
+    const GenerationRecord& getRecord() const { return this->m_cRecord; }
+
+    /**
+     * @brief   確保しているメモリの量(記録と作業用の領域)をhistoryへ加算する.
+     * @param   MemoryUsage& io_cUsage 加算先.
+     * @return  なし.
+     */
+    void getMemoryUsage(MemoryUsage& io_cUsage) const
+	{
+		this->m_cRecord.getMemoryUsage(io_cUsage);
+		io_cUsage.add(MemoryUsage::CATEGORY_HISTORY,
+			MemoryUsage::getVectorByte(this->m_vecDelta) + MemoryUsage::getHeapByte(this->m_cKeyFrame.getByteSize()));
+	}
+
+	/**
+	 * @brief	Subjectから通知を受信.
+	 * @param	const MatrixCellAttribute* i_pcAttribute MatrixCellの属性.
+	 * @return	成功/失敗.
+	 * @note	セルの編集を記録する場合も, 編集したセルを渡して呼ぶ.
+	 */
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		// 状態は要らないので, 変化のあった語だけを辿る.
+		i_pcAttribute->forEachChangedWord([this](long i_lCol, long i_lRow, BitBoard::WORD i_wBits)
+		{
+			// 語の全ビット分が書けるだけ確保しておき, 書き出しは伸び縮みさせない.
+			size_t a_lNeed = this->m_lDeltaSize + __builtin_popcountll(i_wBits) * GenerationRecord::INDEX_BYTE_MAX;
+			if(this->m_vecDelta.size() < a_lNeed) this->m_vecDelta.resize(std::max(a_lNeed, this->m_vecDelta.size() * 2));
+
+			long a_lIndex = i_lRow * this->m_cRecord.getColMax() + i_lCol;
+			unsigned char* a_pDelta = &this->m_vecDelta[this->m_lDeltaSize];
+			unsigned char* a_pEnd = a_pDelta;
+			while(0 != i_wBits)
+			{
+				a_pEnd = GenerationRecord::encodeIndex(a_pEnd, this->m_lPrevIndex, a_lIndex + __builtin_ctzll(i_wBits));
+				i_wBits &= i_wBits - 1;
+			}
+			this->m_lDeltaSize += a_pEnd - a_pDelta;
+		});
+		return true;
+	}
+
+private:
+    /**
+     * @brief   キーフレーム間隔.
+     */
+    long m_lKeyFrameInterval;
+
+    /**
+     * @brief   記録中のMatrixCell.(記録していない場合は0).
+     */
+    MatrixCell* m_pcMatrixCell;
+
+    /**
+     * @brief   記録.
+     */
+    GenerationRecord m_cRecord;
+
+    /**
+     * @brief   確定前の差分の書き出し先.(先頭m_lDeltaSizeバイトが差分. 世代を跨いで使い回す).
+     */
+    std::vector<unsigned char> m_vecDelta;
+
+    /**
+     * @brief   確定前の差分のバイト数.
+     */
+    size_t m_lDeltaSize;
+
+    /**
+     * @brief   差分へ最後に追加したセルの位置.
+     */
+    long m_lPrevIndex;
+
+    /**
+     * @brief   キーフレーム作成用の作業領域.
+     */
+    BitBoard m_cKeyFrame;
+};
+
+#endif  //__GENERATION_RECORDER_H__
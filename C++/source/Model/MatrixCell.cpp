@@ -3,8 +3,11 @@
  * @brief   全細胞（全セル）を管理するクラスの実装.
  */
 #include "MatrixCell.h"
+#include "../Lib/ParallelFor.h"
+#include "../Lib/Tracer.h"
 
 
+#include <algorithm>
 #include <iostream>		// デバッグ用.
 #include <sstream>		// デバッグ用.
 #include <string>		// デバッグ用.
@@ -20,8 +23,120 @@ void MatrixCell::init(long i_lColMax, long i_lRowMax)
 {
     this->setColMax(i_lColMax);	// 横幅最大値 設定.
     this->setRowMax(i_lRowMax);	// 縦幅最大値 設定.
+    this->m_lGeneration = 0;		// 世代数 初期化.
+    this->m_lPopulation = 0;		// 全セル"死"で生成する.
+    this->m_lChangedNum = 0;
     this->makeCell();			// セルの生成.
     this->linkCell();			// 隣接セルをリンクさせる.
+
+	// 変化の記録.(タイルは横1語 x 縦TILE_SIZE行).
+	this->m_cChangedBoard.init(i_lColMax, i_lRowMax);
+	this->m_cBornBoard.init(i_lColMax, i_lRowMax);
+	this->m_vecTileDirty.assign(this->m_cChangedBoard.getWordNum() * ((i_lRowMax + TILE_SIZE - 1) / TILE_SIZE), 0);
+	this->m_vecDirtyTile.clear();
+	this->m_vecDirtyTile.reserve(this->m_vecTileDirty.size());	// 世代の途中で確保し直さない.(使用量も一定になる).
+}
+
+/******************************************
+ * 確保しているメモリの量.
+ ******************************************/
+void MatrixCell::getMemoryUsage(MemoryUsage& io_cUsage) const
+{
+	// セルは1個ずつnewしている.(隣接セルへのポインタはセルの中).
+	size_t a_lCellNum = static_cast<size_t>(this->m_lColMax) * this->m_lRowMax;
+	size_t a_lLinkByte = sizeof(StaticSubject<CellAttribute, Cell, 8>);
+	io_cUsage.add(MemoryUsage::CATEGORY_CELL, a_lCellNum * (MemoryUsage::getHeapByte(sizeof(Cell)) - a_lLinkByte));
+	io_cUsage.add(MemoryUsage::CATEGORY_LINK, a_lCellNum * a_lLinkByte);
+
+	// 索引.(行毎のvector<Cell*>).
+	io_cUsage.add(MemoryUsage::CATEGORY_CELL, sizeof(MatrixCell) + MemoryUsage::getVectorByte(this->m_vecCellArray));
+	for(size_t a_lRow=0; a_lRow<this->m_vecCellArray.size(); a_lRow++)
+	{
+		io_cUsage.add(MemoryUsage::CATEGORY_CELL, MemoryUsage::getVectorByte(this->m_vecCellArray[a_lRow]));
+	}
+
+	// 変化の記録と関心領域.
+	io_cUsage.add(MemoryUsage::CATEGORY_CACHE, MemoryUsage::getHeapByte(this->m_cChangedBoard.getByteSize())
+		+ MemoryUsage::getHeapByte(this->m_cBornBoard.getByteSize())
+		+ MemoryUsage::getVectorByte(this->m_vecTileDirty) + MemoryUsage::getVectorByte(this->m_vecDirtyTile)
+		+ MemoryUsage::getVectorByte(this->m_vecInterest) + MemoryUsage::getVectorByte(this->m_pcObserverList));
+}
+
+/******************************************
+ * 確保するメモリの量を見積もる.
+ ******************************************/
+void MatrixCell::estimateMemoryUsage(long i_lColMax, long i_lRowMax, MemoryUsage& io_cUsage)
+{
+	size_t a_lCellNum = static_cast<size_t>(i_lColMax) * i_lRowMax;
+	size_t a_lLinkByte = sizeof(StaticSubject<CellAttribute, Cell, 8>);
+	io_cUsage.add(MemoryUsage::CATEGORY_CELL, a_lCellNum * (MemoryUsage::getHeapByte(sizeof(Cell)) - a_lLinkByte));
+	io_cUsage.add(MemoryUsage::CATEGORY_LINK, a_lCellNum * a_lLinkByte);
+
+	io_cUsage.add(MemoryUsage::CATEGORY_CELL, sizeof(MatrixCell) + MemoryUsage::getHeapByte(i_lRowMax * sizeof(vector<Cell*>))
+		+ i_lRowMax * MemoryUsage::getHeapByte(i_lColMax * sizeof(Cell*)));
+
+	size_t a_lBoardByte = sizeof(BitBoard::WORD) * ((i_lColMax + BitBoard::WORD_BIT - 1) / BitBoard::WORD_BIT) * i_lRowMax;
+	size_t a_lTileNum = ((i_lColMax + BitBoard::WORD_BIT - 1) / BitBoard::WORD_BIT) * ((i_lRowMax + TILE_SIZE - 1) / TILE_SIZE);
+	io_cUsage.add(MemoryUsage::CATEGORY_CACHE, 2 * MemoryUsage::getHeapByte(a_lBoardByte)
+		+ MemoryUsage::getHeapByte(a_lTileNum * sizeof(char)) + MemoryUsage::getHeapByte(a_lTileNum * sizeof(long)));
+}
+
+/******************************************
+ * Observerを登録する.(盤面全体).
+ ******************************************/
+void MatrixCell::attach(Observer<MatrixCellAttribute>* i_pcObserver)
+{
+	Subject<MatrixCellAttribute>::attach(i_pcObserver);
+	INTEREST a_stInterest = { i_pcObserver, true, 0, 0, 0, 0 };
+	this->m_vecInterest.push_back(a_stInterest);
+}
+
+/******************************************
+ * Observerを関心領域を指定して登録する.
+ ******************************************/
+void MatrixCell::attach(Observer<MatrixCellAttribute>* i_pcObserver, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	Subject<MatrixCellAttribute>::attach(i_pcObserver);
+	INTEREST a_stInterest = { i_pcObserver, false, i_lCol, i_lRow, i_lWidth, i_lHeight };
+	this->m_vecInterest.push_back(a_stInterest);
+	this->notifySnapshot(a_stInterest);
+}
+
+/******************************************
+ * Observerの関心領域を変更する.
+ ******************************************/
+bool MatrixCell::setInterest(Observer<MatrixCellAttribute>* i_pcObserver, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	bool a_bIsFound = false;
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecInterest.size(); a_lIndex++)
+	{
+		INTEREST& a_stInterest = this->m_vecInterest[a_lIndex];
+		if(i_pcObserver != a_stInterest.m_pcObserver) continue;
+
+		a_stInterest.m_bIsAll = false;
+		a_stInterest.m_lCol = i_lCol;
+		a_stInterest.m_lRow = i_lRow;
+		a_stInterest.m_lWidth = i_lWidth;
+		a_stInterest.m_lHeight = i_lHeight;
+		this->notifySnapshot(a_stInterest);
+		a_bIsFound = true;
+	}
+	return a_bIsFound;
+}
+
+/******************************************
+ * Observerを登録解除する.
+ ******************************************/
+void MatrixCell::detach(Observer<MatrixCellAttribute>* i_pcObserver)
+{
+	Subject<MatrixCellAttribute>::detach(i_pcObserver);
+	for(size_t a_lIndex=this->m_vecInterest.size(); a_lIndex>0; a_lIndex--)
+	{
+		if(i_pcObserver == this->m_vecInterest[a_lIndex - 1].m_pcObserver)
+		{
+			this->m_vecInterest.erase(this->m_vecInterest.begin() + (a_lIndex - 1));
+		}
+	}
 }
 
 /******************************
@@ -30,14 +145,49 @@ void MatrixCell::init(long i_lColMax, long i_lRowMax)
  ******************************/
 bool MatrixCell::refreshCell()
 {
+	TRACE_SCOPE_VALUE("model", "step", this->m_lGeneration + 1);
+
 	// 隣接セルに自分自身の状態を通知する.
-    this->sendStateToNeighborCell();
+	{
+		PROFILE_PHASE(this->m_cProfiler, Profiler::PHASE_SEND);
+		TRACE_SCOPE("model", "send");
+	    this->sendStateToNeighborCell();
+	}
 	// 次世代のセルを決定する.
-    this->decideNextGeneration();
+	{
+		PROFILE_PHASE(this->m_cProfiler, Profiler::PHASE_DECIDE);
+		TRACE_SCOPE("model", "decide");
+	    this->decideNextGeneration();
+	}
+	// 変化をObserverへ通知する.
+	if(!this->m_vecInterest.empty())
+	{
+		PROFILE_PHASE(this->m_cProfiler, Profiler::PHASE_NOTIFY);
+		TRACE_SCOPE("model", "notify");
+		this->notifyChanged();
+	}
 
+	this->m_lGeneration++;
+	PROFILE_COUNT(this->m_cProfiler, Profiler::COUNTER_VISITED, this->m_lColMax * this->m_lRowMax);
+	PROFILE_COUNT(this->m_cProfiler, Profiler::COUNTER_CHANGED, this->m_lChangedNum);
+	PROFILE_END_GENERATION(this->m_cProfiler, this->m_lGeneration);
 	return true;
 }
 
+/**********************************
+ * デストラクタ.
+ **********************************/
+MatrixCell::~MatrixCell()
+{
+	for(size_t a_lRow=0; a_lRow<this->m_vecCellArray.size(); a_lRow++)
+	{
+		for(size_t a_lCol=0; a_lCol<this->m_vecCellArray[a_lRow].size(); a_lCol++)
+		{
+			delete this->m_vecCellArray[a_lRow][a_lCol];
+		}
+	}
+}
+
 /**********************************
  * セルを生成する.
  *
@@ -48,6 +198,8 @@ bool MatrixCell::makeCell()
     Cell* a_pcCell = 0;
 	vector<Cell*> a_vecCell;
 
+	// 行の索引は必要な数だけ確保する.(見積りと使用量を一致させる).
+	this->m_vecCellArray.reserve(m_lRowMax);
     for(long a_lRow=0; a_lRow<m_lRowMax; a_lRow++)
     {
         for(long a_lCol=0; a_lCol<m_lColMax; a_lCol++)
@@ -110,6 +262,13 @@ bool MatrixCell::setNeighborCell(Cell* i_pcTargetCell, long i_lCol, long i_lRow)
 		// 隣接セル（横）のインデックスを計算.
 		long a_lNeighborRow = i_lRow + a_rglRow[a_lIndex];
 
+		// 端が繋がっていなければ盤面の外は隣接セルにしない.
+		if(BOUNDARY_DEAD == this->m_eBoundary)
+		{
+			if( (0 > a_lNeighborCol) || (this->m_lColMax <= a_lNeighborCol) ) continue;
+			if( (0 > a_lNeighborRow) || (this->m_lRowMax <= a_lNeighborRow) ) continue;
+		}
+
 		// インデックスの境界値をチェック.
 		a_lNeighborCol = this->check_region(a_lNeighborCol, this->m_lColMax);
 		a_lNeighborRow = this->check_region(a_lNeighborRow, this->m_lRowMax);
@@ -171,6 +330,10 @@ bool MatrixCell::decideNextGeneration()
 {
     Cell* a_pcCell = 0;
 	bool a_bIsChanged = false;
+	long a_lBornNum = 0;
+	long a_lChangedNum = 0;
+	// Observerがいなければ変化を記録しない.(記録した変化はrefreshCell()がnotifyChanged()で通知する).
+	bool a_bIsObserved = !this->m_vecInterest.empty();
 
     for(long a_lRow=0; a_lRow<m_lRowMax; a_lRow++)
     {
@@ -179,21 +342,373 @@ bool MatrixCell::decideNextGeneration()
             a_pcCell = this->getCell(a_lCol, a_lRow);
             // @@ToDo@@
 
-            a_bIsChanged = a_pcCell->decideState();
-			if(a_bIsChanged) this->sendState(a_lCol, a_lRow, a_pcCell->getState());
+            a_bIsChanged = a_pcCell->decideState(this->m_cRule);
+			if(a_bIsChanged)
+			{
+				CellAttribute::CELL_STATE a_eState = a_pcCell->getState();
+				a_lChangedNum++;
+				if(CellAttribute::ALIVE == a_eState) a_lBornNum++;
+				if(a_bIsObserved) this->markChanged(a_lCol, a_lRow, CellAttribute::ALIVE == a_eState);
+			}
         }
     }
 
+	// 誕生は+1, 死亡は-1.
+	this->m_lChangedNum = a_lChangedNum;
+	this->m_lPopulation += a_lBornNum * 2 - a_lChangedNum;
+
     return true;
 }
 
-/*******************************
- * MatrixCellの状態を通知する.
- *******************************/
-bool MatrixCell::sendState(long i_lCol, long i_lRow, CellAttribute::CELL_STATE a_eState)
+/******************************************
+ * 記録した変化をタイル毎に通知し, 記録を消す.
+ ******************************************/
+void MatrixCell::notifyChanged()
 {
-	MatrixCellAttribute a_cMatrixCellAttribute(i_lCol, i_lRow, a_eState);
-	this->notify(&a_cMatrixCellAttribute);
+	long a_lTileColNum = this->m_cChangedBoard.getWordNum();
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecInterest.size(); a_lIndex++)
+	{
+		const INTEREST& a_stInterest = this->m_vecInterest[a_lIndex];
+		if(a_stInterest.m_bIsAll)
+		{
+			// 盤面全体: 変化があったタイルを全て通知.
+			for(size_t a_lDirty=0; a_lDirty<this->m_vecDirtyTile.size(); a_lDirty++)
+			{
+				long a_lTile = this->m_vecDirtyTile[a_lDirty];
+				this->notifyInterest(a_stInterest, (a_lTile % a_lTileColNum) * TILE_SIZE, (a_lTile / a_lTileColNum) * TILE_SIZE, TILE_SIZE, TILE_SIZE,
+					0, 0, this->m_cBornBoard, this->m_cChangedBoard);
+			}
+			continue;
+		}
+
+		// 関心領域: 関心領域に掛かるタイルだけを調べる.
+		long a_lCol = a_stInterest.m_lCol;
+		long a_lRow = a_stInterest.m_lRow;
+		long a_lWidth = a_stInterest.m_lWidth;
+		long a_lHeight = a_stInterest.m_lHeight;
+		if(!this->clipRegion(a_lCol, a_lRow, a_lWidth, a_lHeight)) continue;
+		for(long a_lTileRow=a_lRow / TILE_SIZE; a_lTileRow<=(a_lRow + a_lHeight - 1) / TILE_SIZE; a_lTileRow++)
+		{
+			for(long a_lTileCol=a_lCol / TILE_SIZE; a_lTileCol<=(a_lCol + a_lWidth - 1) / TILE_SIZE; a_lTileCol++)
+			{
+				if(!this->m_vecTileDirty[a_lTileRow * a_lTileColNum + a_lTileCol]) continue;
+				this->notifyInterest(a_stInterest, a_lTileCol * TILE_SIZE, a_lTileRow * TILE_SIZE, TILE_SIZE, TILE_SIZE,
+					0, 0, this->m_cBornBoard, this->m_cChangedBoard);
+			}
+		}
+	}
+
+	// 変化があったタイルの記録だけを消す.
+	for(size_t a_lDirty=0; a_lDirty<this->m_vecDirtyTile.size(); a_lDirty++)
+	{
+		long a_lTile = this->m_vecDirtyTile[a_lDirty];
+		long a_lWord = a_lTile % a_lTileColNum;
+		long a_lRowEnd = min((a_lTile / a_lTileColNum + 1) * TILE_SIZE, this->m_lRowMax);
+		for(long a_lRow=(a_lTile / a_lTileColNum) * TILE_SIZE; a_lRow<a_lRowEnd; a_lRow++)
+		{
+			this->m_cChangedBoard.getRow(a_lRow)[a_lWord] = 0;
+			this->m_cBornBoard.getRow(a_lRow)[a_lWord] = 0;
+		}
+		this->m_vecTileDirty[a_lTile] = 0;
+	}
+	this->m_vecDirtyTile.clear();
+}
+
+/******************************************
+ * 矩形の一括通知を関心領域で切り取って送る.
+ ******************************************/
+void MatrixCell::notifyInterest(const INTEREST& i_stInterest, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight,
+	long i_lBoardCol, long i_lBoardRow, const BitBoard& i_cRegion, const BitBoard& i_cChanged)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight)) return;
+	if(!i_stInterest.m_bIsAll)
+	{
+		long a_lColEnd = min(i_lCol + i_lWidth, i_stInterest.m_lCol + i_stInterest.m_lWidth);
+		long a_lRowEnd = min(i_lRow + i_lHeight, i_stInterest.m_lRow + i_stInterest.m_lHeight);
+		i_lCol = max(i_lCol, i_stInterest.m_lCol);
+		i_lRow = max(i_lRow, i_stInterest.m_lRow);
+		i_lWidth = a_lColEnd - i_lCol;
+		i_lHeight = a_lRowEnd - i_lRow;
+		if( (0 >= i_lWidth) || (0 >= i_lHeight) ) return;
+	}
+
+	MatrixCellAttribute a_cMatrixCellAttribute(i_lBoardCol, i_lBoardRow, &i_cRegion, &i_cChanged,
+		i_lCol - i_lBoardCol, i_lRow - i_lBoardRow, i_lWidth, i_lHeight);
+	i_stInterest.m_pcObserver->update(&a_cMatrixCellAttribute);
+	PROFILE_COUNT(this->m_cProfiler, Profiler::COUNTER_NOTIFY, 1);
+}
+
+/******************************************
+ * 関心領域内の全セルを送る.
+ ******************************************/
+void MatrixCell::notifySnapshot(const INTEREST& i_stInterest)
+{
+	long a_lCol = i_stInterest.m_lCol;
+	long a_lRow = i_stInterest.m_lRow;
+	long a_lWidth = i_stInterest.m_lWidth;
+	long a_lHeight = i_stInterest.m_lHeight;
+	if(!this->clipRegion(a_lCol, a_lRow, a_lWidth, a_lHeight)) return;
+
+	// 全セルを"変化した"として送る.
+	BitBoard a_cRegion;
+	this->copyRegion(a_lCol, a_lRow, a_lWidth, a_lHeight, a_cRegion);
+	BitBoard a_cChanged;
+	a_cChanged.init(a_lWidth, a_lHeight);
+	a_cChanged.fillRect(0, 0, a_lWidth, a_lHeight, true);
+	this->notifyInterest(i_stInterest, a_lCol, a_lRow, a_lWidth, a_lHeight, a_lCol, a_lRow, a_cRegion, a_cChanged);
+}
+
+/******************************************
+ * 全セルの状態をBitBoardへ書き出す.
+ ******************************************/
+void MatrixCell::exportBitBoard(BitBoard& o_cBoard, int i_iThreadNum)
+{
+	if( (o_cBoard.getColMax()!=m_lColMax) || (o_cBoard.getRowMax()!=m_lRowMax) )
+	{
+		o_cBoard.init(m_lColMax, m_lRowMax);
+	}
+
+	parallelFor(0, m_lRowMax, i_iThreadNum, [this, &o_cBoard](long i_lBegin, long i_lEnd)
+	{
+		PROFILE_PHASE(this->m_cProfiler, Profiler::PHASE_EXPORT);
+		TRACE_SCOPE_VALUE("band", "export", i_lBegin);
+		for(long a_lRow=i_lBegin; a_lRow<i_lEnd; a_lRow++)
+		{
+			vector<Cell*>& a_vecRow = this->m_vecCellArray[a_lRow];
+			BitBoard::WORD* a_pWord = o_cBoard.getRow(a_lRow);
+
+			// 64セル分をまとめて1ワードに詰める.
+			for(long a_lWord=0; a_lWord<o_cBoard.getWordNum(); a_lWord++)
+			{
+				BitBoard::WORD a_wBits = 0;
+				long a_lBase = a_lWord * BitBoard::WORD_BIT;
+				long a_lEnd = a_lBase + BitBoard::WORD_BIT;
+				if(a_lEnd > m_lColMax) a_lEnd = m_lColMax;
+				for(long a_lCol=a_lBase; a_lCol<a_lEnd; a_lCol++)
+				{
+					if(CellAttribute::ALIVE == a_vecRow[a_lCol]->getState())
+					{
+						a_wBits |= static_cast<BitBoard::WORD>(1) << (a_lCol - a_lBase);
+					}
+				}
+				a_pWord[a_lWord] = a_wBits;
+			}
+		}
+	});
+}
+
+/******************************************
+ * BitBoardから全セルの状態を読み込む.
+ ******************************************/
+void MatrixCell::importBitBoard(const BitBoard& i_cBoard, int i_iThreadNum)
+{
+	parallelFor(0, m_lRowMax, i_iThreadNum, [this, &i_cBoard](long i_lBegin, long i_lEnd)
+	{
+		TRACE_SCOPE_VALUE("band", "import", i_lBegin);
+		for(long a_lRow=i_lBegin; a_lRow<i_lEnd; a_lRow++)
+		{
+			vector<Cell*>& a_vecRow = this->m_vecCellArray[a_lRow];
+			const BitBoard::WORD* a_pWord = i_cBoard.getRow(a_lRow);
+
+			// 1ワード(64セル)ずつ読む.
+			for(long a_lBase=0; a_lBase<m_lColMax; a_lBase+=BitBoard::WORD_BIT)
+			{
+				BitBoard::WORD a_wBits = *a_pWord++;
+				long a_lEnd = a_lBase + BitBoard::WORD_BIT;
+				if(a_lEnd > m_lColMax) a_lEnd = m_lColMax;
+				for(long a_lCol=a_lBase; a_lCol<a_lEnd; a_lCol++, a_wBits>>=1)
+				{
+					a_vecRow[a_lCol]->setState( (a_wBits & 1)? CellAttribute::ALIVE : CellAttribute::DEAD );
+				}
+			}
+		}
+	});
+	this->m_lPopulation = i_cBoard.count();
+}
+
+/******************************************
+ * 矩形内の全セルを"生"にする.
+ ******************************************/
+bool MatrixCell::fillRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight)) return false;
+
+	BitBoard a_cBefore;
+	this->copyRegion(i_lCol, i_lRow, i_lWidth, i_lHeight, a_cBefore);
+	BitBoard a_cAfter(i_lWidth, i_lHeight);
+	a_cAfter.fillRect(0, 0, i_lWidth, i_lHeight, true);
+	return this->applyRegion(i_lCol, i_lRow, a_cBefore, a_cAfter);
+}
+
+/******************************************
+ * 矩形内の全セルを"死"にする.
+ ******************************************/
+bool MatrixCell::clearRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight)) return false;
+
+	BitBoard a_cBefore;
+	this->copyRegion(i_lCol, i_lRow, i_lWidth, i_lHeight, a_cBefore);
+	BitBoard a_cAfter(i_lWidth, i_lHeight);
+	return this->applyRegion(i_lCol, i_lRow, a_cBefore, a_cAfter);
+}
+
+/******************************************
+ * 矩形内の全セルの 生/死 を反転する.
+ ******************************************/
+bool MatrixCell::invertRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight)) return false;
+
+	BitBoard a_cBefore;
+	this->copyRegion(i_lCol, i_lRow, i_lWidth, i_lHeight, a_cBefore);
+	BitBoard a_cAfter = a_cBefore;
+	a_cAfter.invertRect(0, 0, i_lWidth, i_lHeight);
+	return this->applyRegion(i_lCol, i_lRow, a_cBefore, a_cAfter);
+}
+
+/******************************************
+ * 矩形内のセルの状態をクリップボードへ写す.
+ ******************************************/
+void MatrixCell::copyRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight, BitBoard& o_cClipboard)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight))
+	{
+		o_cClipboard.init(0, 0);
+		return;
+	}
+
+	o_cClipboard.init(i_lWidth, i_lHeight);
+	for(long a_lRow=0; a_lRow<i_lHeight; a_lRow++)
+	{
+		vector<Cell*>& a_vecRow = this->m_vecCellArray[i_lRow + a_lRow];
+		BitBoard::WORD* a_pWord = o_cClipboard.getRow(a_lRow);
+
+		// 64セル分をまとめて1ワードに詰める.
+		for(long a_lWord=0; a_lWord<o_cClipboard.getWordNum(); a_lWord++)
+		{
+			BitBoard::WORD a_wBits = 0;
+			long a_lBase = a_lWord * BitBoard::WORD_BIT;
+			long a_lEnd = a_lBase + BitBoard::WORD_BIT;
+			if(a_lEnd > i_lWidth) a_lEnd = i_lWidth;
+			for(long a_lCol=a_lBase; a_lCol<a_lEnd; a_lCol++)
+			{
+				if(CellAttribute::ALIVE == a_vecRow[i_lCol + a_lCol]->getState())
+				{
+					a_wBits |= static_cast<BitBoard::WORD>(1) << (a_lCol - a_lBase);
+				}
+			}
+			a_pWord[a_lWord] = a_wBits;
+		}
+	}
+}
+
+/******************************************
+ * クリップボードを貼り付ける.
+ ******************************************/
+bool MatrixCell::pasteRegion(const BitBoard& i_cClipboard, long i_lCol, long i_lRow, BitBoard::PASTE_MODE i_eMode)
+{
+	long a_lWidth = i_cClipboard.getColMax();
+	long a_lHeight = i_cClipboard.getRowMax();
+	if( (0>i_lCol) || (0>i_lRow) || !this->clipRegion(i_lCol, i_lRow, a_lWidth, a_lHeight) ) return false;
+
+	BitBoard a_cBefore;
+	this->copyRegion(i_lCol, i_lRow, a_lWidth, a_lHeight, a_cBefore);
+	BitBoard a_cAfter = a_cBefore;
+	a_cAfter.pasteRect(i_cClipboard, 0, 0, i_eMode);
+	return this->applyRegion(i_lCol, i_lRow, a_cBefore, a_cAfter);
+}
+
+/******************************************
+ * 矩形内のセルを時計回りに90度回転する.
+ ******************************************/
+bool MatrixCell::rotateRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight)) return false;
+
+	BitBoard a_cSource;
+	this->copyRegion(i_lCol, i_lRow, i_lWidth, i_lHeight, a_cSource);
+	BitBoard a_cRotated;
+	a_cSource.rotateClockwise(a_cRotated);
+
+	// 回転前と回転後の矩形を合わせた範囲を更新する.
+	long a_lSize = std::max(i_lWidth, i_lHeight);
+	long a_lWidth = a_lSize;
+	long a_lHeight = a_lSize;
+	this->clipRegion(i_lCol, i_lRow, a_lWidth, a_lHeight);
+
+	BitBoard a_cBefore;
+	this->copyRegion(i_lCol, i_lRow, a_lWidth, a_lHeight, a_cBefore);
+	BitBoard a_cAfter = a_cBefore;
+	a_cAfter.fillRect(0, 0, i_lWidth, i_lHeight, false);
+	a_cAfter.pasteRect(a_cRotated, 0, 0, BitBoard::PASTE_REPLACE);
+	return this->applyRegion(i_lCol, i_lRow, a_cBefore, a_cAfter);
+}
+
+/******************************************
+ * 矩形内のセルを反転する.
+ ******************************************/
+bool MatrixCell::flipRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight, bool i_bIsHorizontal)
+{
+	if(!this->clipRegion(i_lCol, i_lRow, i_lWidth, i_lHeight)) return false;
+
+	BitBoard a_cBefore;
+	this->copyRegion(i_lCol, i_lRow, i_lWidth, i_lHeight, a_cBefore);
+	BitBoard a_cAfter = a_cBefore;
+	if(i_bIsHorizontal) a_cAfter.flipHorizontal();
+	else                a_cAfter.flipVertical();
+	return this->applyRegion(i_lCol, i_lRow, a_cBefore, a_cAfter);
+}
+
+/******************************************
+ * 矩形を範囲内に切り詰める.
+ ******************************************/
+bool MatrixCell::clipRegion(long& io_lCol, long& io_lRow, long& io_lWidth, long& io_lHeight) const
+{
+	if(0 > io_lCol) { io_lWidth += io_lCol;  io_lCol = 0; }
+	if(0 > io_lRow) { io_lHeight += io_lRow; io_lRow = 0; }
+	if(io_lCol + io_lWidth > m_lColMax)  io_lWidth = m_lColMax - io_lCol;
+	if(io_lRow + io_lHeight > m_lRowMax) io_lHeight = m_lRowMax - io_lRow;
+	return (0 < io_lWidth) && (0 < io_lHeight);
+}
+
+/******************************************
+ * 矩形内のセルを変更後の状態にし, 変化したセルを一括で通知する.
+ ******************************************/
+bool MatrixCell::applyRegion(long i_lCol, long i_lRow, const BitBoard& i_cBefore, const BitBoard& i_cAfter)
+{
+	// 変化したセル = 変更前 XOR 変更後.
+	BitBoard a_cChanged = i_cAfter;
+	a_cChanged.pasteRect(i_cBefore, 0, 0, BitBoard::PASTE_XOR);
+
+	bool a_bIsChanged = false;
+	for(long a_lRow=0; a_lRow<a_cChanged.getRowMax(); a_lRow++)
+	{
+		vector<Cell*>& a_vecRow = this->m_vecCellArray[i_lRow + a_lRow];
+		const BitBoard::WORD* a_pWord = a_cChanged.getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<a_cChanged.getWordNum(); a_lWord++)
+		{
+			// 変化したセルだけを書き換える.
+			BitBoard::WORD a_wBits = a_pWord[a_lWord];
+			while(0 != a_wBits)
+			{
+				long a_lCol = a_lWord * BitBoard::WORD_BIT + __builtin_ctzll(a_wBits);
+				bool a_bAlive = i_cAfter.getBit(a_lCol, a_lRow);
+				a_vecRow[i_lCol + a_lCol]->setState(a_bAlive? CellAttribute::ALIVE : CellAttribute::DEAD);
+				this->m_lPopulation += a_bAlive? 1 : -1;
+				a_wBits &= a_wBits - 1;
+				a_bIsChanged = true;
+			}
+		}
+	}
+	if(!a_bIsChanged) return false;
+
+	// 関心領域と重なる部分だけを通知.
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecInterest.size(); a_lIndex++)
+	{
+		this->notifyInterest(this->m_vecInterest[a_lIndex], i_lCol, i_lRow, a_cChanged.getColMax(), a_cChanged.getRowMax(),
+			i_lCol, i_lRow, i_cAfter, a_cChanged);
+	}
 	return true;
 }
 
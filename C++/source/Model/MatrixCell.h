@@ -12,27 +12,52 @@
 #include "../Lib/Observer.h"
 #include "../Lib/CellAttribute.h"
 #include "../Lib/MatrixCellAttribute.h"
+#include "../Lib/LifeRule.h"
+#include "../Lib/Profiler.h"
+#include "../Lib/MemoryUsage.h"
 #include "Cell.h"
+#include "BitBoard.h"
 
 /**
  * @brief   全細胞（全セル）を管理するクラス.
  * @note    Cellを管理する.
+ * @note    Observerは盤面全体, または注目する矩形(関心領域)を指定して登録する.
+ *          世代の変化は盤面をTILE_SIZE四方のタイルに分けて記録し, 変化があったタイルのうち関心領域と重なる部分だけを
+ *          タイル毎に一括で通知する.(大きな盤面の一部だけを見るObserverの負荷は, 見ている範囲の変化に比例する).
  */
-class MatrixCell : public Subject
+class MatrixCell : public Subject<MatrixCellAttribute>
 {
 public:
+	/**
+	 * @brief	変化を通知するタイルの大きさ.(縦横のセル数. 横はBitBoardの1語).
+	 */
+	enum { TILE_SIZE = BitBoard::WORD_BIT };
+
+	/**
+	 * @brief	盤面の端の扱い.
+	 */
+	enum BOUNDARY {
+		BOUNDARY_TORUS = 0,		// 上下左右の端が反対側の端と繋がる.(トーラス).
+		BOUNDARY_DEAD,			// 盤面の外は常に"死".
+	};
+
     /**
      * @brief   コンストラクタ.
+     * @param   long i_lColMax 横幅.
+     * @param   long i_lRowMax 縦幅.
+     * @param   BOUNDARY i_eBoundary 盤面の端の扱い.
      */
-    MatrixCell(long i_lColMax, long i_lRowMax)
+    MatrixCell(long i_lColMax, long i_lRowMax, BOUNDARY i_eBoundary=BOUNDARY_TORUS)
 	{
+		this->m_eBoundary = i_eBoundary;
 		this->init(i_lColMax, i_lRowMax);
 	}
 
     /**
      * @brief   デストラクタ.
+     * @note    セルを破棄する.
      */
-	virtual ~MatrixCell() { }
+	virtual ~MatrixCell();
 
     /**
      * @brief   初期化.
@@ -55,6 +80,117 @@ public:
      */
     long getRowMax() const { return this->m_lRowMax; }
 
+    /**
+     * @brief   盤面の端の扱いを取得.
+     */
+    BOUNDARY getBoundary() const { return this->m_eBoundary; }
+
+    /**
+     * @brief   現在の世代数を取得.
+     * @param   なし.
+     * @return  世代数.(refreshCell()を呼ぶ度に1増える).
+     */
+    long getGeneration() const { return this->m_lGeneration; }
+
+    /**
+     * @brief   世代数を設定する.
+     * @param   long i_lGeneration 世代数.
+     * @return  なし.
+     * @note    履歴から盤面を巻き戻す場合に使う.(セルの状態は変えない).
+     */
+    void setGeneration(long i_lGeneration) { this->m_lGeneration = i_lGeneration; }
+
+    /**
+     * @brief   Observerを登録する.(盤面全体の変化を通知する).
+     * @param   Observer<MatrixCellAttribute>* i_pcObserver 登録するオブザーバ.
+     * @return  なし.
+     */
+    virtual void attach(Observer<MatrixCellAttribute>* i_pcObserver);
+
+    /**
+     * @brief   Observerを関心領域を指定して登録する.(関心領域内の変化だけを通知する).
+     * @param   Observer<MatrixCellAttribute>* i_pcObserver 登録するオブザーバ.
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置(上端).
+     * @param   long i_lWidth 横幅.
+     * @param   long i_lHeight 縦幅.
+     * @return  なし.
+     * @note    登録時に関心領域内の全セルを一括で通知する.
+     */
+    void attach(Observer<MatrixCellAttribute>* i_pcObserver, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   登録済みのObserverの関心領域を変更する.(ビューポートが動いた場合など).
+     * @param   Observer<MatrixCellAttribute>* i_pcObserver オブザーバ.
+     * @param   long i_lCol 〜 long i_lHeight 新しい関心領域.
+     * @return  成功/失敗.(登録されていない).
+     * @note    新しい関心領域内の全セルを一括で通知する.(関心領域の外で起きた変化を受信側が取りこぼさないように).
+     */
+    bool setInterest(Observer<MatrixCellAttribute>* i_pcObserver, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   Observerを登録解除する.
+     * @param   Observer<MatrixCellAttribute>* i_pcObserver 登録解除するオブザーバ.
+     * @return  なし.
+     */
+    virtual void detach(Observer<MatrixCellAttribute>* i_pcObserver);
+
+    /**
+     * @brief   生きているセルの数を取得.
+     * @param   なし.
+     * @return  生きているセルの数.(セルの状態を変える度に増減させており, 数え直さない).
+     */
+    long getPopulation() const { return this->m_lPopulation; }
+
+    /**
+     * @brief   直前のrefreshCell()で状態が変化したセルの数を取得.
+     * @param   なし.
+     * @return  変化したセルの数.(誕生と死亡の合計).
+     */
+    long getChangedNum() const { return this->m_lChangedNum; }
+
+    /**
+     * @brief   処理段階毎の時間と件数を取得.(LIFEGAME_PROFILEを定義してビルドした場合のみ計測する).
+     * @note    世代毎の集計はrefreshCell()の終わりに行う.(exportBitBoard()の時間は次の世代に含まれる).
+     */
+    const Profiler& getProfiler() const { return this->m_cProfiler; }
+
+    /**
+     * @brief   処理段階毎の時間と件数を取得.(定期的な出力の設定用).
+     */
+    Profiler& getProfiler() { return this->m_cProfiler; }
+
+    /**
+     * @brief   確保しているメモリの量を分類別に加算する.
+     * @param   MemoryUsage& io_cUsage 加算先.
+     * @return  なし.
+     * @note    セル(1個ずつnewする)と索引はcell, セル内の隣接セルへのポインタはlink, 変化の記録と関心領域はcacheに入る.
+     *          MatrixCell自身の大きさを含む.
+     */
+    void getMemoryUsage(MemoryUsage& io_cUsage) const;
+
+    /**
+     * @brief   指定した大きさのMatrixCellが確保するメモリの量を, 確保せずに見積もる.
+     * @param   long i_lColMax 横幅.
+     * @param   long i_lRowMax 縦幅.
+     * @param   MemoryUsage& io_cUsage 加算先.
+     * @return  なし.
+     * @note    生成直後のgetMemoryUsage()と一致する.(以降はObserverの登録の分しか増えない).
+     */
+    static void estimateMemoryUsage(long i_lColMax, long i_lRowMax, MemoryUsage& io_cUsage);
+
+    /**
+     * @brief   誕生/生存の規則を取得.
+     */
+    const LifeRule& getRule() const { return this->m_cRule; }
+
+    /**
+     * @brief   誕生/生存の規則を設定.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
+     * @return  なし.
+     */
+    void setRule(const LifeRule& i_cRule) { this->m_cRule = i_cRule; }
+
     /**
      * @brief   セルを取得する.
      * @param   long i_lCol 取得したいセルの横位置.
@@ -77,6 +213,7 @@ public:
     void setCellState(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
 	{
 		Cell* a_pcCell = this->getCell(i_lCol, i_lRow);
+		if(a_pcCell->getState() != i_eState) this->m_lPopulation += (CellAttribute::ALIVE==i_eState)? 1 : -1;
 		a_pcCell->setState(i_eState);
 	}
 
@@ -104,6 +241,98 @@ public:
      */
     bool refreshCell();
 
+	/**
+	 * @brief	全セルの状態をBitBoardへ書き出す.
+	 * @param	BitBoard& o_cBoard 書き出し先.(大きさはMatrixCellに合わせる).
+	 * @param	int i_iThreadNum スレッド数.(行を分割する).
+	 * @return	なし.
+	 */
+	void exportBitBoard(BitBoard& o_cBoard, int i_iThreadNum=1);
+
+	/**
+	 * @brief	BitBoardから全セルの状態を読み込む.
+	 * @param	const BitBoard& i_cBoard 読み込み元.(大きさはMatrixCellと同じであること).
+	 * @param	int i_iThreadNum スレッド数.(行を分割する).
+	 * @return	なし.
+	 * @note	setCellState()と同様, Observerへの通知は行わない.
+	 */
+	void importBitBoard(const BitBoard& i_cBoard, int i_iThreadNum=1);
+
+	/**
+	 * @brief	矩形内の全セルを"生"にする.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	long i_lWidth 横幅.
+	 * @param	long i_lHeight 縦幅.
+	 * @return	変化したセルがあったか否か.
+	 * @note	矩形は範囲内に切り詰める.(以下の矩形操作も同じ).
+	 * @note	変化したセルを1回の通知でObserverへ通知する.(以下の矩形操作も同じ).
+	 */
+	bool fillRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+	/**
+	 * @brief	矩形内の全セルを"死"にする.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	long i_lWidth 横幅.
+	 * @param	long i_lHeight 縦幅.
+	 * @return	変化したセルがあったか否か.
+	 */
+	bool clearRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+	/**
+	 * @brief	矩形内の全セルの 生/死 を反転する.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	long i_lWidth 横幅.
+	 * @param	long i_lHeight 縦幅.
+	 * @return	変化したセルがあったか否か.
+	 */
+	bool invertRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+	/**
+	 * @brief	矩形内のセルの状態をクリップボードへ写す.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	long i_lWidth 横幅.
+	 * @param	long i_lHeight 縦幅.
+	 * @param	BitBoard& o_cClipboard 写し先.(大きさは切り詰めた矩形になる).
+	 * @return	なし.
+	 */
+	void copyRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight, BitBoard& o_cClipboard);
+
+	/**
+	 * @brief	クリップボードを貼り付ける.
+	 * @param	const BitBoard& i_cClipboard 貼り付けるセルの状態.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	BitBoard::PASTE_MODE i_eMode 貼り付け方法.(OR/XOR/置き換え).
+	 * @return	変化したセルがあったか否か.
+	 */
+	bool pasteRegion(const BitBoard& i_cClipboard, long i_lCol, long i_lRow, BitBoard::PASTE_MODE i_eMode);
+
+	/**
+	 * @brief	矩形内のセルを時計回りに90度回転する.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	long i_lWidth 横幅.
+	 * @param	long i_lHeight 縦幅.
+	 * @return	変化したセルがあったか否か.
+	 * @note	左上を基準に回転する.(回転後の矩形は縦横が入れ替わる).
+	 */
+	bool rotateRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+	/**
+	 * @brief	矩形内のセルを反転する.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	long i_lWidth 横幅.
+	 * @param	long i_lHeight 縦幅.
+	 * @param	bool i_bIsHorizontal true:左右反転 false:上下反転.
+	 * @return	変化したセルがあったか否か.
+	 */
+	bool flipRegion(long i_lCol, long i_lRow, long i_lWidth, long i_lHeight, bool i_bIsHorizontal);
+
 	/**
 	 * @brief	全セルの状態を表示.
 	 * @note	デバッグ用.
@@ -127,11 +356,79 @@ private:
      */
     long m_lRowMax;
 
+    /**
+     * @brief   盤面の端の扱い.
+     */
+    BOUNDARY m_eBoundary;
+
+    /**
+     * @brief   世代数.
+     */
+    long m_lGeneration;
+
+    /**
+     * @brief   生きているセルの数.
+     */
+    long m_lPopulation;
+
+    /**
+     * @brief   直前の世代で状態が変化したセルの数.
+     */
+    long m_lChangedNum;
+
+    /**
+     * @brief   誕生/生存の規則.
+     */
+    LifeRule m_cRule;
+
+    /**
+     * @brief   処理段階毎の時間と件数.
+     */
+    Profiler m_cProfiler;
+
     /**
      * @brief   セルの集合体.
      */
     std::vector< std::vector <Cell*> > m_vecCellArray;
 
+	/**
+	 * @brief	Observerと関心領域.
+	 */
+	struct INTEREST
+	{
+		Observer<MatrixCellAttribute>* m_pcObserver;	// オブザーバ.
+		bool m_bIsAll;									// 盤面全体か否か.
+		long m_lCol;									// 関心領域.(m_bIsAllでない場合).
+		long m_lRow;
+		long m_lWidth;
+		long m_lHeight;
+	};
+
+	/**
+	 * @brief	登録されたObserverと関心領域.(Subject::m_pcObserverListと同じ順).
+	 */
+	std::vector<INTEREST> m_vecInterest;
+
+	/**
+	 * @brief	次世代で変化したセル.(盤面と同じ大きさ. notifyChanged()で変化したタイルだけを消す).
+	 */
+	BitBoard m_cChangedBoard;
+
+	/**
+	 * @brief	次世代で誕生したセル.(変化したセルの変化後の状態).
+	 */
+	BitBoard m_cBornBoard;
+
+	/**
+	 * @brief	タイル毎の変化の有無.(行順. 横のタイル数はm_cChangedBoard.getWordNum()).
+	 */
+	std::vector<char> m_vecTileDirty;
+
+	/**
+	 * @brief	変化があったタイル.(変化が見つかった順).
+	 */
+	std::vector<long> m_vecDirtyTile;
+
     /**
      * @brief   セルを生成する.
      * @param   なし.
@@ -195,13 +492,73 @@ private:
     void setColMax(long i_lColMax){ this->m_lColMax = i_lColMax; }
 
 	/**
-	 * @brief   MatrixCellの状態を通知する.
-     * @param   なし.
-     * @return  通知に成功/失敗を返す.
-     * @retval  true    成功.
-     * @retval  false   失敗.
+	 * @brief	次世代で変化したセルを記録する.(通知はnotifyChanged()でまとめて行う).
+	 * @param	long i_lCol 横位置.
+	 * @param	long i_lRow 縦位置.
+	 * @param	bool i_bAlive 変化後の状態.
+	 * @return	なし.
+	 */
+	void markChanged(long i_lCol, long i_lRow, bool i_bAlive)
+	{
+		BitBoard::WORD a_wBit = static_cast<BitBoard::WORD>(1) << (i_lCol % BitBoard::WORD_BIT);
+		long a_lWord = i_lCol / BitBoard::WORD_BIT;
+		this->m_cChangedBoard.getRow(i_lRow)[a_lWord] |= a_wBit;
+		if(i_bAlive) this->m_cBornBoard.getRow(i_lRow)[a_lWord] |= a_wBit;
+
+		long a_lTile = (i_lRow / TILE_SIZE) * this->m_cChangedBoard.getWordNum() + a_lWord;
+		if(!this->m_vecTileDirty[a_lTile])
+		{
+			this->m_vecTileDirty[a_lTile] = 1;
+			this->m_vecDirtyTile.push_back(a_lTile);
+		}
+	}
+
+	/**
+	 * @brief	記録した変化を, 変化があったタイル毎にObserverへ通知し, 記録を消す.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void notifyChanged();
+
+	/**
+	 * @brief	矩形の一括通知を関心領域で切り取って1つのObserverへ送る.
+	 * @param	const INTEREST& i_stInterest 送り先.
+	 * @param	long i_lCol 〜 long i_lHeight 通知する矩形.(盤面の座標).
+	 * @param	long i_lBoardCol 横位置(BitBoardの左端).
+	 * @param	long i_lBoardRow 縦位置(BitBoardの上端).
+	 * @param	const BitBoard& i_cRegion 全セルの状態.
+	 * @param	const BitBoard& i_cChanged 変化したセル.
+	 * @return	なし.(関心領域と重ならなければ送らない).
+	 */
+	void notifyInterest(const INTEREST& i_stInterest, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight,
+		long i_lBoardCol, long i_lBoardRow, const BitBoard& i_cRegion, const BitBoard& i_cChanged);
+
+	/**
+	 * @brief	関心領域内の全セルを1つのObserverへ送る.
+	 * @param	const INTEREST& i_stInterest 送り先.
+	 * @return	なし.
+	 */
+	void notifySnapshot(const INTEREST& i_stInterest);
+
+	/**
+	 * @brief	矩形を範囲内に切り詰める.
+	 * @param	long& io_lCol 横位置(左端).
+	 * @param	long& io_lRow 縦位置(上端).
+	 * @param	long& io_lWidth 横幅.
+	 * @param	long& io_lHeight 縦幅.
+	 * @return	切り詰めた矩形が空でないか否か.
+	 */
+	bool clipRegion(long& io_lCol, long& io_lRow, long& io_lWidth, long& io_lHeight) const;
+
+	/**
+	 * @brief	矩形内のセルを変更後の状態にし, 変化したセルを一括で通知する.
+	 * @param	long i_lCol 横位置(左端).
+	 * @param	long i_lRow 縦位置(上端).
+	 * @param	const BitBoard& i_cBefore 変更前の状態.
+	 * @param	const BitBoard& i_cAfter 変更後の状態.(i_cBeforeと同じ大きさ).
+	 * @return	変化したセルがあったか否か.
 	 */
-	bool sendState(long i_lCol, long i_lRow, CellAttribute::CELL_STATE a_eState);
+	bool applyRegion(long i_lCol, long i_lRow, const BitBoard& i_cBefore, const BitBoard& i_cAfter);
 
     /**
      * @brief   セルの縦最大幅を設定.
@@ -0,0 +1,221 @@
+/**
+ * @file    PatternFile.cpp
+ * @brief   パターンファイルを読み書きするクラスの実装.
+ */
+#include "PatternFile.h"
+#include "../Lib/Tracer.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+using namespace std;
+
+// RLE形式の1行の最大文字数.
+#define RLE_LINE_MAX	(70)
+
+/******************************************
+ * パターンファイルを読み込む.
+ ******************************************/
+bool PatternFile::load(const string& i_strPath, BitBoard& o_cPattern, LifeRule* o_pcRule)
+{
+	ifstream a_cFile(i_strPath.c_str());
+	if(!a_cFile) return false;
+
+	stringstream a_strStream;
+	a_strStream << a_cFile.rdbuf();
+	string a_strText = a_strStream.str();
+
+	// "x"で始まる行があればRLE形式.
+	istringstream a_cLines(a_strText);
+	string a_strLine;
+	while(getline(a_cLines, a_strLine))
+	{
+		size_t a_lPos = a_strLine.find_first_not_of(" \t");
+		if(string::npos == a_lPos) continue;
+		if('#' == a_strLine[a_lPos]) continue;
+		if('x' == a_strLine[a_lPos]) return parseRle(a_strText, o_cPattern, o_pcRule);
+		break;
+	}
+	return parsePlainText(a_strText, o_cPattern);
+}
+
+/******************************************
+ * パターンをRLE形式で保存する.
+ ******************************************/
+bool PatternFile::save(const string& i_strPath, const BitBoard& i_cPattern, const LifeRule& i_cRule)
+{
+	TRACE_SCOPE("io", "pattern save");
+	ofstream a_cFile(i_strPath.c_str());
+	if(!a_cFile) return false;
+
+	a_cFile << toRle(i_cPattern, i_cRule);
+	return a_cFile.good();
+}
+
+/******************************************
+ * RLE形式の文字列を読み込む.
+ ******************************************/
+bool PatternFile::parseRle(const string& i_strText, BitBoard& o_cPattern, LifeRule* o_pcRule)
+{
+	istringstream a_cLines(i_strText);
+	string a_strLine;
+	long a_lColMax = -1;
+	long a_lRowMax = -1;
+
+	// ヘッダ行 "x = 3, y = 3, rule = B3/S23" を探す.
+	while(getline(a_cLines, a_strLine))
+	{
+		size_t a_lPos = a_strLine.find_first_not_of(" \t");
+		if(string::npos == a_lPos) continue;
+		if('#' == a_strLine[a_lPos]) continue;
+
+		istringstream a_cItems(a_strLine);
+		string a_strItem;
+		while(getline(a_cItems, a_strItem, ','))
+		{
+			size_t a_lEqual = a_strItem.find('=');
+			if(string::npos == a_lEqual) return false;
+			string a_strKey = a_strItem.substr(0, a_lEqual);
+			string a_strValue = a_strItem.substr(a_lEqual + 1);
+			a_strKey.erase(0, a_strKey.find_first_not_of(" \t"));
+			a_strKey.erase(a_strKey.find_last_not_of(" \t\r") + 1);
+			a_strValue.erase(0, a_strValue.find_first_not_of(" \t"));
+			a_strValue.erase(a_strValue.find_last_not_of(" \t\r") + 1);
+
+			if("x" == a_strKey) a_lColMax = atol(a_strValue.c_str());
+			else if("y" == a_strKey) a_lRowMax = atol(a_strValue.c_str());
+			else if( ("rule" == a_strKey) && (0 != o_pcRule) ) o_pcRule->parse(a_strValue);
+		}
+		break;
+	}
+	if( (0>a_lColMax) || (0>a_lRowMax) ) return false;
+
+	o_cPattern.init(a_lColMax, a_lRowMax);
+
+	// 本体 "bo$2bo$3o!" を読む.
+	long a_lCol = 0;
+	long a_lRow = 0;
+	long a_lCount = 0;
+	char a_ch = '\0';
+	while(a_cLines.get(a_ch))
+	{
+		if( ('0'<=a_ch) && ('9'>=a_ch) )
+		{
+			a_lCount = a_lCount * 10 + (a_ch - '0');
+			continue;
+		}
+		long a_lRun = (0==a_lCount)? 1 : a_lCount;
+		a_lCount = 0;
+
+		if('!' == a_ch) break;
+		else if('$' == a_ch)
+		{
+			a_lRow += a_lRun;
+			a_lCol = 0;
+		}
+		else if('b' == a_ch || '.' == a_ch)
+		{
+			a_lCol += a_lRun;
+		}
+		else if( (('a'<=a_ch) && ('z'>=a_ch)) || (('A'<=a_ch) && ('Z'>=a_ch)) )
+		{
+			// 'o'以外の状態(多状態の規則)も生として扱う.
+			for(long a_lIndex=0; a_lIndex<a_lRun; a_lIndex++, a_lCol++)
+			{
+				if( (a_lCol<a_lColMax) && (a_lRow<a_lRowMax) ) o_cPattern.setBit(a_lCol, a_lRow, true);
+			}
+		}
+	}
+
+	return true;
+}
+
+/******************************************
+ * プレーンテキスト形式の文字列を読み込む.
+ ******************************************/
+bool PatternFile::parsePlainText(const string& i_strText, BitBoard& o_cPattern)
+{
+	istringstream a_cLines(i_strText);
+	string a_strLine;
+	vector<string> a_vecRow;
+	long a_lColMax = 0;
+
+	while(getline(a_cLines, a_strLine))
+	{
+		if( !a_strLine.empty() && ('!'==a_strLine[0]) ) continue;
+		if( !a_strLine.empty() && ('\r'==a_strLine[a_strLine.size()-1]) ) a_strLine.erase(a_strLine.size()-1);
+		a_vecRow.push_back(a_strLine);
+		if(a_lColMax < static_cast<long>(a_strLine.size())) a_lColMax = a_strLine.size();
+	}
+
+	// 末尾の空行は無視する.
+	while( !a_vecRow.empty() && a_vecRow.back().empty() ) a_vecRow.pop_back();
+
+	o_cPattern.init(a_lColMax, a_vecRow.size());
+	for(size_t a_lRow=0; a_lRow<a_vecRow.size(); a_lRow++)
+	{
+		for(size_t a_lCol=0; a_lCol<a_vecRow[a_lRow].size(); a_lCol++)
+		{
+			char a_ch = a_vecRow[a_lRow][a_lCol];
+			if('O'==a_ch || '*'==a_ch) o_cPattern.setBit(a_lCol, a_lRow, true);
+			else if('.'!=a_ch && ' '!=a_ch) return false;
+		}
+	}
+	return true;
+}
+
+/******************************************
+ * パターンをRLE形式の文字列にする.
+ ******************************************/
+string PatternFile::toRle(const BitBoard& i_cPattern, const LifeRule& i_cRule)
+{
+	ostringstream a_strStream;
+	a_strStream << "x = " << i_cPattern.getColMax() << ", y = " << i_cPattern.getRowMax()
+		<< ", rule = " << i_cRule.toString() << endl;
+
+	string a_strLine;
+	long a_lEmptyRow = 0;
+
+	// 1つの連続(個数+文字)を追加する. 1行はRLE_LINE_MAX文字まで.
+	#define APPEND_RUN(count, tag) \
+		do{ \
+			ostringstream a_strRun; \
+			if(1 < (count)) a_strRun << (count); \
+			a_strRun << (tag); \
+			if(RLE_LINE_MAX < a_strLine.size() + a_strRun.str().size()) \
+			{ \
+				a_strStream << a_strLine << endl; \
+				a_strLine.clear(); \
+			} \
+			a_strLine += a_strRun.str(); \
+		}while(0)
+
+	for(long a_lRow=0; a_lRow<i_cPattern.getRowMax(); a_lRow++)
+	{
+		// 行内の連続を数える.(行末の死セルは書かない).
+		long a_lCol = 0;
+		bool a_bIsFirst = true;
+		while(a_lCol < i_cPattern.getColMax())
+		{
+			bool a_bAlive = i_cPattern.getBit(a_lCol, a_lRow);
+			long a_lRun = 1;
+			while( (a_lCol+a_lRun < i_cPattern.getColMax()) && (a_bAlive == i_cPattern.getBit(a_lCol+a_lRun, a_lRow)) ) a_lRun++;
+			if( !a_bAlive && (a_lCol+a_lRun == i_cPattern.getColMax()) ) break;
+
+			if(a_bIsFirst && (0 < a_lEmptyRow))
+			{
+				APPEND_RUN(a_lEmptyRow, '$');
+				a_lEmptyRow = 0;
+			}
+			a_bIsFirst = false;
+			APPEND_RUN(a_lRun, a_bAlive? 'o' : 'b');
+			a_lCol += a_lRun;
+		}
+		a_lEmptyRow++;
+	}
+	#undef APPEND_RUN
+
+	a_strStream << a_strLine << "!" << endl;
+	return a_strStream.str();
+}
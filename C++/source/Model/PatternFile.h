@@ -0,0 +1,68 @@
+/**
+ * @file    PatternFile.h
+ * @brief   パターンファイルを読み書きするクラスの宣言.
+ */
+
+#ifndef __PATTERN_FILE_H__
+#define __PATTERN_FILE_H__
+
+#include <string>
+
+#include "../Lib/LifeRule.h"
+#include "BitBoard.h"
+
+/**
+ * @brief   パターンファイルを読み書きするクラス.
+ * @note    以下の形式に対応する.
+ * @note        ・RLE形式(.rle). "x = 3, y = 3, rule = B3/S23" の行と "bo$2bo$3o!" の形式.
+ * @note        ・プレーンテキスト形式(.cells). '!'で始まる行はコメント. '.'が死, 'O'または'*'が生.
+ */
+class PatternFile
+{
+public:
+    /**
+     * @brief   パターンファイルを読み込む.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   BitBoard& o_cPattern 読み込んだパターン.(大きさはパターンに合わせる).
+     * @param   LifeRule* o_pcRule ファイルに規則が書かれていた場合に設定する.(不要なら0).
+     * @return  成功/失敗.
+     * @note    形式は内容から判定する.
+     */
+    static bool load(const std::string& i_strPath, BitBoard& o_cPattern, LifeRule* o_pcRule=0);
+
+    /**
+     * @brief   パターンをRLE形式で保存する.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   const BitBoard& i_cPattern 保存するパターン.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
+     * @return  成功/失敗.
+     */
+    static bool save(const std::string& i_strPath, const BitBoard& i_cPattern, const LifeRule& i_cRule);
+
+    /**
+     * @brief   RLE形式の文字列を読み込む.
+     * @param   const std::string& i_strText RLE形式の文字列.
+     * @param   BitBoard& o_cPattern 読み込んだパターン.
+     * @param   LifeRule* o_pcRule 規則が書かれていた場合に設定する.(不要なら0).
+     * @return  成功/失敗.
+     */
+    static bool parseRle(const std::string& i_strText, BitBoard& o_cPattern, LifeRule* o_pcRule=0);
+
+    /**
+     * @brief   プレーンテキスト形式の文字列を読み込む.
+     * @param   const std::string& i_strText プレーンテキスト形式の文字列.
+     * @param   BitBoard& o_cPattern 読み込んだパターン.
+     * @return  成功/失敗.
+     */
+    static bool parsePlainText(const std::string& i_strText, BitBoard& o_cPattern);
+
+    /**
+     * @brief   パターンをRLE形式の文字列にする.
+     * @param   const BitBoard& i_cPattern パターン.
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
+     * @return  RLE形式の文字列.
+     */
+    static std::string toRle(const BitBoard& i_cPattern, const LifeRule& i_cRule);
+};
+
+#endif  //__PATTERN_FILE_H__
@@ -0,0 +1,75 @@
+/**
+ * @file    SoupGenerator.cpp
+ * @brief   ランダムな初期配置(スープ)を生成するクラスの実装.
+ */
+#include "SoupGenerator.h"
+#include "../Lib/ParallelFor.h"
+#include "../Lib/Tracer.h"
+
+/******************************************
+ * 密度を設定.
+ ******************************************/
+void SoupGenerator::setDensity(double i_dDensity)
+{
+	if(i_dDensity < 0.0) i_dDensity = 0.0;
+	if(i_dDensity > 1.0) i_dDensity = 1.0;
+	this->m_uiDensity = static_cast<unsigned int>(i_dDensity * (1 << DENSITY_BIT) + 0.5);
+}
+
+/******************************************
+ * スープを生成する.
+ ******************************************/
+void SoupGenerator::generate(BitBoard& o_cBoard, int i_iThreadNum) const
+{
+	parallelFor(0, o_cBoard.getRowMax(), i_iThreadNum,
+		[this, &o_cBoard](long i_lBegin, long i_lEnd)
+		{
+			TRACE_SCOPE_VALUE("band", "soup", i_lBegin);
+			this->generateRows(o_cBoard, i_lBegin, i_lEnd);
+		});
+}
+
+/******************************************
+ * 行のスープを生成する.
+ ******************************************/
+void SoupGenerator::generateRows(BitBoard& o_cBoard, long i_lBegin, long i_lEnd) const
+{
+	// 密度 m/256 の2進数を下位ビットから辿り, 1ならOR, 0ならANDで乱数ワードを重ねる.
+	// i番目まで重ねたビットが1になる確率は (b_i + 前の確率) / 2 となり, 最後に m/256 になる.
+	// 下位の0のビットは結果が0のままなので飛ばす.
+	unsigned int a_uiDensity = this->m_uiDensity;
+	int a_iFirstBit = 0;
+	if( (0 != a_uiDensity) && ((1U << DENSITY_BIT) != a_uiDensity) )
+	{
+		while(0 == ((a_uiDensity >> a_iFirstBit) & 1)) a_iFirstBit++;
+	}
+
+	BitBoard::WORD a_wLastMask = o_cBoard.getLastWordMask();
+	long a_lWordNum = o_cBoard.getWordNum();
+	for(long a_lRow=i_lBegin; a_lRow<i_lEnd; a_lRow++)
+	{
+		// 行ごとに独立した乱数列.(分割の仕方に依らず同じ結果になる).
+		uint64_t a_ulState = this->m_ulSeed ^ (static_cast<uint64_t>(a_lRow + 1) * 0xD1B54A32D192ED03ULL);
+		next(a_ulState);
+
+		BitBoard::WORD* a_pWord = o_cBoard.getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<a_lWordNum; a_lWord++)
+		{
+			BitBoard::WORD a_wBits = 0;
+			if((1U << DENSITY_BIT) == a_uiDensity)
+			{
+				a_wBits = ~static_cast<BitBoard::WORD>(0);
+			}
+			else if(0 != a_uiDensity)
+			{
+				for(int a_iBit=a_iFirstBit; a_iBit<DENSITY_BIT; a_iBit++)
+				{
+					BitBoard::WORD a_wRandom = next(a_ulState);
+					a_wBits = ((a_uiDensity >> a_iBit) & 1)? (a_wBits | a_wRandom) : (a_wBits & a_wRandom);
+				}
+			}
+			a_pWord[a_lWord] = a_wBits;
+		}
+		if(0 < a_lWordNum) a_pWord[a_lWordNum - 1] &= a_wLastMask;
+	}
+}
@@ -0,0 +1,97 @@
+/**
+ * @file    SoupGenerator.h
+ * @brief   ランダムな初期配置(スープ)を生成するクラスの宣言.
+ */
+#ifndef __SOUP_GENERATOR_H__
+#define __SOUP_GENERATOR_H__
+
+#include <stdint.h>
+
+#include "BitBoard.h"
+
+/**
+ * @brief   ランダムな初期配置(スープ)を生成するクラス.
+ * @note    乱数はSplitMix64. シードと行番号から行ごとに独立した乱数列を作るため,
+ *          スレッド数に関係なく同じシードからは同じスープができる.
+ * @note    1ワード(64セル)ずつ生成する. 密度は1/256単位に丸め,
+ *          乱数ワードをAND/ORで組み合わせて各ビットが密度の確率で1になるようにする.
+ */
+class SoupGenerator
+{
+public:
+	/**
+	 * @brief	密度の分解能.(ビット数).
+	 */
+	enum { DENSITY_BIT = 8 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   uint64_t i_ulSeed シード.
+     * @param   double i_dDensity 密度.(0.0〜1.0).
+     */
+    SoupGenerator(uint64_t i_ulSeed, double i_dDensity=0.5)
+	{
+		this->m_ulSeed = i_ulSeed;
+		this->setDensity(i_dDensity);
+	}
+
+    /**
+     * @brief   密度を設定.
+     * @param   double i_dDensity 密度.(0.0〜1.0. 範囲外は丸める).
+     * @return  なし.
+     */
+    void setDensity(double i_dDensity);
+
+    /**
+     * @brief   密度を取得.(1/256単位に丸めた値).
+     */
+    double getDensity() const { return static_cast<double>(this->m_uiDensity) / (1 << DENSITY_BIT); }
+
+    /**
+     * @brief   シードを取得.
+     */
+    uint64_t getSeed() const { return this->m_ulSeed; }
+
+    /**
+     * @brief   スープを生成する.
+     * @param   BitBoard& o_cBoard 生成先.(大きさは変えない. 全セルを上書きする).
+     * @param   int i_iThreadNum スレッド数.(行を分割する).
+     * @return  なし.
+     */
+    void generate(BitBoard& o_cBoard, int i_iThreadNum=1) const;
+
+    /**
+     * @brief   SplitMix64の次の乱数.
+     * @param   uint64_t& io_ulState 状態.(呼ぶ度に進む).
+     * @return  乱数.
+     */
+    static uint64_t next(uint64_t& io_ulState)
+	{
+		uint64_t a_ulValue = (io_ulState += 0x9E3779B97F4A7C15ULL);
+		a_ulValue = (a_ulValue ^ (a_ulValue >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		a_ulValue = (a_ulValue ^ (a_ulValue >> 27)) * 0x94D049BB133111EBULL;
+		return a_ulValue ^ (a_ulValue >> 31);
+	}
+
+private:
+    /**
+     * @brief   行のスープを生成する.
+     * @param   BitBoard& o_cBoard 生成先.
+     * @param   long i_lBegin 開始行.
+     * @param   long i_lEnd 終了行.(含まない).
+     * @return  なし.
+     */
+    void generateRows(BitBoard& o_cBoard, long i_lBegin, long i_lEnd) const;
+
+    /**
+     * @brief   シード.
+     */
+    uint64_t m_ulSeed;
+
+    /**
+     * @brief   密度.(1/256単位. 0〜256).
+     */
+    unsigned int m_uiDensity;
+};
+
+#endif	// __SOUP_GENERATOR_H__
@@ -0,0 +1,386 @@
+/*********************************************************
+ * MatrixCellの性能測定.
+ *
+ * 盤面の大きさ毎に以下を測り, 結果をJSONで出力する.
+ * 　・MatrixCellの生成時間と使用メモリ.(ヒープの使用量の増分).
+ * 　・refreshCell()の速さ.(セル更新数/秒). スープ(密度別)と既知のパターン.
+ * 　・GenerationRecorderで全世代を記録した時の, 記録しない場合に対する1世代の時間の増分.(スープ. 密度別).
+ * 　・BitBoardとの変換の速さ.(スレッド数別).
+ *
+ * 使い方: bench_Matrix_Cell [--size N[,N...]] [--density D[,D...]] [--threads T[,T...]]
+ *                           [--updates U] [--max-mb M] [--pattern PATH]... [--json PATH]
+ * 　・--size     盤面の一辺.(既定 64,256,1024,4096,16384).
+ * 　・--density  スープの密度.(既定 0.1,0.3,0.5).
+ * 　・--threads  変換のスレッド数.(既定 1,2,4).
+ * 　・--updates  1つの測定で進めるセル更新数の目安.(既定 3e7. 世代数 = 目安/セル数. 1〜1000世代).
+ * 　・--max-mb   使用メモリの上限.(既定 空きメモリの半分). 超えると見込まれる盤面は測らずに"skipped"とする.
+ * 　・--pattern  測定するパターンファイルを追加する.(ブリーダーなど. RLE/プレーンテキスト).
+ * 　・--json     JSONの出力先.(既定 標準出力). 経過は標準エラー出力に出す.
+ *********************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <malloc.h>
+
+#include "../MatrixCell.h"
+#include "../BitBoard.h"
+#include "../SoupGenerator.h"
+#include "../PatternFile.h"
+#include "../GenerationRecorder.h"
+#include "../../Lib/Clock.h"
+
+using namespace std;
+
+/**
+ * @brief	組み込みのパターン.(RLE).
+ */
+static const struct
+{
+	const char* m_pName;
+	const char* m_pRle;
+} gPATTERN[] = {
+	// 1103世代まで成長するメトセラ.
+	{ "r-pentomino", "x = 3, y = 3\nb2o$2o$bo!\n" },
+	// 5206世代まで成長するメトセラ.
+	{ "acorn", "x = 7, y = 3\nbo5b$3bo3b$2o2b3o!\n" },
+	// 30世代毎にグライダーを出し続ける.(生きているセルが増え続ける).
+	{ "gosper-gun", "x = 36, y = 9\n24bo11b$22bobo11b$12b2o6b2o12b2o$11bo3bo4b2o12b2o$2o8bo5bo3b2o14b$"
+		"2o8bo3bob2o4bobo11b$10bo5bo7bo11b$11bo3bo20b$12b2o22b!\n" },
+};
+
+/**
+ * @brief	測定の設定.
+ */
+struct SETTING
+{
+	vector<long> m_vecSize;				// 盤面の一辺.
+	vector<double> m_vecDensity;		// スープの密度.
+	vector<int> m_vecThread;			// 変換のスレッド数.
+	double m_dUpdates;					// 1つの測定のセル更新数の目安.
+	double m_dMaxByte;					// 使用メモリの上限.
+	vector<string> m_vecPatternPath;	// 追加のパターンファイル.
+	string m_strJsonPath;				// JSONの出力先.(空ならば標準出力).
+};
+
+// ヒープの使用量.(バイト).
+double get_heap_byte()
+{
+	struct mallinfo2 a_stInfo = mallinfo2();
+	return static_cast<double>(a_stInfo.uordblks) + static_cast<double>(a_stInfo.hblkhd);
+}
+
+// 空きメモリ.(バイト. 取得できなければ0).
+double get_available_byte()
+{
+	ifstream a_cFile("/proc/meminfo");
+	string a_strKey;
+	double a_dValue = 0;
+	string a_strUnit;
+	while(a_cFile >> a_strKey >> a_dValue >> a_strUnit)
+	{
+		if("MemAvailable:" == a_strKey) return a_dValue * 1024.0;
+	}
+	return 0;
+}
+
+// カンマ区切りの数値を読む.
+template<typename T>
+vector<T> parse_list(const char* i_pText)
+{
+	vector<T> a_vecValue;
+	istringstream a_cItems(i_pText);
+	string a_strItem;
+	while(getline(a_cItems, a_strItem, ','))
+	{
+		if(!a_strItem.empty()) a_vecValue.push_back(static_cast<T>(atof(a_strItem.c_str())));
+	}
+	return a_vecValue;
+}
+
+// コマンドライン引数を読む.
+bool parse_setting(int argc, char* argv[], SETTING& o_stSetting)
+{
+	o_stSetting.m_vecSize = parse_list<long>("64,256,1024,4096,16384");
+	o_stSetting.m_vecDensity = parse_list<double>("0.1,0.3,0.5");
+	o_stSetting.m_vecThread = parse_list<int>("1,2,4");
+	o_stSetting.m_dUpdates = 3e7;
+	o_stSetting.m_dMaxByte = get_available_byte() / 2;
+
+	for(int a_iIndex=1; a_iIndex<argc; a_iIndex++)
+	{
+		string a_strOption = argv[a_iIndex];
+		if(a_iIndex + 1 >= argc)
+		{
+			cerr << "option requires an argument: " << a_strOption << endl;
+			return false;
+		}
+		const char* a_pValue = argv[++a_iIndex];
+		if("--size" == a_strOption) o_stSetting.m_vecSize = parse_list<long>(a_pValue);
+		else if("--density" == a_strOption) o_stSetting.m_vecDensity = parse_list<double>(a_pValue);
+		else if("--threads" == a_strOption) o_stSetting.m_vecThread = parse_list<int>(a_pValue);
+		else if("--updates" == a_strOption) o_stSetting.m_dUpdates = atof(a_pValue);
+		else if("--max-mb" == a_strOption) o_stSetting.m_dMaxByte = atof(a_pValue) * 1024 * 1024;
+		else if("--pattern" == a_strOption) o_stSetting.m_vecPatternPath.push_back(a_pValue);
+		else if("--json" == a_strOption) o_stSetting.m_strJsonPath = a_pValue;
+		else
+		{
+			cerr << "unknown option: " << a_strOption << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// JSONの文字列.(パスに含まれる'"'と'\'をエスケープする).
+string to_json_string(const string& i_strText)
+{
+	string a_strJson = "\"";
+	for(size_t a_lIndex=0; a_lIndex<i_strText.size(); a_lIndex++)
+	{
+		if( ('"' == i_strText[a_lIndex]) || ('\\' == i_strText[a_lIndex]) ) a_strJson += '\\';
+		a_strJson += i_strText[a_lIndex];
+	}
+	return a_strJson + "\"";
+}
+
+// 盤面を読み込み, 世代を進めて速さを測る.(1件分のJSONを返す).
+string bench_step(MatrixCell& io_cMatrixCell, const BitBoard& i_cBoard, const string& i_strWorkload, const string& i_strParameter, double i_dUpdates)
+{
+	double a_dCellNum = static_cast<double>(i_cBoard.getColMax()) * i_cBoard.getRowMax();
+	long a_lGenerationNum = static_cast<long>(i_dUpdates / a_dCellNum);
+	if(1 > a_lGenerationNum) a_lGenerationNum = 1;
+	if(1000 < a_lGenerationNum) a_lGenerationNum = 1000;
+
+	io_cMatrixCell.importBitBoard(i_cBoard);
+	long a_lInitialPopulation = io_cMatrixCell.getPopulation();
+	long a_lChangedNum = 0;
+	double a_dBegin = getSecond();
+	for(long a_lGeneration=0; a_lGeneration<a_lGenerationNum; a_lGeneration++)
+	{
+		io_cMatrixCell.refreshCell();
+		a_lChangedNum += io_cMatrixCell.getChangedNum();
+	}
+	double a_dTime = getSecond() - a_dBegin;
+
+	char a_szJson[512];
+	snprintf(a_szJson, sizeof(a_szJson),
+		"{\"workload\": %s, %s\"generations\": %ld, \"seconds\": %.6f, \"cell_updates_per_sec\": %.0f, "
+		"\"initial_population\": %ld, \"final_population\": %ld, \"changed_per_gen\": %.1f}",
+		to_json_string(i_strWorkload).c_str(), i_strParameter.c_str(), a_lGenerationNum, a_dTime, a_dCellNum * a_lGenerationNum / a_dTime,
+		a_lInitialPopulation, io_cMatrixCell.getPopulation(), static_cast<double>(a_lChangedNum) / a_lGenerationNum);
+	// 経過の表示は引数のJSONから'"'と末尾の", "を除いたもの.
+	string a_strLabel;
+	for(size_t a_lIndex=0; a_lIndex+2<i_strParameter.size(); a_lIndex++)
+	{
+		if('"' != i_strParameter[a_lIndex]) a_strLabel += i_strParameter[a_lIndex];
+	}
+	fprintf(stderr, "  %-12s %-24s %5ld gen  %8.3f Mcell/s\n", i_strWorkload.c_str(), a_strLabel.c_str(), a_lGenerationNum,
+		a_dCellNum * a_lGenerationNum / a_dTime / 1e6);
+	return a_szJson;
+}
+
+// 値の中央値.
+double get_median(vector<double> i_vecValue)
+{
+	sort(i_vecValue.begin(), i_vecValue.end());
+	return i_vecValue[i_vecValue.size() / 2];
+}
+
+// 記録による1世代の時間の増分を測る.(1件分のJSONを返す).
+// 同じ状態から8世代を記録せずに進め, 続けて同じ8世代を記録しながら進めることを繰り返し, 1世代の時間の中央値で比べる.
+// 同じ盤面を交互に使うのは, 実行環境の速さの揺らぎとメモリ配置の違いを両方に等しく掛けるため.
+string bench_record(MatrixCell& io_cMatrixCell, const BitBoard& i_cBoard, const string& i_strParameter, double i_dUpdates)
+{
+	const long BLOCK = 8;
+	double a_dCellNum = static_cast<double>(i_cBoard.getColMax()) * i_cBoard.getRowMax();
+	long a_lGenerationNum = static_cast<long>(i_dUpdates / a_dCellNum);
+	if(BLOCK > a_lGenerationNum) a_lGenerationNum = BLOCK;
+	if(1000 < a_lGenerationNum) a_lGenerationNum = 1000;
+	a_lGenerationNum -= a_lGenerationNum % BLOCK;
+
+	BitBoard a_cState = i_cBoard;
+	GenerationRecorder a_cRecorder;
+	vector<double> a_vecPlainTime;
+	vector<double> a_vecRecordTime;
+	size_t a_lDeltaSize = 0;
+	for(long a_lBlock=0; a_lBlock<a_lGenerationNum / BLOCK; a_lBlock++)
+	{
+		io_cMatrixCell.importBitBoard(a_cState);
+		for(long a_lGeneration=0; a_lGeneration<BLOCK; a_lGeneration++)
+		{
+			double a_dBegin = getSecond();
+			io_cMatrixCell.refreshCell();
+			a_vecPlainTime.push_back(getSecond() - a_dBegin);
+		}
+
+		io_cMatrixCell.importBitBoard(a_cState);
+		a_cRecorder.start(&io_cMatrixCell);
+		for(long a_lGeneration=0; a_lGeneration<BLOCK; a_lGeneration++)
+		{
+			double a_dBegin = getSecond();
+			io_cMatrixCell.refreshCell();
+			a_cRecorder.commit();
+			a_vecRecordTime.push_back(getSecond() - a_dBegin);
+		}
+		a_cRecorder.stop();
+		a_lDeltaSize += a_cRecorder.getRecord().getDeltaSize();
+		io_cMatrixCell.exportBitBoard(a_cState);
+	}
+	double a_dPlainTime = get_median(a_vecPlainTime);
+	double a_dRecordTime = get_median(a_vecRecordTime);
+	double a_dOverhead = a_dRecordTime / a_dPlainTime - 1.0;
+
+	char a_szJson[512];
+	snprintf(a_szJson, sizeof(a_szJson),
+		"{%s\"generations\": %ld, \"median_sec\": %.6f, \"record_median_sec\": %.6f, \"overhead\": %.4f, \"delta_bytes\": %zu}",
+		i_strParameter.c_str(), a_lGenerationNum, a_dPlainTime, a_dRecordTime, a_dOverhead, a_lDeltaSize);
+	// 経過の表示は引数のJSONから'"'と末尾の", "を除いたもの.
+	string a_strLabel;
+	for(size_t a_lIndex=0; a_lIndex+2<i_strParameter.size(); a_lIndex++)
+	{
+		if('"' != i_strParameter[a_lIndex]) a_strLabel += i_strParameter[a_lIndex];
+	}
+	fprintf(stderr, "  %-12s %-24s %5ld gen  %+8.1f %%  %.0f delta bytes/gen\n", "record", a_strLabel.c_str(), a_lGenerationNum,
+		a_dOverhead * 100, static_cast<double>(a_lDeltaSize) / a_lGenerationNum);
+	return a_szJson;
+}
+
+// 1つの大きさの盤面を測る.(1件分のJSONを返す).
+string bench_size(long i_lSize, const SETTING& i_stSetting, const vector< pair<string, BitBoard> >& i_vecPattern)
+{
+	double a_dCellNum = static_cast<double>(i_lSize) * i_lSize;
+	ostringstream a_cJson;
+	a_cJson << "{\"size\": " << i_lSize << ", \"cells\": " << static_cast<long>(a_dCellNum);
+
+	// 確保する前に見積もり, 上限を超えるならば測らない.
+	MemoryUsage a_cEstimate;
+	MatrixCell::estimateMemoryUsage(i_lSize, i_lSize, a_cEstimate);
+	double a_dEstimate = static_cast<double>(a_cEstimate.getTotal());
+	if( (0 < i_stSetting.m_dMaxByte) && (a_dEstimate > i_stSetting.m_dMaxByte) )
+	{
+		fprintf(stderr, "size %ld: skipped (estimated %.0f MB > %.0f MB)\n", i_lSize, a_dEstimate / 1048576, i_stSetting.m_dMaxByte / 1048576);
+		a_cJson << ", \"skipped\": \"memory\", \"estimated_bytes\": " << static_cast<long>(a_dEstimate) << "}";
+		return a_cJson.str();
+	}
+
+	// 生成.
+	double a_dHeap = get_heap_byte();
+	double a_dBegin = getSecond();
+	MatrixCell* a_pcMatrixCell = new MatrixCell(i_lSize, i_lSize);
+	double a_dConstructTime = getSecond() - a_dBegin;
+	double a_dByte = get_heap_byte() - a_dHeap;
+	double a_dBytePerCell = a_dByte / a_dCellNum;
+	fprintf(stderr, "size %ld: construct %.3f sec, %.1f MB (%.1f bytes/cell, estimated %.1f MB)\n", i_lSize, a_dConstructTime, a_dByte / 1048576, a_dBytePerCell, a_dEstimate / 1048576);
+	a_cJson << ", \"construct_sec\": " << a_dConstructTime << ", \"memory_bytes\": " << static_cast<long>(a_dByte)
+		<< ", \"estimated_bytes\": " << static_cast<long>(a_dEstimate) << ", \"bytes_per_cell\": " << a_dBytePerCell;
+
+	// スープ.(密度別).
+	a_cJson << ", \"step\": [";
+	BitBoard a_cBoard;
+	a_cBoard.init(i_lSize, i_lSize);
+	for(size_t a_lIndex=0; a_lIndex<i_stSetting.m_vecDensity.size(); a_lIndex++)
+	{
+		SoupGenerator a_cSoup(12345, i_stSetting.m_vecDensity[a_lIndex]);
+		a_cSoup.generate(a_cBoard);
+		char a_szParameter[64];
+		snprintf(a_szParameter, sizeof(a_szParameter), "\"density\": %.3f, ", i_stSetting.m_vecDensity[a_lIndex]);
+		a_cJson << (0==a_lIndex? "" : ", ") << bench_step(*a_pcMatrixCell, a_cBoard, "soup", a_szParameter, i_stSetting.m_dUpdates);
+	}
+
+	// パターン.(中央に置く. 盤面に収まらないものは測らない).
+	for(size_t a_lIndex=0; a_lIndex<i_vecPattern.size(); a_lIndex++)
+	{
+		const BitBoard& a_cPattern = i_vecPattern[a_lIndex].second;
+		if( (a_cPattern.getColMax() > i_lSize) || (a_cPattern.getRowMax() > i_lSize) ) continue;
+		a_cBoard.init(i_lSize, i_lSize);
+		a_cBoard.pasteRect(a_cPattern, (i_lSize - a_cPattern.getColMax()) / 2, (i_lSize - a_cPattern.getRowMax()) / 2, BitBoard::PASTE_REPLACE);
+		string a_strParameter = "\"pattern\": " + to_json_string(i_vecPattern[a_lIndex].first) + ", ";
+		a_cJson << ", " << bench_step(*a_pcMatrixCell, a_cBoard, "pattern", a_strParameter, i_stSetting.m_dUpdates);
+	}
+	a_cJson << "]";
+
+	// 記録.(スープと同じ盤面. 密度別).
+	a_cJson << ", \"record\": [";
+	for(size_t a_lIndex=0; a_lIndex<i_stSetting.m_vecDensity.size(); a_lIndex++)
+	{
+		SoupGenerator a_cSoup(12345, i_stSetting.m_vecDensity[a_lIndex]);
+		a_cSoup.generate(a_cBoard);
+		char a_szParameter[64];
+		snprintf(a_szParameter, sizeof(a_szParameter), "\"density\": %.3f, ", i_stSetting.m_vecDensity[a_lIndex]);
+		a_cJson << (0==a_lIndex? "" : ", ") << bench_record(*a_pcMatrixCell, a_cBoard, a_szParameter, i_stSetting.m_dUpdates);
+	}
+	a_cJson << "]";
+
+	// BitBoardとの変換.(スレッド数別. refreshCell()は1スレッドで進める).
+	SoupGenerator a_cSoup(12345, 0.3);
+	a_cSoup.generate(a_cBoard);
+	a_cJson << ", \"convert\": [";
+	for(size_t a_lIndex=0; a_lIndex<i_stSetting.m_vecThread.size(); a_lIndex++)
+	{
+		int a_iThreadNum = i_stSetting.m_vecThread[a_lIndex];
+		a_dBegin = getSecond();
+		a_pcMatrixCell->importBitBoard(a_cBoard, a_iThreadNum);
+		double a_dImportTime = getSecond() - a_dBegin;
+		BitBoard a_cExport;
+		a_dBegin = getSecond();
+		a_pcMatrixCell->exportBitBoard(a_cExport, a_iThreadNum);
+		double a_dExportTime = getSecond() - a_dBegin;
+		fprintf(stderr, "  convert      threads %-8d import %8.3f ms  export %8.3f ms\n", a_iThreadNum, a_dImportTime * 1000, a_dExportTime * 1000);
+		a_cJson << (0==a_lIndex? "" : ", ") << "{\"threads\": " << a_iThreadNum << ", \"import_sec\": " << a_dImportTime
+			<< ", \"export_sec\": " << a_dExportTime << ", \"match\": " << ((a_cExport==a_cBoard)? "true" : "false") << "}";
+	}
+	a_cJson << "]}";
+
+	delete a_pcMatrixCell;
+	return a_cJson.str();
+}
+
+int main(int argc, char* argv[])
+{
+	SETTING a_stSetting;
+	if(!parse_setting(argc, argv, a_stSetting)) return 1;
+
+	// 測定するパターン.
+	vector< pair<string, BitBoard> > a_vecPattern;
+	for(size_t a_lIndex=0; a_lIndex<sizeof(gPATTERN)/sizeof(gPATTERN[0]); a_lIndex++)
+	{
+		a_vecPattern.push_back(make_pair(string(gPATTERN[a_lIndex].m_pName), BitBoard()));
+		PatternFile::parseRle(gPATTERN[a_lIndex].m_pRle, a_vecPattern.back().second);
+	}
+	for(size_t a_lIndex=0; a_lIndex<a_stSetting.m_vecPatternPath.size(); a_lIndex++)
+	{
+		BitBoard a_cPattern;
+		if(!PatternFile::load(a_stSetting.m_vecPatternPath[a_lIndex], a_cPattern))
+		{
+			cerr << "cannot load pattern: " << a_stSetting.m_vecPatternPath[a_lIndex] << endl;
+			return 1;
+		}
+		a_vecPattern.push_back(make_pair(a_stSetting.m_vecPatternPath[a_lIndex], a_cPattern));
+	}
+
+	ostringstream a_cJson;
+	a_cJson.precision(9);
+	a_cJson << "{\"benchmark\": \"MatrixCell\", \"updates_per_run\": " << a_stSetting.m_dUpdates
+		<< ", \"max_bytes\": " << static_cast<long>(a_stSetting.m_dMaxByte) << ", \"results\": [";
+	for(size_t a_lIndex=0; a_lIndex<a_stSetting.m_vecSize.size(); a_lIndex++)
+	{
+		a_cJson << (0==a_lIndex? "" : ",") << "\n  " << bench_size(a_stSetting.m_vecSize[a_lIndex], a_stSetting, a_vecPattern);
+	}
+	a_cJson << "\n]}\n";
+
+	if(a_stSetting.m_strJsonPath.empty())
+	{
+		cout << a_cJson.str();
+		return 0;
+	}
+	ofstream a_cFile(a_stSetting.m_strJsonPath.c_str());
+	a_cFile << a_cJson.str();
+	return a_cFile? 0 : 1;
+}
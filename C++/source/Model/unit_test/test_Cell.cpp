@@ -3,6 +3,9 @@
  ***********************************/
 
 #include <iostream>
+#include <vector>
+#include <cstdio>
+#include <chrono>
 #include "../Cell.h"
 
 void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
@@ -250,6 +253,131 @@ bool test_cell_over_population2()
 	return a_bIsSuccess;
 }
 
+// 規則(HighLife B36/S23)を指定したセルの誕生をテスト.
+bool test_cell_born_with_rule()
+{
+	LifeRule a_cRule;
+	if(!a_cRule.parse("B36/S23")) return false;
+
+	Cell a_cSelfCell;
+	Cell a_rgcNeighborCell[6];
+
+	// 自分自身の状態を"死"に設定.
+	a_cSelfCell.setState(CellAttribute::DEAD);
+
+	// 隣接セルの設定と通知.
+	long a_lMax = sizeof(a_rgcNeighborCell) / sizeof(a_rgcNeighborCell[0]);
+	Cell* a_pcCell = a_rgcNeighborCell;
+	for(long a_lIndex=0; a_lIndex<a_lMax; a_lIndex++)
+	{
+		a_pcCell->setState(CellAttribute::ALIVE);
+		a_pcCell->setNeighbor(&a_cSelfCell);
+		a_pcCell->sendState();
+		a_pcCell++;
+	}
+
+	// 自分自身の状態を決定.(既定の規則B3/S23では誕生しない).
+	a_cSelfCell.decideState(a_cRule);
+
+	bool a_bIsSuccess = (CellAttribute::ALIVE== a_cSelfCell.getState());
+	return a_bIsSuccess;
+}
+
+// 隣接セルの登録(最大8個)と登録解除をテスト.
+bool test_static_subject()
+{
+	Cell a_cSelfCell;
+	Cell a_rgcNeighborCell[9];
+
+	// 8個まで登録できる.
+	bool a_bIsSuccess = true;
+	for(int a_iIndex=0; a_iIndex<8; a_iIndex++)
+	{
+		a_bIsSuccess = a_bIsSuccess && a_cSelfCell.attach(&a_rgcNeighborCell[a_iIndex]);
+	}
+	a_bIsSuccess = a_bIsSuccess && !a_cSelfCell.attach(&a_rgcNeighborCell[8]);
+	a_bIsSuccess = a_bIsSuccess && (8==a_cSelfCell.getObserverNum());
+
+	// 登録解除した隣接セルには通知されない.
+	a_cSelfCell.detach(&a_rgcNeighborCell[3]);
+	a_bIsSuccess = a_bIsSuccess && (7==a_cSelfCell.getObserverNum()) && !a_cSelfCell.hasObserver(&a_rgcNeighborCell[3]);
+	a_cSelfCell.setState(CellAttribute::ALIVE);
+	a_cSelfCell.sendState();
+	for(int a_iIndex=0; a_iIndex<8; a_iIndex++)
+	{
+		long a_lExpected = (3==a_iIndex)? 0 : 1;
+		a_bIsSuccess = a_bIsSuccess && (a_lExpected==a_rgcNeighborCell[a_iIndex].getNeighborAliveNum());
+	}
+	return a_bIsSuccess;
+}
+
+// 仮想関数を介して通知を受けるセル.(比較用).
+class VirtualCell : public Subject<CellAttribute>, public Observer<CellAttribute>
+{
+public:
+	VirtualCell() : m_lNeighborAliveNum(0) { }
+	bool update(const CellAttribute* i_pcAttribute)
+	{
+		if(CellAttribute::ALIVE==i_pcAttribute->getState()) m_lNeighborAliveNum++;
+		return true;
+	}
+	void sendState(const CellAttribute* i_pcAttribute) { notify(i_pcAttribute); }
+	long m_lNeighborAliveNum;
+};
+
+// 隣接セルへの通知の速さを表示.(仮想関数のSubject/Observerと, Cellが使うStaticSubjectを比べる).
+bool bench_dispatch()
+{
+	const long a_lCellNum = 100000;
+	const long a_lLoopNum = 20;
+	CellAttribute a_cAttribute(CellAttribute::ALIVE);
+
+	// 仮想関数で通知.
+	std::vector<VirtualCell> a_vecVirtualCell(a_lCellNum);
+	for(long a_lIndex=0; a_lIndex<a_lCellNum; a_lIndex++)
+	{
+		for(long a_lNeighbor=1; a_lNeighbor<=8; a_lNeighbor++)
+		{
+			a_vecVirtualCell[a_lIndex].attach(&a_vecVirtualCell[(a_lIndex + a_lNeighbor * 97) % a_lCellNum]);
+		}
+	}
+	std::chrono::steady_clock::time_point a_cBegin = std::chrono::steady_clock::now();
+	for(long a_lLoop=0; a_lLoop<a_lLoopNum; a_lLoop++)
+	{
+		for(long a_lIndex=0; a_lIndex<a_lCellNum; a_lIndex++) a_vecVirtualCell[a_lIndex].sendState(&a_cAttribute);
+	}
+	double a_dVirtualTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - a_cBegin).count();
+
+	// Cell(StaticSubject)で通知.
+	std::vector<Cell> a_vecCell(a_lCellNum);
+	for(long a_lIndex=0; a_lIndex<a_lCellNum; a_lIndex++)
+	{
+		a_vecCell[a_lIndex].setState(CellAttribute::ALIVE);
+		for(long a_lNeighbor=1; a_lNeighbor<=8; a_lNeighbor++)
+		{
+			a_vecCell[a_lIndex].setNeighbor(&a_vecCell[(a_lIndex + a_lNeighbor * 97) % a_lCellNum]);
+		}
+	}
+	a_cBegin = std::chrono::steady_clock::now();
+	for(long a_lLoop=0; a_lLoop<a_lLoopNum; a_lLoop++)
+	{
+		for(long a_lIndex=0; a_lIndex<a_lCellNum; a_lIndex++) a_vecCell[a_lIndex].sendState();
+	}
+	double a_dStaticTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - a_cBegin).count();
+
+	printf("  virtual: %8.3f ns/notify\n", a_dVirtualTime * 1e9 / (a_lCellNum * a_lLoopNum * 8));
+	printf("  static:  %8.3f ns/notify\n", a_dStaticTime * 1e9 / (a_lCellNum * a_lLoopNum * 8));
+
+	// 通知した回数が合っている.
+	bool a_bIsSuccess = true;
+	for(long a_lIndex=0; a_lIndex<a_lCellNum; a_lIndex++)
+	{
+		a_bIsSuccess = a_bIsSuccess && (8 * a_lLoopNum==a_vecVirtualCell[a_lIndex].m_lNeighborAliveNum);
+		a_bIsSuccess = a_bIsSuccess && (8 * a_lLoopNum==a_vecCell[a_lIndex].getNeighborAliveNum());
+	}
+	return a_bIsSuccess;
+}
+
 bool test_Cell()
 {
 	bool a_bIsSuccess = false;
@@ -294,6 +422,18 @@ bool test_Cell()
 	a_bIsSuccess = test_cell_over_population2();
 	print_test_result("test_cell_over_population2", a_bIsSuccess);
 
+	// 規則を指定したセルの誕生をテスト.
+	a_bIsSuccess = test_cell_born_with_rule();
+	print_test_result("test_cell_born_with_rule", a_bIsSuccess);
+
+	// 隣接セルの登録と登録解除をテスト.
+	a_bIsSuccess = test_static_subject();
+	print_test_result("test_static_subject", a_bIsSuccess);
+
+	// 隣接セルへの通知の速さ.
+	a_bIsSuccess = bench_dispatch();
+	print_test_result("bench_dispatch", a_bIsSuccess);
+
 	return true;
 }
 
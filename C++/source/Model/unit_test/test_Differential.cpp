@@ -0,0 +1,428 @@
+/*********************************************************
+ * 世代を進める実装の差分テスト.
+ *
+ * 基準(Cell/MatrixCell)と各実装を, 乱数で作った盤面, 規則, 端の扱いで
+ * 同じ世代数だけ進め, 毎世代の盤面のハッシュを比べる.
+ * 食い違った場合は, 食い違いが残る範囲で生きているセルと盤面を減らし,
+ * 最小の再現手順(盤面の大きさ, 規則, 端の扱い, 世代数, RLE)を表示する.
+ *
+ * 実装を追加した場合は, Engineを派生してget_engines()へ加える.
+ *
+ * 使い方: test_Differential [乱数の種] [件数]
+ *********************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdint.h>
+
+#include "../MatrixCell.h"
+#include "../BitBoard.h"
+#include "../PatternFile.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+/**
+ * @brief	世代を進める実装.(基準と比べる相手).
+ */
+class Engine
+{
+public:
+	virtual ~Engine(){ }
+	virtual const char* getName() const = 0;
+	// 盤面, 規則, 端の扱いを設定する.
+	virtual void load(const BitBoard& i_cBoard, const LifeRule& i_cRule, MatrixCell::BOUNDARY i_eBoundary) = 0;
+	// 1世代進める.
+	virtual void step() = 0;
+	// 盤面を取得する.
+	virtual void save(BitBoard& o_cBoard) = 0;
+};
+
+/**
+ * @brief	基準.(Cell/MatrixCell).
+ */
+class MatrixCellEngine : public Engine
+{
+public:
+	MatrixCellEngine() : m_pcMatrixCell(0) { }
+	~MatrixCellEngine() { delete this->m_pcMatrixCell; }
+	const char* getName() const { return "MatrixCell"; }
+	void load(const BitBoard& i_cBoard, const LifeRule& i_cRule, MatrixCell::BOUNDARY i_eBoundary)
+	{
+		delete this->m_pcMatrixCell;
+		this->m_pcMatrixCell = new MatrixCell(i_cBoard.getColMax(), i_cBoard.getRowMax(), i_eBoundary);
+		this->m_pcMatrixCell->setRule(i_cRule);
+		this->m_pcMatrixCell->importBitBoard(i_cBoard);
+	}
+	void step() { this->m_pcMatrixCell->refreshCell(); }
+	void save(BitBoard& o_cBoard) { this->m_pcMatrixCell->exportBitBoard(o_cBoard); }
+
+protected:
+	MatrixCell* m_pcMatrixCell;
+};
+
+/**
+ * @brief	MatrixCellの変化の通知だけから盤面を組み立てる.(通知の取りこぼしを見つける).
+ */
+class NotifyEngine : public MatrixCellEngine, public Observer<MatrixCellAttribute>
+{
+public:
+	const char* getName() const { return "MatrixCell notify"; }
+	void load(const BitBoard& i_cBoard, const LifeRule& i_cRule, MatrixCell::BOUNDARY i_eBoundary)
+	{
+		MatrixCellEngine::load(i_cBoard, i_cRule, i_eBoundary);
+		this->m_cBoard = i_cBoard;
+		this->m_pcMatrixCell->attach(this);
+	}
+	void save(BitBoard& o_cBoard) { o_cBoard = this->m_cBoard; }
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+		{
+			this->m_cBoard.setBit(i_lCol, i_lRow, CellAttribute::ALIVE == i_eState);
+		});
+		return true;
+	}
+
+private:
+	BitBoard m_cBoard;
+};
+
+/**
+ * @brief	BitBoardの各セルの隣接セルを数える素朴な実装.(MatrixCellとは独立に書いたもの).
+ */
+class NaiveEngine : public Engine
+{
+public:
+	const char* getName() const { return "naive"; }
+	void load(const BitBoard& i_cBoard, const LifeRule& i_cRule, MatrixCell::BOUNDARY i_eBoundary)
+	{
+		this->m_cBoard = i_cBoard;
+		this->m_cRule = i_cRule;
+		this->m_eBoundary = i_eBoundary;
+	}
+	void step()
+	{
+		long a_lColMax = this->m_cBoard.getColMax();
+		long a_lRowMax = this->m_cBoard.getRowMax();
+		BitBoard a_cNext;
+		a_cNext.init(a_lColMax, a_lRowMax);
+		for(long a_lRow=0; a_lRow<a_lRowMax; a_lRow++)
+		{
+			for(long a_lCol=0; a_lCol<a_lColMax; a_lCol++)
+			{
+				long a_lAliveNum = 0;
+				for(long a_lDy=-1; a_lDy<=1; a_lDy++)
+				{
+					for(long a_lDx=-1; a_lDx<=1; a_lDx++)
+					{
+						if( (0 == a_lDx) && (0 == a_lDy) ) continue;
+						long a_lX = a_lCol + a_lDx;
+						long a_lY = a_lRow + a_lDy;
+						if(MatrixCell::BOUNDARY_TORUS == this->m_eBoundary)
+						{
+							a_lX = (a_lX + a_lColMax) % a_lColMax;
+							a_lY = (a_lY + a_lRowMax) % a_lRowMax;
+						}
+						else if( (0 > a_lX) || (a_lColMax <= a_lX) || (0 > a_lY) || (a_lRowMax <= a_lY) ) continue;
+						if(this->m_cBoard.getBit(a_lX, a_lY)) a_lAliveNum++;
+					}
+				}
+				a_cNext.setBit(a_lCol, a_lRow, this->decide(this->m_cBoard.getBit(a_lCol, a_lRow), a_lAliveNum));
+			}
+		}
+		this->m_cBoard = a_cNext;
+	}
+	void save(BitBoard& o_cBoard) { o_cBoard = this->m_cBoard; }
+
+protected:
+	// 次の状態.
+	virtual bool decide(bool i_bAlive, long i_lAliveNum) const
+	{
+		return i_bAlive? this->m_cRule.isSurvive(i_lAliveNum) : this->m_cRule.isBorn(i_lAliveNum);
+	}
+
+	BitBoard m_cBoard;
+	LifeRule m_cRule;
+	MatrixCell::BOUNDARY m_eBoundary;
+};
+
+/**
+ * @brief	わざと誤った実装.(隣接セルが6個の死んだセルも誕生させる). 縮小のテスト用.
+ */
+class BuggyEngine : public NaiveEngine
+{
+public:
+	const char* getName() const { return "buggy"; }
+
+protected:
+	bool decide(bool i_bAlive, long i_lAliveNum) const
+	{
+		if(!i_bAlive && (6 == i_lAliveNum)) return true;
+		return NaiveEngine::decide(i_bAlive, i_lAliveNum);
+	}
+};
+
+/**
+ * @brief	比べる条件.
+ */
+struct CASE
+{
+	BitBoard m_cBoard;					// 初期配置.
+	LifeRule m_cRule;					// 規則.
+	MatrixCell::BOUNDARY m_eBoundary;	// 端の扱い.
+	long m_lGenerationNum;				// 進める世代数.
+};
+
+// 盤面のハッシュ.(FNV-1a. 大きさを含む).
+uint64_t hash_board(const BitBoard& i_cBoard)
+{
+	uint64_t a_ulHash = 14695981039346656037ULL;
+	uint64_t a_rgulSize[] = { static_cast<uint64_t>(i_cBoard.getColMax()), static_cast<uint64_t>(i_cBoard.getRowMax()) };
+	for(int a_iIndex=0; a_iIndex<2; a_iIndex++) a_ulHash = (a_ulHash ^ a_rgulSize[a_iIndex]) * 1099511628211ULL;
+	for(long a_lRow=0; a_lRow<i_cBoard.getRowMax(); a_lRow++)
+	{
+		const BitBoard::WORD* a_pWord = i_cBoard.getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<i_cBoard.getWordNum(); a_lWord++) a_ulHash = (a_ulHash ^ a_pWord[a_lWord]) * 1099511628211ULL;
+	}
+	return a_ulHash;
+}
+
+// 基準と実装を進め, 最初に盤面が食い違った世代を返す.(最後まで一致すれば-1).
+long find_mismatch(Engine& io_cReference, Engine& io_cEngine, const CASE& i_stCase)
+{
+	io_cReference.load(i_stCase.m_cBoard, i_stCase.m_cRule, i_stCase.m_eBoundary);
+	io_cEngine.load(i_stCase.m_cBoard, i_stCase.m_cRule, i_stCase.m_eBoundary);
+	BitBoard a_cReference;
+	BitBoard a_cBoard;
+	for(long a_lGeneration=0; a_lGeneration<=i_stCase.m_lGenerationNum; a_lGeneration++)
+	{
+		if(0 < a_lGeneration)
+		{
+			io_cReference.step();
+			io_cEngine.step();
+		}
+		io_cReference.save(a_cReference);
+		io_cEngine.save(a_cBoard);
+		if(hash_board(a_cReference) != hash_board(a_cBoard)) return a_lGeneration;
+	}
+	return -1;
+}
+
+// 食い違いが残る範囲で条件を小さくする.(世代数, 生きているセル, 盤面の大きさの順).
+void shrink_case(Engine& io_cReference, Engine& io_cEngine, CASE& io_stCase)
+{
+	io_stCase.m_lGenerationNum = find_mismatch(io_cReference, io_cEngine, io_stCase);
+
+	// 生きているセルを塊で消し, 食い違いが残れば採用する.(塊は半分ずつ小さくする).
+	vector< pair<long, long> > a_vecAlive;
+	for(long a_lRow=0; a_lRow<io_stCase.m_cBoard.getRowMax(); a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<io_stCase.m_cBoard.getColMax(); a_lCol++)
+		{
+			if(io_stCase.m_cBoard.getBit(a_lCol, a_lRow)) a_vecAlive.push_back(make_pair(a_lCol, a_lRow));
+		}
+	}
+	for(size_t a_lChunk=max<size_t>(a_vecAlive.size() / 2, 1); 0 < a_lChunk; a_lChunk/=2)
+	{
+		for(size_t a_lBegin=0; a_lBegin<a_vecAlive.size(); )
+		{
+			size_t a_lEnd = min(a_lBegin + a_lChunk, a_vecAlive.size());
+			CASE a_stTrial = io_stCase;
+			for(size_t a_lIndex=a_lBegin; a_lIndex<a_lEnd; a_lIndex++) a_stTrial.m_cBoard.setBit(a_vecAlive[a_lIndex].first, a_vecAlive[a_lIndex].second, false);
+			long a_lGeneration = find_mismatch(io_cReference, io_cEngine, a_stTrial);
+			if(0 <= a_lGeneration)
+			{
+				a_stTrial.m_lGenerationNum = a_lGeneration;
+				io_stCase = a_stTrial;
+				a_vecAlive.erase(a_vecAlive.begin() + a_lBegin, a_vecAlive.begin() + a_lEnd);
+			}
+			else a_lBegin = a_lEnd;
+		}
+	}
+
+	// 盤面の端の行と列を削る.
+	for(bool a_bIsShrunk=true; a_bIsShrunk; )
+	{
+		a_bIsShrunk = false;
+		long a_lColMax = io_stCase.m_cBoard.getColMax();
+		long a_lRowMax = io_stCase.m_cBoard.getRowMax();
+		// 左, 右, 上, 下.
+		long a_rglRect[4][4] = {
+			{ 1, 0, a_lColMax - 1, a_lRowMax },
+			{ 0, 0, a_lColMax - 1, a_lRowMax },
+			{ 0, 1, a_lColMax, a_lRowMax - 1 },
+			{ 0, 0, a_lColMax, a_lRowMax - 1 },
+		};
+		for(int a_iIndex=0; (a_iIndex<4) && !a_bIsShrunk; a_iIndex++)
+		{
+			if( (1 > a_rglRect[a_iIndex][2]) || (1 > a_rglRect[a_iIndex][3]) ) continue;
+			CASE a_stTrial = io_stCase;
+			a_stTrial.m_cBoard.extract(io_stCase.m_cBoard, a_rglRect[a_iIndex][0], a_rglRect[a_iIndex][1], a_rglRect[a_iIndex][2], a_rglRect[a_iIndex][3]);
+			long a_lGeneration = find_mismatch(io_cReference, io_cEngine, a_stTrial);
+			if(0 <= a_lGeneration)
+			{
+				a_stTrial.m_lGenerationNum = a_lGeneration;
+				io_stCase = a_stTrial;
+				a_bIsShrunk = true;
+			}
+		}
+	}
+}
+
+// 再現手順を表示.
+void print_reproducer(const Engine& i_cEngine, const CASE& i_stCase)
+{
+	cout << "  " << i_cEngine.getName() << " differs from reference at generation " << i_stCase.m_lGenerationNum
+		<< ": size " << i_stCase.m_cBoard.getColMax() << "x" << i_stCase.m_cBoard.getRowMax()
+		<< ", rule " << i_stCase.m_cRule.toString()
+		<< ", boundary " << ((MatrixCell::BOUNDARY_TORUS == i_stCase.m_eBoundary)? "torus" : "dead")
+		<< ", alive " << i_stCase.m_cBoard.count() << endl;
+	cout << PatternFile::toRle(i_stCase.m_cBoard, i_stCase.m_cRule);
+}
+
+// 乱数で条件を作る.
+void make_case(mt19937_64& io_cRandom, CASE& o_stCase)
+{
+	long a_lColMax = 1 + static_cast<long>(io_cRandom() % 100);
+	long a_lRowMax = 1 + static_cast<long>(io_cRandom() % 100);
+	double a_dDensity = static_cast<double>(io_cRandom() % 1000) / 1000.0;
+	o_stCase.m_cBoard.init(a_lColMax, a_lRowMax);
+	for(long a_lRow=0; a_lRow<a_lRowMax; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<a_lColMax; a_lCol++)
+		{
+			o_stCase.m_cBoard.setBit(a_lCol, a_lRow, a_dDensity * 1000 > io_cRandom() % 1000);
+		}
+	}
+
+	// 半分はB3/S23. 残りは誕生/生存の数をでたらめに選ぶ.
+	o_stCase.m_cRule = LifeRule();
+	if(0 != io_cRandom() % 2)
+	{
+		string a_strRule = "B";
+		for(int a_iNum=0; a_iNum<=8; a_iNum++) if(0 == io_cRandom() % 3) a_strRule += static_cast<char>('0' + a_iNum);
+		a_strRule += "/S";
+		for(int a_iNum=0; a_iNum<=8; a_iNum++) if(0 == io_cRandom() % 3) a_strRule += static_cast<char>('0' + a_iNum);
+		o_stCase.m_cRule.parse(a_strRule);
+	}
+	o_stCase.m_eBoundary = (0 == io_cRandom() % 2)? MatrixCell::BOUNDARY_TORUS : MatrixCell::BOUNDARY_DEAD;
+	o_stCase.m_lGenerationNum = 1 + static_cast<long>(io_cRandom() % 100);
+}
+
+// 比べる実装.
+vector<Engine*> get_engines()
+{
+	vector<Engine*> a_vecEngine;
+	a_vecEngine.push_back(new NaiveEngine());
+	a_vecEngine.push_back(new NotifyEngine());
+	return a_vecEngine;
+}
+
+// 乱数の条件で全ての実装が基準と一致するかをテスト.
+bool test_differential(uint64_t i_ulSeed, long i_lCaseNum)
+{
+	mt19937_64 a_cRandom(i_ulSeed);
+	MatrixCellEngine a_cReference;
+	vector<Engine*> a_vecEngine = get_engines();
+	bool a_bIsSuccess = true;
+	long a_lGenerationNum = 0;
+	for(long a_lCase=0; a_lCase<i_lCaseNum; a_lCase++)
+	{
+		CASE a_stCase;
+		make_case(a_cRandom, a_stCase);
+		a_lGenerationNum += a_stCase.m_lGenerationNum;
+		for(size_t a_lIndex=0; a_lIndex<a_vecEngine.size(); a_lIndex++)
+		{
+			if(0 > find_mismatch(a_cReference, *a_vecEngine[a_lIndex], a_stCase)) continue;
+			shrink_case(a_cReference, *a_vecEngine[a_lIndex], a_stCase);
+			print_reproducer(*a_vecEngine[a_lIndex], a_stCase);
+			a_bIsSuccess = false;
+		}
+	}
+	cout << "  seed " << i_ulSeed << ", " << i_lCaseNum << " cases, " << a_lGenerationNum << " generations, "
+		<< a_vecEngine.size() << " engines" << endl;
+	for(size_t a_lIndex=0; a_lIndex<a_vecEngine.size(); a_lIndex++) delete a_vecEngine[a_lIndex];
+	return a_bIsSuccess;
+}
+
+// 食い違いを見つけて小さくできるかをテスト.(わざと誤った実装を使う).
+bool test_shrink()
+{
+	mt19937_64 a_cRandom(1);
+	MatrixCellEngine a_cReference;
+	BuggyEngine a_cBuggy;
+
+	// B3/S23の密なスープなら, 隣接セルが6個の死んだセルがいずれ現れる.
+	CASE a_stCase;
+	a_stCase.m_cBoard.init(60, 40);
+	for(long a_lRow=0; a_lRow<40; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<60; a_lCol++) a_stCase.m_cBoard.setBit(a_lCol, a_lRow, 0 == a_cRandom() % 2);
+	}
+	a_stCase.m_eBoundary = MatrixCell::BOUNDARY_TORUS;
+	a_stCase.m_lGenerationNum = 50;
+	bool a_bIsSuccess = (0 <= find_mismatch(a_cReference, a_cBuggy, a_stCase));
+
+	shrink_case(a_cReference, a_cBuggy, a_stCase);
+	print_reproducer(a_cBuggy, a_stCase);
+
+	// 小さくした条件でも食い違い, 1世代目で食い違う.
+	// 生きているセルは6個以下, 盤面は3x3以下になる.(トーラスの小さな盤面では同じセルを何度も数えるため, 6個より少なくなりうる).
+	a_bIsSuccess = a_bIsSuccess && (a_stCase.m_lGenerationNum == find_mismatch(a_cReference, a_cBuggy, a_stCase));
+	a_bIsSuccess = a_bIsSuccess && (1 == a_stCase.m_lGenerationNum) && (6 >= a_stCase.m_cBoard.count());
+	a_bIsSuccess = a_bIsSuccess && (9 >= a_stCase.m_cBoard.getColMax() * a_stCase.m_cBoard.getRowMax());
+	return a_bIsSuccess;
+}
+
+// 端の扱いをテスト.(上端の横ブリンカーは, トーラスでは下端へ回り込み, 死の端では欠ける).
+bool test_boundary()
+{
+	bool a_bIsSuccess = true;
+	MatrixCell::BOUNDARY a_rgeBoundary[] = { MatrixCell::BOUNDARY_TORUS, MatrixCell::BOUNDARY_DEAD };
+	long a_rglPopulation[] = { 3, 2 };
+	for(int a_iIndex=0; a_iIndex<2; a_iIndex++)
+	{
+		MatrixCell a_cMatrixCell(5L, 5L, a_rgeBoundary[a_iIndex]);
+		a_cMatrixCell.setCellState(1, 0, CellAttribute::ALIVE);
+		a_cMatrixCell.setCellState(2, 0, CellAttribute::ALIVE);
+		a_cMatrixCell.setCellState(3, 0, CellAttribute::ALIVE);
+		a_cMatrixCell.refreshCell();
+		a_bIsSuccess = a_bIsSuccess && (a_rgeBoundary[a_iIndex] == a_cMatrixCell.getBoundary());
+		a_bIsSuccess = a_bIsSuccess && (a_rglPopulation[a_iIndex] == a_cMatrixCell.getPopulation());
+		a_bIsSuccess = a_bIsSuccess && (CellAttribute::ALIVE == a_cMatrixCell.getCellState(2, 1));
+		a_bIsSuccess = a_bIsSuccess && ((MatrixCell::BOUNDARY_TORUS == a_rgeBoundary[a_iIndex]) == (CellAttribute::ALIVE == a_cMatrixCell.getCellState(2, 4)));
+	}
+	return a_bIsSuccess;
+}
+
+int main(int argc, char* argv[])
+{
+	uint64_t a_ulSeed = (1 < argc)? strtoull(argv[1], 0, 10) : 20240601;
+	long a_lCaseNum = (2 < argc)? atol(argv[2]) : 200;
+	bool a_bIsSuccess = false;
+
+	// 端の扱いをテスト.
+	a_bIsSuccess = test_boundary();
+	print_test_result("test_boundary", a_bIsSuccess);
+
+	// 全ての実装が基準と一致するかをテスト.
+	a_bIsSuccess = test_differential(a_ulSeed, a_lCaseNum);
+	print_test_result("test_differential", a_bIsSuccess);
+
+	// 食い違いを小さくできるかをテスト.
+	a_bIsSuccess = test_shrink();
+	print_test_result("test_shrink", a_bIsSuccess);
+	return 0;
+}
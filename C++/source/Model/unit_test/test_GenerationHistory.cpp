@@ -0,0 +1,252 @@
+/*********************************************************
+ * GenerationHistoryクラスのユニットテスト
+ *********************************************************/
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <chrono>
+
+#include "../MatrixCell.h"
+#include "../BitBoard.h"
+#include "../SoupGenerator.h"
+#include "../GenerationHistory.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+// スープを配置.
+void plot_soup(MatrixCell& io_cMatrixCell, long i_lWidth, long i_lHeight)
+{
+	BitBoard a_cBoard;
+	a_cBoard.init(i_lWidth, i_lHeight);
+	SoupGenerator a_cSoup(12345, 0.3);
+	a_cSoup.generate(a_cBoard);
+	io_cMatrixCell.importBitBoard(a_cBoard);
+}
+
+// 世代を進めて記録した盤面へ巻き戻せるかをテスト.(キーフレームからの巻き戻しを含む).
+bool test_rewind_generation()
+{
+	MatrixCell a_cMatrixCell(100L, 70L);
+	plot_soup(a_cMatrixCell, 100, 70);
+
+	GenerationHistory a_cHistory;
+	a_cHistory.start(&a_cMatrixCell);
+
+	vector<BitBoard> a_vecExpected(1);
+	a_cMatrixCell.exportBitBoard(a_vecExpected[0]);
+	for(long a_lGeneration=1; a_lGeneration<=300; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cHistory.commit();
+		a_vecExpected.push_back(BitBoard());
+		a_cMatrixCell.exportBitBoard(a_vecExpected.back());
+	}
+	bool a_bIsSuccess = (300==a_cHistory.getEntryNum()) && (0<a_cHistory.getKeyFrameNum());
+
+	// 1世代, 数世代, キーフレームを跨ぐ巻き戻し, 範囲を超える巻き戻し.
+	long a_rglRewind[] = { 1, 7, 100, 150, 1000 };
+	long a_lGeneration = 300;
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglRewind)/sizeof(a_rglRewind[0]); a_lIndex++)
+	{
+		long a_lRewound = a_cHistory.rewind(a_rglRewind[a_lIndex]);
+		a_bIsSuccess = a_bIsSuccess && (a_lRewound == min(a_rglRewind[a_lIndex], a_lGeneration));
+		a_lGeneration -= a_lRewound;
+
+		BitBoard a_cBoard;
+		a_cMatrixCell.exportBitBoard(a_cBoard);
+		a_bIsSuccess = a_bIsSuccess && (a_cBoard==a_vecExpected[a_lGeneration]);
+		a_bIsSuccess = a_bIsSuccess && (a_lGeneration==a_cMatrixCell.getGeneration());
+	}
+	a_bIsSuccess = a_bIsSuccess && (0==a_cHistory.getEntryNum()) && (0==a_cHistory.getByteSize());
+
+	// 巻き戻した後も正しく進められる.
+	a_cMatrixCell.refreshCell();
+	a_cHistory.commit();
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (a_cBoard==a_vecExpected[1]) && (1==a_cHistory.getEntryNum());
+	return a_bIsSuccess;
+}
+
+// 編集を取り消せるかをテスト.(世代数は変わらない).
+bool test_rewind_edit()
+{
+	MatrixCell a_cMatrixCell(80L, 40L);
+	plot_soup(a_cMatrixCell, 80, 40);
+
+	GenerationHistory a_cHistory;
+	a_cHistory.start(&a_cMatrixCell);
+
+	a_cMatrixCell.refreshCell();
+	a_cHistory.commit();
+	BitBoard a_cBefore;
+	a_cMatrixCell.exportBitBoard(a_cBefore);
+
+	// 通知する編集.
+	a_cMatrixCell.fillRegion(10, 5, 30, 20);
+	a_cHistory.commit();
+	// 通知しない編集.(編集したセルを渡す).
+	CellAttribute::CELL_STATE a_eState = a_cMatrixCell.getCellState(70, 30);
+	a_eState = (CellAttribute::ALIVE==a_eState)? CellAttribute::DEAD : CellAttribute::ALIVE;
+	a_cMatrixCell.setCellState(70, 30, a_eState);
+	MatrixCellAttribute a_cAttribute(70, 30, a_eState);
+	a_cHistory.update(&a_cAttribute);
+	a_cHistory.commit();
+
+	// 何も変わっていなければ履歴を作らない.
+	a_cHistory.commit();
+	bool a_bIsSuccess = (3==a_cHistory.getEntryNum());
+
+	a_bIsSuccess = a_bIsSuccess && (2==a_cHistory.rewind(2));
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (a_cBoard==a_cBefore) && (1==a_cMatrixCell.getGeneration());
+	return a_bIsSuccess;
+}
+
+// 容量を超えたら古い履歴を捨てるかをテスト.
+bool test_byte_max()
+{
+	MatrixCell a_cMatrixCell(200L, 100L);
+	plot_soup(a_cMatrixCell, 200, 100);
+
+	// 盤面(200x100 = 4ワード x 100行 = 3200バイト)の数枚分.
+	GenerationHistory a_cHistory(16 * 1024);
+	a_cHistory.start(&a_cMatrixCell);
+
+	vector<BitBoard> a_vecExpected(1);
+	a_cMatrixCell.exportBitBoard(a_vecExpected[0]);
+	bool a_bIsSuccess = true;
+	for(long a_lGeneration=1; a_lGeneration<=500; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cHistory.commit();
+		a_bIsSuccess = a_bIsSuccess && (a_cHistory.getByteSize() <= a_cHistory.getByteMax());
+		a_vecExpected.push_back(BitBoard());
+		a_cMatrixCell.exportBitBoard(a_vecExpected.back());
+	}
+	long a_lEntryNum = a_cHistory.getEntryNum();
+	a_bIsSuccess = a_bIsSuccess && (0<a_lEntryNum) && (500>a_lEntryNum);
+
+	// 残っている最も古い状態まで戻れる.
+	a_bIsSuccess = a_bIsSuccess && (a_lEntryNum==a_cHistory.rewind(500));
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (a_cBoard==a_vecExpected[500 - a_lEntryNum]);
+	a_bIsSuccess = a_bIsSuccess && (500 - a_lEntryNum==a_cMatrixCell.getGeneration());
+
+	// 容量を減らすと捨てる.
+	for(long a_lGeneration=1; a_lGeneration<=100; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cHistory.commit();
+	}
+	a_cHistory.setByteMax(1024);
+	a_bIsSuccess = a_bIsSuccess && (a_cHistory.getByteSize() <= 1024);
+	return a_bIsSuccess;
+}
+
+// 変化の無い盤面でも履歴の管理領域が容量を超えないかをテスト.
+bool test_memory_usage()
+{
+	MatrixCell a_cMatrixCell(200L, 100L);
+	a_cMatrixCell.setCellState(10, 10, CellAttribute::ALIVE);	// ブロック(固定物体).
+	a_cMatrixCell.setCellState(11, 10, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(10, 11, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(11, 11, CellAttribute::ALIVE);
+
+	size_t a_lByteMax = 64 * 1024;
+	GenerationHistory a_cHistory(a_lByteMax);
+	a_cHistory.start(&a_cMatrixCell);
+
+	MemoryUsage a_cEstimate;
+	GenerationHistory::estimateMemoryUsage(200L, 100L, a_lByteMax, a_cEstimate);
+	bool a_bIsSuccess = true;
+	for(long a_lGeneration=1; a_lGeneration<=20000; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cHistory.commit();
+	}
+	MemoryUsage a_cUsage;
+	a_cHistory.getMemoryUsage(a_cUsage);
+	a_bIsSuccess = a_bIsSuccess && (a_cHistory.getByteSize() <= a_lByteMax) && (20000 > a_cHistory.getEntryNum());
+	a_bIsSuccess = a_bIsSuccess && (0 < a_cUsage.get(MemoryUsage::CATEGORY_HISTORY));
+	a_bIsSuccess = a_bIsSuccess && (a_cUsage.getTotal() == a_cUsage.get(MemoryUsage::CATEGORY_HISTORY));
+	a_bIsSuccess = a_bIsSuccess && (a_cUsage.getTotal() <= a_cEstimate.getTotal());
+
+	// 容量が0なら見積りも0.
+	MemoryUsage a_cZero;
+	GenerationHistory::estimateMemoryUsage(200L, 100L, 0, a_cZero);
+	a_bIsSuccess = a_bIsSuccess && (0 == a_cZero.getTotal());
+	return a_bIsSuccess;
+}
+
+// 巻き戻しの速さと履歴の大きさを表示.(1000x1000, 1000世代).
+bool bench_rewind()
+{
+	MatrixCell a_cMatrixCell(1000L, 1000L);
+	plot_soup(a_cMatrixCell, 1000, 1000);
+
+	GenerationHistory a_cHistory;
+	a_cHistory.start(&a_cMatrixCell);
+	for(long a_lGeneration=1; a_lGeneration<=1000; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cHistory.commit();
+	}
+	cout << "  entries: " << a_cHistory.getEntryNum() << ", keyframes: " << a_cHistory.getKeyFrameNum()
+		<< ", bytes: " << a_cHistory.getByteSize() << endl;
+
+	long a_rglRewind[] = { 1, 10, 100, 500 };
+	bool a_bIsSuccess = true;
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglRewind)/sizeof(a_rglRewind[0]); a_lIndex++)
+	{
+		chrono::steady_clock::time_point a_cBegin = chrono::steady_clock::now();
+		a_bIsSuccess = a_bIsSuccess && (a_rglRewind[a_lIndex]==a_cHistory.rewind(a_rglRewind[a_lIndex]));
+		double a_dTime = chrono::duration<double>(chrono::steady_clock::now() - a_cBegin).count();
+		printf("  rewind %4ld: %8.3f ms\n", a_rglRewind[a_lIndex], a_dTime * 1000.0);
+	}
+	return a_bIsSuccess;
+}
+
+bool test_Generation_History()
+{
+	bool a_bIsSuccess = false;
+
+	// 世代を巻き戻せるかをテスト.
+	a_bIsSuccess = test_rewind_generation();
+	print_test_result("test_rewind_generation", a_bIsSuccess);
+
+	// 編集を取り消せるかをテスト.
+	a_bIsSuccess = test_rewind_edit();
+	print_test_result("test_rewind_edit", a_bIsSuccess);
+
+	// 容量を超えたら古い履歴を捨てるかをテスト.
+	a_bIsSuccess = test_byte_max();
+	print_test_result("test_byte_max", a_bIsSuccess);
+
+	// 変化の無い盤面でも容量を超えないかをテスト.
+	a_bIsSuccess = test_memory_usage();
+	print_test_result("test_memory_usage", a_bIsSuccess);
+
+	// 巻き戻しの速さ.
+	a_bIsSuccess = bench_rewind();
+	print_test_result("bench_rewind", a_bIsSuccess);
+
+	return true;
+}
+
+int main()
+{
+	test_Generation_History();
+	return 0;
+}
@@ -0,0 +1,238 @@
+/*********************************************************
+ * GenerationRecorder/GenerationPlayerクラスのユニットテスト
+ *********************************************************/
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+#include "../MatrixCell.h"
+#include "../BitBoard.h"
+#include "../GenerationRecorder.h"
+#include "../GenerationPlayer.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+// テスト用にグライダーとブリンカーを配置.
+void plot_pattern(MatrixCell& io_cMatrixCell)
+{
+	// グライダー (移動物体)
+	io_cMatrixCell.setCellState(2, 1, CellAttribute::ALIVE);
+	io_cMatrixCell.setCellState(3, 2, CellAttribute::ALIVE);
+	io_cMatrixCell.setCellState(1, 3, CellAttribute::ALIVE);
+	io_cMatrixCell.setCellState(2, 3, CellAttribute::ALIVE);
+	io_cMatrixCell.setCellState(3, 3, CellAttribute::ALIVE);
+	// ブリンカー (振動子)
+	io_cMatrixCell.setCellState(10, 10, CellAttribute::ALIVE);
+	io_cMatrixCell.setCellState(11, 10, CellAttribute::ALIVE);
+	io_cMatrixCell.setCellState(12, 10, CellAttribute::ALIVE);
+}
+
+// MatrixCellとBitBoardの相互変換をテスト.
+bool test_bitboard_export_import()
+{
+	MatrixCell a_cMatrixCell(70L, 5L);
+	a_cMatrixCell.setCellState(0, 0, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(63, 1, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(64, 2, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(69, 4, CellAttribute::ALIVE);
+
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+
+	MatrixCell a_cCopy(70L, 5L);
+	a_cCopy.importBitBoard(a_cBoard);
+
+	return (4==a_cBoard.count())
+		&& a_cBoard.getBit(64, 2)
+		&& (a_cMatrixCell.dispAllCellState()==a_cCopy.dispAllCellState());
+}
+
+// 記録した全世代が再計算結果と一致するかをテスト.(前方へ順に移動).
+bool test_record_and_seek_forward()
+{
+	MatrixCell a_cMatrixCell(16L, 16L);
+	plot_pattern(a_cMatrixCell);
+
+	GenerationRecorder a_cRecorder(8);
+	a_cRecorder.start(&a_cMatrixCell);
+
+	vector<BitBoard> a_vecExpected(1);
+	a_cMatrixCell.exportBitBoard(a_vecExpected[0]);
+	for(long a_lGeneration=1; a_lGeneration<=100; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cRecorder.commit();
+		a_vecExpected.push_back(BitBoard());
+		a_cMatrixCell.exportBitBoard(a_vecExpected.back());
+	}
+	a_cRecorder.stop();
+
+	GenerationPlayer a_cPlayer(&a_cRecorder.getRecord());
+	bool a_bIsSuccess = (101==a_cRecorder.getRecord().getGenerationNum());
+	for(long a_lGeneration=0; a_lGeneration<=100; a_lGeneration++)
+	{
+		a_bIsSuccess = a_bIsSuccess && a_cPlayer.seek(a_lGeneration);
+		a_bIsSuccess = a_bIsSuccess && (a_cPlayer.getBoard()==a_vecExpected[a_lGeneration]);
+	}
+	return a_bIsSuccess;
+}
+
+// 任意の順序で移動できるかをテスト.(編集の記録と保存/読み込みを含む).
+bool test_record_edit_and_random_seek()
+{
+	MatrixCell a_cMatrixCell(16L, 16L);
+	plot_pattern(a_cMatrixCell);
+
+	GenerationRecorder a_cRecorder(5);
+	a_cRecorder.start(&a_cMatrixCell);
+
+	vector<BitBoard> a_vecExpected(1);
+	a_cMatrixCell.exportBitBoard(a_vecExpected[0]);
+	for(long a_lGeneration=1; a_lGeneration<=40; a_lGeneration++)
+	{
+		// 途中でセルを編集する.(生死を反転).
+		if(17==a_lGeneration)
+		{
+			CellAttribute::CELL_STATE a_eState = a_cMatrixCell.getCellState(7, 7);
+			a_eState = (CellAttribute::ALIVE==a_eState)? CellAttribute::DEAD : CellAttribute::ALIVE;
+			a_cMatrixCell.setCellState(7, 7, a_eState);
+			MatrixCellAttribute a_cAttribute(7, 7, a_eState);
+			a_cRecorder.update(&a_cAttribute);
+		}
+		a_cMatrixCell.refreshCell();
+		a_cRecorder.commit();
+		a_vecExpected.push_back(BitBoard());
+		a_cMatrixCell.exportBitBoard(a_vecExpected.back());
+	}
+	a_cRecorder.stop();
+
+	// 保存して読み込む.
+	const char* a_pPath = "test_GenerationRecorder.rec";
+	GenerationRecord a_cLoaded;
+	bool a_bIsSuccess = a_cRecorder.getRecord().save(a_pPath) && a_cLoaded.load(a_pPath);
+	remove(a_pPath);
+
+	long a_rglSeek[] = { 40, 3, 17, 18, 16, 0, 39, 25, 26, 24 };
+	GenerationPlayer a_cPlayer(&a_cLoaded);
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglSeek)/sizeof(a_rglSeek[0]); a_lIndex++)
+	{
+		a_bIsSuccess = a_bIsSuccess && a_cPlayer.seek(a_rglSeek[a_lIndex]);
+		a_bIsSuccess = a_bIsSuccess && (a_cPlayer.getBoard()==a_vecExpected[a_rglSeek[a_lIndex]]);
+	}
+
+	// 範囲外は失敗.
+	a_bIsSuccess = a_bIsSuccess && !a_cPlayer.seek(41);
+	return a_bIsSuccess;
+}
+
+// ヘッダの1項目を書き換えて保存し直す.
+static void patch_record(const char* i_pSource, const char* i_pPath, int i_iHeader, long i_lValue, long i_lTruncate=0)
+{
+	FILE* a_pFile = fopen(i_pSource, "rb");
+	vector<char> a_vecData;
+	char a_szBuffer[4096];
+	for(size_t a_lSize; 0 < (a_lSize = fread(a_szBuffer, 1, sizeof(a_szBuffer), a_pFile)); ) a_vecData.insert(a_vecData.end(), a_szBuffer, a_szBuffer + a_lSize);
+	fclose(a_pFile);
+	if(0 <= i_iHeader) memcpy(&a_vecData[8 + sizeof(long) * i_iHeader], &i_lValue, sizeof(long));
+	a_vecData.resize(a_vecData.size() - i_lTruncate);
+	a_pFile = fopen(i_pPath, "wb");
+	fwrite(&a_vecData[0], 1, a_vecData.size(), a_pFile);
+	fclose(a_pFile);
+}
+
+// 壊れた記録ファイルを拒否するかをテスト.
+bool test_load_corrupt()
+{
+	MatrixCell a_cMatrixCell(16L, 16L);
+	plot_pattern(a_cMatrixCell);
+	GenerationRecorder a_cRecorder(5);
+	a_cRecorder.start(&a_cMatrixCell);
+	for(long a_lGeneration=1; a_lGeneration<=12; a_lGeneration++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cRecorder.commit();
+	}
+	a_cRecorder.stop();
+
+	const char* a_pSource = "test_GenerationRecorder_src.rec";
+	const char* a_pPath = "test_GenerationRecorder_bad.rec";
+	GenerationRecord a_cLoaded;
+	bool a_bIsSuccess = a_cRecorder.getRecord().save(a_pSource) && a_cLoaded.load(a_pSource);
+
+	// ヘッダ: 0:横 1:縦 2:キーフレーム間隔 3:最初の世代 4:世代数 5:キーフレーム数 6:差分の大きさ.
+	long a_rglPatch[][2] = {
+		{ 0, 0 }, { 1, -1 },						// 大きさが0以下.
+		{ 1, 1L << 40 }, { 0, 1L << 50 },			// キーフレームがファイルに収まらない.
+		{ 6, 1L << 40 },							// 差分がファイルに収まらない.
+		{ 4, 1L << 40 }, { 4, 14 },					// 世代数がキーフレーム数, ファイルの大きさと合わない.
+	};
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglPatch)/sizeof(a_rglPatch[0]); a_lIndex++)
+	{
+		patch_record(a_pSource, a_pPath, static_cast<int>(a_rglPatch[a_lIndex][0]), a_rglPatch[a_lIndex][1]);
+		a_bIsSuccess = a_bIsSuccess && !a_cLoaded.load(a_pPath) && (0 == a_cLoaded.getGenerationNum());
+	}
+
+	// 差分の終端が減る/差分の外を指す.(世代数13 = 終端13個の後ろに差分).
+	long a_lDeltaSize = static_cast<long>(a_cRecorder.getRecord().getDeltaSize());
+	size_t a_lEndOffset = 8 + sizeof(long) * 7 + 3 * sizeof(BitBoard::WORD) * 16;
+	size_t a_rglBadEnd[] = { 0, static_cast<size_t>(a_lDeltaSize) + 1 };
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglBadEnd)/sizeof(a_rglBadEnd[0]); a_lIndex++)
+	{
+		patch_record(a_pSource, a_pPath, -1, 0);
+		FILE* a_pFile = fopen(a_pPath, "r+b");
+		fseek(a_pFile, a_lEndOffset + sizeof(size_t) * 12, SEEK_SET);
+		fwrite(&a_rglBadEnd[a_lIndex], sizeof(size_t), 1, a_pFile);
+		fclose(a_pFile);
+		a_bIsSuccess = a_bIsSuccess && (0 < a_lDeltaSize) && !a_cLoaded.load(a_pPath);
+	}
+
+	// 途中で切れている.
+	patch_record(a_pSource, a_pPath, -1, 0, 1);
+	a_bIsSuccess = a_bIsSuccess && !a_cLoaded.load(a_pPath);
+
+	// 書き換えなければ読める.
+	patch_record(a_pSource, a_pPath, -1, 0);
+	a_bIsSuccess = a_bIsSuccess && a_cLoaded.load(a_pPath) && (13 == a_cLoaded.getGenerationNum());
+	remove(a_pSource);
+	remove(a_pPath);
+	return a_bIsSuccess;
+}
+
+bool test_Generation_Recorder()
+{
+	bool a_bIsSuccess = false;
+
+	// MatrixCellとBitBoardの相互変換をテスト.
+	a_bIsSuccess = test_bitboard_export_import();
+	print_test_result("test_bitboard_export_import", a_bIsSuccess);
+
+	// 記録した全世代が再計算結果と一致するかをテスト.
+	a_bIsSuccess = test_record_and_seek_forward();
+	print_test_result("test_record_and_seek_forward", a_bIsSuccess);
+
+	// 任意の順序で移動できるかをテスト.
+	a_bIsSuccess = test_record_edit_and_random_seek();
+	print_test_result("test_record_edit_and_random_seek", a_bIsSuccess);
+
+	// 壊れた記録ファイルを拒否するかをテスト.
+	a_bIsSuccess = test_load_corrupt();
+	print_test_result("test_load_corrupt", a_bIsSuccess);
+
+	return true;
+}
+
+int main()
+{
+	test_Generation_Recorder();
+	return 0;
+}
@@ -5,9 +5,16 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <malloc.h>
 
 #include "../Cell.h"
 #include "../MatrixCell.h"
+#include "../BitBoard.h"
+#include "../../Lib/Tracer.h"
 
 using namespace std;
 
@@ -187,6 +194,484 @@ bool test_cell_over_population()
 	return a_bIsSuccess;
 }
 
+// 通知の回数と変化したセル数を数えるObserver.
+class CountObserver : public Observer<MatrixCellAttribute>
+{
+public:
+	CountObserver() : m_lNotifyNum(0), m_lChangedNum(0) { }
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		this->m_lNotifyNum++;
+		i_pcAttribute->forEachChanged([this](long, long, CellAttribute::CELL_STATE){ this->m_lChangedNum++; });
+		return true;
+	}
+	long m_lNotifyNum;
+	long m_lChangedNum;
+};
+
+// 矩形の塗りつぶし/消去/反転と一括通知をテスト.
+bool test_region_fill_clear_invert()
+{
+	MatrixCell a_cMatrixCell(6L, 5L);
+	CountObserver a_cObserver;
+	a_cMatrixCell.attach(&a_cObserver);
+
+	// 3x2を塗りつぶす.(通知は1回).
+	a_cMatrixCell.fillRegion(1, 1, 3, 2);
+	bool a_bIsSuccess = test_checkResult("000000\n011100\n011100\n000000\n000000\n", a_cMatrixCell.dispAllCellState());
+	a_bIsSuccess = a_bIsSuccess && (1 == a_cObserver.m_lNotifyNum) && (6 == a_cObserver.m_lChangedNum);
+
+	// 範囲外へはみ出した反転は切り詰める.
+	a_cMatrixCell.invertRegion(2, 2, 10, 10);
+	a_bIsSuccess = a_bIsSuccess && test_checkResult("000000\n011100\n010011\n001111\n001111\n", a_cMatrixCell.dispAllCellState());
+
+	// 変化しない場合は通知しない.
+	a_cMatrixCell.clearRegion(0, 0, 1, 5);
+	a_bIsSuccess = a_bIsSuccess && (2 == a_cObserver.m_lNotifyNum);
+
+	a_cMatrixCell.clearRegion(0, 0, 6, 5);
+	a_bIsSuccess = a_bIsSuccess && test_checkResult("000000\n000000\n000000\n000000\n000000\n", a_cMatrixCell.dispAllCellState());
+
+	a_cMatrixCell.detach(&a_cObserver);
+	return a_bIsSuccess;
+}
+
+// コピーと貼り付け(置き換え/OR/XOR)をテスト.
+bool test_region_copy_paste()
+{
+	MatrixCell a_cMatrixCell(6L, 4L);
+	a_cMatrixCell.setCellState(0, 0, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(1, 1, CellAttribute::ALIVE);
+
+	BitBoard a_cClipboard;
+	a_cMatrixCell.copyRegion(0, 0, 2, 2, a_cClipboard);
+	bool a_bIsSuccess = (2 == a_cClipboard.getColMax()) && (2 == a_cClipboard.count());
+
+	a_cMatrixCell.setCellState(3, 1, CellAttribute::ALIVE);
+	a_cMatrixCell.pasteRegion(a_cClipboard, 2, 0, BitBoard::PASTE_OR);
+	a_bIsSuccess = a_bIsSuccess && test_checkResult("101000\n010100\n000000\n000000\n", a_cMatrixCell.dispAllCellState());
+
+	a_cMatrixCell.pasteRegion(a_cClipboard, 2, 0, BitBoard::PASTE_XOR);
+	a_bIsSuccess = a_bIsSuccess && test_checkResult("100000\n010000\n000000\n000000\n", a_cMatrixCell.dispAllCellState());
+
+	// 置き換えは死セルも書き込む. 範囲外は切り詰める.
+	a_cMatrixCell.fillRegion(4, 2, 2, 2);
+	a_cMatrixCell.pasteRegion(a_cClipboard, 5, 2, BitBoard::PASTE_REPLACE);
+	a_bIsSuccess = a_bIsSuccess && test_checkResult("100000\n010000\n000011\n000010\n", a_cMatrixCell.dispAllCellState());
+	return a_bIsSuccess;
+}
+
+// 回転と反転をテスト.(1ワードを超える幅で, 1セルずつの計算結果と比較する).
+bool test_region_rotate_flip()
+{
+	const long a_lColMax = 150;
+	const long a_lRowMax = 140;
+	MatrixCell a_cMatrixCell(a_lColMax, a_lRowMax);
+	for(long a_lRow=0; a_lRow<a_lRowMax; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<a_lColMax; a_lCol++)
+		{
+			if(0 == (a_lCol * 7 + a_lRow * 13 + a_lCol * a_lRow) % 5) a_cMatrixCell.setCellState(a_lCol, a_lRow, CellAttribute::ALIVE);
+		}
+	}
+	BitBoard a_cOriginal;
+	a_cMatrixCell.exportBitBoard(a_cOriginal);
+
+	// 左右反転. (3, 4)から130x20.
+	a_cMatrixCell.flipRegion(3, 4, 130, 20, true);
+	bool a_bIsSuccess = true;
+	for(long a_lRow=0; a_lRow<20; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<130; a_lCol++)
+		{
+			bool a_bExpected = a_cOriginal.getBit(3 + 129 - a_lCol, 4 + a_lRow);
+			a_bIsSuccess = a_bIsSuccess && (a_bExpected == (CellAttribute::ALIVE == a_cMatrixCell.getCellState(3 + a_lCol, 4 + a_lRow)));
+		}
+	}
+	a_cMatrixCell.flipRegion(3, 4, 130, 20, true);
+
+	// 上下反転.
+	a_cMatrixCell.flipRegion(3, 4, 130, 20, false);
+	for(long a_lRow=0; a_lRow<20; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<130; a_lCol++)
+		{
+			bool a_bExpected = a_cOriginal.getBit(3 + a_lCol, 4 + 19 - a_lRow);
+			a_bIsSuccess = a_bIsSuccess && (a_bExpected == (CellAttribute::ALIVE == a_cMatrixCell.getCellState(3 + a_lCol, 4 + a_lRow)));
+		}
+	}
+	a_cMatrixCell.flipRegion(3, 4, 130, 20, false);
+
+	// 反転を2回行うと元に戻る.
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (a_cBoard == a_cOriginal);
+
+	// 時計回りに回転. 70x100の矩形は100x70になり, 元の矩形の残りは"死"になる.
+	a_cMatrixCell.rotateRegion(10, 20, 70, 100);
+	for(long a_lRow=0; a_lRow<100; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<100; a_lCol++)
+		{
+			bool a_bExpected = false;
+			if(a_lRow < 70) a_bExpected = a_cOriginal.getBit(10 + a_lRow, 20 + 99 - a_lCol);
+			else if(a_lCol >= 70) a_bExpected = a_cOriginal.getBit(10 + a_lCol, 20 + a_lRow);
+			a_bIsSuccess = a_bIsSuccess && (a_bExpected == (CellAttribute::ALIVE == a_cMatrixCell.getCellState(10 + a_lCol, 20 + a_lRow)));
+		}
+	}
+	return a_bIsSuccess;
+}
+
+// 生きているセルの数と変化したセルの数をテスト.(数え直した結果と比較する).
+bool test_population_counter()
+{
+	MatrixCell a_cMatrixCell(70L, 50L);
+	BitBoard a_cBoard;
+	bool a_bIsSuccess = (0 == a_cMatrixCell.getPopulation());
+
+	// セルの設定. 同じ状態の設定は数えない.
+	a_cMatrixCell.setCellState(10, 10, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(10, 10, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(11, 10, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(12, 10, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(13, 10, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(13, 10, CellAttribute::DEAD);
+	a_bIsSuccess = a_bIsSuccess && (3 == a_cMatrixCell.getPopulation());
+
+	// ブリンカーは1世代で2セル誕生, 2セル死亡.
+	a_cMatrixCell.refreshCell();
+	a_bIsSuccess = a_bIsSuccess && (3 == a_cMatrixCell.getPopulation()) && (4 == a_cMatrixCell.getChangedNum());
+
+	// 矩形の操作.
+	a_cMatrixCell.fillRegion(60, 40, 20, 20);
+	a_bIsSuccess = a_bIsSuccess && (3 + 100 == a_cMatrixCell.getPopulation());
+	a_cMatrixCell.invertRegion(55, 35, 10, 10);
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (a_cBoard.count() == a_cMatrixCell.getPopulation());
+
+	// 世代を進めても数え直した結果と一致する.
+	for(int a_iIndex=0; a_iIndex<30; a_iIndex++)
+	{
+		BitBoard a_cPrev;
+		a_cMatrixCell.exportBitBoard(a_cPrev);
+		a_cMatrixCell.refreshCell();
+		a_cMatrixCell.exportBitBoard(a_cBoard);
+		BitBoard a_cChanged = a_cBoard;
+		a_cChanged.pasteRect(a_cPrev, 0, 0, BitBoard::PASTE_XOR);
+		a_bIsSuccess = a_bIsSuccess && (a_cBoard.count() == a_cMatrixCell.getPopulation()) && (a_cChanged.count() == a_cMatrixCell.getChangedNum());
+	}
+
+	// BitBoardからの読み込み.
+	a_cBoard.init(70, 50);
+	a_cBoard.fillRect(0, 0, 64, 2, true);
+	a_cMatrixCell.importBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (128 == a_cMatrixCell.getPopulation());
+	return a_bIsSuccess;
+}
+
+// 受け取った変化をBitBoardへ写すObserver.
+class MirrorObserver : public Observer<MatrixCellAttribute>
+{
+public:
+	MirrorObserver(long i_lColMax, long i_lRowMax) : m_lNotifyNum(0), m_lChangedNum(0) { this->m_cBoard.init(i_lColMax, i_lRowMax); }
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		this->m_lNotifyNum++;
+		i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+		{
+			this->m_cBoard.setBit(i_lCol, i_lRow, CellAttribute::ALIVE == i_eState);
+			this->m_lChangedNum++;
+		});
+		return true;
+	}
+	BitBoard m_cBoard;
+	long m_lNotifyNum;
+	long m_lChangedNum;
+};
+
+// 疑似乱数で盤面を埋める.(約3割が生).
+void plot_random(MatrixCell& io_cMatrixCell)
+{
+	BitBoard a_cBoard;
+	a_cBoard.init(io_cMatrixCell.getColMax(), io_cMatrixCell.getRowMax());
+	unsigned long a_ulSeed = 12345;
+	for(long a_lRow=0; a_lRow<a_cBoard.getRowMax(); a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<a_cBoard.getColMax(); a_lCol++)
+		{
+			a_ulSeed = a_ulSeed * 6364136223846793005UL + 1442695040888963407UL;
+			a_cBoard.setBit(a_lCol, a_lRow, 30 > (a_ulSeed >> 33) % 100);
+		}
+	}
+	io_cMatrixCell.importBitBoard(a_cBoard);
+}
+
+// 関心領域の内側が盤面と一致し, 外側は通知されていないかを確認.
+bool check_interest(MatrixCell& i_cMatrixCell, const BitBoard& i_cMirror, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	BitBoard a_cBoard;
+	i_cMatrixCell.exportBitBoard(a_cBoard);
+	BitBoard a_cExpected;
+	a_cExpected.init(a_cBoard.getColMax(), a_cBoard.getRowMax());
+	BitBoard a_cInside;
+	a_cInside.extract(a_cBoard, i_lCol, i_lRow, i_lWidth, i_lHeight);
+	a_cExpected.pasteRect(a_cInside, i_lCol, i_lRow, BitBoard::PASTE_REPLACE);
+	return a_cExpected == i_cMirror;
+}
+
+// 関心領域を指定したObserverへの通知をテスト.
+bool test_interest()
+{
+	MatrixCell a_cMatrixCell(300L, 200L);
+	plot_random(a_cMatrixCell);
+
+	// 盤面全体のObserverは, 登録時点の盤面に変化を重ねると常に盤面と一致する.
+	MirrorObserver a_cAllObserver(300, 200);
+	a_cMatrixCell.exportBitBoard(a_cAllObserver.m_cBoard);
+	a_cMatrixCell.attach(&a_cAllObserver);
+
+	// 関心領域のObserverは, 登録時に関心領域内の全セルを受け取る.(タイルの境界を跨ぐ矩形).
+	MirrorObserver a_cRoiObserver(300, 200);
+	a_cMatrixCell.attach(&a_cRoiObserver, 70, 50, 100, 60);
+	bool a_bIsSuccess = (1 == a_cRoiObserver.m_lNotifyNum) && (100 * 60 == a_cRoiObserver.m_lChangedNum);
+	a_bIsSuccess = a_bIsSuccess && check_interest(a_cMatrixCell, a_cRoiObserver.m_cBoard, 70, 50, 100, 60);
+
+	for(int a_iIndex=0; a_iIndex<20; a_iIndex++)
+	{
+		a_cMatrixCell.refreshCell();
+		BitBoard a_cBoard;
+		a_cMatrixCell.exportBitBoard(a_cBoard);
+		a_bIsSuccess = a_bIsSuccess && (a_cBoard == a_cAllObserver.m_cBoard);
+		a_bIsSuccess = a_bIsSuccess && check_interest(a_cMatrixCell, a_cRoiObserver.m_cBoard, 70, 50, 100, 60);
+	}
+	// 通知はタイル毎にまとめる.(関心領域に掛かるタイルは2x2個).
+	a_bIsSuccess = a_bIsSuccess && (1 + 20 * 4 >= a_cRoiObserver.m_lNotifyNum);
+
+	// 矩形の操作は関心領域と重なる部分だけを通知する.
+	a_cMatrixCell.invertRegion(150, 100, 100, 50);
+	a_bIsSuccess = a_bIsSuccess && check_interest(a_cMatrixCell, a_cRoiObserver.m_cBoard, 70, 50, 100, 60);
+	long a_lNotifyNum = a_cRoiObserver.m_lNotifyNum;
+	a_cMatrixCell.invertRegion(0, 0, 10, 10);
+	a_bIsSuccess = a_bIsSuccess && (a_lNotifyNum == a_cRoiObserver.m_lNotifyNum);
+
+	// 関心領域を動かすと新しい関心領域の全セルを受け取る.(盤面からはみ出した分は切り詰める).
+	a_cRoiObserver.m_cBoard.init(300, 200);
+	a_bIsSuccess = a_bIsSuccess && a_cMatrixCell.setInterest(&a_cRoiObserver, 250, 180, 100, 100);
+	for(int a_iIndex=0; a_iIndex<10; a_iIndex++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_bIsSuccess = a_bIsSuccess && check_interest(a_cMatrixCell, a_cRoiObserver.m_cBoard, 250, 180, 50, 20);
+	}
+
+	// 登録解除後は通知しない.
+	a_cMatrixCell.detach(&a_cRoiObserver);
+	a_lNotifyNum = a_cRoiObserver.m_lNotifyNum;
+	a_cMatrixCell.refreshCell();
+	a_bIsSuccess = a_bIsSuccess && (a_lNotifyNum == a_cRoiObserver.m_lNotifyNum) && !a_cMatrixCell.setInterest(&a_cRoiObserver, 0, 0, 10, 10);
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard);
+	a_bIsSuccess = a_bIsSuccess && (a_cBoard == a_cAllObserver.m_cBoard);
+	a_cMatrixCell.detach(&a_cAllObserver);
+	return a_bIsSuccess;
+}
+
+// 関心領域の大きさと通知の量を表示.(2000x2000, 10世代).
+bool bench_interest()
+{
+	long a_rglSize[] = { 0, 2000, 500, 100 };
+	bool a_bIsSuccess = true;
+	long a_lPrevChangedNum = -1;
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglSize)/sizeof(a_rglSize[0]); a_lIndex++)
+	{
+		MatrixCell a_cMatrixCell(2000L, 2000L);
+		plot_random(a_cMatrixCell);
+		MirrorObserver a_cObserver(2000, 2000);
+		// 0は盤面全体.
+		if(0 == a_rglSize[a_lIndex]) a_cMatrixCell.attach(&a_cObserver);
+		else a_cMatrixCell.attach(&a_cObserver, 1000 - a_rglSize[a_lIndex] / 2, 1000 - a_rglSize[a_lIndex] / 2, a_rglSize[a_lIndex], a_rglSize[a_lIndex]);
+		a_cObserver.m_lNotifyNum = 0;
+		a_cObserver.m_lChangedNum = 0;
+
+		chrono::steady_clock::time_point a_cBegin = chrono::steady_clock::now();
+		for(int a_iGeneration=0; a_iGeneration<10; a_iGeneration++) a_cMatrixCell.refreshCell();
+		double a_dTime = chrono::duration<double>(chrono::steady_clock::now() - a_cBegin).count();
+		printf("  interest %4ld: %7.2f ms/gen, %6ld notifies, %9ld cells\n", a_rglSize[a_lIndex], a_dTime * 100.0,
+			a_cObserver.m_lNotifyNum, a_cObserver.m_lChangedNum);
+
+		// 関心領域が小さいほど受け取るセルが少ない.
+		if(0 < a_rglSize[a_lIndex]) a_bIsSuccess = a_bIsSuccess && (a_lPrevChangedNum >= a_cObserver.m_lChangedNum);
+		a_lPrevChangedNum = a_cObserver.m_lChangedNum;
+		a_cMatrixCell.detach(&a_cObserver);
+	}
+	return a_bIsSuccess;
+}
+
+// 処理段階毎の計測をテスト.(LIFEGAME_PROFILEを定義しない場合は何も計測しない).
+bool test_profiler()
+{
+	MatrixCell a_cMatrixCell(200L, 100L);
+	plot_random(a_cMatrixCell);
+	CountObserver a_cObserver;
+	a_cMatrixCell.attach(&a_cObserver);
+
+	long a_lNotifyNum = 0;
+	for(int a_iIndex=0; a_iIndex<3; a_iIndex++)
+	{
+		// 複数スレッドでの書き出しは次の世代に合計する.
+		BitBoard a_cBoard;
+		a_cMatrixCell.exportBitBoard(a_cBoard, 4);
+		a_lNotifyNum = a_cObserver.m_lNotifyNum;
+		a_cMatrixCell.refreshCell();
+		a_lNotifyNum = a_cObserver.m_lNotifyNum - a_lNotifyNum;
+	}
+	a_cMatrixCell.detach(&a_cObserver);
+
+	const Profiler::RECORD& a_stLast = a_cMatrixCell.getProfiler().getLast();
+	const Profiler::RECORD& a_stTotal = a_cMatrixCell.getProfiler().getTotal();
+	if(!Profiler::isEnabled())
+	{
+		return (0 == a_stTotal.m_lGenerationNum) && (0 == a_stTotal.m_rglCounter[Profiler::COUNTER_VISITED]);
+	}
+
+	bool a_bIsSuccess = (3 == a_stTotal.m_lGenerationNum) && (3 == a_stLast.m_lGeneration) && (1 == a_stLast.m_lGenerationNum);
+	a_bIsSuccess = a_bIsSuccess && (200 * 100 == a_stLast.m_rglCounter[Profiler::COUNTER_VISITED]);
+	a_bIsSuccess = a_bIsSuccess && (3 * 200 * 100 == a_stTotal.m_rglCounter[Profiler::COUNTER_VISITED]);
+	a_bIsSuccess = a_bIsSuccess && (a_cMatrixCell.getChangedNum() == a_stLast.m_rglCounter[Profiler::COUNTER_CHANGED]);
+	a_bIsSuccess = a_bIsSuccess && (a_lNotifyNum == a_stLast.m_rglCounter[Profiler::COUNTER_NOTIFY]);
+	for(int a_iPhase=0; a_iPhase<Profiler::PHASE_MAX; a_iPhase++)
+	{
+		a_bIsSuccess = a_bIsSuccess && (0 < a_stLast.m_rgdWallSecond[a_iPhase]);
+	}
+	Profiler::dump(stdout, a_stTotal);
+	return a_bIsSuccess;
+}
+
+// 作り直したスレッドの領域の番号が一巡しても, 同時に加算した件数を失わないことをテスト.
+bool test_profiler_threads()
+{
+	Profiler a_cProfiler;
+	const long a_lAddNum = 10000;
+	const int a_iThreadNum = 8;
+	bool a_bIsSuccess = true;
+	for(int a_iRound=0; a_iRound<20; a_iRound++)
+	{
+		// 呼び出し元のスレッドも同時に加算する.(parallelFor()と同じ).
+		vector<std::thread> a_vecThread;
+		for(int a_iIndex=0; a_iIndex<a_iThreadNum-1; a_iIndex++)
+		{
+			a_vecThread.push_back(std::thread([&a_cProfiler, a_lAddNum]()
+			{
+				for(long a_lIndex=0; a_lIndex<a_lAddNum; a_lIndex++) a_cProfiler.addCount(Profiler::COUNTER_VISITED, 1);
+			}));
+		}
+		for(long a_lIndex=0; a_lIndex<a_lAddNum; a_lIndex++) a_cProfiler.addCount(Profiler::COUNTER_VISITED, 1);
+		for(size_t a_lIndex=0; a_lIndex<a_vecThread.size(); a_lIndex++) a_vecThread[a_lIndex].join();
+
+		a_cProfiler.endGeneration(a_iRound + 1);
+		a_bIsSuccess = a_bIsSuccess && (a_iThreadNum * a_lAddNum == a_cProfiler.getLast().m_rglCounter[Profiler::COUNTER_VISITED]);
+	}
+	return a_bIsSuccess;
+}
+
+// 文字列の出現回数.
+static long count_string(const string& i_strText, const string& i_strKey)
+{
+	long a_lNum = 0;
+	for(size_t a_lPos=i_strText.find(i_strKey); string::npos!=a_lPos; a_lPos=i_strText.find(i_strKey, a_lPos+1)) a_lNum++;
+	return a_lNum;
+}
+
+// 処理の区間の記録をテスト.(LIFEGAME_TRACEを定義しない場合は何も記録しない).
+bool test_tracer()
+{
+	MatrixCell a_cMatrixCell(200L, 100L);
+	plot_random(a_cMatrixCell);
+
+	Tracer& a_cTracer = Tracer::getInstance();
+	TRACE_THREAD_NAME("test main");
+	a_cTracer.start();
+	for(int a_iIndex=0; a_iIndex<3; a_iIndex++)
+	{
+		// 帯のスレッドは毎回作り直されるが, 領域は使い回す.
+		BitBoard a_cBoard;
+		a_cMatrixCell.exportBitBoard(a_cBoard, 4);
+		a_cMatrixCell.refreshCell();
+	}
+	a_cTracer.stop();
+	a_cMatrixCell.refreshCell();	// 停止後は記録しない.
+
+	FILE* a_pFile = tmpfile();
+	if(0 == a_pFile) return false;
+	bool a_bIsSuccess = a_cTracer.write(a_pFile);
+	string a_strJson;
+	char a_szBuffer[4096];
+	rewind(a_pFile);
+	for(size_t a_lSize; 0 < (a_lSize = fread(a_szBuffer, 1, sizeof(a_szBuffer), a_pFile)); ) a_strJson.append(a_szBuffer, a_lSize);
+	fclose(a_pFile);
+
+	a_bIsSuccess = a_bIsSuccess && (0 == a_strJson.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+	a_bIsSuccess = a_bIsSuccess && (a_strJson.size() - 4 == a_strJson.rfind("\n]}\n"));
+	if(!Tracer::isEnabled())
+	{
+		return a_bIsSuccess && (0 == a_cTracer.getEventNum()) && (0 == count_string(a_strJson, "\"ph\":\"X\""));
+	}
+
+	// 1世代あたり step, send, decide と書き出しの帯4つ.(Observerが無いのでnotifyは無い).
+	a_bIsSuccess = a_bIsSuccess && (3 * 7 == a_cTracer.getEventNum()) && (0 == a_cTracer.getDropNum());
+	a_bIsSuccess = a_bIsSuccess && (3 * 7 == count_string(a_strJson, "\"ph\":\"X\""));
+	a_bIsSuccess = a_bIsSuccess && (3 * 4 == count_string(a_strJson, "\"name\":\"export\""));
+	a_bIsSuccess = a_bIsSuccess && (0 == count_string(a_strJson, "\"name\":\"notify\""));
+	a_bIsSuccess = a_bIsSuccess && (1 == count_string(a_strJson, "\"args\":{\"name\":\"test main\"}"));
+	a_bIsSuccess = a_bIsSuccess && (3 == count_string(a_strJson, "\"name\":\"step\",\"cat\":\"model\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"));
+
+	// 帯のスレッドは終了したスレッドの領域を使い回すので, 多くても同時に動いた4スレッド分しか無い.
+	a_bIsSuccess = a_bIsSuccess && (0 < count_string(a_strJson, "\"tid\":2,")) && (0 == count_string(a_strJson, "\"tid\":5,"));
+	return a_bIsSuccess;
+}
+
+// メモリの量の見積りと集計をテスト.
+bool test_memory_usage()
+{
+	// 確保する前の見積りと確保した後の集計が一致する.
+	long a_rglSize[][2] = { { 1L, 1L }, { 200L, 100L }, { 1000L, 1000L } };
+	bool a_bIsSuccess = true;
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rglSize)/sizeof(a_rglSize[0]); a_lIndex++)
+	{
+		MemoryUsage a_cEstimate;
+		MatrixCell::estimateMemoryUsage(a_rglSize[a_lIndex][0], a_rglSize[a_lIndex][1], a_cEstimate);
+
+		struct mallinfo2 a_stBefore = mallinfo2();
+		MatrixCell* a_pcMatrixCell = new MatrixCell(a_rglSize[a_lIndex][0], a_rglSize[a_lIndex][1]);
+		struct mallinfo2 a_stAfter = mallinfo2();
+		MemoryUsage a_cUsage;
+		a_pcMatrixCell->getMemoryUsage(a_cUsage);
+
+		for(int a_iCategory=0; a_iCategory<MemoryUsage::CATEGORY_MAX; a_iCategory++)
+		{
+			MemoryUsage::CATEGORY a_eCategory = static_cast<MemoryUsage::CATEGORY>(a_iCategory);
+			a_bIsSuccess = a_bIsSuccess && (a_cEstimate.get(a_eCategory) == a_cUsage.get(a_eCategory));
+		}
+		a_bIsSuccess = a_bIsSuccess && (0 == a_cUsage.get(MemoryUsage::CATEGORY_HASH));
+
+		// mallocが実際に増やした量と2%以内.(MatrixCell自身は集計に含むがヒープの量ではないので除く).
+		double a_dHeap = static_cast<double>((a_stAfter.uordblks + a_stAfter.hblkhd) - (a_stBefore.uordblks + a_stBefore.hblkhd));
+		double a_dTotal = static_cast<double>(a_cUsage.getTotal() - sizeof(MatrixCell) + MemoryUsage::getHeapByte(sizeof(MatrixCell)));
+		if(1000L == a_rglSize[a_lIndex][0])
+		{
+			printf("  %ldx%ld: heap %.0f, usage %.0f, ", a_rglSize[a_lIndex][0], a_rglSize[a_lIndex][1], a_dHeap, a_dTotal);
+			a_cUsage.dump(stdout);
+			a_bIsSuccess = a_bIsSuccess && (a_dHeap * 0.98 <= a_dTotal) && (a_dTotal <= a_dHeap * 1.02);
+		}
+		// 世代を進めても変わらない.
+		a_pcMatrixCell->refreshCell();
+		MemoryUsage a_cAfterStep;
+		a_pcMatrixCell->getMemoryUsage(a_cAfterStep);
+		a_bIsSuccess = a_bIsSuccess && (a_cAfterStep.getTotal() == a_cUsage.getTotal());
+		delete a_pcMatrixCell;
+	}
+	return a_bIsSuccess;
+}
+
 bool test_Matrix_Cell()
 {
 	bool a_bIsSuccess = false;
@@ -215,6 +700,44 @@ bool test_Matrix_Cell()
 	a_bIsSuccess = test_cell_over_population();
 	print_test_result("test_cell_over_population", a_bIsSuccess);
 
+	// 矩形の塗りつぶし/消去/反転をテスト.
+	a_bIsSuccess = test_region_fill_clear_invert();
+	print_test_result("test_region_fill_clear_invert", a_bIsSuccess);
+
+	// コピーと貼り付けをテスト.
+	a_bIsSuccess = test_region_copy_paste();
+	print_test_result("test_region_copy_paste", a_bIsSuccess);
+
+	// 回転と反転をテスト.
+	a_bIsSuccess = test_region_rotate_flip();
+	print_test_result("test_region_rotate_flip", a_bIsSuccess);
+
+	// 生きているセルの数と変化したセルの数をテスト.
+	a_bIsSuccess = test_population_counter();
+	print_test_result("test_population_counter", a_bIsSuccess);
+
+	// 関心領域を指定したObserverへの通知をテスト.
+	a_bIsSuccess = test_interest();
+	print_test_result("test_interest", a_bIsSuccess);
+
+	// 処理段階毎の計測をテスト.
+	a_bIsSuccess = test_profiler();
+	print_test_result("test_profiler", a_bIsSuccess);
+
+	a_bIsSuccess = test_profiler_threads();
+	print_test_result("test_profiler_threads", a_bIsSuccess);
+
+	a_bIsSuccess = test_tracer();
+	print_test_result("test_tracer", a_bIsSuccess);
+
+	// メモリの量の見積りと集計をテスト.
+	a_bIsSuccess = test_memory_usage();
+	print_test_result("test_memory_usage", a_bIsSuccess);
+
+	// 関心領域の大きさと通知の量.
+	a_bIsSuccess = bench_interest();
+	print_test_result("bench_interest", a_bIsSuccess);
+
 	return true;
 }
 
@@ -0,0 +1,113 @@
+/*********************************************************
+ * SoupGeneratorクラスのユニットテスト
+ *********************************************************/
+
+#include <iostream>
+#include <cstdio>
+#include <sys/time.h>
+
+#include "../MatrixCell.h"
+#include "../BitBoard.h"
+#include "../SoupGenerator.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+double get_second()
+{
+	struct timeval a_stTime;
+	gettimeofday(&a_stTime, 0);
+	return a_stTime.tv_sec + a_stTime.tv_usec / 1000000.0;
+}
+
+// 同じシードならばスレッド数に関係なく同じスープになるかをテスト.
+bool test_soup_reproducible()
+{
+	BitBoard a_cBoard1(1000, 300);
+	BitBoard a_cBoard4(1000, 300);
+	BitBoard a_cOther(1000, 300);
+
+	SoupGenerator(12345, 0.37).generate(a_cBoard1, 1);
+	SoupGenerator(12345, 0.37).generate(a_cBoard4, 4);
+	SoupGenerator(12346, 0.37).generate(a_cOther, 4);
+
+	return (a_cBoard1 == a_cBoard4) && (a_cBoard1 != a_cOther);
+}
+
+// 密度どおりに生きたセルができるかをテスト.
+bool test_soup_density()
+{
+	bool a_bIsSuccess = true;
+	const double a_rgdDensity[] = { 0.0, 0.1, 0.25, 0.5, 0.9, 1.0 };
+
+	// 横幅は64の倍数でない値にして行末の余りビットも確認する.
+	BitBoard a_cBoard(1001, 1000);
+	for(size_t a_lIndex=0; a_lIndex<sizeof(a_rgdDensity)/sizeof(a_rgdDensity[0]); a_lIndex++)
+	{
+		SoupGenerator a_cSoup(1, a_rgdDensity[a_lIndex]);
+		a_cSoup.generate(a_cBoard, 2);
+		double a_dActual = static_cast<double>(a_cBoard.count()) / (1001 * 1000);
+		double a_dDiff = a_dActual - a_cSoup.getDensity();
+		a_bIsSuccess = a_bIsSuccess && (-0.005 < a_dDiff) && (0.005 > a_dDiff);
+	}
+	return a_bIsSuccess;
+}
+
+// 生成したスープをMatrixCellへ読み込めるかをテスト.
+bool test_soup_import()
+{
+	BitBoard a_cSoup(130, 70);
+	SoupGenerator(7, 0.5).generate(a_cSoup, 3);
+
+	MatrixCell a_cMatrixCell(130, 70);
+	a_cMatrixCell.importBitBoard(a_cSoup, 3);
+
+	BitBoard a_cBoard;
+	a_cMatrixCell.exportBitBoard(a_cBoard, 2);
+	return a_cBoard == a_cSoup;
+}
+
+// 1億セルのスープの生成時間を表示.
+void bench_soup()
+{
+	BitBoard a_cBoard(10000, 10000);
+	for(int a_iThread=1; a_iThread<=4; a_iThread*=2)
+	{
+		double a_dStart = get_second();
+		SoupGenerator(1, 0.3).generate(a_cBoard, a_iThread);
+		printf("bench_soup(10000x10000, %d threads): %.3f sec\n", a_iThread, get_second() - a_dStart);
+	}
+}
+
+bool test_Soup_Generator()
+{
+	bool a_bIsSuccess = false;
+
+	// スレッド数に依らず再現できるかをテスト.
+	a_bIsSuccess = test_soup_reproducible();
+	print_test_result("test_soup_reproducible", a_bIsSuccess);
+
+	// 密度をテスト.
+	a_bIsSuccess = test_soup_density();
+	print_test_result("test_soup_density", a_bIsSuccess);
+
+	// MatrixCellへの読み込みをテスト.
+	a_bIsSuccess = test_soup_import();
+	print_test_result("test_soup_import", a_bIsSuccess);
+
+	bench_soup();
+	return true;
+}
+
+int main()
+{
+	test_Soup_Generator();
+	return 0;
+}
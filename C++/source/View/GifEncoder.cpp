@@ -0,0 +1,179 @@
+/**
+ * @file    GifEncoder.cpp
+ * @brief   アニメーションGIFを書き出すクラスの実装.
+ */
+
+#include "GifEncoder.h"
+
+// LZWの最小符号長.(4色 → 2ビット).
+#define LZW_MIN_CODE_SIZE	(2)
+// LZWの最大符号数.
+#define LZW_CODE_MAX		(4096)
+
+/***************************
+ * 16ビット値を書き出す.(リトルエンディアン).
+ ***************************/
+static void putWord(FILE* i_pFile, int i_iValue)
+{
+	fputc(i_iValue & 0xFF, i_pFile);
+	fputc((i_iValue >> 8) & 0xFF, i_pFile);
+}
+
+/***************************
+ * ファイルを開き, ヘッダを書き出す.
+ ***************************/
+bool GifEncoder::open(const std::string& i_strPath, int i_iWidth, int i_iHeight, const unsigned char* i_pbyPalette)
+{
+	this->close();
+
+	this->m_pFile = fopen(i_strPath.c_str(), "wb");
+	if(0 == this->m_pFile) return false;
+
+	// ヘッダ.
+	fwrite("GIF89a", 1, 6, this->m_pFile);
+
+	// 論理画面記述子.(グローバルカラーテーブル有り, 4色).
+	putWord(this->m_pFile, i_iWidth);
+	putWord(this->m_pFile, i_iHeight);
+	fputc(0x80 | (LZW_MIN_CODE_SIZE - 1), this->m_pFile);
+	fputc(0, this->m_pFile);	// 背景色.
+	fputc(0, this->m_pFile);	// アスペクト比.
+	fwrite(i_pbyPalette, 1, COLOR_NUM * 3, this->m_pFile);
+
+	// アプリケーション拡張.(無限ループ).
+	fputc(0x21, this->m_pFile);
+	fputc(0xFF, this->m_pFile);
+	fputc(11, this->m_pFile);
+	fwrite("NETSCAPE2.0", 1, 11, this->m_pFile);
+	fputc(3, this->m_pFile);
+	fputc(1, this->m_pFile);
+	putWord(this->m_pFile, 0);
+	fputc(0, this->m_pFile);
+
+	return true;
+}
+
+/***************************
+ * 1フレームを書き出す.
+ ***************************/
+bool GifEncoder::writeFrame(int i_iLeft, int i_iTop, int i_iWidth, int i_iHeight, const unsigned char* i_pbyPixel, int i_iDelay)
+{
+	if(0 == this->m_pFile) return false;
+
+	// グラフィック制御拡張.(前フレームを残す).
+	fputc(0x21, this->m_pFile);
+	fputc(0xF9, this->m_pFile);
+	fputc(4, this->m_pFile);
+	fputc(1 << 2, this->m_pFile);
+	putWord(this->m_pFile, i_iDelay);
+	fputc(0, this->m_pFile);
+	fputc(0, this->m_pFile);
+
+	// イメージ記述子.
+	fputc(0x2C, this->m_pFile);
+	putWord(this->m_pFile, i_iLeft);
+	putWord(this->m_pFile, i_iTop);
+	putWord(this->m_pFile, i_iWidth);
+	putWord(this->m_pFile, i_iHeight);
+	fputc(0, this->m_pFile);
+
+	// イメージデータ.(255バイト以下のサブブロックに分割).
+	this->encodeLzw(i_pbyPixel, static_cast<long>(i_iWidth) * i_iHeight);
+	fputc(LZW_MIN_CODE_SIZE, this->m_pFile);
+	for(size_t a_lPos=0; a_lPos<this->m_vecCode.size(); a_lPos+=255)
+	{
+		size_t a_lSize = this->m_vecCode.size() - a_lPos;
+		if(255 < a_lSize) a_lSize = 255;
+		fputc(static_cast<int>(a_lSize), this->m_pFile);
+		fwrite(&this->m_vecCode[a_lPos], 1, a_lSize, this->m_pFile);
+	}
+	fputc(0, this->m_pFile);
+
+	return (0 == ferror(this->m_pFile));
+}
+
+/***************************
+ * トレーラを書き出し, ファイルを閉じる.
+ ***************************/
+void GifEncoder::close()
+{
+	if(0 == this->m_pFile) return;
+
+	fputc(0x3B, this->m_pFile);
+	fclose(this->m_pFile);
+	this->m_pFile = 0;
+}
+
+/***************************
+ * ピクセル列をLZW符号化する.
+ ***************************/
+void GifEncoder::encodeLzw(const unsigned char* i_pbyPixel, long i_lSize)
+{
+	const int a_iClearCode = 1 << LZW_MIN_CODE_SIZE;
+	int a_iCodeSize = LZW_MIN_CODE_SIZE + 1;
+	int a_iMaxCode = a_iClearCode + 1;
+
+	unsigned long a_ulBitBuffer = 0;
+	int a_iBitNum = 0;
+
+	this->m_vecCode.clear();
+	this->m_vecDictionary.assign(LZW_CODE_MAX * COLOR_NUM, 0);
+
+	// 符号をLSBから詰めて書き出す.
+	#define WRITE_CODE(code) \
+		do{ \
+			a_ulBitBuffer |= static_cast<unsigned long>(code) << a_iBitNum; \
+			a_iBitNum += a_iCodeSize; \
+			while(8 <= a_iBitNum) \
+			{ \
+				this->m_vecCode.push_back(static_cast<unsigned char>(a_ulBitBuffer & 0xFF)); \
+				a_ulBitBuffer >>= 8; \
+				a_iBitNum -= 8; \
+			} \
+		}while(0)
+
+	WRITE_CODE(a_iClearCode);
+
+	int a_iCurCode = -1;
+	for(long a_lIndex=0; a_lIndex<i_lSize; a_lIndex++)
+	{
+		int a_iPixel = i_pbyPixel[a_lIndex] & (COLOR_NUM - 1);
+		if(0 > a_iCurCode)
+		{
+			a_iCurCode = a_iPixel;
+			continue;
+		}
+
+		unsigned short& a_rsNext = this->m_vecDictionary[a_iCurCode * COLOR_NUM + a_iPixel];
+		if(0 != a_rsNext)
+		{
+			a_iCurCode = a_rsNext;
+			continue;
+		}
+
+		// 辞書に無い並びになったので, ここまでの符号を書き出して辞書へ登録する.
+		WRITE_CODE(a_iCurCode);
+		a_rsNext = static_cast<unsigned short>(++a_iMaxCode);
+		if( (1 << a_iCodeSize) <= a_iMaxCode ) a_iCodeSize++;
+
+		// 辞書が一杯になったら初期化する.
+		if( (LZW_CODE_MAX - 1) == a_iMaxCode )
+		{
+			WRITE_CODE(a_iClearCode);
+			this->m_vecDictionary.assign(LZW_CODE_MAX * COLOR_NUM, 0);
+			a_iCodeSize = LZW_MIN_CODE_SIZE + 1;
+			a_iMaxCode = a_iClearCode + 1;
+		}
+		a_iCurCode = a_iPixel;
+	}
+
+	// 最後の符号を書き出し, 辞書を初期化してから終了符号を書き出す.
+	if(0 <= a_iCurCode) WRITE_CODE(a_iCurCode);
+	WRITE_CODE(a_iClearCode);
+	a_iCodeSize = LZW_MIN_CODE_SIZE + 1;
+	WRITE_CODE(a_iClearCode + 1);
+
+	#undef WRITE_CODE
+
+	if(0 < a_iBitNum) this->m_vecCode.push_back(static_cast<unsigned char>(a_ulBitBuffer & 0xFF));
+}
@@ -0,0 +1,102 @@
+/**
+ * @file    GifEncoder.h
+ * @brief   アニメーションGIFを書き出すクラスの宣言.
+ */
+#ifndef __GIF_ENCODER_H__
+#define __GIF_ENCODER_H__
+
+#include <cstdio>
+#include <vector>
+#include <string>
+
+/**
+ * @brief   アニメーションGIFを書き出すクラス.
+ * @note    4色のグローバルカラーテーブルを持つGIF89aを書き出す.
+ * @note    各フレームは画像の一部の矩形(前フレームからの変化部分)でもよい.
+ *          前フレームは消去しない(disposal method = 1)ため, 矩形外は前フレームの表示が残る.
+ */
+class GifEncoder
+{
+public:
+    /**
+     * @brief   カラーテーブルの色数.
+     */
+    enum { COLOR_NUM = 4 };
+
+    /**
+     * @brief   コンストラクタ.
+     */
+    GifEncoder()
+	{
+		this->m_pFile = 0;
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~GifEncoder()
+	{
+		this->close();
+	}
+
+    /**
+     * @brief   ファイルを開き, ヘッダを書き出す.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   int i_iWidth 画像の横幅.(ピクセル).
+     * @param   int i_iHeight 画像の縦幅.(ピクセル).
+     * @param   const unsigned char* i_pbyPalette カラーテーブル.(RGB x COLOR_NUM).
+     * @return  成功/失敗.
+     */
+    bool open(const std::string& i_strPath, int i_iWidth, int i_iHeight, const unsigned char* i_pbyPalette);
+
+    /**
+     * @brief   1フレームを書き出す.
+     * @param   int i_iLeft 矩形の左端.
+     * @param   int i_iTop 矩形の上端.
+     * @param   int i_iWidth 矩形の横幅.
+     * @param   int i_iHeight 矩形の縦幅.
+     * @param   const unsigned char* i_pbyPixel 矩形内のピクセル.(カラーテーブルの番号. 横幅 x 縦幅).
+     * @param   int i_iDelay 表示時間.(1/100秒単位).
+     * @return  成功/失敗.
+     */
+    bool writeFrame(int i_iLeft, int i_iTop, int i_iWidth, int i_iHeight, const unsigned char* i_pbyPixel, int i_iDelay);
+
+    /**
+     * @brief   トレーラを書き出し, ファイルを閉じる.
+     * @param   なし.
+     * @return  なし.
+     */
+    void close();
+
+    /**
+     * @brief   ファイルを開いているか否か.
+     */
+    bool isOpen() const { return 0 != this->m_pFile; }
+
+private:
+    /**
+     * @brief   書き出し先のファイル.
+     */
+    FILE* m_pFile;
+
+    /**
+     * @brief   LZW符号化したデータ.(サブブロックへ分割する前).
+     */
+    std::vector<unsigned char> m_vecCode;
+
+    /**
+     * @brief   LZWの辞書.(符号 x 次の色 → 符号. 未登録は0).
+     */
+    std::vector<unsigned short> m_vecDictionary;
+
+    /**
+     * @brief   ピクセル列をLZW符号化する.
+     * @param   const unsigned char* i_pbyPixel ピクセル列.
+     * @param   long i_lSize ピクセル数.
+     * @return  なし.
+     * @note    結果はm_vecCodeへ格納する.
+     */
+    void encodeLzw(const unsigned char* i_pbyPixel, long i_lSize);
+};
+
+#endif  // __GIF_ENCODER_H__
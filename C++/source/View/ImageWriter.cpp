@@ -0,0 +1,120 @@
+/**
+ * @file    ImageWriter.cpp
+ * @brief   RGB画像をPPM/PNG形式で保存するクラスの実装.
+ */
+#include "ImageWriter.h"
+
+#include <cstdio>
+#include <cctype>
+#include <vector>
+#include <algorithm>
+#include <zlib.h>
+
+/******************************************
+ * ファイル名の拡張子から形式を決める.
+ ******************************************/
+ImageWriter::FORMAT ImageWriter::getFormat(const std::string& i_strPath)
+{
+	if(4 > i_strPath.size()) return FORMAT_PPM;
+	std::string a_strExtension = i_strPath.substr(i_strPath.size() - 4);
+	for(size_t a_lIndex=0; a_lIndex<a_strExtension.size(); a_lIndex++)
+	{
+		a_strExtension[a_lIndex] = static_cast<char>(tolower(a_strExtension[a_lIndex]));
+	}
+	return (".png" == a_strExtension)? FORMAT_PNG : FORMAT_PPM;
+}
+
+/******************************************
+ * 画像を保存する.
+ ******************************************/
+bool ImageWriter::save(const std::string& i_strPath, FORMAT i_eFormat, long i_lWidth, long i_lHeight, const unsigned char* i_pbyPixel)
+{
+	if(FORMAT_PNG == i_eFormat) return savePng(i_strPath, i_lWidth, i_lHeight, i_pbyPixel);
+	return savePpm(i_strPath, i_lWidth, i_lHeight, i_pbyPixel);
+}
+
+/******************************************
+ * PPM形式で保存する.
+ ******************************************/
+bool ImageWriter::savePpm(const std::string& i_strPath, long i_lWidth, long i_lHeight, const unsigned char* i_pbyPixel)
+{
+	FILE* a_pFile = fopen(i_strPath.c_str(), "wb");
+	if(0 == a_pFile) return false;
+
+	size_t a_lSize = static_cast<size_t>(i_lWidth) * i_lHeight * 3;
+	bool a_bRet = (0 < fprintf(a_pFile, "P6\n%ld %ld\n255\n", i_lWidth, i_lHeight))
+	           && (a_lSize == fwrite(i_pbyPixel, 1, a_lSize, a_pFile));
+	return (0 == fclose(a_pFile)) && a_bRet;
+}
+
+/******************************************
+ * 32ビット値を書き出す.(ビッグエンディアン).
+ ******************************************/
+static void putLong(std::vector<unsigned char>& o_vecData, unsigned long i_ulValue)
+{
+	o_vecData.push_back(static_cast<unsigned char>(i_ulValue >> 24));
+	o_vecData.push_back(static_cast<unsigned char>(i_ulValue >> 16));
+	o_vecData.push_back(static_cast<unsigned char>(i_ulValue >> 8));
+	o_vecData.push_back(static_cast<unsigned char>(i_ulValue));
+}
+
+/******************************************
+ * PNGのチャンクを書き出す.(長さ, 種類, データ, CRC).
+ ******************************************/
+static bool writeChunk(FILE* i_pFile, const char* i_pType, const unsigned char* i_pbyData, size_t i_lSize)
+{
+	std::vector<unsigned char> a_vecHeader;
+	putLong(a_vecHeader, i_lSize);
+	a_vecHeader.insert(a_vecHeader.end(), i_pType, i_pType + 4);
+
+	// CRCは種類とデータから計算する.
+	uLong a_ulCrc = crc32(0L, Z_NULL, 0);
+	a_ulCrc = crc32(a_ulCrc, reinterpret_cast<const Bytef*>(i_pType), 4);
+	if(0 < i_lSize) a_ulCrc = crc32(a_ulCrc, i_pbyData, i_lSize);
+	std::vector<unsigned char> a_vecCrc;
+	putLong(a_vecCrc, a_ulCrc);
+
+	return (a_vecHeader.size() == fwrite(&a_vecHeader[0], 1, a_vecHeader.size(), i_pFile))
+	    && ((0 == i_lSize) || (i_lSize == fwrite(i_pbyData, 1, i_lSize, i_pFile)))
+	    && (a_vecCrc.size() == fwrite(&a_vecCrc[0], 1, a_vecCrc.size(), i_pFile));
+}
+
+/******************************************
+ * PNG形式で保存する.
+ ******************************************/
+bool ImageWriter::savePng(const std::string& i_strPath, long i_lWidth, long i_lHeight, const unsigned char* i_pbyPixel)
+{
+	static const unsigned char a_rgbySignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	// IHDR: 横幅, 縦幅, ビット深度8, カラータイプ2(RGB), 圧縮0, フィルタ0, インターレースなし.
+	std::vector<unsigned char> a_vecHeader;
+	putLong(a_vecHeader, i_lWidth);
+	putLong(a_vecHeader, i_lHeight);
+	a_vecHeader.push_back(8);
+	a_vecHeader.push_back(2);
+	a_vecHeader.push_back(0);
+	a_vecHeader.push_back(0);
+	a_vecHeader.push_back(0);
+
+	// 各行の先頭にフィルタ種別(0:なし)を付けて圧縮する.
+	// ライフゲームの画像は同じ色が続くため, フィルタなしでも十分に縮む.
+	size_t a_lLineSize = static_cast<size_t>(i_lWidth) * 3;
+	std::vector<unsigned char> a_vecRaw((a_lLineSize + 1) * i_lHeight);
+	for(long a_lRow=0; a_lRow<i_lHeight; a_lRow++)
+	{
+		unsigned char* a_pbyLine = &a_vecRaw[(a_lLineSize + 1) * a_lRow];
+		a_pbyLine[0] = 0;
+		std::copy(i_pbyPixel + a_lLineSize * a_lRow, i_pbyPixel + a_lLineSize * (a_lRow + 1), a_pbyLine + 1);
+	}
+	uLongf a_ulCompressedSize = compressBound(a_vecRaw.size());
+	std::vector<unsigned char> a_vecCompressed(a_ulCompressedSize);
+	if(Z_OK != compress2(&a_vecCompressed[0], &a_ulCompressedSize, &a_vecRaw[0], a_vecRaw.size(), 1)) return false;
+
+	FILE* a_pFile = fopen(i_strPath.c_str(), "wb");
+	if(0 == a_pFile) return false;
+	bool a_bRet = (sizeof(a_rgbySignature) == fwrite(a_rgbySignature, 1, sizeof(a_rgbySignature), a_pFile))
+	           && writeChunk(a_pFile, "IHDR", &a_vecHeader[0], a_vecHeader.size())
+	           && writeChunk(a_pFile, "IDAT", &a_vecCompressed[0], a_ulCompressedSize)
+	           && writeChunk(a_pFile, "IEND", 0, 0);
+	return (0 == fclose(a_pFile)) && a_bRet;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file    ImageWriter.h
+ * @brief   RGB画像をPPM/PNG形式で保存するクラスの宣言.
+ */
+#ifndef __IMAGE_WRITER_H__
+#define __IMAGE_WRITER_H__
+
+#include <string>
+
+/**
+ * @brief   RGB画像をPPM/PNG形式で保存するクラス.
+ * @note    画素は1ピクセル3バイト(R,G,B)を左上から並べたもの.
+ * @note    PNGの圧縮にはzlibを使う.(速度を優先して圧縮レベルは低くする).
+ */
+class ImageWriter
+{
+public:
+	/**
+	 * @brief	画像の形式.
+	 */
+	enum FORMAT {
+		FORMAT_PPM,		// バイナリPPM(P6).
+		FORMAT_PNG,		// 8ビットRGBのPNG.
+	};
+
+    /**
+     * @brief   ファイル名の拡張子から形式を決める.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @return  ".png"(大文字小文字を区別しない)ならばFORMAT_PNG, それ以外はFORMAT_PPM.
+     */
+    static FORMAT getFormat(const std::string& i_strPath);
+
+    /**
+     * @brief   画像を保存する.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   FORMAT i_eFormat 形式.
+     * @param   long i_lWidth 横幅.(ピクセル).
+     * @param   long i_lHeight 縦幅.(ピクセル).
+     * @param   const unsigned char* i_pbyPixel 画素.(RGB x 横幅 x 縦幅).
+     * @return  成功/失敗.
+     */
+    static bool save(const std::string& i_strPath, FORMAT i_eFormat, long i_lWidth, long i_lHeight, const unsigned char* i_pbyPixel);
+
+    /**
+     * @brief   PPM形式で保存する.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   long i_lWidth 横幅.(ピクセル).
+     * @param   long i_lHeight 縦幅.(ピクセル).
+     * @param   const unsigned char* i_pbyPixel 画素.(RGB x 横幅 x 縦幅).
+     * @return  成功/失敗.
+     */
+    static bool savePpm(const std::string& i_strPath, long i_lWidth, long i_lHeight, const unsigned char* i_pbyPixel);
+
+    /**
+     * @brief   PNG形式で保存する.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   long i_lWidth 横幅.(ピクセル).
+     * @param   long i_lHeight 縦幅.(ピクセル).
+     * @param   const unsigned char* i_pbyPixel 画素.(RGB x 横幅 x 縦幅).
+     * @return  成功/失敗.
+     */
+    static bool savePng(const std::string& i_strPath, long i_lWidth, long i_lHeight, const unsigned char* i_pbyPixel);
+};
+
+#endif  // __IMAGE_WRITER_H__
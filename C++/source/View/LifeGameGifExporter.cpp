@@ -0,0 +1,179 @@
+/**
+ * @file    LifeGameGifExporter.cpp
+ * @brief   ライフゲームをアニメーションGIFへ書き出すクラスの実装.
+ */
+
+#include "LifeGameGifExporter.h"
+#include "../Lib/Tracer.h"
+
+#include <algorithm>
+
+// カラーテーブル.(0:DEAD 1:ALIVE 2,3:未使用).
+const unsigned char LifeGameGifExporter::m_rgbyPalette[GifEncoder::COLOR_NUM * 3] =
+{
+	0x00, 0x00, 0x00,
+	0xFF, 0xFF, 0xFF,
+	0x80, 0x80, 0x80,
+	0xFF, 0x00, 0x00,
+};
+
+/***************************
+ * 書き出しを開始する.
+ ***************************/
+bool LifeGameGifExporter::open(const std::string& i_strPath, long i_lColMax, long i_lRowMax, int i_iScale, int i_iDelay)
+{
+	this->close();
+
+	this->m_lColMax = i_lColMax;
+	this->m_lRowMax = i_lRowMax;
+	this->m_iScale = (0<i_iScale)? i_iScale : 1;
+	this->m_iDelay = i_iDelay;
+	this->m_lFrameNum = 0;
+	this->m_vecFrameBuffer.assign(i_lColMax * i_lRowMax, 0);
+
+	if(!this->m_cEncoder.open(i_strPath, i_lColMax * this->m_iScale, i_lRowMax * this->m_iScale, m_rgbyPalette)) return false;
+
+	// 最初のフレームは全体.
+	this->m_lDirtyLeft = 0;
+	this->m_lDirtyTop = 0;
+	this->m_lDirtyRight = i_lColMax - 1;
+	this->m_lDirtyBottom = i_lRowMax - 1;
+
+	this->m_bIsClosing = false;
+	this->m_bIsOpen = true;
+	this->m_cThread = std::thread(&LifeGameGifExporter::encodeThread, this);
+	return true;
+}
+
+/***************************
+ * 書き出しを終了する.
+ ***************************/
+void LifeGameGifExporter::close()
+{
+	if(!this->m_bIsOpen) return;
+
+	{
+		std::lock_guard<std::mutex> a_cLock(this->m_cMutex);
+		this->m_bIsClosing = true;
+	}
+	this->m_cNotEmpty.notify_one();
+	this->m_cThread.join();
+
+	this->m_cEncoder.close();
+	this->m_bIsOpen = false;
+}
+
+/***************************
+ * フレームバッファにセルの状態を描画.
+ ***************************/
+bool LifeGameGifExporter::draw(int i_iCol, int i_iRow, CellAttribute::CELL_STATE i_eState)
+{
+	unsigned char& a_rbyPixel = this->m_vecFrameBuffer[i_iRow * this->m_lColMax + i_iCol];
+	unsigned char a_byColor = static_cast<unsigned char>(i_eState);
+	if(a_rbyPixel == a_byColor) return true;
+	a_rbyPixel = a_byColor;
+
+	// 変化した矩形を広げる.
+	if(i_iCol < this->m_lDirtyLeft)   this->m_lDirtyLeft = i_iCol;
+	if(i_iCol > this->m_lDirtyRight)  this->m_lDirtyRight = i_iCol;
+	if(i_iRow < this->m_lDirtyTop)    this->m_lDirtyTop = i_iRow;
+	if(i_iRow > this->m_lDirtyBottom) this->m_lDirtyBottom = i_iRow;
+	return true;
+}
+
+/***************************
+ * フレームバッファへ全セルの状態を描画.
+ ***************************/
+void LifeGameGifExporter::drawBoard(const BitBoard& i_cBoard)
+{
+	for(long a_lRow=0; a_lRow<this->m_lRowMax; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<this->m_lColMax; a_lCol++)
+		{
+			this->draw(a_lCol, a_lRow, i_cBoard.getBit(a_lCol, a_lRow)? CellAttribute::ALIVE : CellAttribute::DEAD);
+		}
+	}
+}
+
+/***************************
+ * 前フレームから変化した矩形を1フレームとして書き出す.
+ ***************************/
+void LifeGameGifExporter::writeFrame()
+{
+	if(!this->m_bIsOpen) return;
+	TRACE_SCOPE_VALUE("render", "gif frame", this->m_lFrameNum);
+
+	// 変化が無い場合は, 左上の1セルだけのフレームとする.
+	if(this->m_lDirtyRight < this->m_lDirtyLeft)
+	{
+		this->m_lDirtyLeft = this->m_lDirtyRight = 0;
+		this->m_lDirtyTop = this->m_lDirtyBottom = 0;
+	}
+
+	// 変化した矩形をフレームバッファから切り出す.
+	FRAME* a_pstFrame = new FRAME;
+	a_pstFrame->m_lLeft = this->m_lDirtyLeft;
+	a_pstFrame->m_lTop = this->m_lDirtyTop;
+	a_pstFrame->m_lWidth = this->m_lDirtyRight - this->m_lDirtyLeft + 1;
+	a_pstFrame->m_lHeight = this->m_lDirtyBottom - this->m_lDirtyTop + 1;
+	a_pstFrame->m_vecPixel.resize(a_pstFrame->m_lWidth * a_pstFrame->m_lHeight);
+	for(long a_lRow=0; a_lRow<a_pstFrame->m_lHeight; a_lRow++)
+	{
+		const unsigned char* a_pbySrc = &this->m_vecFrameBuffer[(a_pstFrame->m_lTop + a_lRow) * this->m_lColMax + a_pstFrame->m_lLeft];
+		std::copy(a_pbySrc, a_pbySrc + a_pstFrame->m_lWidth, a_pstFrame->m_vecPixel.begin() + a_lRow * a_pstFrame->m_lWidth);
+	}
+	this->clearDirty();
+
+	// 書き出しスレッドへ渡す.(キューが満杯の間は待つ).
+	{
+		TRACE_SCOPE("render", "gif queue wait");
+		std::unique_lock<std::mutex> a_cLock(this->m_cMutex);
+		while(static_cast<size_t>(QUEUE_MAX) <= this->m_deqFrame.size()) this->m_cNotFull.wait(a_cLock);
+		this->m_deqFrame.push_back(a_pstFrame);
+	}
+	this->m_cNotEmpty.notify_one();
+	this->m_lFrameNum++;
+}
+
+/***************************
+ * 書き出しスレッド.
+ ***************************/
+void LifeGameGifExporter::encodeThread()
+{
+	TRACE_THREAD_NAME("gif encoder");
+	std::vector<unsigned char> a_vecScaled;
+
+	for(;;)
+	{
+		FRAME* a_pstFrame = 0;
+		{
+			std::unique_lock<std::mutex> a_cLock(this->m_cMutex);
+			while(this->m_deqFrame.empty() && !this->m_bIsClosing) this->m_cNotEmpty.wait(a_cLock);
+			if(this->m_deqFrame.empty()) break;		// 終了要求かつキューが空.
+			a_pstFrame = this->m_deqFrame.front();
+			this->m_deqFrame.pop_front();
+		}
+		this->m_cNotFull.notify_one();
+
+		// 拡大して符号化する.
+		TRACE_SCOPE("io", "gif encode");
+		const unsigned char* a_pbyPixel = &a_pstFrame->m_vecPixel[0];
+		long a_lWidth = a_pstFrame->m_lWidth * this->m_iScale;
+		long a_lHeight = a_pstFrame->m_lHeight * this->m_iScale;
+		if(1 < this->m_iScale)
+		{
+			a_vecScaled.resize(a_lWidth * a_lHeight);
+			for(long a_lRow=0; a_lRow<a_lHeight; a_lRow++)
+			{
+				const unsigned char* a_pbySrc = a_pbyPixel + (a_lRow / this->m_iScale) * a_pstFrame->m_lWidth;
+				unsigned char* a_pbyDst = &a_vecScaled[a_lRow * a_lWidth];
+				for(long a_lCol=0; a_lCol<a_lWidth; a_lCol++) a_pbyDst[a_lCol] = a_pbySrc[a_lCol / this->m_iScale];
+			}
+			a_pbyPixel = &a_vecScaled[0];
+		}
+		this->m_cEncoder.writeFrame(a_pstFrame->m_lLeft * this->m_iScale, a_pstFrame->m_lTop * this->m_iScale,
+			a_lWidth, a_lHeight, a_pbyPixel, this->m_iDelay);
+
+		delete a_pstFrame;
+	}
+}
@@ -0,0 +1,241 @@
+/**
+ * @file    LifeGameGifExporter.h
+ * @brief   ライフゲームをアニメーションGIFへ書き出すクラスの宣言.
+ */
+#ifndef __LIFEGAME_GIF_EXPORTER_H__
+#define __LIFEGAME_GIF_EXPORTER_H__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../Lib/Observer.h"
+#include "../Lib/CellAttribute.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "../Model/BitBoard.h"
+#include "GifEncoder.h"
+
+/**
+ * @brief   ライフゲームをアニメーションGIFへ書き出すクラス.
+ * @note    端末を使わずに表示(View)の代わりとしてMatrixCellへ登録する.
+ * @note    通知されたセルをカラーテーブル番号のフレームバッファへ描画し,
+ *          writeFrame()で前フレームから変化した矩形だけを切り出してフレームとする.
+ * @note    LZW符号化とファイルへの書き出しは別スレッドで行う.
+ */
+class LifeGameGifExporter : public Observer<MatrixCellAttribute>
+{
+public:
+    /**
+     * @brief   コンストラクタ.
+     */
+    LifeGameGifExporter()
+	{
+		this->m_lColMax = 0;
+		this->m_lRowMax = 0;
+		this->m_iScale = 1;
+		this->m_iDelay = 10;
+		this->m_lFrameNum = 0;
+		this->m_bIsOpen = false;
+		this->m_bIsClosing = false;
+		this->clearDirty();
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~LifeGameGifExporter()
+	{
+		this->close();
+	}
+
+    /**
+     * @brief   書き出しを開始する.
+     * @param   const std::string& i_strPath ファイルパス.
+     * @param   long i_lColMax セルの横最大幅.
+     * @param   long i_lRowMax セルの縦最大幅.
+     * @param   int i_iScale 1セルあたりのピクセル数(縦横).
+     * @param   int i_iDelay 1フレームの表示時間.(1/100秒単位).
+     * @return  成功/失敗.
+     */
+    bool open(const std::string& i_strPath, long i_lColMax, long i_lRowMax, int i_iScale=1, int i_iDelay=10);
+
+    /**
+     * @brief   書き出しを終了する.
+     * @param   なし.
+     * @return  なし.
+     * @note    キューに残っているフレームを全て書き出してから終了する.
+     */
+    void close();
+
+    /**
+     * @brief   書き出し中か否か.
+     */
+    bool isOpen() const { return this->m_bIsOpen; }
+
+    /**
+     * @brief   フレームバッファにセルの状態を描画.
+     * @param   int i_iCol セルの横位置.
+     * @param   int i_iRow セルの縦位置.
+     * @param   CellAttribute::CELL_STATE i_eState セルの状態.
+     * @return  成功/失敗.
+     */
+    bool draw(int i_iCol, int i_iRow, CellAttribute::CELL_STATE i_eState);
+
+    /**
+     * @brief   フレームバッファへ全セルの状態を描画.
+     * @param   const BitBoard& i_cBoard 全セルの状態.
+     * @return  なし.
+     */
+    void drawBoard(const BitBoard& i_cBoard);
+
+    /**
+     * @brief   前フレームから変化した矩形を1フレームとして書き出す.
+     * @param   なし.
+     * @return  なし.
+     * @note    書き出しスレッドが遅れている場合は, キューに空きができるまで待つ.
+     */
+    void writeFrame();
+
+    /**
+     * @brief   書き出したフレーム数を取得.
+     */
+    long getFrameNum() const { return this->m_lFrameNum; }
+
+	/**
+	 * @brief	Subjectから通知を受信.
+	 * @param	const MatrixCellAttribute* i_pcAttribute MatrixCellの属性.
+	 * @return	成功/失敗.
+	 */
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+		{
+			this->draw(i_lCol, i_lRow, i_eState);
+		});
+		return true;
+	}
+
+private:
+    /**
+     * @brief   キューに溜めるフレームの最大数.
+     */
+    enum { QUEUE_MAX = 64 };
+
+    /**
+     * @brief   1フレーム.(フレームバッファから切り出した矩形).
+     */
+    struct FRAME
+    {
+        long m_lLeft;
+        long m_lTop;
+        long m_lWidth;
+        long m_lHeight;
+        std::vector<unsigned char> m_vecPixel;
+    };
+
+    /**
+     * @brief   カラーテーブル.
+     */
+    static const unsigned char m_rgbyPalette[GifEncoder::COLOR_NUM * 3];
+
+    /**
+     * @brief   セルの横最大幅.
+     */
+    long m_lColMax;
+
+    /**
+     * @brief   セルの縦最大幅.
+     */
+    long m_lRowMax;
+
+    /**
+     * @brief   1セルあたりのピクセル数.
+     */
+    int m_iScale;
+
+    /**
+     * @brief   1フレームの表示時間.
+     */
+    int m_iDelay;
+
+    /**
+     * @brief   書き出したフレーム数.
+     */
+    long m_lFrameNum;
+
+    /**
+     * @brief   書き出し中か否か.
+     */
+    bool m_bIsOpen;
+
+    /**
+     * @brief   フレームバッファ.(1セル1バイト. カラーテーブルの番号).
+     */
+    std::vector<unsigned char> m_vecFrameBuffer;
+
+    /**
+     * @brief   前フレームから変化した矩形.(右端, 下端を含む).
+     */
+    long m_lDirtyLeft;
+    long m_lDirtyTop;
+    long m_lDirtyRight;
+    long m_lDirtyBottom;
+
+    /**
+     * @brief   GIFの書き出し.(書き出しスレッドのみが使う).
+     */
+    GifEncoder m_cEncoder;
+
+    /**
+     * @brief   書き出し待ちのフレーム.
+     */
+    std::deque<FRAME*> m_deqFrame;
+
+    /**
+     * @brief   キューの排他.
+     */
+    std::mutex m_cMutex;
+
+    /**
+     * @brief   キューにフレームが追加された事の通知.
+     */
+    std::condition_variable m_cNotEmpty;
+
+    /**
+     * @brief   キューに空きができた事の通知.
+     */
+    std::condition_variable m_cNotFull;
+
+    /**
+     * @brief   終了要求.
+     */
+    bool m_bIsClosing;
+
+    /**
+     * @brief   書き出しスレッド.
+     */
+    std::thread m_cThread;
+
+    /**
+     * @brief   変化した矩形を空にする.
+     */
+    void clearDirty()
+	{
+		this->m_lDirtyLeft = this->m_lColMax;
+		this->m_lDirtyTop = this->m_lRowMax;
+		this->m_lDirtyRight = -1;
+		this->m_lDirtyBottom = -1;
+	}
+
+    /**
+     * @brief   書き出しスレッド.
+     * @param   なし.
+     * @return  なし.
+     */
+    void encodeThread();
+};
+
+#endif  // __LIFEGAME_GIF_EXPORTER_H__
@@ -0,0 +1,325 @@
+/**
+ * @file    LifeGameImageExporter.cpp
+ * @brief   ライフゲームの世代を画像(PPM/PNG)へ書き出すクラスの実装.
+ */
+
+#include "LifeGameImageExporter.h"
+#include "../Lib/ParallelFor.h"
+#include "../Lib/Tracer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+	/**
+	 * @brief   ファイルパスの書式を世代(long)を1つ埋め込む形に揃える.
+	 * @param   const std::string& i_strPath ファイルパス.
+	 * @param   std::string& o_strPattern 書式.
+	 * @return  成功/失敗.('%'が2つ以上ある, または%d/%ld以外の場合は失敗).
+	 */
+	bool makePathPattern(const std::string& i_strPath, std::string& o_strPattern)
+	{
+		std::string::size_type a_lPercent = i_strPath.find('%');
+		if(std::string::npos == a_lPercent)
+		{
+			// 拡張子の前に世代を入れる.
+			std::string::size_type a_lSlash = i_strPath.rfind('/');
+			std::string::size_type a_lDot = i_strPath.rfind('.');
+			if(std::string::npos == a_lDot || (std::string::npos != a_lSlash && a_lDot < a_lSlash)) a_lDot = i_strPath.size();
+			o_strPattern = i_strPath.substr(0, a_lDot) + "%06ld" + i_strPath.substr(a_lDot);
+			return true;
+		}
+		if(std::string::npos != i_strPath.find('%', a_lPercent + 1)) return false;
+
+		// 幅の指定の後ろは"d"または"ld".
+		std::string::size_type a_lWidthEnd = i_strPath.find_first_not_of("0123456789", a_lPercent + 1);
+		std::string::size_type a_lPos = a_lWidthEnd;
+		if(a_lPos < i_strPath.size() && 'l' == i_strPath[a_lPos]) a_lPos++;
+		if(i_strPath.size() <= a_lPos || 'd' != i_strPath[a_lPos]) return false;
+
+		o_strPattern = i_strPath.substr(0, a_lWidthEnd) + "ld" + i_strPath.substr(a_lPos + 1);
+		return true;
+	}
+
+	/**
+	 * @brief   2色の間を線形補間する.
+	 */
+	uint32_t mixColor(uint32_t i_uFrom, uint32_t i_uTo, long i_lNum, long i_lDenom)
+	{
+		uint32_t a_uColor = 0;
+		for(int a_iShift=0; a_iShift<24; a_iShift+=8)
+		{
+			long a_lFrom = (i_uFrom >> a_iShift) & 0xFF;
+			long a_lTo = (i_uTo >> a_iShift) & 0xFF;
+			a_uColor |= static_cast<uint32_t>(a_lFrom + (a_lTo - a_lFrom) * i_lNum / i_lDenom) << a_iShift;
+		}
+		return a_uColor;
+	}
+}
+
+/***************************
+ * セルの色を取得.
+ ***************************/
+uint32_t LifeGameImageExporter::getColor(COLOR_MODE i_eColorMode, bool i_bIsAlive, long i_lElapsed)
+{
+	if(i_lElapsed < 0) i_lElapsed = 0;
+
+	switch(i_eColorMode)
+	{
+	case COLOR_AGE:
+		if(!i_bIsAlive) return 0x000000;
+		{
+			// 生まれたて:白 → 黄 → 橙 → 赤 → 紫 → 青(長く生きている固定物体).
+			static const long s_rglAge[] = { 0, 1, 4, 16, 64, AGE_MAX };
+			static const uint32_t s_rguColor[] = { 0xFFFFFF, 0xFFFF00, 0xFF8000, 0xFF0000, 0xC000C0, 0x4040FF };
+			if(AGE_MAX <= i_lElapsed) return s_rguColor[5];
+			int a_iIndex = 0;
+			while(s_rglAge[a_iIndex + 1] <= i_lElapsed) a_iIndex++;
+			return mixColor(s_rguColor[a_iIndex], s_rguColor[a_iIndex + 1],
+				i_lElapsed - s_rglAge[a_iIndex], s_rglAge[a_iIndex + 1] - s_rglAge[a_iIndex]);
+		}
+	case COLOR_HEAT:
+		if(i_bIsAlive) return 0xFFFFFF;
+		// 死んだ直後:赤 → 黒.
+		if(HEAT_MAX <= i_lElapsed) return 0x000000;
+		return mixColor(0xFF0000, 0x000000, i_lElapsed, HEAT_MAX);
+	case COLOR_MONO:
+	default:
+		return i_bIsAlive? 0xFFFFFF : 0x000000;
+	}
+}
+
+/***************************
+ * 書き出しを開始する.
+ ***************************/
+bool LifeGameImageExporter::open(const std::string& i_strPath, long i_lColMax, long i_lRowMax, int i_iScale, COLOR_MODE i_eColorMode, int i_iThreadNum)
+{
+	this->close();
+
+	if(!makePathPattern(i_strPath, this->m_strPath)) return false;
+	this->m_eFormat = ImageWriter::getFormat(i_strPath);
+	this->m_lColMax = i_lColMax;
+	this->m_lRowMax = i_lRowMax;
+	this->m_iScale = (0<i_iScale)? i_iScale : 1;
+	this->m_eColorMode = i_eColorMode;
+	this->m_iThreadNum = (0<i_iThreadNum)? i_iThreadNum : 1;
+	this->m_lGeneration = 0;
+	this->m_lFrameNum = 0;
+	this->m_bIsError = false;
+	this->m_cBoard.init(i_lColMax, i_lRowMax);
+
+	// 最後に変化した世代は, 色が付かないだけ昔とする.
+	if(COLOR_MONO == i_eColorMode)
+	{
+		std::vector<int32_t>().swap(this->m_vecChangedGeneration);
+	}
+	else
+	{
+		this->m_vecChangedGeneration.assign(i_lColMax * i_lRowMax, -(AGE_MAX + HEAT_MAX));
+	}
+
+	// 色の表.
+	long a_rglColorNum[CellAttribute::CELL_STATE_MAX] = { 1, 1 };
+	if(COLOR_AGE == i_eColorMode)  a_rglColorNum[CellAttribute::ALIVE] = AGE_MAX + 1;
+	if(COLOR_HEAT == i_eColorMode) a_rglColorNum[CellAttribute::DEAD] = HEAT_MAX + 1;
+	for(int a_iState=0; a_iState<CellAttribute::CELL_STATE_MAX; a_iState++)
+	{
+		this->m_vecColor[a_iState].resize(a_rglColorNum[a_iState]);
+		for(long a_lElapsed=0; a_lElapsed<a_rglColorNum[a_iState]; a_lElapsed++)
+		{
+			this->m_vecColor[a_iState][a_lElapsed] = getColor(i_eColorMode, CellAttribute::ALIVE == a_iState, a_lElapsed);
+		}
+	}
+
+	// フレームバッファは使い回す.
+	for(int a_iIndex=0; a_iIndex<FRAME_BUFFER_NUM; a_iIndex++)
+	{
+		FRAME* a_pstFrame = new FRAME;
+		a_pstFrame->m_vecPixel.resize(i_lColMax * this->m_iScale * i_lRowMax * this->m_iScale * 3);
+		this->m_vecFreeFrame.push_back(a_pstFrame);
+	}
+
+	this->m_bIsClosing = false;
+	this->m_bIsOpen = true;
+	this->m_cThread = std::thread(&LifeGameImageExporter::writeThread, this);
+	return true;
+}
+
+/***************************
+ * 書き出しを終了する.
+ ***************************/
+bool LifeGameImageExporter::close()
+{
+	if(!this->m_bIsOpen) return !this->m_bIsError;
+
+	{
+		std::lock_guard<std::mutex> a_cLock(this->m_cMutex);
+		this->m_bIsClosing = true;
+	}
+	this->m_cNotEmpty.notify_one();
+	this->m_cThread.join();
+
+	for(size_t a_lIndex=0; a_lIndex<this->m_vecFreeFrame.size(); a_lIndex++)
+	{
+		delete this->m_vecFreeFrame[a_lIndex];
+	}
+	this->m_vecFreeFrame.clear();
+	this->m_bIsOpen = false;
+	return !this->m_bIsError;
+}
+
+/***************************
+ * セルの状態を描画.
+ ***************************/
+bool LifeGameImageExporter::draw(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+{
+	if(i_lCol < 0 || this->m_lColMax <= i_lCol || i_lRow < 0 || this->m_lRowMax <= i_lRow) return false;
+
+	bool a_bIsAlive = (CellAttribute::ALIVE == i_eState);
+	if(this->m_cBoard.getBit(i_lCol, i_lRow) == a_bIsAlive) return true;
+	this->m_cBoard.setBit(i_lCol, i_lRow, a_bIsAlive);
+	if(!this->m_vecChangedGeneration.empty())
+	{
+		this->m_vecChangedGeneration[i_lRow * this->m_lColMax + i_lCol] = static_cast<int32_t>(this->m_lGeneration);
+	}
+	return true;
+}
+
+/***************************
+ * 全セルの状態を描画.
+ ***************************/
+void LifeGameImageExporter::drawBoard(const BitBoard& i_cBoard)
+{
+	for(long a_lRow=0; a_lRow<this->m_lRowMax; a_lRow++)
+	{
+		const BitBoard::WORD* a_pSrc = i_cBoard.getRow(a_lRow);
+		BitBoard::WORD* a_pDst = this->m_cBoard.getRow(a_lRow);
+		for(long a_lWord=0; a_lWord<this->m_cBoard.getWordNum(); a_lWord++)
+		{
+			BitBoard::WORD a_wChanged = a_pSrc[a_lWord] ^ a_pDst[a_lWord];
+			a_pDst[a_lWord] = a_pSrc[a_lWord];
+			if(this->m_vecChangedGeneration.empty()) continue;
+			for(; 0 != a_wChanged; a_wChanged &= a_wChanged - 1)
+			{
+				long a_lCol = a_lWord * BitBoard::WORD_BIT + __builtin_ctzll(a_wChanged);
+				this->m_vecChangedGeneration[a_lRow * this->m_lColMax + a_lCol] = static_cast<int32_t>(this->m_lGeneration);
+			}
+		}
+	}
+}
+
+/***************************
+ * フレームバッファの行を描画する.
+ ***************************/
+void LifeGameImageExporter::renderRows(unsigned char* o_pbyPixel, long i_lBegin, long i_lEnd) const
+{
+	long a_lWidth = this->m_lColMax * this->m_iScale;
+	long a_lLineSize = a_lWidth * 3;
+	const uint32_t* a_rgpuColor[CellAttribute::CELL_STATE_MAX] = { &this->m_vecColor[CellAttribute::DEAD][0], &this->m_vecColor[CellAttribute::ALIVE][0] };
+	long a_rglColorMax[CellAttribute::CELL_STATE_MAX] = {
+		static_cast<long>(this->m_vecColor[CellAttribute::DEAD].size()) - 1,
+		static_cast<long>(this->m_vecColor[CellAttribute::ALIVE].size()) - 1 };
+
+	for(long a_lRow=i_lBegin; a_lRow<i_lEnd; a_lRow++)
+	{
+		unsigned char* a_pbyLine = o_pbyPixel + a_lRow * this->m_iScale * a_lLineSize;
+		const BitBoard::WORD* a_pWord = this->m_cBoard.getRow(a_lRow);
+		const int32_t* a_piChanged = this->m_vecChangedGeneration.empty()? 0 : &this->m_vecChangedGeneration[a_lRow * this->m_lColMax];
+
+		// 1行目を描画し, 残りの行は複写する.
+		unsigned char* a_pbyDst = a_pbyLine;
+		for(long a_lCol=0; a_lCol<this->m_lColMax; a_lCol++)
+		{
+			int a_iState = static_cast<int>((a_pWord[a_lCol / BitBoard::WORD_BIT] >> (a_lCol % BitBoard::WORD_BIT)) & 1);
+			long a_lElapsed = (0 == a_piChanged)? 0 : this->m_lGeneration - a_piChanged[a_lCol];
+			if(a_lElapsed > a_rglColorMax[a_iState]) a_lElapsed = a_rglColorMax[a_iState];
+			uint32_t a_uColor = a_rgpuColor[a_iState][a_lElapsed];
+			for(int a_iPixel=0; a_iPixel<this->m_iScale; a_iPixel++)
+			{
+				*a_pbyDst++ = static_cast<unsigned char>(a_uColor >> 16);
+				*a_pbyDst++ = static_cast<unsigned char>(a_uColor >> 8);
+				*a_pbyDst++ = static_cast<unsigned char>(a_uColor);
+			}
+		}
+		for(int a_iLine=1; a_iLine<this->m_iScale; a_iLine++)
+		{
+			memcpy(a_pbyLine + a_iLine * a_lLineSize, a_pbyLine, a_lLineSize);
+		}
+	}
+}
+
+/***************************
+ * 現在の世代を1枚の画像として書き出す.
+ ***************************/
+void LifeGameImageExporter::writeFrame()
+{
+	if(!this->m_bIsOpen) return;
+	TRACE_SCOPE_VALUE("render", "image frame", this->m_lGeneration);
+
+	// 空いているフレームバッファを取る.(書き出しが遅れている場合は待つ).
+	FRAME* a_pstFrame = 0;
+	{
+		TRACE_SCOPE("render", "image buffer wait");
+		std::unique_lock<std::mutex> a_cLock(this->m_cMutex);
+		while(this->m_vecFreeFrame.empty()) this->m_cFree.wait(a_cLock);
+		a_pstFrame = this->m_vecFreeFrame.back();
+		this->m_vecFreeFrame.pop_back();
+	}
+
+	// 行の帯に分けて描画する.
+	unsigned char* a_pbyPixel = &a_pstFrame->m_vecPixel[0];
+	parallelFor(0, this->m_lRowMax, this->m_iThreadNum, [this, a_pbyPixel](long i_lBegin, long i_lEnd)
+	{
+		TRACE_SCOPE_VALUE("band", "render rows", i_lBegin);
+		this->renderRows(a_pbyPixel, i_lBegin, i_lEnd);
+	});
+
+	char a_szPath[4096];
+	snprintf(a_szPath, sizeof(a_szPath), this->m_strPath.c_str(), this->m_lGeneration);
+	a_pstFrame->m_strPath = a_szPath;
+
+	// 書き出しスレッドへ渡す.
+	{
+		std::lock_guard<std::mutex> a_cLock(this->m_cMutex);
+		this->m_deqFrame.push_back(a_pstFrame);
+	}
+	this->m_cNotEmpty.notify_one();
+	this->m_lFrameNum++;
+}
+
+/***************************
+ * 書き出しスレッド.
+ ***************************/
+void LifeGameImageExporter::writeThread()
+{
+	TRACE_THREAD_NAME("image writer");
+	long a_lWidth = this->m_lColMax * this->m_iScale;
+	long a_lHeight = this->m_lRowMax * this->m_iScale;
+
+	for(;;)
+	{
+		FRAME* a_pstFrame = 0;
+		{
+			std::unique_lock<std::mutex> a_cLock(this->m_cMutex);
+			while(this->m_deqFrame.empty() && !this->m_bIsClosing) this->m_cNotEmpty.wait(a_cLock);
+			if(this->m_deqFrame.empty()) break;		// 終了要求かつキューが空.
+			a_pstFrame = this->m_deqFrame.front();
+			this->m_deqFrame.pop_front();
+		}
+
+		TRACE_SCOPE("io", "image write");
+		if(!ImageWriter::save(a_pstFrame->m_strPath, this->m_eFormat, a_lWidth, a_lHeight, &a_pstFrame->m_vecPixel[0]))
+		{
+			this->m_bIsError = true;
+		}
+
+		// フレームバッファを返す.
+		{
+			std::lock_guard<std::mutex> a_cLock(this->m_cMutex);
+			this->m_vecFreeFrame.push_back(a_pstFrame);
+		}
+		this->m_cFree.notify_one();
+	}
+}
@@ -0,0 +1,304 @@
+/**
+ * @file    LifeGameImageExporter.h
+ * @brief   ライフゲームの世代を画像(PPM/PNG)へ書き出すクラスの宣言.
+ */
+#ifndef __LIFEGAME_IMAGE_EXPORTER_H__
+#define __LIFEGAME_IMAGE_EXPORTER_H__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+#include "../Lib/Observer.h"
+#include "../Lib/CellAttribute.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "../Model/BitBoard.h"
+#include "ImageWriter.h"
+
+/**
+ * @brief   ライフゲームの世代を画像(PPM/PNG)へ書き出すクラス.
+ * @note    端末を使わずに表示(View)の代わりとしてMatrixCellへ登録する.
+ * @note    通知されたセルを盤面の写しへ反映し, writeFrame()で拡大したRGBのフレームバッファを
+ *          行の帯に分けて複数スレッドで描画する.
+ * @note    画像の符号化とファイルへの書き出しは別スレッドで行う.(フレームバッファは使い回す).
+ * @note    年齢/熱の色付けでは, セルが最後に変化した世代を覚えておく.
+ *              ・COLOR_AGE   生きているセルを生まれてからの世代数で色付けする.
+ *              ・COLOR_HEAT  死んだセルを死んでからの世代数で赤から黒へ色付けする.(動いた跡が残る).
+ */
+class LifeGameImageExporter : public Observer<MatrixCellAttribute>
+{
+public:
+	/**
+	 * @brief	色付けの方法.
+	 */
+	enum COLOR_MODE {
+		COLOR_MONO,		// 生:白 死:黒.
+		COLOR_AGE,		// 生:年齢で黄→赤→青 死:黒.
+		COLOR_HEAT,		// 生:白 死:死んでからの世代数で赤→黒.
+	};
+
+	/**
+	 * @brief	色付けの世代数の上限.(これ以上は同じ色).
+	 */
+	enum { AGE_MAX = 255, HEAT_MAX = 32 };
+
+    /**
+     * @brief   コンストラクタ.
+     */
+    LifeGameImageExporter()
+	{
+		this->m_lColMax = 0;
+		this->m_lRowMax = 0;
+		this->m_iScale = 1;
+		this->m_eColorMode = COLOR_MONO;
+		this->m_iThreadNum = 1;
+		this->m_lGeneration = 0;
+		this->m_lFrameNum = 0;
+		this->m_bIsOpen = false;
+		this->m_bIsClosing = false;
+		this->m_bIsError = false;
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~LifeGameImageExporter()
+	{
+		this->close();
+	}
+
+    /**
+     * @brief   書き出しを開始する.
+     * @param   const std::string& i_strPath ファイルパス.(printf形式で世代を埋め込む. 例: "gen%06ld.png").
+     * @param   long i_lColMax セルの横最大幅.
+     * @param   long i_lRowMax セルの縦最大幅.
+     * @param   int i_iScale 1セルあたりのピクセル数(縦横).
+     * @param   COLOR_MODE i_eColorMode 色付けの方法.
+     * @param   int i_iThreadNum フレームバッファを描画するスレッド数.
+     * @return  成功/失敗.
+     * @note    ファイルパスに'%'が無ければ拡張子の前に"%06ld"を補う. 書式は%d/%ld(幅の指定は可)のみ.
+     * @note    形式はファイルパスの拡張子で決める.(.pngならばPNG, それ以外はPPM).
+     */
+    bool open(const std::string& i_strPath, long i_lColMax, long i_lRowMax, int i_iScale=1, COLOR_MODE i_eColorMode=COLOR_MONO, int i_iThreadNum=1);
+
+    /**
+     * @brief   書き出しを終了する.
+     * @param   なし.
+     * @return  書き出しに全て成功したか否か.
+     * @note    キューに残っているフレームを全て書き出してから終了する.
+     */
+    bool close();
+
+    /**
+     * @brief   書き出し中か否か.
+     */
+    bool isOpen() const { return this->m_bIsOpen; }
+
+    /**
+     * @brief   セルの状態を描画.
+     * @param   long i_lCol セルの横位置.
+     * @param   long i_lRow セルの縦位置.
+     * @param   CellAttribute::CELL_STATE i_eState セルの状態.
+     * @return  成功/失敗.
+     */
+    bool draw(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState);
+
+    /**
+     * @brief   全セルの状態を描画.
+     * @param   const BitBoard& i_cBoard 全セルの状態.
+     * @return  なし.
+     * @note    生きているセルは現在の世代に生まれたものとする.
+     */
+    void drawBoard(const BitBoard& i_cBoard);
+
+    /**
+     * @brief   世代を1つ進める.
+     * @param   なし.
+     * @return  なし.
+     * @note    MatrixCell::refreshCell()の前に呼ぶ.(通知されたセルは進めた後の世代に変化したものとする).
+     */
+    void nextGeneration() { this->m_lGeneration++; }
+
+    /**
+     * @brief   現在の世代.
+     */
+    long getGeneration() const { return this->m_lGeneration; }
+
+    /**
+     * @brief   現在の世代を1枚の画像として書き出す.
+     * @param   なし.
+     * @return  なし.
+     * @note    書き出しスレッドが遅れている場合は, フレームバッファが空くまで待つ.
+     */
+    void writeFrame();
+
+    /**
+     * @brief   書き出したフレーム数を取得.
+     */
+    long getFrameNum() const { return this->m_lFrameNum; }
+
+    /**
+     * @brief   セルの色を取得.
+     * @param   COLOR_MODE i_eColorMode 色付けの方法.
+     * @param   bool i_bIsAlive セルが生きているか否か.
+     * @param   long i_lElapsed セルが最後に変化してからの世代数.
+     * @return  色.(0xRRGGBB).
+     */
+    static uint32_t getColor(COLOR_MODE i_eColorMode, bool i_bIsAlive, long i_lElapsed);
+
+	/**
+	 * @brief	Subjectから通知を受信.
+	 * @param	const MatrixCellAttribute* i_pcAttribute MatrixCellの属性.
+	 * @return	成功/失敗.
+	 */
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+		{
+			this->draw(i_lCol, i_lRow, i_eState);
+		});
+		return true;
+	}
+
+private:
+    /**
+     * @brief   フレームバッファの数.(描画中の1枚と書き出し待ち).
+     */
+    enum { FRAME_BUFFER_NUM = 3 };
+
+    /**
+     * @brief   1フレーム.
+     */
+    struct FRAME
+    {
+        std::string m_strPath;
+        std::vector<unsigned char> m_vecPixel;
+    };
+
+    /**
+     * @brief   ファイルパス.(printf形式).
+     */
+    std::string m_strPath;
+
+    /**
+     * @brief   画像の形式.
+     */
+    ImageWriter::FORMAT m_eFormat;
+
+    /**
+     * @brief   セルの横最大幅.
+     */
+    long m_lColMax;
+
+    /**
+     * @brief   セルの縦最大幅.
+     */
+    long m_lRowMax;
+
+    /**
+     * @brief   1セルあたりのピクセル数.
+     */
+    int m_iScale;
+
+    /**
+     * @brief   色付けの方法.
+     */
+    COLOR_MODE m_eColorMode;
+
+    /**
+     * @brief   フレームバッファを描画するスレッド数.
+     */
+    int m_iThreadNum;
+
+    /**
+     * @brief   現在の世代.
+     */
+    long m_lGeneration;
+
+    /**
+     * @brief   書き出したフレーム数.
+     */
+    long m_lFrameNum;
+
+    /**
+     * @brief   書き出し中か否か.
+     */
+    bool m_bIsOpen;
+
+    /**
+     * @brief   全セルの状態.
+     */
+    BitBoard m_cBoard;
+
+    /**
+     * @brief   各セルが最後に変化した世代.(COLOR_MONOでは使わない).
+     */
+    std::vector<int32_t> m_vecChangedGeneration;
+
+    /**
+     * @brief   色の表.(生/死 x 経過世代数).
+     */
+    std::vector<uint32_t> m_vecColor[CellAttribute::CELL_STATE_MAX];
+
+    /**
+     * @brief   空いているフレームバッファ.
+     */
+    std::vector<FRAME*> m_vecFreeFrame;
+
+    /**
+     * @brief   書き出し待ちのフレーム.
+     */
+    std::deque<FRAME*> m_deqFrame;
+
+    /**
+     * @brief   キューの排他.
+     */
+    std::mutex m_cMutex;
+
+    /**
+     * @brief   キューにフレームが追加された事の通知.
+     */
+    std::condition_variable m_cNotEmpty;
+
+    /**
+     * @brief   フレームバッファが空いた事の通知.
+     */
+    std::condition_variable m_cFree;
+
+    /**
+     * @brief   終了要求.
+     */
+    bool m_bIsClosing;
+
+    /**
+     * @brief   書き出しに失敗したか否か.
+     */
+    bool m_bIsError;
+
+    /**
+     * @brief   書き出しスレッド.
+     */
+    std::thread m_cThread;
+
+    /**
+     * @brief   フレームバッファの行を描画する.
+     * @param   unsigned char* o_pbyPixel フレームバッファ.
+     * @param   long i_lBegin 開始行.(セルの座標).
+     * @param   long i_lEnd 終了行.(含まない).
+     * @return  なし.
+     */
+    void renderRows(unsigned char* o_pbyPixel, long i_lBegin, long i_lEnd) const;
+
+    /**
+     * @brief   書き出しスレッド.
+     * @param   なし.
+     * @return  なし.
+     */
+    void writeThread();
+};
+
+#endif  // __LIFEGAME_IMAGE_EXPORTER_H__
@@ -0,0 +1,334 @@
+/**
+ * @file    LifeGameView.cpp
+ * @brief   ライフゲームの表示を管理するクラスの実装.(端末の種類に依らない部分).
+ */
+
+#include "LifeGameView.h"
+
+// 表示する文字の定義.
+const wchar_t LifeGameView::m_pwDispCharacter[CellAttribute::CELL_STATE_MAX] = { L' ', L'*', };
+
+// 半ブロック表示の文字の定義.(空白, 上半分, 下半分, 全体).
+const wchar_t LifeGameView::m_pwHalfBlockCharacter[4] = { L' ', L'▀', L'▄', L'█', };
+
+// 点字の先頭の文字コード.
+#define BRAILLE_BASE	(0x2800)
+
+/******************************************
+ * 偶数番目のビットを下位へ詰める.(64ビット -> 32ビット).
+ ******************************************/
+static inline BitBoard::WORD compressEvenBits(BitBoard::WORD i_wBits)
+{
+	i_wBits &= 0x5555555555555555ULL;
+	i_wBits = (i_wBits | (i_wBits >> 1))  & 0x3333333333333333ULL;
+	i_wBits = (i_wBits | (i_wBits >> 2))  & 0x0F0F0F0F0F0F0F0FULL;
+	i_wBits = (i_wBits | (i_wBits >> 4))  & 0x00FF00FF00FF00FFULL;
+	i_wBits = (i_wBits | (i_wBits >> 8))  & 0x0000FFFF0000FFFFULL;
+	i_wBits = (i_wBits | (i_wBits >> 16)) & 0x00000000FFFFFFFFULL;
+	return i_wBits;
+}
+
+/***************************
+ * 盤面の大きさを設定する.
+ ***************************/
+void LifeGameView::init(long i_lColMax, long i_lRowMax)
+{
+	this->m_cBoard.init(i_lColMax, i_lRowMax);
+	this->m_lCursorCol = 0;
+	this->m_lCursorRow = 0;
+	this->m_lViewCol = 0;
+	this->m_lViewRow = 0;
+	this->m_eZoom = ZOOM_CELL;
+	this->m_bIsDirty = true;
+}
+
+/**********************************
+ * セルの状態を描画.
+ **********************************/
+bool LifeGameView::draw(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+{
+	if( (0>i_lCol) || (this->getColMax()<=i_lCol) || (0>i_lRow) || (this->getRowMax()<=i_lRow) ) return false;
+
+	this->m_cBoard.setBit(i_lCol, i_lRow, CellAttribute::ALIVE==i_eState);
+
+	// 見えている範囲が変わった場合だけ描き直す.
+	if( (this->m_lViewCol <= i_lCol) && (i_lCol < this->m_lViewCol + this->getScreenColMax() * this->getCellWidth())
+	 && (this->m_lViewRow <= i_lRow) && (i_lRow < this->m_lViewRow + this->getBoardScreenRowMax() * this->getCellHeight()) )
+	{
+		this->m_bIsDirty = true;
+	}
+    return true;
+}
+
+/**********************************
+ * 全セルの状態を描画.
+ **********************************/
+void LifeGameView::drawBoard(const BitBoard& i_cBoard)
+{
+	this->m_cBoard = i_cBoard;
+	this->m_bIsDirty = true;
+}
+
+/**********************************
+ * 矩形内のセルの状態を描画.
+ **********************************/
+void LifeGameView::drawRegion(const BitBoard& i_cBoard, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight)
+{
+	this->m_cBoard.copyRect(i_cBoard, i_lCol, i_lRow, i_lWidth, i_lHeight);
+	this->m_bIsDirty = true;
+}
+
+/**********************************
+ * 見えている範囲を取得.
+ **********************************/
+void LifeGameView::getViewRegion(long& o_lCol, long& o_lRow, long& o_lWidth, long& o_lHeight) const
+{
+	long a_lViewColMax = this->getScreenColMax() * this->getCellWidth();
+	long a_lViewRowMax = this->getBoardScreenRowMax() * this->getCellHeight();
+	o_lCol = this->m_lViewCol;
+	o_lRow = this->m_lViewRow;
+	o_lWidth = (a_lViewColMax < this->getColMax() - o_lCol)? a_lViewColMax : this->getColMax() - o_lCol;
+	o_lHeight = (a_lViewRowMax < this->getRowMax() - o_lRow)? a_lViewRowMax : this->getRowMax() - o_lRow;
+}
+
+/**********************************
+ * 画面の1行分の表示文字を作る.
+ **********************************/
+void LifeGameView::renderLine(long i_lScreenRow, wchar_t* o_pwLine) const
+{
+	long a_lScreenColMax = this->getScreenColMax();
+	long a_lRowMax = this->getRowMax();
+
+	if(i_lScreenRow >= this->getBoardScreenRowMax())
+	{
+		// ステータス行.
+		for(long a_lScreenCol=0; a_lScreenCol<a_lScreenColMax; a_lScreenCol++)
+		{
+			o_pwLine[a_lScreenCol] = (a_lScreenCol < static_cast<long>(this->m_strStatus.size()))? static_cast<wchar_t>(this->m_strStatus[a_lScreenCol]) : L' ';
+		}
+	}
+	else if(ZOOM_CELL == this->m_eZoom)
+	{
+		// 1文字 = 1セル.
+		long a_lRow = this->m_lViewRow + i_lScreenRow;
+		for(long a_lScreenCol=0; a_lScreenCol<a_lScreenColMax; a_lScreenCol+=BitBoard::WORD_BIT)
+		{
+			BitBoard::WORD a_wBits = (a_lRow < a_lRowMax)? this->m_cBoard.getBits(this->m_lViewCol + a_lScreenCol, a_lRow) : 0;
+			for(long a_lIndex=0; (a_lIndex<BitBoard::WORD_BIT) && (a_lScreenCol+a_lIndex<a_lScreenColMax); a_lIndex++)
+			{
+				o_pwLine[a_lScreenCol + a_lIndex] = m_pwDispCharacter[(a_wBits >> a_lIndex) & 1];
+			}
+		}
+	}
+	else if(ZOOM_HALF_BLOCK == this->m_eZoom)
+	{
+		// 1文字 = 1x2セル.
+		long a_lRow = this->m_lViewRow + i_lScreenRow * 2;
+		for(long a_lScreenCol=0; a_lScreenCol<a_lScreenColMax; a_lScreenCol+=BitBoard::WORD_BIT)
+		{
+			long a_lCol = this->m_lViewCol + a_lScreenCol;
+			BitBoard::WORD a_wUpper = (a_lRow < a_lRowMax)? this->m_cBoard.getBits(a_lCol, a_lRow) : 0;
+			BitBoard::WORD a_wLower = (a_lRow + 1 < a_lRowMax)? this->m_cBoard.getBits(a_lCol, a_lRow + 1) : 0;
+			for(long a_lIndex=0; (a_lIndex<BitBoard::WORD_BIT) && (a_lScreenCol+a_lIndex<a_lScreenColMax); a_lIndex++)
+			{
+				o_pwLine[a_lScreenCol + a_lIndex] = m_pwHalfBlockCharacter[((a_wUpper >> a_lIndex) & 1) | (((a_wLower >> a_lIndex) & 1) << 1)];
+			}
+		}
+	}
+	else
+	{
+		// 1文字 = 2x4ドット. 64ドット(32文字)ずつ作る.
+		long a_lScale = 1L << (this->m_eZoom - ZOOM_BRAILLE);
+		long a_lRow = this->m_lViewRow + i_lScreenRow * 4 * a_lScale;
+		for(long a_lScreenCol=0; a_lScreenCol<a_lScreenColMax; a_lScreenCol+=BitBoard::WORD_BIT/2)
+		{
+			long a_lCol = this->m_lViewCol + a_lScreenCol * 2 * a_lScale;
+			BitBoard::WORD a_rgwDot[4];
+			for(long a_lDotRow=0; a_lDotRow<4; a_lDotRow++)
+			{
+				a_rgwDot[a_lDotRow] = this->getDotBits(a_lCol, a_lRow + a_lDotRow * a_lScale, a_lScale);
+			}
+			for(long a_lIndex=0; (a_lIndex<BitBoard::WORD_BIT/2) && (a_lScreenCol+a_lIndex<a_lScreenColMax); a_lIndex++)
+			{
+				// 点字のドット番号: 左列 上から 0x01,0x02,0x04,0x40 / 右列 0x08,0x10,0x20,0x80.
+				long a_lLeft = a_lIndex * 2;
+				long a_lRight = a_lLeft + 1;
+				unsigned int a_uiCode =
+					  ((a_rgwDot[0] >> a_lLeft) & 1)        | (((a_rgwDot[1] >> a_lLeft) & 1) << 1)
+					| (((a_rgwDot[2] >> a_lLeft) & 1) << 2) | (((a_rgwDot[0] >> a_lRight) & 1) << 3)
+					| (((a_rgwDot[1] >> a_lRight) & 1) << 4) | (((a_rgwDot[2] >> a_lRight) & 1) << 5)
+					| (((a_rgwDot[3] >> a_lLeft) & 1) << 6) | (((a_rgwDot[3] >> a_lRight) & 1) << 7);
+				o_pwLine[a_lScreenCol + a_lIndex] = static_cast<wchar_t>(BRAILLE_BASE + a_uiCode);
+			}
+		}
+	}
+}
+
+/**********************************
+ * ドットの行を作る.(縮小表示用).
+ **********************************/
+BitBoard::WORD LifeGameView::getDotBits(long i_lCol, long i_lRow, long i_lScale) const
+{
+	// 64セルずつ, 縦i_lScale行をORでまとめてから, 横を隣同士のORで1/i_lScaleに詰める.
+	BitBoard::WORD a_wDots = 0;
+	long a_lDotNum = BitBoard::WORD_BIT / i_lScale;
+	for(long a_lWord=0; a_lWord<i_lScale; a_lWord++)
+	{
+		BitBoard::WORD a_wBits = 0;
+		long a_lCol = i_lCol + a_lWord * BitBoard::WORD_BIT;
+		if(a_lCol >= this->getColMax()) break;
+		for(long a_lRow=i_lRow; (a_lRow<i_lRow+i_lScale) && (a_lRow<this->getRowMax()); a_lRow++)
+		{
+			a_wBits |= this->m_cBoard.getBits(a_lCol, a_lRow);
+		}
+		for(long a_lScale=1; a_lScale<i_lScale; a_lScale<<=1)
+		{
+			a_wBits = compressEvenBits(a_wBits | (a_wBits >> 1));
+		}
+		a_wDots |= a_wBits << (a_lWord * a_lDotNum);
+	}
+	return a_wDots;
+}
+
+/**********************************
+ * 1文字あたりのセルの横幅.
+ **********************************/
+long LifeGameView::getCellWidth() const
+{
+	if(ZOOM_BRAILLE > this->m_eZoom) return 1;
+	return 2L << (this->m_eZoom - ZOOM_BRAILLE);
+}
+
+/**********************************
+ * 1文字あたりのセルの縦幅.
+ **********************************/
+long LifeGameView::getCellHeight() const
+{
+	if(ZOOM_CELL == this->m_eZoom) return 1;
+	if(ZOOM_HALF_BLOCK == this->m_eZoom) return 2;
+	return 4L << (this->m_eZoom - ZOOM_BRAILLE);
+}
+
+/**********************************
+ * 拡大する.
+ **********************************/
+void LifeGameView::zoomIn()
+{
+	if(ZOOM_CELL == this->m_eZoom) return;
+	this->m_eZoom = static_cast<ZOOM>(this->m_eZoom - 1);
+	this->scrollToCursor(true);
+	this->m_bIsDirty = true;
+}
+
+/**********************************
+ * 縮小する.
+ **********************************/
+void LifeGameView::zoomOut()
+{
+	if(ZOOM_MAX == this->m_eZoom) return;
+	this->m_eZoom = static_cast<ZOOM>(this->m_eZoom + 1);
+	this->scrollToCursor(true);
+	this->m_bIsDirty = true;
+}
+
+/**********************************
+ * ステータス行を表示/非表示にする.
+ **********************************/
+void LifeGameView::showStatus(bool i_bIsVisible)
+{
+	if(this->m_bIsStatusVisible == i_bIsVisible) return;
+	this->m_bIsStatusVisible = i_bIsVisible;
+	this->scrollToCursor(false);
+	this->m_bIsDirty = true;
+}
+
+/**********************************
+ * ステータス行の文字列を設定する.
+ **********************************/
+void LifeGameView::setStatus(const std::string& i_strStatus)
+{
+	if(this->m_strStatus == i_strStatus) return;
+	this->m_strStatus = i_strStatus;
+	if(this->m_bIsStatusVisible) this->m_bIsDirty = true;
+}
+
+/**********************************
+ * カーソルが見えるようにビューポートを動かす.
+ **********************************/
+void LifeGameView::scrollToCursor(bool i_bIsCenter)
+{
+	long a_lViewColMax = this->getScreenColMax() * this->getCellWidth();
+	long a_lViewRowMax = this->getBoardScreenRowMax() * this->getCellHeight();
+	long a_lViewCol = this->m_lViewCol;
+	long a_lViewRow = this->m_lViewRow;
+
+	if(i_bIsCenter)
+	{
+		a_lViewCol = this->m_lCursorCol - a_lViewColMax / 2;
+		a_lViewRow = this->m_lCursorRow - a_lViewRowMax / 2;
+	}
+	else
+	{
+		if(this->m_lCursorCol < a_lViewCol) a_lViewCol = this->m_lCursorCol;
+		else if(this->m_lCursorCol >= a_lViewCol + a_lViewColMax) a_lViewCol = this->m_lCursorCol - a_lViewColMax + 1;
+		if(this->m_lCursorRow < a_lViewRow) a_lViewRow = this->m_lCursorRow;
+		else if(this->m_lCursorRow >= a_lViewRow + a_lViewRowMax) a_lViewRow = this->m_lCursorRow - a_lViewRowMax + 1;
+	}
+
+	// 盤面の外を表示しないようにする.
+	if(a_lViewCol > this->getColMax() - a_lViewColMax) a_lViewCol = this->getColMax() - a_lViewColMax;
+	if(a_lViewRow > this->getRowMax() - a_lViewRowMax) a_lViewRow = this->getRowMax() - a_lViewRowMax;
+	if(0 > a_lViewCol) a_lViewCol = 0;
+	if(0 > a_lViewRow) a_lViewRow = 0;
+
+	if( (a_lViewCol != this->m_lViewCol) || (a_lViewRow != this->m_lViewRow) )
+	{
+		this->m_lViewCol = a_lViewCol;
+		this->m_lViewRow = a_lViewRow;
+		this->m_bIsDirty = true;
+	}
+}
+
+/********************
+ * カーソルを指定位置へ移動.
+ ********************/
+void LifeGameView::moveCursor(long i_lCol, long i_lRow)
+{
+	// 盤面の端は反対側へ回り込む.
+	this->m_lCursorCol = ((i_lCol % this->getColMax()) + this->getColMax()) % this->getColMax();
+	this->m_lCursorRow = ((i_lRow % this->getRowMax()) + this->getRowMax()) % this->getRowMax();
+	this->scrollToCursor(false);
+}
+
+/********************
+ * カーソルを上へ移動.
+ ********************/
+void LifeGameView::moveToUpper()
+{
+	// 縮小表示では1文字分移動する.
+	this->moveCursor(this->m_lCursorCol, this->m_lCursorRow - this->getCellHeight());
+}
+
+/********************
+ * カーソルを下へ移動.
+ ********************/
+void LifeGameView::moveToLower()
+{
+	this->moveCursor(this->m_lCursorCol, this->m_lCursorRow + this->getCellHeight());
+}
+
+/********************
+ * カーソルを右へ移動.
+ ********************/
+void LifeGameView::moveToRight()
+{
+	this->moveCursor(this->m_lCursorCol + this->getCellWidth(), this->m_lCursorRow);
+}
+
+/********************
+ * カーソルを左へ移動.
+ ********************/
+void LifeGameView::moveToLeft()
+{
+	this->moveCursor(this->m_lCursorCol - this->getCellWidth(), this->m_lCursorRow);
+}
@@ -0,0 +1,371 @@
+/**
+ * @file    LifeGameView.h
+ * @brief   ライフゲームの表示を管理するクラスの宣言.(端末の種類に依らない部分).
+ */
+#ifndef __LIFEGAME_VIEW_H__
+#define __LIFEGAME_VIEW_H__
+
+#include "../Lib/Observer.h"
+#include "../Lib/CellAttribute.h"
+#include "../Lib/MatrixCellAttribute.h"
+#include "../Model/BitBoard.h"
+
+#include <string>
+
+/**
+ * @brief   ライフゲームの表示を管理するクラス.(基底クラス).
+ * @note    セルの状態はBitBoardに写し, flush()で画面に見えている範囲(ビューポート)だけを描画する.
+ *          盤面は端末より大きくてよく, カーソルが端に来るとビューポートが動く.
+ * @note    縮小表示では1文字に複数のセルを描く.
+ *              ・ZOOM_CELL         1文字 = 1セル.
+ *              ・ZOOM_HALF_BLOCK   1文字 = 1x2セル.(ブロック要素 ▀▄█).
+ *              ・ZOOM_BRAILLE以上  1文字 = 2x4ドット.(点字). 1ドットは2^(倍率-ZOOM_BRAILLE)四方のセル.
+ * @note    ステータス行を表示する場合は, 画面の最下行をステータス行とし盤面はその上に表示する.
+ * @note    端末への出力と入力は派生クラスで行う.
+ *              ・LifeGameViewOnCurses  cursesで出力する.
+ *              ・LifeGameViewOnAnsi    ANSIエスケープシーケンスを直接出力する.
+ */
+class LifeGameView : public Observer<MatrixCellAttribute>
+{
+public:
+	/**
+	 * @brief	表示倍率.
+	 */
+	enum ZOOM {
+		ZOOM_CELL = 0,
+		ZOOM_HALF_BLOCK,
+		ZOOM_BRAILLE,
+		ZOOM_MAX = ZOOM_BRAILLE + 6,	// 1ドット = 64x64セル.
+	};
+
+    /**
+     * @brief   コンストラクタ.
+     * @note    盤面の大きさは0. 派生クラスで端末を初期化した後にinit()を呼ぶ.
+     */
+    LifeGameView()
+	{
+		this->m_bIsStatusVisible = false;
+		this->init(0, 0);
+	}
+
+    /**
+     * @brief   デストラクタ.
+     */
+    virtual ~LifeGameView(){ }
+
+    /**
+     * @brief   盤面の大きさを設定する.
+     * @param   long i_lColMax 盤面の横幅.
+     * @param   long i_lRowMax 盤面の縦幅.
+     * @return  なし.
+     * @note    全セルを"死"とし, カーソルとビューポートを左上へ戻す.
+     */
+    void init(long i_lColMax, long i_lRowMax);
+
+    /**
+     * @brief   盤面の横幅.
+     */
+    long getColMax() const { return this->m_cBoard.getColMax(); }
+
+    /**
+     * @brief   盤面の縦幅.
+     */
+    long getRowMax() const { return this->m_cBoard.getRowMax(); }
+
+    /**
+     * @brief   端末の横幅.(文字数).
+     */
+    virtual long getScreenColMax() const = 0;
+
+    /**
+     * @brief   端末の縦幅.(文字数).
+     */
+    virtual long getScreenRowMax() const = 0;
+
+	/**
+	 * @brief	カーソルの位置(x座標)を取得.(盤面の座標).
+	 */
+	long getCol() const { return this->m_lCursorCol; }
+
+	/**
+	 * @brief	カーソルの位置(y座標)を取得.(盤面の座標).
+	 */
+	long getRow() const { return this->m_lCursorRow; }
+
+	/**
+	 * @brief	表示倍率を取得.
+	 */
+	ZOOM getZoom() const { return this->m_eZoom; }
+
+	/**
+	 * @brief	拡大する.(1文字あたりのセルを減らす).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void zoomIn();
+
+	/**
+	 * @brief	縮小する.(1文字あたりのセルを増やす).
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void zoomOut();
+
+    /**
+     * @brief   セルの状態を描画.
+     * @param   long i_lCol 横位置.
+     * @param   long i_lRow 縦位置.
+     * @param   CellAttribute::CELL_STATE i_eState   セルの状態.
+     * @return  成功/失敗.
+     * @note    画面へはflush()を呼ぶまで反映しない.
+     */
+    bool draw(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState);
+
+    /**
+     * @brief   全セルの状態を描画.
+     * @param   const BitBoard& i_cBoard 全セルの状態.(盤面と同じ大きさ).
+     * @return  なし.
+     * @note    画面へはflush()を呼ぶまで反映しない.
+     */
+    void drawBoard(const BitBoard& i_cBoard);
+
+    /**
+     * @brief   矩形内のセルの状態を描画.
+     * @param   const BitBoard& i_cBoard 全セルの状態.(盤面と同じ大きさ. 矩形の外は見ない).
+     * @param   long i_lCol 横位置(左端).
+     * @param   long i_lRow 縦位置(上端).
+     * @param   long i_lWidth 横幅.
+     * @param   long i_lHeight 縦幅.
+     * @return  なし.
+     * @note    見えている範囲(getViewRegion())を含む矩形を渡せば, 盤面全体を写さずに済む.
+     * @note    画面へはflush()を呼ぶまで反映しない.
+     */
+    void drawRegion(const BitBoard& i_cBoard, long i_lCol, long i_lRow, long i_lWidth, long i_lHeight);
+
+    /**
+     * @brief   見えている範囲を取得.(盤面の座標).
+     * @param   long& o_lCol 横位置(左端).
+     * @param   long& o_lRow 縦位置(上端).
+     * @param   long& o_lWidth 横幅.(盤面の端で切り詰める).
+     * @param   long& o_lHeight 縦幅.(盤面の端で切り詰める).
+     * @return  なし.
+     * @note    カーソルの移動, 拡大/縮小, ステータス行の表示/非表示, 端末の大きさで変わる.
+     */
+    void getViewRegion(long& o_lCol, long& o_lRow, long& o_lWidth, long& o_lHeight) const;
+
+    /**
+     * @brief   描画した内容とカーソルを画面へ反映する.
+     * @param   なし.
+     * @return  なし.
+     * @note    1フレームに1回呼ぶ.
+     */
+    virtual void flush() = 0;
+
+	/**
+	 * @brief	ユーザーから入力されたコマンドを取得.
+	 * @param	なし.
+	 * @return	入力されたコマンド.(入力が無い場合は'\0').
+	 * @note	入力を待たない.
+	 */
+	virtual char getCommand() const = 0;
+
+	/**
+	 * @brief	入力を待つためのファイルディスクリプタ.
+	 * @note	poll()で入力を待ってからgetCommand()を呼ぶ.
+	 */
+	virtual int getInputFd() const = 0;
+
+    /**
+     * @brief   ステータス行を表示/非表示にする.
+     * @param   bool i_bIsVisible true:表示 false:非表示.
+     * @return  なし.
+     * @note    表示すると盤面を表示する行が1行減る.
+     */
+    void showStatus(bool i_bIsVisible);
+
+    /**
+     * @brief   ステータス行を表示しているか否か.
+     */
+    bool isStatusVisible() const { return this->m_bIsStatusVisible; }
+
+    /**
+     * @brief   ステータス行の文字列を設定する.
+     * @param   const std::string& i_strStatus 表示する文字列.(ASCII文字のみ. 画面の幅で切り詰める).
+     * @return  なし.
+     * @note    画面へはflush()を呼ぶまで反映しない.
+     */
+    void setStatus(const std::string& i_strStatus);
+
+    /**
+     * @brief   カーソルを上へ移動.
+	 * @param	なし.
+	 * @return	なし.
+     */
+    void moveToUpper();
+
+    /**
+     * @brief   カーソルを下へ移動.
+	 * @param	なし.
+	 * @return	なし.
+     */
+    void moveToLower();
+
+    /**
+     * @brief   カーソルを右へ移動.
+	 * @param	なし.
+	 * @return	なし.
+     */
+    void moveToRight();
+
+    /**
+     * @brief   カーソルを左へ移動.
+	 * @param	なし.
+	 * @return	なし.
+     */
+    void moveToLeft();
+
+    /**
+     * @brief   カーソルを指定位置へ移動.
+	 * @param	long i_lCol 横位置.
+	 * @param	long i_lRow 縦位置.
+	 * @return	なし.
+     */
+    void moveCursor(long i_lCol, long i_lRow);
+
+	/**
+	 * @brief	Subjectから通知を受信.
+	 * @param	const MatrixCellAttribute* i_pcAttribute MatrixCellの属性.
+	 * @return	成功/失敗.
+	 */
+	bool update(const MatrixCellAttribute* i_pcAttribute)
+	{
+		this->recieveState(i_pcAttribute);
+		return true;
+	}
+
+protected:
+    /**
+     * @brief   前回の描画から見えている範囲が変わったか否か.
+     */
+    bool m_bIsDirty;
+
+    /**
+     * @brief   画面の1行分の表示文字を作る.
+     * @param   long i_lScreenRow 画面の行.
+     * @param   wchar_t* o_pwLine 表示文字.(getScreenColMax()文字).
+     * @return  なし.
+     */
+    void renderLine(long i_lScreenRow, wchar_t* o_pwLine) const;
+
+    /**
+     * @brief   カーソルのある文字の位置(横).(画面の座標).
+     */
+    long getScreenCursorCol() const { return (this->m_lCursorCol - this->m_lViewCol) / this->getCellWidth(); }
+
+    /**
+     * @brief   カーソルのある文字の位置(縦).(画面の座標).
+     */
+    long getScreenCursorRow() const { return (this->m_lCursorRow - this->m_lViewRow) / this->getCellHeight(); }
+
+private:
+	/**
+	 * @brief	表示する文字の定義.
+	 */
+	static const wchar_t m_pwDispCharacter[CellAttribute::CELL_STATE_MAX];
+
+	/**
+	 * @brief	半ブロック表示の文字の定義.(bit0:上のセル, bit1:下のセル).
+	 */
+	static const wchar_t m_pwHalfBlockCharacter[4];
+
+    /**
+     * @brief   全セルの状態.
+     */
+    BitBoard m_cBoard;
+
+    /**
+     * @brief   カーソルの位置(x座標).(盤面の座標).
+     */
+    long m_lCursorCol;
+
+    /**
+     * @brief   カーソルの位置(y座標).(盤面の座標).
+     */
+    long m_lCursorRow;
+
+    /**
+     * @brief   ビューポートの左端.(盤面の座標).
+     */
+    long m_lViewCol;
+
+    /**
+     * @brief   ビューポートの上端.(盤面の座標).
+     */
+    long m_lViewRow;
+
+    /**
+     * @brief   表示倍率.
+     */
+    ZOOM m_eZoom;
+
+    /**
+     * @brief   ステータス行を表示しているか否か.
+     */
+    bool m_bIsStatusVisible;
+
+    /**
+     * @brief   ステータス行の文字列.
+     */
+    std::string m_strStatus;
+
+    /**
+     * @brief   盤面を表示する行数.(ステータス行を除く).
+     */
+    long getBoardScreenRowMax() const { return this->getScreenRowMax() - (this->m_bIsStatusVisible? 1 : 0); }
+
+    /**
+     * @brief   1文字あたりのセルの横幅.
+     */
+    long getCellWidth() const;
+
+    /**
+     * @brief   1文字あたりのセルの縦幅.
+     */
+    long getCellHeight() const;
+
+    /**
+     * @brief   カーソルが見えるようにビューポートを動かす.
+     * @param   bool i_bIsCenter true:カーソルを中央にする false:はみ出した分だけ動かす.
+     * @return  なし.
+     */
+    void scrollToCursor(bool i_bIsCenter);
+
+    /**
+     * @brief   ドットの行を作る.(縮小表示用).
+     * @param   long i_lCol 左端.(盤面の座標).
+     * @param   long i_lRow 上端.(盤面の座標).
+     * @param   long i_lScale 1ドットのセル数(縦横).
+     * @return  64ドット分のビット.(bit0が左端). 縦i_lScale行のORを横i_lScaleセルずつORでまとめたもの.
+     */
+    BitBoard::WORD getDotBits(long i_lCol, long i_lRow, long i_lScale) const;
+
+	/**
+	 * @brief   MatrixCellの状態を受け取る.
+     * @param   const MatrixCellAttribute* i_pcMatrixCellAttribute MatrixCellの状態.
+     * @return  結果.
+     * @retval  true    成功.
+     * @retval  false   失敗.
+	 */
+	bool recieveState(const MatrixCellAttribute* i_pcMatrixCellAttribute)
+	{
+		// 矩形の一括通知の場合は変化したセルを全て描画.
+		i_pcMatrixCellAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+		{
+			this->draw(i_lCol, i_lRow, i_eState);
+		});
+		return true;
+	}
+
+};
+
+#endif  // __LIFEGAME_VIEW_H__
@@ -0,0 +1,255 @@
+/**
+ * @file    LifeGameViewOnAnsi.cpp
+ * @brief   ライフゲームの表示をANSIエスケープシーケンスで行うクラスの実装.
+ */
+
+#include "LifeGameViewOnAnsi.h"
+#include "../Lib/Tracer.h"
+
+#include <sys/ioctl.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+
+// 代替画面へ切り替えて消去する.
+#define ANSI_ENTER	"\x1b[?1049h\x1b[H\x1b[2J"
+// 元の画面へ戻す.
+#define ANSI_LEAVE	"\x1b[?1049l"
+
+/*******************
+ * コンストラクタ.
+ *******************/
+LifeGameViewOnAnsi::LifeGameViewOnAnsi(int i_iInput, int i_iOutput)
+{
+	this->m_iInput = i_iInput;
+	this->m_iOutput = i_iOutput;
+	this->m_bIsTerminal = false;
+	this->m_lOutputSize = 0;
+	this->initDisplay();
+	this->init(this->getScreenColMax(), this->getScreenRowMax());
+}
+
+/*****************
+ * デストラクタ.
+ *****************/
+LifeGameViewOnAnsi::~LifeGameViewOnAnsi()
+{
+	this->m_lOutputSize = 0;
+	this->put(ANSI_LEAVE);
+	this->writeOutput();
+	if(this->m_bIsTerminal)
+	{
+		tcsetattr(this->m_iInput, TCSANOW, &this->m_stTermios);
+	}
+}
+
+/***************************
+ * 端末の初期化.
+ ***************************/
+void LifeGameViewOnAnsi::initDisplay()
+{
+	// 行バッファリングとエコーバックをやめる.(cursesのcbreak()/noecho()と同じ).
+	if(0 == tcgetattr(this->m_iInput, &this->m_stTermios))
+	{
+		struct termios a_stTermios = this->m_stTermios;
+		a_stTermios.c_lflag &= ~(ICANON | ECHO);
+		a_stTermios.c_cc[VMIN] = 0;
+		a_stTermios.c_cc[VTIME] = 0;
+		this->m_bIsTerminal = (0 == tcsetattr(this->m_iInput, TCSANOW, &a_stTermios));
+	}
+
+	// 端末の大きさ.
+	struct winsize a_stSize;
+	this->m_lScreenColMax = DEFAULT_SCREEN_COL_MAX;
+	this->m_lScreenRowMax = DEFAULT_SCREEN_ROW_MAX;
+	if( (0 == ioctl(this->m_iOutput, TIOCGWINSZ, &a_stSize)) && (0 < a_stSize.ws_col) && (0 < a_stSize.ws_row) )
+	{
+		this->m_lScreenColMax = a_stSize.ws_col;
+		this->m_lScreenRowMax = a_stSize.ws_row;
+	}
+
+	// 消去した直後の画面は空白.
+	long a_lScreenSize = this->m_lScreenColMax * this->m_lScreenRowMax;
+	this->m_vecScreen.assign(a_lScreenSize, L' ');
+	this->m_vecLine.resize(this->m_lScreenColMax);
+
+	// 全文字が1文字ずつカーソル移動を伴って変化した場合の大きさ.(UTF-8で最大3バイト).
+	this->m_vecOutput.resize(a_lScreenSize * (3 + MOVE_SIZE_MAX) + MOVE_SIZE_MAX + sizeof(ANSI_ENTER) + sizeof(ANSI_LEAVE));
+
+	this->m_lOutputSize = 0;
+	this->put(ANSI_ENTER);
+	this->m_lOutputCol = 0;
+	this->m_lOutputRow = 0;
+	this->writeOutput();
+}
+
+/**********************************
+ * 描画した内容を画面へ反映する.
+ **********************************/
+void LifeGameViewOnAnsi::flush()
+{
+	TRACE_SCOPE("render", "flush");
+	this->m_lOutputSize = 0;
+
+	if(this->m_bIsDirty)
+	{
+		long a_lScreenColMax = this->getScreenColMax();
+		wchar_t* a_pwLine = &this->m_vecLine[0];
+		for(long a_lScreenRow=0; a_lScreenRow<this->getScreenRowMax(); a_lScreenRow++)
+		{
+			this->renderLine(a_lScreenRow, a_pwLine);
+			wchar_t* a_pwScreen = &this->m_vecScreen[a_lScreenRow * a_lScreenColMax];
+			for(long a_lScreenCol=0; a_lScreenCol<a_lScreenColMax; a_lScreenCol++)
+			{
+				if(a_pwLine[a_lScreenCol] == a_pwScreen[a_lScreenCol]) continue;
+
+				// 変化した文字の位置へ移動する.(少し先ならば間の文字を書き直す方が短い).
+				if( (this->m_lOutputRow == a_lScreenRow) && (0 <= this->m_lOutputCol)
+				 && (this->m_lOutputCol <= a_lScreenCol) && (a_lScreenCol - this->m_lOutputCol <= JUMP_GAP) )
+				{
+					for(long a_lCol=this->m_lOutputCol; a_lCol<a_lScreenCol; a_lCol++)
+					{
+						this->putCharacter(a_pwScreen[a_lCol]);
+					}
+				}
+				else
+				{
+					this->putMove(a_lScreenCol, a_lScreenRow);
+				}
+
+				this->putCharacter(a_pwLine[a_lScreenCol]);
+				a_pwScreen[a_lScreenCol] = a_pwLine[a_lScreenCol];
+				this->m_lOutputCol = a_lScreenCol + 1;
+				this->m_lOutputRow = a_lScreenRow;
+
+				// 右端に書いた後のカーソル位置は端末によって異なる.
+				if(this->m_lOutputCol >= a_lScreenColMax) this->m_lOutputRow = -1;
+			}
+		}
+		this->m_bIsDirty = false;
+	}
+
+	// カーソル.
+	long a_lCursorCol = this->getScreenCursorCol();
+	long a_lCursorRow = this->getScreenCursorRow();
+	if( (a_lCursorCol != this->m_lOutputCol) || (a_lCursorRow != this->m_lOutputRow) )
+	{
+		this->putMove(a_lCursorCol, a_lCursorRow);
+		this->m_lOutputCol = a_lCursorCol;
+		this->m_lOutputRow = a_lCursorRow;
+	}
+
+	// 1回だけ端末へ出力する.
+	this->writeOutput();
+}
+
+/**********************************
+ * ユーザーから入力されたコマンドを取得.
+ **********************************/
+char LifeGameViewOnAnsi::getCommand() const
+{
+	// 入力を待たない.(端末でない場合もread()で止まらないようにpoll()で確認する).
+	struct pollfd a_stPoll;
+	a_stPoll.fd = this->m_iInput;
+	a_stPoll.events = POLLIN;
+	a_stPoll.revents = 0;
+	char a_ch = '\0';
+	if( (0 < poll(&a_stPoll, 1, 0)) && (1 == read(this->m_iInput, &a_ch, 1)) ) return a_ch;
+	return '\0';
+}
+
+/**********************************
+ * 出力バッファへ文字列を書く.
+ **********************************/
+void LifeGameViewOnAnsi::put(const char* i_pString)
+{
+	size_t a_lLength = strlen(i_pString);
+	memcpy(&this->m_vecOutput[this->m_lOutputSize], i_pString, a_lLength);
+	this->m_lOutputSize += a_lLength;
+}
+
+/**********************************
+ * 出力バッファへ1文字をUTF-8で書く.
+ **********************************/
+void LifeGameViewOnAnsi::putCharacter(wchar_t i_wCharacter)
+{
+	char* a_pOutput = &this->m_vecOutput[this->m_lOutputSize];
+	unsigned long a_ulCode = static_cast<unsigned long>(i_wCharacter);
+	if(0x80 > a_ulCode)
+	{
+		a_pOutput[0] = static_cast<char>(a_ulCode);
+		this->m_lOutputSize += 1;
+	}
+	else if(0x800 > a_ulCode)
+	{
+		a_pOutput[0] = static_cast<char>(0xC0 | (a_ulCode >> 6));
+		a_pOutput[1] = static_cast<char>(0x80 | (a_ulCode & 0x3F));
+		this->m_lOutputSize += 2;
+	}
+	else
+	{
+		a_pOutput[0] = static_cast<char>(0xE0 | (a_ulCode >> 12));
+		a_pOutput[1] = static_cast<char>(0x80 | ((a_ulCode >> 6) & 0x3F));
+		a_pOutput[2] = static_cast<char>(0x80 | (a_ulCode & 0x3F));
+		this->m_lOutputSize += 3;
+	}
+}
+
+/**********************************
+ * 出力バッファへ10進数を書く.
+ **********************************/
+void LifeGameViewOnAnsi::putNumber(long i_lNumber)
+{
+	char a_szNumber[24];
+	int a_iIndex = sizeof(a_szNumber);
+	a_szNumber[--a_iIndex] = '\0';
+	do{
+		a_szNumber[--a_iIndex] = static_cast<char>('0' + i_lNumber % 10);
+		i_lNumber /= 10;
+	}while(0 < i_lNumber);
+	this->put(&a_szNumber[a_iIndex]);
+}
+
+/**********************************
+ * 出力バッファへカーソル移動を書く.
+ **********************************/
+void LifeGameViewOnAnsi::putMove(long i_lScreenCol, long i_lScreenRow)
+{
+	if( (this->m_lOutputRow == i_lScreenRow) && (0 <= this->m_lOutputCol) && (this->m_lOutputCol < i_lScreenCol) )
+	{
+		// CUF: "ESC [ n C".
+		this->put("\x1b[");
+		this->putNumber(i_lScreenCol - this->m_lOutputCol);
+		this->put("C");
+	}
+	else
+	{
+		// CUP: "ESC [ row ; col H".(1始まり).
+		this->put("\x1b[");
+		this->putNumber(i_lScreenRow + 1);
+		this->put(";");
+		this->putNumber(i_lScreenCol + 1);
+		this->put("H");
+	}
+}
+
+/**********************************
+ * 出力バッファを出力する.
+ **********************************/
+void LifeGameViewOnAnsi::writeOutput()
+{
+	// 通常は1回のwrite()で書き終わる.(途中までしか書けなかった場合のみ続きを書く).
+	const char* a_pOutput = &this->m_vecOutput[0];
+	long a_lRest = this->m_lOutputSize;
+	while(0 < a_lRest)
+	{
+		ssize_t a_lWritten = write(this->m_iOutput, a_pOutput, a_lRest);
+		if(0 > a_lWritten)
+		{
+			if(EINTR == errno) continue;
+			break;
+		}
+		a_pOutput += a_lWritten;
+		a_lRest -= a_lWritten;
+	}
+}
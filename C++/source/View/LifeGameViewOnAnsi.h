@@ -0,0 +1,194 @@
+/**
+ * @file    LifeGameViewOnAnsi.h
+ * @brief   ライフゲームの表示をANSIエスケープシーケンスで行うクラスの宣言.
+ */
+#ifndef __LIFEGAME_VIEW_ON_ANSI_H__
+#define __LIFEGAME_VIEW_ON_ANSI_H__
+
+#include <unistd.h>
+#include <termios.h>
+#include <vector>
+
+#include "LifeGameView.h"
+
+/**
+ * @brief   ライフゲームの表示をANSIエスケープシーケンスで行うクラス.
+ * @note    cursesを使わず, 前フレームから変化した文字の並びだけを
+ *          カーソル移動と共に事前に確保したバッファへ書き, 1フレームにつき1回write()する.
+ * @note    文字はUTF-8で出力する.(ロケールに依らない).
+ * @note    端末でない場合(パイプ等)は端末の設定を変えず, 大きさは既定値とする.
+ */
+class LifeGameViewOnAnsi : public LifeGameView
+{
+public:
+	/**
+	 * @brief	端末の大きさが取得できない場合の既定値.
+	 */
+	enum { DEFAULT_SCREEN_COL_MAX = 80, DEFAULT_SCREEN_ROW_MAX = 24 };
+
+	/**
+	 * @brief	カーソルを移動する代わりに書き直す文字数の上限.(移動のエスケープシーケンスより短い場合).
+	 */
+	enum { JUMP_GAP = 4 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   int i_iInput 入力のファイルディスクリプタ.
+     * @param   int i_iOutput 出力のファイルディスクリプタ.
+     * @note    盤面の大きさは端末の大きさとする.(init()で変更できる).
+     */
+    LifeGameViewOnAnsi(int i_iInput = STDIN_FILENO, int i_iOutput = STDOUT_FILENO);
+
+    /**
+     * @brief   デストラクタ.
+     * @note    端末の設定と画面を戻す.
+     */
+    virtual ~LifeGameViewOnAnsi();
+
+    /**
+     * @brief   端末の横幅.(文字数).
+     */
+    long getScreenColMax() const { return this->m_lScreenColMax; }
+
+    /**
+     * @brief   端末の縦幅.(文字数).
+     */
+    long getScreenRowMax() const { return this->m_lScreenRowMax; }
+
+    /**
+     * @brief   描画した内容とカーソルを画面へ反映する.
+     * @param   なし.
+     * @return  なし.
+     * @note    変化した文字だけを1回のwrite()で出力する.(変化が無ければ出力しない).
+     */
+    void flush();
+
+	/**
+	 * @brief	ユーザーから入力されたコマンドを取得.
+	 * @param	なし.
+	 * @return	入力されたコマンド.(入力が無い場合は'\0').
+	 */
+	char getCommand() const;
+
+	/**
+	 * @brief	入力を待つためのファイルディスクリプタ.
+	 */
+	int getInputFd() const { return this->m_iInput; }
+
+	/**
+	 * @brief	最後のflush()で出力したバイト数.
+	 */
+	long getOutputSize() const { return this->m_lOutputSize; }
+
+private:
+	/**
+	 * @brief	カーソル移動1回分のエスケープシーケンスの最大長.
+	 */
+	enum { MOVE_SIZE_MAX = 24 };
+
+	/**
+	 * @brief	入力のファイルディスクリプタ.
+	 */
+	int m_iInput;
+
+	/**
+	 * @brief	出力のファイルディスクリプタ.
+	 */
+	int m_iOutput;
+
+	/**
+	 * @brief	端末の設定を変更したか否か.
+	 */
+	bool m_bIsTerminal;
+
+	/**
+	 * @brief	変更前の端末の設定.
+	 */
+	struct termios m_stTermios;
+
+	/**
+	 * @brief	端末の横幅.
+	 */
+	long m_lScreenColMax;
+
+	/**
+	 * @brief	端末の縦幅.
+	 */
+	long m_lScreenRowMax;
+
+	/**
+	 * @brief	端末に表示済みの文字.(getScreenColMax() x getScreenRowMax()).
+	 */
+	std::vector<wchar_t> m_vecScreen;
+
+    /**
+     * @brief   1行分の表示文字.(描画の作業用).
+     */
+    std::vector<wchar_t> m_vecLine;
+
+	/**
+	 * @brief	出力バッファ.(全文字が変化した場合の大きさを事前に確保する).
+	 */
+	std::vector<char> m_vecOutput;
+
+	/**
+	 * @brief	出力バッファに書いたバイト数.
+	 */
+	long m_lOutputSize;
+
+	/**
+	 * @brief	出力後の端末のカーソル位置(横).(-1は不明).
+	 */
+	long m_lOutputCol;
+
+	/**
+	 * @brief	出力後の端末のカーソル位置(縦).(-1は不明).
+	 */
+	long m_lOutputRow;
+
+    /**
+     * @brief   端末の初期化.
+     * @param   なし.
+     * @return  なし.
+     */
+    void initDisplay();
+
+	/**
+	 * @brief	出力バッファへ文字列を書く.
+	 * @param	const char* i_pString 文字列.
+	 * @return	なし.
+	 */
+	void put(const char* i_pString);
+
+	/**
+	 * @brief	出力バッファへ1文字をUTF-8で書く.
+	 * @param	wchar_t i_wCharacter 文字.
+	 * @return	なし.
+	 */
+	void putCharacter(wchar_t i_wCharacter);
+
+	/**
+	 * @brief	出力バッファへ10進数を書く.
+	 * @param	long i_lNumber 0以上の数.
+	 * @return	なし.
+	 */
+	void putNumber(long i_lNumber);
+
+	/**
+	 * @brief	出力バッファへカーソル移動を書く.
+	 * @param	long i_lScreenCol 横位置.(画面の座標).
+	 * @param	long i_lScreenRow 縦位置.(画面の座標).
+	 * @return	なし.
+	 * @note	同じ行で右へ移動する場合は相対移動(CUF), それ以外は絶対位置(CUP)を使う.
+	 */
+	void putMove(long i_lScreenCol, long i_lScreenRow);
+
+	/**
+	 * @brief	出力バッファを出力する.
+	 * @param	なし.
+	 * @return	なし.
+	 */
+	void writeOutput();
+};
+
+#endif  // __LIFEGAME_VIEW_ON_ANSI_H__
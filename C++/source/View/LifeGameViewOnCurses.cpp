@@ -1,18 +1,19 @@
 /**
  * @file    LifeGameViewOnCurses.cpp
- * @brief   ライフゲームの表示を管理するクラスの実装.
+ * @brief   ライフゲームの表示をcursesで行うクラスの実装.
  */
 
 #include "LifeGameViewOnCurses.h"
+#include "../Lib/Tracer.h"
 
-// 表示する文字の定義.
-const int LifeGameViewOnCurses::m_piDispCharacter[CellAttribute::CELL_STATE_MAX] = { ' ', '*', };
+#include <clocale>
 
 /***************************
  * curses初期化.
  ***************************/
 void LifeGameViewOnCurses::initDisplay()
 {
+    setlocale(LC_ALL, "");      // 点字/ブロック要素を表示するためにロケールを設定.
     m_pWindow = initscr();      // cursesライブラリの初期化.
     nodelay(m_pWindow, true);   // 非ブロッキングモード.
     cbreak();                   // 行バッファリングをやめ，DeleteやBackSpaceを無効にする.
@@ -20,88 +21,31 @@ void LifeGameViewOnCurses::initDisplay()
 }
 
 /**********************************
- * 現カーソル上にセルの状態を描画.
+ * 描画した内容を画面へ反映する.
  **********************************/
-bool LifeGameViewOnCurses::draw(int i_iCol, int i_iRow, CellAttribute::CELL_STATE i_eState)
+void LifeGameViewOnCurses::flush()
 {
-	// 表示する文字を設定.
-	int a_iChar = this->m_piDispCharacter[i_eState];
-    mvaddch(i_iRow, i_iCol, a_iChar);	// curses ライブラリ.
-    refresh();							// curses ライブラリ.
-
-    return true;
-}
-
-/********************
- * カーソルを上へ移動.
- ********************/
-void LifeGameViewOnCurses::moveToUpper()
-{
-    int a_iRow=0;
-    int a_iCol=0;
-
-    // カーソル位置を取得.
-    getyx(m_pWindow, a_iRow, a_iCol);
-
-    a_iRow--;
-    if(0 > a_iRow) a_iRow=getRowMax()-1;
-
-    // カーソルを移動.
-    move(a_iRow, a_iCol);
+	TRACE_SCOPE("render", "flush");
+	if(this->m_bIsDirty)
+	{
+		// 見えている範囲を1行ずつ描画する.
+		long a_lScreenColMax = this->getScreenColMax();
+		this->m_vecLine.resize(a_lScreenColMax);
+		for(long a_lScreenRow=0; a_lScreenRow<this->getScreenRowMax(); a_lScreenRow++)
+		{
+			this->renderLine(a_lScreenRow, &this->m_vecLine[0]);
+			mvaddnwstr(a_lScreenRow, 0, &this->m_vecLine[0], a_lScreenColMax);	// curses ライブラリ.
+		}
+		// ステータス行は反転表示.
+		if(this->isStatusVisible())
+		{
+			mvchgat(this->getScreenRowMax() - 1, 0, -1, A_REVERSE, 0, 0);	// curses ライブラリ.
+		}
+		this->m_bIsDirty = false;
+	}
+
+	// 1回だけ端末へ出力する.
+    move(this->getScreenCursorRow(), this->getScreenCursorCol());	// curses ライブラリ.
+    wnoutrefresh(this->m_pWindow);		// curses ライブラリ.
+    doupdate();							// curses ライブラリ.
 }
-
-/********************
- * カーソルを下へ移動.
- ********************/
-void LifeGameViewOnCurses::moveToLower()
-{
-    int a_iCol=0;
-    int a_iRow=0;
-
-    // カーソル位置を取得.
-    getyx(m_pWindow, a_iRow, a_iCol);
-
-    a_iRow++;
-    if(getRowMax() <= a_iRow) a_iRow=0;
-
-    // カーソルを移動.
-    move(a_iRow, a_iCol);
-}
-
-/********************
- * カーソルを右へ移動.
- ********************/
-void LifeGameViewOnCurses::moveToRight()
-{
-    int a_iCol=0;
-    int a_iRow=0;
-
-    // カーソル位置を取得.
-    getyx(m_pWindow, a_iRow, a_iCol);
-
-    a_iCol++;
-    if(getColMax() <= a_iCol) a_iCol=0;
-
-    // カーソルを移動.
-    move(a_iRow, a_iCol);
-}
-
-/********************
- * カーソルを左へ移動.
- ********************/
-void LifeGameViewOnCurses::moveToLeft()
-{
-    int a_iCol=0;
-    int a_iRow=0;
-
-    // カーソル位置を取得.
-    getyx(m_pWindow, a_iRow, a_iCol);
-
-    a_iCol--;
-    if(0 > a_iCol) a_iCol=getColMax()-1;
-
-    // カーソルを移動.
-    move(a_iRow, a_iCol);
-}
-
-
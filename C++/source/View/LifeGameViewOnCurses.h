@@ -1,31 +1,34 @@
 /**
  * @file    LifeGameViewOnCurses.h
- * @brief   ライフゲームの表示を管理するクラスの宣言.
+ * @brief   ライフゲームの表示をcursesで行うクラスの宣言.
  */
-#ifndef __LIFEGAME_VIEW_H__
-#define __LIFEGAME_VIEW_H__
+#ifndef __LIFEGAME_VIEW_ON_CURSES_H__
+#define __LIFEGAME_VIEW_ON_CURSES_H__
 
+#define NCURSES_WIDECHAR	1	// 点字/ブロック要素の表示にワイド文字版(ncursesw)を使う.
 #include <curses.h>
+#include <vector>
+#include <unistd.h>
 
-#include "../Lib/CellAttribute.h"
-#include "../Lib/MatrixCellAttribute.h"
+#include "LifeGameView.h"
 
 /**
- * @brief   ライフゲームの表示を管理するクラス.
+ * @brief   ライフゲームの表示をcursesで行うクラス.
  * @note    UNIX環境のcursesで表示する事を想定している.
  * @note    以下URLを参考にした.
  * @note    http://www.kis-lab.com/serikashiki/man/ncurses.html
  */
-class LifeGameViewOnCurses : public Observer
+class LifeGameViewOnCurses : public LifeGameView
 {
 public:
-
     /**
      * @brief   コンストラクタ.
+     * @note    盤面の大きさは端末の大きさとする.(init()で変更できる).
      */
     LifeGameViewOnCurses()
 	{
 	    this->initDisplay();
+		this->init(this->getScreenColMax(), this->getScreenRowMax());
 	}
 
     /**
@@ -37,134 +40,60 @@ public:
 	}
 
     /**
-     * @brief   座標位置 横方向の最大.
+     * @brief   端末の横幅.(文字数).
 	 * @note	curses ライブラリ.
      */
-    long getColMax()
-	{
-		return COLS;
-	}
+    long getScreenColMax() const { return COLS; }
 
     /**
-     * @brief   座標位置 縦方向の最大.
+     * @brief   端末の縦幅.(文字数).
 	 * @note	curses ライブラリ.
      */
-    long getRowMax()
-	{
-		return LINES;
-	}
-
-	/**
-	 * @brief	カーソルの位置(x座標)を取得.
-	 */
-	long getCol()
-	{
-		int a_iRow, a_iCol;
-		getyx(m_pWindow, a_iRow, a_iCol);
-		return (a_iCol);
-	}
-	/**
-	 * @brief	カーソルの位置(y座標)を取得.
-	 */
-	long getRow()
-	{
-		int a_iRow,a_iCol;
-		getyx(m_pWindow, a_iRow, a_iCol);
-		return (a_iRow);
-	}
+    long getScreenRowMax() const { return LINES; }
 
     /**
-     * @brief   現カーソル上にセルの状態を描画.
-     * @param   CellAttribute::CELL_STATE i_eState   セルの状態.
-     * @return  成功/失敗. 
+     * @brief   描画した内容とカーソルを画面へ反映する.
+     * @param   なし.
+     * @return  なし.
+     * @note    1フレームに1回呼ぶ.(変化した部分だけが端末へ出力される).
      */
-    bool draw(int i_iCol, int i_iRow, CellAttribute::CELL_STATE i_eState);
+    void flush();
 
 	/**
 	 * @brief	ユーザーから入力されたコマンドを取得.
 	 * @param	なし.
-	 * @return	入力されたコマンド.
+	 * @return	入力されたコマンド.(入力が無い場合は'\0').
+	 * @note	非ブロッキングモードなので入力を待たない.
 	 */
 	char getCommand() const
 	{
-		return static_cast<char>(getch());
+		int a_iCh = getch();		// curses ライブラリ.
+		return (ERR == a_iCh)? '\0' : static_cast<char>(a_iCh);
 	}
 
-    /**
-     * @brief   カーソルを上へ移動.
-	 * @param	なし.
-	 * @return	なし.
-     */
-    void moveToUpper();
-
-    /**
-     * @brief   カーソルを下へ移動.
-	 * @param	なし.
-	 * @return	なし.
-     */
-    void moveToLower();
-
-    /**
-     * @brief   カーソルを右へ移動.
-	 * @param	なし.
-	 * @return	なし.
-     */
-    void moveToRight();
-
-    /**
-     * @brief   カーソルを左へ移動.
-	 * @param	なし.
-	 * @return	なし.
-     */
-    void moveToLeft();
-
 	/**
-	 * @brief	Subjectから通知を受信.
-	 * @param	Information* i_pcInformation MatrixCellの属性.
-	 * @return	成功/失敗.
-	 * @note	MatrixCellAttributeのインスタンスが渡されることを想定している.
+	 * @brief	入力を待つためのファイルディスクリプタ.
+	 * @note	cursesは標準入力から読む.
 	 */
-	bool update(Information* i_pcInformation)
-	{
-		this->recieveState(static_cast<MatrixCellAttribute*>(i_pcInformation));
-		return true;
-	}
+	int getInputFd() const { return STDIN_FILENO; }
 
 private:
-	/**
-	 * @brief	表示する文字の定義.
-	 */
-	static const int m_piDispCharacter[CellAttribute::CELL_STATE_MAX];
-
     /**
      * @brief   cursesのウィンドウ.
      */
     WINDOW* m_pWindow;
 
+    /**
+     * @brief   1行分の表示文字.(描画の作業用).
+     */
+    std::vector<wchar_t> m_vecLine;
+
     /**
      * @brief   curses初期化.
      * @param   なし.
      * @return  なし.
      */
     void initDisplay();
-
-	/**
-	 * @brief   MatrixCellの状態を受け取る.
-     * @param   MatrixCellAttribute* i_pcMatrixCellAttribute MatrixCellの状態.
-     * @return  結果.
-     * @retval  true    成功.
-     * @retval  false   失敗.
-	 */
-	bool recieveState(MatrixCellAttribute* i_pcMatrixCellAttribute)
-	{
-		long a_lCol = i_pcMatrixCellAttribute->getCol();
-		long a_lRow = i_pcMatrixCellAttribute->getRow();
-		CellAttribute::CELL_STATE a_eState = i_pcMatrixCellAttribute->getState();
-		this->draw(a_lCol, a_lRow, a_eState);
-		return true;
-	}
-
 };
 
-#endif  // __LIFEGAME_VIEW_H__
-
+#endif  // __LIFEGAME_VIEW_ON_CURSES_H__
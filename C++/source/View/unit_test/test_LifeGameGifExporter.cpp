@@ -0,0 +1,247 @@
+/**********************************************
+ * LifeGameGifExporterクラスのユニットテスト
+ *
+ * 書き出したGIFを読み戻し, 各フレームを重ね合わせた結果が
+ * MatrixCellの各世代と一致するかを確認する.
+ **********************************************/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+
+#include "../LifeGameGifExporter.h"
+#include "../../Model/MatrixCell.h"
+#include "../../Model/BitBoard.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+// 16ビット値を読み出す.(リトルエンディアン).
+long read_word(const vector<unsigned char>& i_vecData, size_t& io_lPos)
+{
+	long a_lValue = i_vecData[io_lPos] | (i_vecData[io_lPos+1] << 8);
+	io_lPos += 2;
+	return a_lValue;
+}
+
+// LZWを復号する.
+vector<unsigned char> decode_lzw(const vector<unsigned char>& i_vecCode, int i_iMinCodeSize)
+{
+	vector<unsigned char> a_vecPixel;
+	vector< vector<unsigned char> > a_vecTable;
+	int a_iClearCode = 1 << i_iMinCodeSize;
+	int a_iCodeSize = i_iMinCodeSize + 1;
+	int a_iPrevCode = -1;
+	unsigned long a_ulBitBuffer = 0;
+	int a_iBitNum = 0;
+	size_t a_lPos = 0;
+
+	for(;;)
+	{
+		while( (a_iBitNum < a_iCodeSize) && (a_lPos < i_vecCode.size()) )
+		{
+			a_ulBitBuffer |= static_cast<unsigned long>(i_vecCode[a_lPos++]) << a_iBitNum;
+			a_iBitNum += 8;
+		}
+		if(a_iBitNum < a_iCodeSize) break;
+		int a_iCode = a_ulBitBuffer & ((1 << a_iCodeSize) - 1);
+		a_ulBitBuffer >>= a_iCodeSize;
+		a_iBitNum -= a_iCodeSize;
+
+		if(a_iClearCode == a_iCode)
+		{
+			a_vecTable.clear();
+			for(int a_iIndex=0; a_iIndex<a_iClearCode+2; a_iIndex++) a_vecTable.push_back(vector<unsigned char>(1, a_iIndex));
+			a_iCodeSize = i_iMinCodeSize + 1;
+			a_iPrevCode = -1;
+			continue;
+		}
+		if(a_iClearCode+1 == a_iCode) break;
+
+		vector<unsigned char> a_vecEntry;
+		if(a_iCode < static_cast<int>(a_vecTable.size())) a_vecEntry = a_vecTable[a_iCode];
+		else
+		{
+			a_vecEntry = a_vecTable[a_iPrevCode];
+			a_vecEntry.push_back(a_vecTable[a_iPrevCode][0]);
+		}
+		a_vecPixel.insert(a_vecPixel.end(), a_vecEntry.begin(), a_vecEntry.end());
+
+		if(0 <= a_iPrevCode)
+		{
+			vector<unsigned char> a_vecNew = a_vecTable[a_iPrevCode];
+			a_vecNew.push_back(a_vecEntry[0]);
+			a_vecTable.push_back(a_vecNew);
+			if( (static_cast<int>(a_vecTable.size()) == (1 << a_iCodeSize)) && (12 > a_iCodeSize) ) a_iCodeSize++;
+		}
+		a_iPrevCode = a_iCode;
+	}
+	return a_vecPixel;
+}
+
+// GIFを読み込み, 各フレームを重ね合わせた画像を返す.
+bool read_gif(const char* i_pPath, long& o_lWidth, long& o_lHeight, vector< vector<unsigned char> >& o_vecFrame)
+{
+	ifstream a_cFile(i_pPath, ios::in | ios::binary);
+	vector<unsigned char> a_vecData((istreambuf_iterator<char>(a_cFile)), istreambuf_iterator<char>());
+	if( (13 > a_vecData.size()) || (0 != string(a_vecData.begin(), a_vecData.begin()+6).compare("GIF89a")) ) return false;
+
+	size_t a_lPos = 6;
+	o_lWidth = read_word(a_vecData, a_lPos);
+	o_lHeight = read_word(a_vecData, a_lPos);
+	int a_iFlag = a_vecData[a_lPos];
+	a_lPos += 3;
+	if(a_iFlag & 0x80) a_lPos += 3 * (2 << (a_iFlag & 7));
+
+	vector<unsigned char> a_vecCanvas(o_lWidth * o_lHeight, 0);
+	while(a_lPos < a_vecData.size())
+	{
+		unsigned char a_byBlock = a_vecData[a_lPos++];
+		if(0x3B == a_byBlock) return true;
+		if(0x21 == a_byBlock)
+		{
+			a_lPos++;
+			while(0 != a_vecData[a_lPos]) a_lPos += a_vecData[a_lPos] + 1;
+			a_lPos++;
+			continue;
+		}
+		if(0x2C != a_byBlock) return false;
+
+		long a_lLeft = read_word(a_vecData, a_lPos);
+		long a_lTop = read_word(a_vecData, a_lPos);
+		long a_lWidth = read_word(a_vecData, a_lPos);
+		long a_lHeight = read_word(a_vecData, a_lPos);
+		a_lPos++;
+		int a_iMinCodeSize = a_vecData[a_lPos++];
+		vector<unsigned char> a_vecCode;
+		while(0 != a_vecData[a_lPos])
+		{
+			a_vecCode.insert(a_vecCode.end(), a_vecData.begin()+a_lPos+1, a_vecData.begin()+a_lPos+1+a_vecData[a_lPos]);
+			a_lPos += a_vecData[a_lPos] + 1;
+		}
+		a_lPos++;
+
+		vector<unsigned char> a_vecPixel = decode_lzw(a_vecCode, a_iMinCodeSize);
+		if(static_cast<long>(a_vecPixel.size()) != a_lWidth * a_lHeight) return false;
+		for(long a_lRow=0; a_lRow<a_lHeight; a_lRow++)
+		{
+			for(long a_lCol=0; a_lCol<a_lWidth; a_lCol++)
+			{
+				a_vecCanvas[(a_lTop + a_lRow) * o_lWidth + a_lLeft + a_lCol] = a_vecPixel[a_lRow * a_lWidth + a_lCol];
+			}
+		}
+		o_vecFrame.push_back(a_vecCanvas);
+	}
+	return false;
+}
+
+// 書き出したGIFの各フレームがMatrixCellの各世代と一致するかをテスト.
+bool test_export(MatrixCell& io_cMatrixCell, long i_lFrameNum, int i_iScale)
+{
+	const char* a_pPath = "test_LifeGameGifExporter.gif";
+	const long a_lColMax = io_cMatrixCell.getColMax();
+	const long a_lRowMax = io_cMatrixCell.getRowMax();
+	const long a_lFrameNum = i_lFrameNum;
+	MatrixCell& a_cMatrixCell = io_cMatrixCell;
+
+	LifeGameGifExporter a_cExporter;
+	bool a_bIsSuccess = a_cExporter.open(a_pPath, a_lColMax, a_lRowMax, i_iScale, 5);
+
+	vector<BitBoard> a_vecExpected(1);
+	a_cMatrixCell.exportBitBoard(a_vecExpected[0]);
+	a_cExporter.drawBoard(a_vecExpected[0]);
+	a_cExporter.writeFrame();
+
+	a_cMatrixCell.attach(&a_cExporter);
+	for(long a_lFrame=1; a_lFrame<a_lFrameNum; a_lFrame++)
+	{
+		a_cMatrixCell.refreshCell();
+		a_cExporter.writeFrame();
+		a_vecExpected.push_back(BitBoard());
+		a_cMatrixCell.exportBitBoard(a_vecExpected.back());
+	}
+	a_cMatrixCell.detach(&a_cExporter);
+	a_cExporter.close();
+
+	long a_lWidth = 0;
+	long a_lHeight = 0;
+	vector< vector<unsigned char> > a_vecFrame;
+	a_bIsSuccess = a_bIsSuccess && read_gif(a_pPath, a_lWidth, a_lHeight, a_vecFrame);
+	remove(a_pPath);
+
+	a_bIsSuccess = a_bIsSuccess && (a_lColMax*i_iScale==a_lWidth) && (a_lRowMax*i_iScale==a_lHeight);
+	a_bIsSuccess = a_bIsSuccess && (a_lFrameNum==static_cast<long>(a_vecFrame.size()));
+	for(long a_lFrame=0; a_bIsSuccess && (a_lFrame<a_lFrameNum); a_lFrame++)
+	{
+		for(long a_lY=0; a_lY<a_lHeight; a_lY++)
+		{
+			for(long a_lX=0; a_lX<a_lWidth; a_lX++)
+			{
+				bool a_bAlive = a_vecExpected[a_lFrame].getBit(a_lX / i_iScale, a_lY / i_iScale);
+				a_bIsSuccess = a_bIsSuccess && ((a_bAlive? 1 : 0) == a_vecFrame[a_lFrame][a_lY * a_lWidth + a_lX]);
+			}
+		}
+	}
+	return a_bIsSuccess;
+}
+
+// グライダーを書き出し.
+bool test_export_glider(int i_iScale)
+{
+	MatrixCell a_cMatrixCell(40L, 30L);
+	a_cMatrixCell.setCellState(2, 1, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(3, 2, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(1, 3, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(2, 3, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(3, 3, CellAttribute::ALIVE);
+	return test_export(a_cMatrixCell, 150, i_iScale);
+}
+
+// ランダムな配置を書き出し.(LZWの辞書が一杯になる場合).
+bool test_export_soup()
+{
+	MatrixCell a_cMatrixCell(200L, 150L);
+	unsigned long a_ulRandom = 12345;
+	for(long a_lRow=0; a_lRow<a_cMatrixCell.getRowMax(); a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<a_cMatrixCell.getColMax(); a_lCol++)
+		{
+			a_ulRandom = a_ulRandom * 1103515245 + 12345;
+			if(0 == ((a_ulRandom >> 16) % 3)) a_cMatrixCell.setCellState(a_lCol, a_lRow, CellAttribute::ALIVE);
+		}
+	}
+	return test_export(a_cMatrixCell, 10, 1);
+}
+
+bool test_Gif_Exporter()
+{
+	bool a_bIsSuccess = false;
+
+	// 等倍で書き出し.
+	a_bIsSuccess = test_export_glider(1);
+	print_test_result("test_export_glider(scale 1)", a_bIsSuccess);
+
+	// 拡大して書き出し.
+	a_bIsSuccess = test_export_glider(3);
+	print_test_result("test_export_glider(scale 3)", a_bIsSuccess);
+
+	// ランダムな配置を書き出し.
+	a_bIsSuccess = test_export_soup();
+	print_test_result("test_export_soup", a_bIsSuccess);
+
+	return true;
+}
+
+int main()
+{
+	test_Gif_Exporter();
+	return 0;
+}
@@ -0,0 +1,326 @@
+/**********************************************
+ * LifeGameImageExporterクラスのユニットテスト
+ *
+ * 書き出したPPM/PNGを読み戻し, 各画像の色が
+ * MatrixCellの各世代から求めた色と一致するかを確認する.
+ **********************************************/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#include "../LifeGameImageExporter.h"
+#include "../../Model/MatrixCell.h"
+#include "../../Model/BitBoard.h"
+#include "../../Lib/Clock.h"
+
+#include <zlib.h>	// BitBoard::WORD_BITと<limits.h>のWORD_BITが衝突するため後で読み込む.
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+// ファイルを全て読み込む.
+bool read_file(const string& i_strPath, vector<unsigned char>& o_vecData)
+{
+	ifstream a_cFile(i_strPath.c_str(), ios::binary);
+	if(!a_cFile) return false;
+	o_vecData.assign(istreambuf_iterator<char>(a_cFile), istreambuf_iterator<char>());
+	return true;
+}
+
+// 32ビット値を読み出す.(ビッグエンディアン).
+unsigned long read_uint32(const vector<unsigned char>& i_vecData, size_t i_lPos)
+{
+	return (static_cast<unsigned long>(i_vecData[i_lPos]) << 24) | (i_vecData[i_lPos+1] << 16) | (i_vecData[i_lPos+2] << 8) | i_vecData[i_lPos+3];
+}
+
+// PPM(P6)を読み込む.
+bool read_ppm(const string& i_strPath, long& o_lWidth, long& o_lHeight, vector<unsigned char>& o_vecPixel)
+{
+	vector<unsigned char> a_vecData;
+	if(!read_file(i_strPath, a_vecData)) return false;
+
+	int a_iMaxValue = 0;
+	int a_iHeaderSize = 0;
+	a_vecData.push_back('\0');
+	if(3 != sscanf(reinterpret_cast<const char*>(&a_vecData[0]), "P6 %ld %ld %d%n", &o_lWidth, &o_lHeight, &a_iMaxValue, &a_iHeaderSize)) return false;
+	a_vecData.pop_back();
+	if(255 != a_iMaxValue) return false;
+
+	size_t a_lPos = a_iHeaderSize + 1;		// 区切りの空白1文字.
+	if(a_lPos + o_lWidth * o_lHeight * 3 != a_vecData.size()) return false;
+	o_vecPixel.assign(a_vecData.begin() + a_lPos, a_vecData.end());
+	return true;
+}
+
+// PNG(8ビットRGB, フィルタなし)を読み込む.
+bool read_png(const string& i_strPath, long& o_lWidth, long& o_lHeight, vector<unsigned char>& o_vecPixel)
+{
+	static const unsigned char s_rgbySignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	vector<unsigned char> a_vecData;
+	if(!read_file(i_strPath, a_vecData)) return false;
+	if( (a_vecData.size() < 8) || !equal(s_rgbySignature, s_rgbySignature + 8, a_vecData.begin()) ) return false;
+
+	vector<unsigned char> a_vecCompressed;
+	bool a_bIsEnd = false;
+	size_t a_lPos = 8;
+	while(!a_bIsEnd && (a_lPos + 12 <= a_vecData.size()))
+	{
+		unsigned long a_ulLength = read_uint32(a_vecData, a_lPos);
+		string a_strType(a_vecData.begin() + a_lPos + 4, a_vecData.begin() + a_lPos + 8);
+		const unsigned char* a_pbyBody = &a_vecData[a_lPos + 8];
+		if(a_lPos + 12 + a_ulLength > a_vecData.size()) return false;
+
+		// CRCは種類と中身から求める.
+		if(crc32(crc32(0, 0, 0), &a_vecData[a_lPos + 4], a_ulLength + 4) != read_uint32(a_vecData, a_lPos + 8 + a_ulLength)) return false;
+
+		if("IHDR" == a_strType)
+		{
+			o_lWidth = read_uint32(a_vecData, a_lPos + 8);
+			o_lHeight = read_uint32(a_vecData, a_lPos + 12);
+			if( (8 != a_pbyBody[8]) || (2 != a_pbyBody[9]) ) return false;		// 8ビットRGBのみ.
+		}
+		else if("IDAT" == a_strType) a_vecCompressed.insert(a_vecCompressed.end(), a_pbyBody, a_pbyBody + a_ulLength);
+		else if("IEND" == a_strType) a_bIsEnd = true;
+		a_lPos += 12 + a_ulLength;
+	}
+	if(!a_bIsEnd) return false;
+
+	long a_lLineSize = o_lWidth * 3 + 1;
+	vector<unsigned char> a_vecRaw(a_lLineSize * o_lHeight);
+	uLongf a_ulRawSize = a_vecRaw.size();
+	if( (Z_OK != uncompress(&a_vecRaw[0], &a_ulRawSize, &a_vecCompressed[0], a_vecCompressed.size())) || (a_ulRawSize != a_vecRaw.size()) ) return false;
+
+	o_vecPixel.clear();
+	for(long a_lRow=0; a_lRow<o_lHeight; a_lRow++)
+	{
+		if(0 != a_vecRaw[a_lRow * a_lLineSize]) return false;		// フィルタなし.
+		o_vecPixel.insert(o_vecPixel.end(), a_vecRaw.begin() + a_lRow * a_lLineSize + 1, a_vecRaw.begin() + (a_lRow + 1) * a_lLineSize);
+	}
+	return true;
+}
+
+// 書き出した画像の色がMatrixCellの各世代から求めた色と一致するかをテスト.
+bool test_export(MatrixCell& io_cMatrixCell, const char* i_pExtension, long i_lGenerationNum, long i_lEvery, int i_iScale,
+	LifeGameImageExporter::COLOR_MODE i_eColorMode, int i_iThreadNum)
+{
+	const string a_strPrefix = "test_LifeGameImageExporter_";
+	const long a_lColMax = io_cMatrixCell.getColMax();
+	const long a_lRowMax = io_cMatrixCell.getRowMax();
+	const long a_lLongAgo = 1L << 20;
+	MatrixCell& a_cMatrixCell = io_cMatrixCell;
+
+	LifeGameImageExporter a_cExporter;
+	bool a_bIsSuccess = a_cExporter.open(a_strPrefix + "%d" + i_pExtension, a_lColMax, a_lRowMax, i_iScale, i_eColorMode, i_iThreadNum);
+
+	// 各セルが最後に変化した世代.(初期配置で生きているセルは世代0).
+	BitBoard a_cPrev;
+	a_cMatrixCell.exportBitBoard(a_cPrev);
+	vector<long> a_vecChanged(a_lColMax * a_lRowMax, -a_lLongAgo);
+	for(long a_lIndex=0; a_lIndex<a_lColMax*a_lRowMax; a_lIndex++)
+	{
+		if(a_cPrev.getBit(a_lIndex % a_lColMax, a_lIndex / a_lColMax)) a_vecChanged[a_lIndex] = 0;
+	}
+
+	// 書き出す世代の期待する色.
+	vector<long> a_vecGeneration;
+	vector< vector<uint32_t> > a_vecExpected;
+	a_cExporter.drawBoard(a_cPrev);
+	a_cExporter.writeFrame();
+
+	a_cMatrixCell.attach(&a_cExporter);
+	for(long a_lGeneration=0; a_lGeneration<=i_lGenerationNum; a_lGeneration++)
+	{
+		if(0 < a_lGeneration)
+		{
+			a_cExporter.nextGeneration();
+			a_cMatrixCell.refreshCell();
+			BitBoard a_cBoard;
+			a_cMatrixCell.exportBitBoard(a_cBoard);
+			for(long a_lIndex=0; a_lIndex<a_lColMax*a_lRowMax; a_lIndex++)
+			{
+				long a_lCol = a_lIndex % a_lColMax;
+				long a_lRow = a_lIndex / a_lColMax;
+				if(a_cBoard.getBit(a_lCol, a_lRow) != a_cPrev.getBit(a_lCol, a_lRow)) a_vecChanged[a_lIndex] = a_lGeneration;
+			}
+			a_cPrev = a_cBoard;
+			if(0 != a_lGeneration % i_lEvery) continue;
+			a_cExporter.writeFrame();
+		}
+
+		a_vecGeneration.push_back(a_lGeneration);
+		a_vecExpected.push_back(vector<uint32_t>(a_lColMax * a_lRowMax));
+		for(long a_lIndex=0; a_lIndex<a_lColMax*a_lRowMax; a_lIndex++)
+		{
+			a_vecExpected.back()[a_lIndex] = LifeGameImageExporter::getColor(i_eColorMode,
+				a_cPrev.getBit(a_lIndex % a_lColMax, a_lIndex / a_lColMax), a_lGeneration - a_vecChanged[a_lIndex]);
+		}
+	}
+	a_cMatrixCell.detach(&a_cExporter);
+	a_bIsSuccess = a_cExporter.close() && a_bIsSuccess;
+	a_bIsSuccess = a_bIsSuccess && (static_cast<long>(a_vecGeneration.size()) == a_cExporter.getFrameNum());
+
+	// 読み戻して比較する.
+	for(size_t a_lFrame=0; a_lFrame<a_vecGeneration.size(); a_lFrame++)
+	{
+		char a_szPath[256];
+		snprintf(a_szPath, sizeof(a_szPath), "%s%ld%s", a_strPrefix.c_str(), a_vecGeneration[a_lFrame], i_pExtension);
+
+		long a_lWidth = 0;
+		long a_lHeight = 0;
+		vector<unsigned char> a_vecPixel;
+		bool a_bIsRead = ('n' == i_pExtension[2])? read_png(a_szPath, a_lWidth, a_lHeight, a_vecPixel) : read_ppm(a_szPath, a_lWidth, a_lHeight, a_vecPixel);
+		remove(a_szPath);
+
+		a_bIsSuccess = a_bIsSuccess && a_bIsRead && (a_lColMax*i_iScale==a_lWidth) && (a_lRowMax*i_iScale==a_lHeight);
+		for(long a_lY=0; a_bIsSuccess && (a_lY<a_lHeight); a_lY++)
+		{
+			for(long a_lX=0; a_lX<a_lWidth; a_lX++)
+			{
+				uint32_t a_uColor = a_vecExpected[a_lFrame][(a_lY / i_iScale) * a_lColMax + a_lX / i_iScale];
+				const unsigned char* a_pbyPixel = &a_vecPixel[(a_lY * a_lWidth + a_lX) * 3];
+				a_bIsSuccess = a_bIsSuccess && (((a_pbyPixel[0] << 16) | (a_pbyPixel[1] << 8) | a_pbyPixel[2]) == static_cast<int>(a_uColor));
+			}
+		}
+	}
+	return a_bIsSuccess;
+}
+
+// グライダーを書き出し.
+bool test_export_glider(const char* i_pExtension, int i_iScale, LifeGameImageExporter::COLOR_MODE i_eColorMode, int i_iThreadNum)
+{
+	MatrixCell a_cMatrixCell(40L, 30L);
+	a_cMatrixCell.setCellState(2, 1, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(3, 2, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(1, 3, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(2, 3, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(3, 3, CellAttribute::ALIVE);
+	// 固定物体(ブロック).(年齢の色が進む).
+	a_cMatrixCell.setCellState(30, 20, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(31, 20, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(30, 21, CellAttribute::ALIVE);
+	a_cMatrixCell.setCellState(31, 21, CellAttribute::ALIVE);
+	return test_export(a_cMatrixCell, i_pExtension, 60, 4, i_iScale, i_eColorMode, i_iThreadNum);
+}
+
+// 色の定義.
+bool test_color()
+{
+	bool a_bIsSuccess = true;
+	a_bIsSuccess = a_bIsSuccess && (0xFFFFFF == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_MONO, true, 100));
+	a_bIsSuccess = a_bIsSuccess && (0x000000 == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_MONO, false, 0));
+	// 年齢: 生まれたては白, 長生きは青.
+	a_bIsSuccess = a_bIsSuccess && (0xFFFFFF == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_AGE, true, 0));
+	a_bIsSuccess = a_bIsSuccess && (0x4040FF == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_AGE, true, 100000));
+	a_bIsSuccess = a_bIsSuccess && (0x000000 == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_AGE, false, 0));
+	// 熱: 死んだ直後は赤, 時間が経つと黒.
+	a_bIsSuccess = a_bIsSuccess && (0xFF0000 == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_HEAT, false, 0));
+	a_bIsSuccess = a_bIsSuccess && (0x000000 == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_HEAT, false, LifeGameImageExporter::HEAT_MAX));
+	a_bIsSuccess = a_bIsSuccess && (LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_HEAT, false, 1) > LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_HEAT, false, 2));
+	a_bIsSuccess = a_bIsSuccess && (0xFFFFFF == LifeGameImageExporter::getColor(LifeGameImageExporter::COLOR_HEAT, true, 5));
+	return a_bIsSuccess;
+}
+
+// ファイルパスの書式.
+bool test_path()
+{
+	const char* a_pPath = "test_LifeGameImageExporter_path000000.ppm";
+	bool a_bIsSuccess = true;
+	LifeGameImageExporter a_cExporter;
+
+	// '%'が無ければ世代を補う.
+	a_bIsSuccess = a_bIsSuccess && a_cExporter.open("test_LifeGameImageExporter_path.ppm", 8, 8);
+	a_cExporter.writeFrame();
+	a_bIsSuccess = a_cExporter.close() && a_bIsSuccess;
+	a_bIsSuccess = a_bIsSuccess && (0 == remove(a_pPath));
+
+	// 世代以外の書式は使えない.
+	a_bIsSuccess = a_bIsSuccess && !a_cExporter.open("test_%s.ppm", 8, 8);
+	a_bIsSuccess = a_bIsSuccess && !a_cExporter.open("test_%d_%d.ppm", 8, 8);
+	a_bIsSuccess = a_bIsSuccess && !a_cExporter.isOpen();
+	return a_bIsSuccess;
+}
+
+// 大きな盤面を書き出す時間を計測.(スレッド数による違い).
+void bench_render()
+{
+	const long a_lSize = 2048;
+	const int a_iFrameNum = 8;
+	BitBoard a_cBoard(a_lSize, a_lSize);
+	unsigned long a_ulRandom = 12345;
+	for(long a_lRow=0; a_lRow<a_lSize; a_lRow++)
+	{
+		for(long a_lCol=0; a_lCol<a_lSize; a_lCol++)
+		{
+			a_ulRandom = a_ulRandom * 1103515245 + 12345;
+			if(0 == ((a_ulRandom >> 16) % 3)) a_cBoard.setBit(a_lCol, a_lRow, true);
+		}
+	}
+
+	for(int a_iThreadNum=1; a_iThreadNum<=4; a_iThreadNum*=2)
+	{
+		LifeGameImageExporter a_cExporter;
+		a_cExporter.open("test_LifeGameImageExporter_bench%d.png", a_lSize, a_lSize, 1, LifeGameImageExporter::COLOR_AGE, a_iThreadNum);
+		a_cExporter.drawBoard(a_cBoard);
+		double a_dStart = getSecond();
+		for(int a_iFrame=0; a_iFrame<a_iFrameNum; a_iFrame++)
+		{
+			a_cExporter.nextGeneration();
+			a_cExporter.writeFrame();
+		}
+		a_cExporter.close();
+		double a_dElapsed = getSecond() - a_dStart;
+		for(int a_iFrame=1; a_iFrame<=a_iFrameNum; a_iFrame++)
+		{
+			char a_szPath[256];
+			snprintf(a_szPath, sizeof(a_szPath), "test_LifeGameImageExporter_bench%d.png", a_iFrame);
+			remove(a_szPath);
+		}
+		cout << "bench_render(" << a_lSize << "x" << a_lSize << " png, threads " << a_iThreadNum << "): "
+			<< (a_dElapsed * 1000.0 / a_iFrameNum) << " msec/frame" << endl;
+	}
+}
+
+bool test_Image_Exporter()
+{
+	bool a_bIsSuccess = false;
+
+	a_bIsSuccess = test_color();
+	print_test_result("test_color", a_bIsSuccess);
+
+	a_bIsSuccess = test_path();
+	print_test_result("test_path", a_bIsSuccess);
+
+	// PPMを等倍で書き出し.
+	a_bIsSuccess = test_export_glider(".ppm", 1, LifeGameImageExporter::COLOR_MONO, 1);
+	print_test_result("test_export_glider(ppm, mono)", a_bIsSuccess);
+
+	// PNGを拡大して書き出し.
+	a_bIsSuccess = test_export_glider(".png", 3, LifeGameImageExporter::COLOR_MONO, 1);
+	print_test_result("test_export_glider(png, mono, scale 3)", a_bIsSuccess);
+
+	// 年齢/熱の色付けを複数スレッドで描画.
+	a_bIsSuccess = test_export_glider(".png", 2, LifeGameImageExporter::COLOR_AGE, 4);
+	print_test_result("test_export_glider(png, age, 4 threads)", a_bIsSuccess);
+
+	a_bIsSuccess = test_export_glider(".ppm", 1, LifeGameImageExporter::COLOR_HEAT, 3);
+	print_test_result("test_export_glider(ppm, heat, 3 threads)", a_bIsSuccess);
+
+	bench_render();
+	return true;
+}
+
+int main()
+{
+	test_Image_Exporter();
+	return 0;
+}
@@ -0,0 +1,406 @@
+/**********************************************
+ * LifeGameViewOnAnsiクラスのユニットテスト
+ *
+ * 端末の代わりにパイプへ出力し, 出力したエスケープシーケンスを
+ * 簡易的な端末で再生した画面がMatrixCellの状態と一致するかを確認する.
+ **********************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+
+#include "../LifeGameViewOnAnsi.h"
+#include "../../Model/MatrixCell.h"
+#include "../../Model/BitBoard.h"
+
+using namespace std;
+
+void print_test_result(const char* i_pMessage, bool i_bIsSuccess)
+{
+	cout << i_pMessage << ": ";
+	if(i_bIsSuccess) cout << "OK";
+	else cout << "NG";
+	cout << endl;
+}
+
+// パイプに出力されたバイト列を読み出す.
+string read_output(int i_iInput, long i_lSize)
+{
+	string a_strOutput(i_lSize, '\0');
+	long a_lRead = 0;
+	while(a_lRead < i_lSize)
+	{
+		ssize_t a_lRet = read(i_iInput, &a_strOutput[a_lRead], i_lSize - a_lRead);
+		if(0 >= a_lRet) break;
+		a_lRead += a_lRet;
+	}
+	a_strOutput.resize(a_lRead);
+	return a_strOutput;
+}
+
+/**
+ * 簡易的な端末.(CUP, CUFとUTF-8の文字のみ).
+ */
+class Terminal
+{
+public:
+	Terminal(long i_lColMax, long i_lRowMax)
+		: m_lColMax(i_lColMax), m_lRowMax(i_lRowMax), m_lCol(0), m_lRow(0), m_vecScreen(i_lColMax * i_lRowMax, L' ') { }
+
+	// バイト列を再生する.(解釈できない場合はfalse).
+	bool play(const string& i_strOutput)
+	{
+		size_t a_lPos = 0;
+		while(a_lPos < i_strOutput.size())
+		{
+			unsigned char a_byData = i_strOutput[a_lPos];
+			if(0x1b == a_byData)
+			{
+				// "ESC [ 数字 ; 数字 文字".
+				if( (a_lPos + 1 >= i_strOutput.size()) || ('[' != i_strOutput[a_lPos+1]) ) return false;
+				a_lPos += 2;
+				long a_rglParam[2] = { 0, 0 };
+				int a_iParamNum = 0;
+				while( (a_lPos < i_strOutput.size()) && (('0' <= i_strOutput[a_lPos] && '9' >= i_strOutput[a_lPos]) || (';' == i_strOutput[a_lPos]) || ('?' == i_strOutput[a_lPos])) )
+				{
+					char a_ch = i_strOutput[a_lPos++];
+					if(';' == a_ch) a_iParamNum++;
+					else if('?' != a_ch && 2 > a_iParamNum) a_rglParam[a_iParamNum] = a_rglParam[a_iParamNum] * 10 + (a_ch - '0');
+				}
+				if(a_lPos >= i_strOutput.size()) return false;
+				char a_chCommand = i_strOutput[a_lPos++];
+				if('H' == a_chCommand)
+				{
+					this->m_lRow = (0 < a_rglParam[0])? a_rglParam[0] - 1 : 0;
+					this->m_lCol = (0 < a_rglParam[1])? a_rglParam[1] - 1 : 0;
+				}
+				else if('C' == a_chCommand)
+				{
+					this->m_lCol += (0 < a_rglParam[0])? a_rglParam[0] : 1;
+				}
+				// 画面の切り替え(h/l)と消去(J)は無視する.
+				continue;
+			}
+
+			// UTF-8.
+			unsigned long a_ulCode = a_byData;
+			int a_iFollow = 0;
+			if(0xE0 == (a_byData & 0xF0))      { a_ulCode = a_byData & 0x0F; a_iFollow = 2; }
+			else if(0xC0 == (a_byData & 0xE0)) { a_ulCode = a_byData & 0x1F; a_iFollow = 1; }
+			a_lPos++;
+			for(int a_iIndex=0; a_iIndex<a_iFollow; a_iIndex++)
+			{
+				if(a_lPos >= i_strOutput.size()) return false;
+				a_ulCode = (a_ulCode << 6) | (static_cast<unsigned char>(i_strOutput[a_lPos++]) & 0x3F);
+			}
+			if( (this->m_lCol >= this->m_lColMax) || (this->m_lRow >= this->m_lRowMax) ) return false;
+			this->m_vecScreen[this->m_lRow * this->m_lColMax + this->m_lCol] = static_cast<wchar_t>(a_ulCode);
+			this->m_lCol++;
+		}
+		return true;
+	}
+
+	wchar_t get(long i_lCol, long i_lRow) const { return this->m_vecScreen[i_lRow * this->m_lColMax + i_lCol]; }
+	long getCol() const { return this->m_lCol; }
+	long getRow() const { return this->m_lRow; }
+
+private:
+	long m_lColMax;
+	long m_lRowMax;
+	long m_lCol;
+	long m_lRow;
+	vector<wchar_t> m_vecScreen;
+};
+
+// 変化したセルだけがカーソル移動と共に出力されるかをテスト.
+bool test_diff_output()
+{
+	int a_rgiOutput[2];
+	if(0 != pipe(a_rgiOutput)) return false;
+
+	bool a_bIsSuccess = true;
+	{
+		LifeGameViewOnAnsi a_cView(a_rgiOutput[0], a_rgiOutput[1]);
+		read_output(a_rgiOutput[0], a_cView.getOutputSize());
+
+		// 端末でない場合は既定の大きさ.
+		a_bIsSuccess = a_bIsSuccess && (LifeGameViewOnAnsi::DEFAULT_SCREEN_COL_MAX == a_cView.getScreenColMax());
+		a_bIsSuccess = a_bIsSuccess && (LifeGameViewOnAnsi::DEFAULT_SCREEN_ROW_MAX == a_cView.getScreenRowMax());
+
+		// 1セル. 移動して書いた後にカーソルを戻す.
+		a_cView.draw(3, 2, CellAttribute::ALIVE);
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && ("\x1b[3;4H*\x1b[1;1H" == read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+
+		// 変化が無ければ出力しない.
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && (0 == a_cView.getOutputSize());
+
+		// 近い変化は間の文字を書き直し, 遠い変化は相対移動する.
+		a_cView.draw(10, 5, CellAttribute::ALIVE);
+		a_cView.draw(11, 5, CellAttribute::ALIVE);
+		a_cView.draw(12, 5, CellAttribute::ALIVE);
+		a_cView.draw(15, 5, CellAttribute::ALIVE);
+		a_cView.draw(30, 5, CellAttribute::ALIVE);
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && ("\x1b[6;11H***  *\x1b[14C*\x1b[1;1H" == read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+
+		// カーソルの移動のみ.
+		a_cView.moveToRight();
+		a_cView.moveToLower();
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && ("\x1b[2;2H" == read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+	}
+	close(a_rgiOutput[0]);
+	close(a_rgiOutput[1]);
+	return a_bIsSuccess;
+}
+
+// 世代を進めながら出力を再生した画面がMatrixCellと一致するかをテスト.
+bool test_replay_generations(bool i_bIsHalfBlock, long& o_lTotalSize, long& o_lFrameNum)
+{
+	int a_rgiOutput[2];
+	if(0 != pipe(a_rgiOutput)) return false;
+
+	bool a_bIsSuccess = true;
+	o_lTotalSize = 0;
+	o_lFrameNum = 0;
+	{
+		LifeGameViewOnAnsi a_cView(a_rgiOutput[0], a_rgiOutput[1]);
+		read_output(a_rgiOutput[0], a_cView.getOutputSize());
+		long a_lScreenColMax = a_cView.getScreenColMax();
+		long a_lScreenRowMax = a_cView.getScreenRowMax();
+		Terminal a_cTerminal(a_lScreenColMax, a_lScreenRowMax);
+
+		long a_lRowMax = i_bIsHalfBlock? a_lScreenRowMax * 2 : a_lScreenRowMax;
+		MatrixCell a_cMatrixCell(a_lScreenColMax, a_lRowMax);
+		unsigned long a_ulRandom = 12345;
+		for(long a_lRow=0; a_lRow<a_lRowMax; a_lRow++)
+		{
+			for(long a_lCol=0; a_lCol<a_lScreenColMax; a_lCol++)
+			{
+				a_ulRandom = a_ulRandom * 1103515245 + 12345;
+				if(0 == ((a_ulRandom >> 16) % 3)) a_cMatrixCell.setCellState(a_lCol, a_lRow, CellAttribute::ALIVE);
+			}
+		}
+
+		a_cView.init(a_lScreenColMax, a_lRowMax);
+		if(i_bIsHalfBlock) a_cView.zoomOut();
+		BitBoard a_cBoard;
+		a_cMatrixCell.exportBitBoard(a_cBoard);
+		a_cView.drawBoard(a_cBoard);
+		a_cMatrixCell.attach(&a_cView);
+
+		for(int a_iGeneration=0; (a_iGeneration<50) && a_bIsSuccess; a_iGeneration++)
+		{
+			if(0 < a_iGeneration) a_cMatrixCell.refreshCell();
+			a_cView.flush();
+			if(0 < a_iGeneration)
+			{
+				o_lTotalSize += a_cView.getOutputSize();
+				o_lFrameNum++;
+			}
+			a_bIsSuccess = a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+
+			for(long a_lRow=0; (a_lRow<a_lScreenRowMax) && a_bIsSuccess; a_lRow++)
+			{
+				for(long a_lCol=0; a_lCol<a_lScreenColMax; a_lCol++)
+				{
+					wchar_t a_wExpected = L' ';
+					if(i_bIsHalfBlock)
+					{
+						static const wchar_t a_rgwHalfBlock[4] = { L' ', L'▀', L'▄', L'█' };
+						int a_iUpper = (CellAttribute::ALIVE == a_cMatrixCell.getCellState(a_lCol, a_lRow * 2))? 1 : 0;
+						int a_iLower = (CellAttribute::ALIVE == a_cMatrixCell.getCellState(a_lCol, a_lRow * 2 + 1))? 2 : 0;
+						a_wExpected = a_rgwHalfBlock[a_iUpper | a_iLower];
+					}
+					else if(CellAttribute::ALIVE == a_cMatrixCell.getCellState(a_lCol, a_lRow))
+					{
+						a_wExpected = L'*';
+					}
+					if(a_wExpected != a_cTerminal.get(a_lCol, a_lRow)) a_bIsSuccess = false;
+				}
+			}
+			a_bIsSuccess = a_bIsSuccess && (0 == a_cTerminal.getCol()) && (0 == a_cTerminal.getRow());
+		}
+		a_cMatrixCell.detach(&a_cView);
+	}
+	close(a_rgiOutput[0]);
+	close(a_rgiOutput[1]);
+	return a_bIsSuccess;
+}
+
+// 入力を待たずにコマンドを取得できるかをテスト.
+bool test_get_command()
+{
+	int a_rgiInput[2];
+	int a_rgiOutput[2];
+	if( (0 != pipe(a_rgiInput)) || (0 != pipe(a_rgiOutput)) ) return false;
+
+	bool a_bIsSuccess = true;
+	{
+		LifeGameViewOnAnsi a_cView(a_rgiInput[0], a_rgiOutput[1]);
+		a_bIsSuccess = a_bIsSuccess && ('\0' == a_cView.getCommand());
+		a_bIsSuccess = a_bIsSuccess && (2 == write(a_rgiInput[1], "sq", 2));
+		a_bIsSuccess = a_bIsSuccess && ('s' == a_cView.getCommand());
+		a_bIsSuccess = a_bIsSuccess && ('q' == a_cView.getCommand());
+		a_bIsSuccess = a_bIsSuccess && ('\0' == a_cView.getCommand());
+	}
+	close(a_rgiInput[0]);
+	close(a_rgiInput[1]);
+	close(a_rgiOutput[0]);
+	close(a_rgiOutput[1]);
+	return a_bIsSuccess;
+}
+
+// ステータス行をテスト.(最下行に表示し, 盤面はその上に表示する).
+bool test_status_line()
+{
+	int a_rgiOutput[2];
+	if(0 != pipe(a_rgiOutput)) return false;
+
+	bool a_bIsSuccess = true;
+	{
+		LifeGameViewOnAnsi a_cView(a_rgiOutput[0], a_rgiOutput[1]);
+		read_output(a_rgiOutput[0], a_cView.getOutputSize());
+		long a_lScreenColMax = a_cView.getScreenColMax();
+		long a_lScreenRowMax = a_cView.getScreenRowMax();
+		long a_lLastRow = a_lScreenRowMax - 1;
+		Terminal a_cTerminal(a_lScreenColMax, a_lScreenRowMax);
+
+		// 盤面の最下行に生きているセルを置く.
+		a_cView.init(a_lScreenColMax, a_lScreenRowMax);
+		a_cView.draw(3, a_lLastRow, CellAttribute::ALIVE);
+		a_cView.setStatus("gen 1 | pop 1");
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+		a_bIsSuccess = a_bIsSuccess && (L'*' == a_cTerminal.get(3, a_lLastRow));
+
+		// 表示すると最下行はステータス行になる.
+		a_cView.showStatus(true);
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+		a_bIsSuccess = a_bIsSuccess && (L'g' == a_cTerminal.get(0, a_lLastRow)) && (L'1' == a_cTerminal.get(12, a_lLastRow))
+			&& (L' ' == a_cTerminal.get(13, a_lLastRow)) && (L' ' == a_cTerminal.get(3, a_lLastRow - 1));
+
+		// 文字列の変更はステータス行だけを出力する.
+		a_cView.setStatus("gen 2 | pop 1");
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && (a_cView.getOutputSize() < a_lScreenColMax);
+		a_bIsSuccess = a_bIsSuccess && a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+		a_bIsSuccess = a_bIsSuccess && (L'2' == a_cTerminal.get(4, a_lLastRow));
+
+		// 盤面の最下行へカーソルを動かすと, 表示範囲が1行下がる.
+		a_cView.moveCursor(3, a_lLastRow);
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+		a_bIsSuccess = a_bIsSuccess && (L'*' == a_cTerminal.get(3, a_lLastRow - 1))
+			&& (3 == a_cTerminal.getCol()) && (a_lLastRow - 1 == a_cTerminal.getRow());
+
+		// 非表示にすると盤面全体が見えるので, 表示範囲は元に戻る.
+		a_cView.showStatus(false);
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+		a_bIsSuccess = a_bIsSuccess && (L'*' == a_cTerminal.get(3, a_lLastRow)) && (L' ' == a_cTerminal.get(0, a_lLastRow))
+			&& (a_lLastRow == a_cTerminal.getRow());
+	}
+	close(a_rgiOutput[0]);
+	close(a_rgiOutput[1]);
+	return a_bIsSuccess;
+}
+
+// 見えている範囲と, 矩形だけの描画をテスト.
+bool test_view_region()
+{
+	int a_rgiOutput[2];
+	if(0 != pipe(a_rgiOutput)) return false;
+
+	bool a_bIsSuccess = true;
+	{
+		LifeGameViewOnAnsi a_cView(a_rgiOutput[0], a_rgiOutput[1]);
+		read_output(a_rgiOutput[0], a_cView.getOutputSize());
+		long a_lScreenColMax = a_cView.getScreenColMax();
+		long a_lScreenRowMax = a_cView.getScreenRowMax();
+		Terminal a_cTerminal(a_lScreenColMax, a_lScreenRowMax);
+		long a_lCol, a_lRow, a_lWidth, a_lHeight;
+
+		// 盤面が端末より大きい場合は端末の大きさ.
+		a_cView.init(a_lScreenColMax * 3, a_lScreenRowMax * 3);
+		a_cView.getViewRegion(a_lCol, a_lRow, a_lWidth, a_lHeight);
+		a_bIsSuccess = a_bIsSuccess && (0 == a_lCol) && (0 == a_lRow) && (a_lScreenColMax == a_lWidth) && (a_lScreenRowMax == a_lHeight);
+
+		// ステータス行の分だけ減り, 半ブロック表示では縦2倍.
+		a_cView.showStatus(true);
+		a_cView.zoomOut();
+		a_cView.getViewRegion(a_lCol, a_lRow, a_lWidth, a_lHeight);
+		a_bIsSuccess = a_bIsSuccess && (a_lScreenColMax == a_lWidth) && ((a_lScreenRowMax - 1) * 2 == a_lHeight);
+
+		// 右下の端では盤面の端で切り詰める.(縮小表示は端末より大きな範囲になる).
+		a_cView.zoomOut();
+		a_cView.zoomOut();
+		a_cView.moveCursor(a_lScreenColMax * 3 - 1, a_lScreenRowMax * 3 - 1);
+		a_cView.getViewRegion(a_lCol, a_lRow, a_lWidth, a_lHeight);
+		a_bIsSuccess = a_bIsSuccess && (a_lScreenColMax * 3 == a_lCol + a_lWidth) && (a_lScreenRowMax * 3 == a_lRow + a_lHeight);
+		a_bIsSuccess = a_bIsSuccess && (0 <= a_lCol) && (0 <= a_lRow);
+
+		// 矩形の外は写さない.
+		a_cView.zoomIn();
+		a_cView.zoomIn();
+		a_cView.zoomIn();
+		a_cView.showStatus(false);
+		a_cView.moveCursor(0, 0);
+		BitBoard a_cBoard(a_lScreenColMax * 3, a_lScreenRowMax * 3);
+		a_cBoard.fillRect(0, 0, a_cBoard.getColMax(), a_cBoard.getRowMax(), true);
+		a_cView.drawRegion(a_cBoard, 0, 0, 70, 5);
+		a_cView.flush();
+		a_bIsSuccess = a_bIsSuccess && a_cTerminal.play(read_output(a_rgiOutput[0], a_cView.getOutputSize()));
+		a_bIsSuccess = a_bIsSuccess && (L'*' == a_cTerminal.get(69, 4)) && (L' ' == a_cTerminal.get(70, 4)) && (L' ' == a_cTerminal.get(69, 5));
+	}
+	close(a_rgiOutput[0]);
+	close(a_rgiOutput[1]);
+	return a_bIsSuccess;
+}
+
+bool test_View_On_Ansi()
+{
+	bool a_bIsSuccess = false;
+	long a_lTotalSize = 0;
+	long a_lFrameNum = 0;
+
+	// 差分の出力をテスト.
+	a_bIsSuccess = test_diff_output();
+	print_test_result("test_diff_output", a_bIsSuccess);
+
+	// 1文字 = 1セルで再生.
+	a_bIsSuccess = test_replay_generations(false, a_lTotalSize, a_lFrameNum);
+	print_test_result("test_replay_generations(cell)", a_bIsSuccess);
+	printf("average output: %.0f bytes/frame (full screen: %d chars)\n",
+		static_cast<double>(a_lTotalSize) / a_lFrameNum,
+		LifeGameViewOnAnsi::DEFAULT_SCREEN_COL_MAX * LifeGameViewOnAnsi::DEFAULT_SCREEN_ROW_MAX);
+
+	// 半ブロック表示で再生.
+	a_bIsSuccess = test_replay_generations(true, a_lTotalSize, a_lFrameNum);
+	print_test_result("test_replay_generations(half block)", a_bIsSuccess);
+
+	// コマンドの取得をテスト.
+	a_bIsSuccess = test_get_command();
+	print_test_result("test_get_command", a_bIsSuccess);
+
+	// ステータス行をテスト.
+	a_bIsSuccess = test_status_line();
+	print_test_result("test_status_line", a_bIsSuccess);
+
+	// 見えている範囲をテスト.
+	a_bIsSuccess = test_view_region();
+	print_test_result("test_view_region", a_bIsSuccess);
+
+	return true;
+}
+
+int main()
+{
+	test_View_On_Ansi();
+	return 0;
+}
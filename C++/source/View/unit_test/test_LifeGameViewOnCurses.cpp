@@ -66,6 +66,7 @@ bool test_LifeGameDisplayOnCurses()
 
 	do{
 		a_ch = getCommand(&a_pcLifeGameView);
+		a_pcLifeGameView.flush();
 	}while('q'!=a_ch);
 
 	return true;
@@ -2,21 +2,96 @@
  * @file    main.cpp
  * @brief   ライフゲームのmain関数.
  */
-#include <unistd.h>
+#include <cstdio>
 #include "./Controller/LifeGameController.h"
+#include "./Controller/LifeGameBatchController.h"
+#include "./Controller/LifeGameServer.h"
+#include "./Controller/LifeGameOption.h"
+#include "./Lib/Tracer.h"
 
-#define DELAY   (100*1000)  // スリープの時間.単位はマイクロ秒.
-
-int main(int argc, char* argv[])
+/**
+ * @brief   指定されたモードで実行する.
+ * @param   const LifeGameOption& i_cOption コマンドライン引数.
+ * @return  終了コード.
+ * @note    戻るときには全てのスレッドが終了している.
+ */
+static int run(const LifeGameOption& i_cOption)
 {
-	LifeGameController a_cController;
+	// 端末を使わずにソケットからの要求に応える.
+	if(!i_cOption.getServePath().empty())
+	{
+		LifeGameServer a_cServer(i_cOption);
+		return a_cServer.run()? 0 : 1;
+	}
+
+	// 端末を使わずに実行.
+	if(i_cOption.isBatch())
+	{
+		LifeGameBatchController a_cBatchController(i_cOption);
+		return a_cBatchController.run()? 0 : 1;
+	}
+
+	LifeGameController a_cController(i_cOption);
 
     LifeGameController::LIFEGAME_EVENT a_eEvent = LifeGameController::EV_NONE;
     do{
         a_eEvent = a_cController.eventLoop();
-        usleep(DELAY);                  // スリープ.
+        a_cController.waitNextEvent();  // 入力, または次のフレームまで待つ.
     }while(LifeGameController::EV_QUIT != a_eEvent);
 
     return 0;
 }
 
+int main(int argc, char* argv[])
+{
+	LifeGameOption a_cOption;
+	if( !a_cOption.parse(argc, argv) || !a_cOption.loadPattern() )
+	{
+		fprintf(stderr, "%s\n%s", a_cOption.getError().c_str(), LifeGameOption::getUsage(argv[0]).c_str());
+		return 1;
+	}
+	if(a_cOption.isHelp())
+	{
+		printf("%s", LifeGameOption::getUsage(argv[0]).c_str());
+		return 0;
+	}
+
+	// 盤面を確保せずにメモリの量を見積もる.(--estimate-memory).
+	if(a_cOption.isEstimateMemory())
+	{
+		long a_lCol = (0 < a_cOption.getColMax())? a_cOption.getColMax() : LifeGameBatchController::DEFAULT_COL_MAX;
+		long a_lRow = (0 < a_cOption.getRowMax())? a_cOption.getRowMax() : LifeGameBatchController::DEFAULT_ROW_MAX;
+		MemoryUsage a_cUsage;
+		LifeGameBatchController::estimateMemoryUsage(a_cOption, a_cUsage);
+		printf("size        : %ldx%ld\n", a_lCol, a_lRow);
+		printf("memory      : ");
+		a_cUsage.dump(stdout);
+		printf("per cell    : %.1f byte\n", static_cast<double>(a_cUsage.getTotal()) / (static_cast<double>(a_lCol) * a_lRow));
+		return 0;
+	}
+
+	// 処理の区間を記録する.(--trace FILE).
+	const std::string& a_strTracePath = a_cOption.getTracePath();
+	if(!a_strTracePath.empty())
+	{
+		TRACE_THREAD_NAME("main");
+		Tracer::getInstance().start();
+	}
+
+	int a_iRet = run(a_cOption);
+
+	if(!a_strTracePath.empty())
+	{
+		Tracer::getInstance().stop();
+		if(!Tracer::getInstance().save(a_strTracePath))
+		{
+			fprintf(stderr, "cannot save: %s\n", a_strTracePath.c_str());
+			a_iRet = 1;
+		}
+		else if(0 < Tracer::getInstance().getDropNum())
+		{
+			fprintf(stderr, "trace: %ld events dropped\n", Tracer::getInstance().getDropNum());
+		}
+	}
+	return a_iRet;
+}
@@ -12,9 +12,25 @@ TARGET = LifeGameView
 TEMPLATE = app
 
 
+# C++版のLib(Profiler, SpscQueue)はalignas(64)の型をnewするため, C++17で作る.(C++版のMakefileのg++の既定と同じ).
+CONFIG   += c++17
+QMAKE_CXXFLAGS += -pthread
+LIBS     += -pthread
+
+# Modelは C++版のソースを使う.
+LIFEGAME_SOURCE = ../../../../C++/source
+
 SOURCES += main.cpp\
-        widget.cpp
+        widget.cpp\
+        lifegamecanvas.cpp\
+        $$LIFEGAME_SOURCE/Model/MatrixCell.cpp\
+        $$LIFEGAME_SOURCE/Model/Cell.cpp\
+        $$LIFEGAME_SOURCE/Model/BitBoard.cpp\
+        $$LIFEGAME_SOURCE/Model/SoupGenerator.cpp\
+        $$LIFEGAME_SOURCE/Model/PatternFile.cpp\
+        $$LIFEGAME_SOURCE/Controller/LifeGameOption.cpp
 
-HEADERS  += widget.h
+HEADERS  += widget.h\
+        lifegamecanvas.h
 
 FORMS    += widget.ui
@@ -0,0 +1,180 @@
+#include "lifegamecanvas.h"
+
+#include <QPainter>
+
+// 表示色.(GIFの書き出しと同じ).
+static const QRgb s_rgColor[LifeGameCanvas::COLOR_MAX] = {
+    qRgb(0x00, 0x00, 0x00),    // COLOR_DEAD.
+    qRgb(0xFF, 0xFF, 0xFF),    // COLOR_ALIVE.
+};
+
+/*******************
+ * コンストラクタ.
+ *******************/
+LifeGameCanvas::LifeGameCanvas(QWidget *parent) :
+    QWidget(parent)
+{
+    this->m_bIsDirty = false;
+    this->m_bIsScaledDirty = true;
+
+    // 毎回全体を描画するため背景の消去は不要.
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+/***************************
+ * 盤面の大きさを設定する.
+ ***************************/
+void LifeGameCanvas::init(long i_lColMax, long i_lRowMax)
+{
+    this->m_cImage = QImage(static_cast<int>(i_lColMax), static_cast<int>(i_lRowMax), QImage::Format_MonoLSB);
+    QVector<QRgb> a_vecColor;
+    a_vecColor << s_rgColor[COLOR_DEAD] << s_rgColor[COLOR_ALIVE];
+    this->m_cImage.setColorTable(a_vecColor);
+    this->m_cImage.fill(static_cast<uint>(COLOR_DEAD));
+
+    this->m_bIsDirty = true;
+    this->m_bIsScaledDirty = true;
+}
+
+/**********************************
+ * セルの状態を描画.
+ **********************************/
+bool LifeGameCanvas::draw(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+{
+    if( (0>i_lCol) || (this->getColMax()<=i_lCol) || (0>i_lRow) || (this->getRowMax()<=i_lRow) ) return false;
+
+    // setPixel()を使わずに行のビットを直接書き換える.
+    uchar* a_pLine = this->m_cImage.scanLine(static_cast<int>(i_lRow));
+    uchar a_byMask = static_cast<uchar>(1 << (i_lCol & 7));
+    if(CellAttribute::ALIVE == i_eState) a_pLine[i_lCol >> 3] |= a_byMask;
+    else                                 a_pLine[i_lCol >> 3] &= ~a_byMask;
+
+    this->m_bIsDirty = true;
+    this->m_bIsScaledDirty = true;
+    return true;
+}
+
+/**********************************
+ * 全セルの状態を描画.
+ **********************************/
+void LifeGameCanvas::drawBoard(const BitBoard& i_cBoard)
+{
+    long a_lColMax = (i_cBoard.getColMax() < this->getColMax())? i_cBoard.getColMax() : this->getColMax();
+    long a_lRowMax = (i_cBoard.getRowMax() < this->getRowMax())? i_cBoard.getRowMax() : this->getRowMax();
+    long a_lByteNum = (a_lColMax + 7) / 8;
+
+    // BitBoardのワードも画像の行も左端が下位ビットのため, ワードを下位バイトから並べればよい.
+    for(long a_lRow=0; a_lRow<a_lRowMax; a_lRow++)
+    {
+        const BitBoard::WORD* a_pWord = i_cBoard.getRow(a_lRow);
+        uchar* a_pLine = this->m_cImage.scanLine(static_cast<int>(a_lRow));
+        for(long a_lByte=0; a_lByte<a_lByteNum; a_lByte++)
+        {
+            a_pLine[a_lByte] = static_cast<uchar>(a_pWord[a_lByte / 8] >> ((a_lByte % 8) * 8));
+        }
+    }
+
+    this->m_bIsDirty = true;
+    this->m_bIsScaledDirty = true;
+}
+
+/**********************************
+ * 描画した内容を画面へ反映する.
+ **********************************/
+void LifeGameCanvas::flush()
+{
+    if(!this->m_bIsDirty) return;
+    this->m_bIsDirty = false;
+
+    // 再描画はQtのイベントループで1回にまとめられる.
+    QWidget::update();
+}
+
+/**********************************
+ * Subjectから通知を受信.
+ **********************************/
+bool LifeGameCanvas::update(const MatrixCellAttribute* i_pcAttribute)
+{
+    // 矩形の一括通知の場合は変化したセルを全て描画.
+    i_pcAttribute->forEachChanged([this](long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState)
+    {
+        this->draw(i_lCol, i_lRow, i_eState);
+    });
+    return true;
+}
+
+/**********************************
+ * 盤面を表示する矩形.
+ **********************************/
+QRect LifeGameCanvas::getTargetRect() const
+{
+    if( (0 >= this->getColMax()) || (0 >= this->getRowMax()) ) return QRect();
+
+    // 縦横比を保ったまま収める.
+    QSize a_cSize = this->m_cImage.size().scaled(this->size(), Qt::KeepAspectRatio);
+    QRect a_cRect(QPoint(0, 0), a_cSize);
+    a_cRect.moveCenter(this->rect().center());
+    return a_cRect;
+}
+
+/**********************************
+ * 縮小表示用の画像を作る.
+ **********************************/
+void LifeGameCanvas::renderScaledImage(const QSize& i_cSize)
+{
+    int a_iWidth = i_cSize.width();
+    int a_iHeight = i_cSize.height();
+    if(this->m_cScaledImage.size() != i_cSize)
+    {
+        this->m_cScaledImage = QImage(i_cSize, QImage::Format_RGB32);
+        this->m_vecSourceCol.resize(a_iWidth);
+        for(int a_iCol=0; a_iCol<a_iWidth; a_iCol++)
+        {
+            this->m_vecSourceCol[a_iCol] = static_cast<int>(static_cast<long>(a_iCol) * this->getColMax() / a_iWidth);
+        }
+    }
+
+    // 表示する画素ごとに対応するセルを1つ選ぶ.(最近傍).
+    const int* a_piSourceCol = this->m_vecSourceCol.constData();
+    for(int a_iRow=0; a_iRow<a_iHeight; a_iRow++)
+    {
+        int a_iSourceRow = static_cast<int>(static_cast<long>(a_iRow) * this->getRowMax() / a_iHeight);
+        const uchar* a_pSource = this->m_cImage.constScanLine(a_iSourceRow);
+        QRgb* a_pPixel = reinterpret_cast<QRgb*>(this->m_cScaledImage.scanLine(a_iRow));
+        for(int a_iCol=0; a_iCol<a_iWidth; a_iCol++)
+        {
+            int a_iSourceCol = a_piSourceCol[a_iCol];
+            a_pPixel[a_iCol] = s_rgColor[(a_pSource[a_iSourceCol >> 3] >> (a_iSourceCol & 7)) & 1];
+        }
+    }
+}
+
+/**********************************
+ * 盤面を描画する.
+ **********************************/
+void LifeGameCanvas::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter a_cPainter(this);
+    a_cPainter.fillRect(this->rect(), this->palette().window());
+
+    QRect a_cTarget = this->getTargetRect();
+    if(a_cTarget.isEmpty()) return;
+
+    if(a_cTarget.width() >= this->getColMax())
+    {
+        // 拡大する場合は元の画像が表示より小さいため, そのまま拡大して描く.
+        a_cPainter.drawImage(a_cTarget, this->m_cImage);
+    }
+    else
+    {
+        // 縮小する場合は表示する画素数だけ処理する.(盤面全体を変換しない).
+        if(this->m_bIsScaledDirty || (this->m_cScaledImage.size() != a_cTarget.size()))
+        {
+            this->renderScaledImage(a_cTarget.size());
+            this->m_bIsScaledDirty = false;
+        }
+        a_cPainter.drawImage(a_cTarget.topLeft(), this->m_cScaledImage);
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef LIFEGAMECANVAS_H
+#define LIFEGAMECANVAS_H
+
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+
+#include "../../../../C++/source/Lib/Observer.h"
+#include "../../../../C++/source/Lib/CellAttribute.h"
+#include "../../../../C++/source/Lib/MatrixCellAttribute.h"
+#include "../../../../C++/source/Model/BitBoard.h"
+
+/**
+ * @brief   ライフゲームの盤面をQImageで表示するウィジェット.
+ * @note    C++版のMatrixCellへObserverとして登録する.
+ * @note    盤面は1セル1ビットのQImage(Format_MonoLSB)に保持し, 通知や
+ *          BitBoardの行から直接書き換える.(セルごとに描画しない).
+ * @note    paintEvent()で表示領域に合わせて拡大/縮小する.
+ *          縮小する場合は表示する大きさのRGB32画像を変化があった時だけ作り直す.
+ */
+class LifeGameCanvas : public QWidget, public Observer<MatrixCellAttribute>
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief   表示色のインデックス.(セルの状態と同じ).
+     */
+    enum { COLOR_DEAD = CellAttribute::DEAD, COLOR_ALIVE = CellAttribute::ALIVE, COLOR_MAX };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   QWidget *parent 親ウィジェット.
+     */
+    explicit LifeGameCanvas(QWidget *parent = 0);
+
+    /**
+     * @brief   盤面の大きさを設定する.
+     * @param   long i_lColMax 盤面の横幅.
+     * @param   long i_lRowMax 盤面の縦幅.
+     * @return  なし.
+     * @note    全セルを"死"とする.
+     */
+    void init(long i_lColMax, long i_lRowMax);
+
+    /**
+     * @brief   盤面の横幅.
+     */
+    long getColMax() const { return this->m_cImage.width(); }
+
+    /**
+     * @brief   盤面の縦幅.
+     */
+    long getRowMax() const { return this->m_cImage.height(); }
+
+    /**
+     * @brief   セルの状態を描画.
+     * @param   long i_lCol 横位置.
+     * @param   long i_lRow 縦位置.
+     * @param   CellAttribute::CELL_STATE i_eState セルの状態.
+     * @return  成功/失敗.
+     * @note    画面へはflush()を呼ぶまで反映しない.
+     */
+    bool draw(long i_lCol, long i_lRow, CellAttribute::CELL_STATE i_eState);
+
+    /**
+     * @brief   全セルの状態を描画.
+     * @param   const BitBoard& i_cBoard 全セルの状態.(盤面と同じ大きさ).
+     * @return  なし.
+     * @note    BitBoardの行を1バイトずつ画像の行へ写す.(ビットの順序が同じため変換は不要).
+     */
+    void drawBoard(const BitBoard& i_cBoard);
+
+    /**
+     * @brief   描画した内容を画面へ反映する.
+     * @param   なし.
+     * @return  なし.
+     * @note    変化があった場合だけ再描画を要求する.(1フレームに1回呼ぶ).
+     */
+    void flush();
+
+    /**
+     * @brief   Subjectから通知を受信.
+     * @param   const MatrixCellAttribute* i_pcAttribute MatrixCellの属性.
+     * @return  成功/失敗.
+     * @note    QWidget::update()と同じ名前のため, 再描画の要求にはQWidget::update()を使う.
+     */
+    bool update(const MatrixCellAttribute* i_pcAttribute);
+    using QWidget::update;
+
+protected:
+    /**
+     * @brief   盤面を描画する.
+     */
+    void paintEvent(QPaintEvent *event);
+
+private:
+    /**
+     * @brief   全セルの状態.(1セル1ビット, 左端が下位ビット).
+     */
+    QImage m_cImage;
+
+    /**
+     * @brief   縮小表示用の画像.(表示する大きさ).
+     */
+    QImage m_cScaledImage;
+
+    /**
+     * @brief   縮小表示の各列に対応する盤面の列.
+     */
+    QVector<int> m_vecSourceCol;
+
+    /**
+     * @brief   前回の再描画から盤面が変わったか否か.
+     */
+    bool m_bIsDirty;
+
+    /**
+     * @brief   縮小表示用の画像を作り直す必要があるか否か.
+     */
+    bool m_bIsScaledDirty;
+
+    /**
+     * @brief   盤面を表示する矩形.(縦横比を保ったままウィジェットに収める).
+     */
+    QRect getTargetRect() const;
+
+    /**
+     * @brief   縮小表示用の画像を作る.
+     * @param   const QSize& i_cSize 表示する大きさ.
+     * @return  なし.
+     */
+    void renderScaledImage(const QSize& i_cSize);
+};
+
+#endif // LIFEGAMECANVAS_H
@@ -1,10 +1,34 @@
 #include "widget.h"
 #include <QApplication>
+#include <cstdio>
+
+#include "../../../../C++/source/Controller/LifeGameOption.h"
+#include "../../../../C++/source/Model/SoupGenerator.h"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
-    Widget w;
+
+    // C++版と同じオプション.(--size, --pattern, --soup, --seed, --rule, --threads).
+    LifeGameOption a_cOption;
+    if( !a_cOption.parse(argc, argv) || !a_cOption.loadPattern() )
+    {
+        fprintf(stderr, "%s\n%s", a_cOption.getError().c_str(), LifeGameOption::getUsage(argv[0]).c_str());
+        return 1;
+    }
+    long a_lColMax = (0 < a_cOption.getColMax())? a_cOption.getColMax() : 4000;
+    long a_lRowMax = (0 < a_cOption.getRowMax())? a_cOption.getRowMax() : 4000;
+
+    // スープを敷き詰めた上に, パターンを中央へ配置する.
+    BitBoard a_cBoard(a_lColMax, a_lRowMax);
+    if(a_cOption.isSoup())
+    {
+        SoupGenerator(a_cOption.getSeed(), a_cOption.getSoupDensity()).generate(a_cBoard, a_cOption.getThreadNum());
+    }
+    const BitBoard& a_cPattern = a_cOption.getPattern();
+    a_cBoard.paste(a_cPattern, (a_lColMax - a_cPattern.getColMax()) / 2, (a_lRowMax - a_cPattern.getRowMax()) / 2);
+
+    Widget w(a_lColMax, a_lRowMax, a_cBoard, a_cOption.getRule());
     w.show();
 
     return a.exec();
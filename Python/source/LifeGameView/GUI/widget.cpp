@@ -1,14 +1,83 @@
 #include "widget.h"
 #include "ui_widget.h"
 
-Widget::Widget(QWidget *parent) :
+Widget::Widget(long i_lColMax, long i_lRowMax, const BitBoard& i_cBoard, const LifeRule& i_cRule, QWidget *parent) :
     QWidget(parent),
     ui(new Ui::Widget)
 {
     ui->setupUi(this);
+
+    // 表のセルごとに描画する代わりにQImageで描画する.(widget.uiはPyQt版と共用のため表はここで外す).
+    m_pcCanvas = new LifeGameCanvas(this);
+    m_pcCanvas->setGeometry(ui->tableWidget->geometry());
+    delete ui->tableWidget;
+    ui->tableWidget = 0;
+
+    // Modelを生成.
+    m_pcLifeGameModel = new MatrixCell(i_lColMax, i_lRowMax);
+    m_pcLifeGameModel->setRule(i_cRule);
+    if( (0 < i_cBoard.getColMax()) && (0 < i_cBoard.getRowMax()) )
+    {
+        m_pcLifeGameModel->importBitBoard(i_cBoard);
+    }
+
+    // Modelのセル状態とViewの表示を同期させる.
+    m_pcCanvas->init(i_lColMax, i_lRowMax);
+    BitBoard a_cBoard;
+    m_pcLifeGameModel->exportBitBoard(a_cBoard);
+    m_pcCanvas->drawBoard(a_cBoard);
+    m_pcLifeGameModel->attach(m_pcCanvas);
+
+    // 世代はイベントループが空く度に進め, 描画は一定間隔で行う.
+    m_cGenerationTimer.setInterval(0);
+    connect(&m_cGenerationTimer, SIGNAL(timeout()), this, SLOT(refreshCell()));
+    m_cFrameTimer.setInterval(1000 / FRAME_RATE);
+    connect(&m_cFrameTimer, SIGNAL(timeout()), this, SLOT(refreshFrame()));
+    m_cFrameTimer.start();
 }
 
 Widget::~Widget()
 {
+    m_cGenerationTimer.stop();
+    m_cFrameTimer.stop();
+    m_pcLifeGameModel->detach(m_pcCanvas);
+    delete m_pcLifeGameModel;
     delete ui;
 }
+
+void Widget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+
+    // 盤面はボタンの下の領域全体.
+    QRect a_cRect = this->rect();
+    a_cRect.setTop(ui->gridLayoutWidget->geometry().bottom() + 8);
+    m_pcCanvas->setGeometry(a_cRect.adjusted(8, 0, -8, -8));
+}
+
+void Widget::on_start_pushButton_clicked()
+{
+    m_cGenerationTimer.start();
+}
+
+void Widget::on_pause_pushButton_clicked()
+{
+    m_cGenerationTimer.stop();
+}
+
+void Widget::on_once_pushButton_clicked()
+{
+    m_cGenerationTimer.stop();
+    this->refreshCell();
+}
+
+void Widget::refreshCell()
+{
+    // 変化したセルはModelからの通知でLifeGameCanvasへ描画される.
+    m_pcLifeGameModel->refreshCell();
+}
+
+void Widget::refreshFrame()
+{
+    m_pcCanvas->flush();
+}
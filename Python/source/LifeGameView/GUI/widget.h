@@ -2,21 +2,84 @@
 #define WIDGET_H
 
 #include <QWidget>
+#include <QTimer>
+
+#include "lifegamecanvas.h"
+#include "../../../../C++/source/Model/MatrixCell.h"
 
 namespace Ui {
 class Widget;
 }
 
+/**
+ * @brief   ライフゲームのGUI.
+ * @note    Modelは C++版のMatrixCellを使い, 盤面はLifeGameCanvasで表示する.
+ * @note    世代の更新と描画は別のタイマーで行う.(描画は1秒あたりFRAME_RATE回まで).
+ */
 class Widget : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit Widget(QWidget *parent = 0);
+    /**
+     * @brief   1秒あたりの描画回数の上限.
+     */
+    enum { FRAME_RATE = 60 };
+
+    /**
+     * @brief   コンストラクタ.
+     * @param   long i_lColMax 盤面の横幅.
+     * @param   long i_lRowMax 盤面の縦幅.
+     * @param   const BitBoard& i_cBoard 初期配置.(大きさ0ならば空の盤面).
+     * @param   const LifeRule& i_cRule 誕生/生存の規則.
+     * @param   QWidget *parent 親ウィジェット.
+     */
+    Widget(long i_lColMax, long i_lRowMax, const BitBoard& i_cBoard, const LifeRule& i_cRule, QWidget *parent = 0);
     ~Widget();
 
+protected:
+    /**
+     * @brief   盤面をボタンの下一杯に広げる.
+     */
+    void resizeEvent(QResizeEvent *event);
+
+private slots:
+    void on_start_pushButton_clicked();
+    void on_pause_pushButton_clicked();
+    void on_once_pushButton_clicked();
+
+    /**
+     * @brief   世代を進める.
+     */
+    void refreshCell();
+
+    /**
+     * @brief   変化があれば再描画する.
+     */
+    void refreshFrame();
+
 private:
     Ui::Widget *ui;
+
+    /**
+     * @brief   LifeGame Model
+     */
+    MatrixCell* m_pcLifeGameModel;
+
+    /**
+     * @brief   LifeGame View
+     */
+    LifeGameCanvas* m_pcCanvas;
+
+    /**
+     * @brief   世代を進めるタイマー.
+     */
+    QTimer m_cGenerationTimer;
+
+    /**
+     * @brief   描画するタイマー.
+     */
+    QTimer m_cFrameTimer;
 };
 
 #endif // WIDGET_H